@@ -14,6 +14,12 @@
 // enables hardware pulse counters (PCNT) which counts edges in the background, with no ISR/CPU overhead!!!
 #include "driver/pcnt.h"
 
+// esp_timer runs the motion control tick in its own task, alongside loop()
+#include "esp_timer.h"
+
+// SCS RX ring indices are shared between the UART event task and loop()
+#include <atomic>
+
 ///////////////////////////////////////////////// Definitions ////////////////////////////////////////////////
 
 // UART port definitions
@@ -31,13 +37,37 @@
 // Assign channels for PCNT units
 #define ENCODER_R_CHANNEL PCNT_CHANNEL_0
 #define ENCODER_L_CHANNEL PCNT_CHANNEL_0
+// Counter limit -> the unit wraps to 0 here and an H_LIM event extends the 32-bit count
+#define ENCODER_H_LIM 32767
 
-// Baud rates
+// Baud rates (SCS_BAUD is the link base rate -> the SNC trains it up after reset)
 #define DEBUG_BAUD 115200
 #define SCS_BAUD   115200
 
 // Packet structure
 #define PACKET_SIZE 4
+#define MOTION_COMPLETE_FLAG 0x01           // MAZE:MDPS:IST4 DEC -> this report closes a stop/rotation (SNC's MDPS_DEC_MOTION_COMPLETE)
+#define ODOMETRY_FRAMES      1              // 0 -> NAVCON reports are IST1-4 only (a HUB that rejects MAZE:MDPS:IST5/6)
+#define ODOMETRY_TICK_MS     10             // IST5/6 DEC timestamp unit (SNC's MDPS_ODOMETRY_TICK_MS)
+
+// SCS link (frame-synchronising receiver + queued transmit, same scheme as the SNC's SerialPacketHandler)
+#define SCS_RX_RING_FRAMES  8               // Whole frames buffered between the UART event task and loop() (power of two)
+#define SCS_FRAME_GAP_US    3000            // Gap that abandons a half-received frame (resync)
+#define SCS_TX_QUEUE_FRAMES 32              // UART driver TX ring in frames -> Transmit() returns without waiting for the wire
+#define SOS_HALT_TIMEOUT_MS 500             // Longest wait for the encoders to read 0 before the SOS reply goes anyway
+
+// SCS link training (same frames and rate table as the SNC's scs_protocol.h) -> IDLE:SNC:IST15 in, IDLE:MDPS:IST15 out
+#define SCS_LINK_IST          15
+#define SCS_LINK_OP_PROPOSE   1             // SNC: try rate DAT0 -> ACK, then switch
+#define SCS_LINK_OP_ACK       2
+#define SCS_LINK_OP_PATTERN   3             // SNC: test frame -> echoed unchanged
+#define SCS_LINK_OP_COMMIT    4             // SNC: keep rate DAT0 -> echoed
+#define SCS_LINK_OP_FALLBACK  5             // SNC: drop to rate DAT0 now, no reply
+#define SCS_LINK_TRIAL_MS     200           // No COMMIT by then -> back to the last committed rate
+#define SCS_LINK_SILENCE_MS   1000          // Above the base rate, no SNC link frame (250 ms keepalive) by then -> base rate
+
+static const uint32_t SCS_LINK_RATES[] = { SCS_BAUD, 230400, 460800, 921600, 1500000, 2000000 };
+#define SCS_LINK_RATE_COUNT (sizeof(SCS_LINK_RATES) / sizeof(SCS_LINK_RATES[0]))
 
 // MDPS identifier
 #define SUBSYSTEM_MDPS 0b10
@@ -45,6 +75,37 @@
 // PI
 #define PI 3.14159265358979323846
 
+// Motion control timer
+#define CONTROL_PERIOD_US 2000              // 500 Hz control tick
+
+// Motion profile (shared by forward/backward, rotations and NAVCON stops)
+#define PROFILE_ACCEL_MAX  150.0            // Wheel acceleration limit (mm/s^2)
+#define PROFILE_JERK_MAX   1500.0           // Rate of change of acceleration limit (mm/s^3)
+
+// NAVCON forward/backward speeds (DAT1 = right, DAT0 = left wheel, mm/s) are held to what the wheels can track
+#define NAVCON_SPEED_MIN  10.0              // Below this the feed-forward table is in the deadband
+#define NAVCON_SPEED_MAX  60.0              // Top of the default table with PI headroom
+
+// Rotation engine (wheel speed targets, run through the motion profile and speed PI)
+#define ROT_SPEED         26.0              // Wheel speed while far from the target (the old fixed 128 drive)
+#define ROT_SPEED_MIN     8.0               // Creep speed for the last few degrees
+#define ROT_BALANCE_GAIN  2.0               // mm/s of trim per mm one wheel is ahead of the other
+#define ROT_TIMEOUT_MS    4000              // Give up (and report what was reached) after this
+
+// Encoder speed estimator (both wheels, every control tick)
+#define SPEED_RING_SIZE    16               // Slot-edge samples kept per wheel
+#define SPEED_WINDOW_US    200000           // Velocity window - edges older than this are dropped
+#define SPEED_STOP_FACTOR  1.5              // No edge for this many edge periods -> wheel stopped
+#define SPEED_STOP_MIN_US  20000            // ... but never declared stopped sooner than this
+
+// Wheel speed controller (per-wheel PI for forward/backward, same control tick)
+#define SPEED_KP           1.5              // Drive levels per mm/s of speed error
+#define SPEED_KI           4.0              // Drive levels per mm/s per second of accumulated error
+#define SPEED_I_LIMIT      80.0             // Integrator clamp in drive levels (anti-windup)
+#define FF_DRIVE_DEADBAND  50               // Default table: drive below which the wheels do not turn
+#define FF_DRIVE_AT_VOP    165              // Default table: the old fixed forward duty (LEDC 90) ...
+#define FF_VOP_SPEED       38.0             // ... gives roughly the default vop (tanSpeedR/L) in mm/s
+
 //////////////////////////////////////////////////// PINS /////////////////////////////////////////////////////
    
 const int interruptPin = 0  ;  // Boot Button, GPIO0, ADC2_CH1, TOUCH_CH1, Boot           -> using BOOT Button as interrupt
@@ -105,6 +166,35 @@ volatile unsigned long lastInterruptTime = 0;
 // Receive Flag
 bool received = false;
 
+// SCS link counters (RX side updated from the UART event task)
+struct SCSLinkStats {
+  uint32_t frames;                          // Complete frames pushed into the RX ring
+  uint32_t resyncs;                         // Partial frames discarded after an inter-frame gap
+  uint32_t drops;                           // Frames lost because the RX ring was full
+  uint32_t bytes;                           // Raw bytes taken from the UART
+  uint32_t txFrames;                        // Frames queued for transmit
+  uint32_t txStalls;                        // Transmits that found the TX queue full and had to wait
+};
+
+SCSLinkStats scsStats = {};
+
+// SCS frame assembly (owned by the UART event task)
+uint8_t       scsPartial[PACKET_SIZE];
+uint8_t       scsPartialCount = 0;
+unsigned long scsLastByteTime = 0;
+
+// Single-producer / single-consumer frame ring -> UART event task writes the head, loop() the tail
+uint8_t              scsRing[SCS_RX_RING_FRAMES][PACKET_SIZE];
+std::atomic<uint8_t> scsRingHead(0);
+std::atomic<uint8_t> scsRingTail(0);
+
+// SCS link rate (index into SCS_LINK_RATES) -> a trial rate is dropped again unless the SNC commits it
+uint8_t       linkRate        = 0;
+uint8_t       linkTrial       = 0;
+bool          linkTrialActive = false;
+unsigned long linkTrialMs     = 0;
+unsigned long linkHeardMs     = 0;         // Last link frame from the SNC (keepalive, training)
+
 // SNC Set Speed
 uint8_t RightWheelSpeed;                             // Right wheel speed - dat1
 uint8_t LeftWheelSpeed;                              // Left  wheel speed - dat0
@@ -114,13 +204,11 @@ float baseDiameter = 150; // mm from wheel centre to wheen centre
 float systemCircumference = PI * baseDiameter; // mm
 float distancePerDegree = (systemCircumference / 360); // mm/degree
 
-// Rotation control variables
-bool isRotating = false;
-float targetRotationDistance = 0;  // Target distance each wheel needs to travel
-float rotationStartDistance_R = 0; // Distance at start of rotation (right wheel)
-float rotationStartDistance_L = 0; // Distance at start of rotation (left wheel)
-
-float avgRotatedDistance = 0;
+// Rotation control variables (raw encoder counts - converted once when the command arrives)
+volatile bool isRotating = false;
+int32_t rotationTargetCounts = 0;  // Right + left counts that make up the commanded angle
+int16_t rotationStartCount_R = 0;  // PCNT value at the start of the rotation (right wheel)
+int16_t rotationStartCount_L = 0;  // PCNT value at the start of the rotation (left wheel)
 
 // Last Rotation Direction & Angle
 uint8_t RotationDirection;  
@@ -150,6 +238,11 @@ const float radius                        = 25;
 const float countsPerRev                  = 60.0;                                // 30 slots × 2 edges = 60 counts
 const float distancePerSlot               = ( (2 * PI * radius) / countsPerRev); // Distance per count
 
+// Odometry stays in counts; Q16 fixed point converts them only when a report is packed
+const int32_t Q16_ONE           = 65536;
+const int32_t MM_PER_COUNT_Q16  = (int32_t)(distancePerSlot * Q16_ONE + 0.5);                      // One wheel count in mm
+const int32_t DEG_PER_COUNT_Q16 = (int32_t)(distancePerSlot / distancePerDegree * Q16_ONE + 0.5);  // One wheel count of a pivot in degrees
+
 int16_t   CurrentDistance = 0;
 
 bool moving = false;
@@ -157,8 +250,13 @@ bool moving = false;
 int16_t   counter_1       = 0;
 int16_t   counter_0       = 0;
 
-float distanceTravelled_1 = 0;
-float distanceTravelled_0 = 0;
+// Extended encoder counts: PCNT value + encoderBase = counts since boot (32-bit, never cleared).
+// clearPCNT() and H_LIM wraps move what the unit held into the base; moves are deltas from moveStart
+portMUX_TYPE encoderMux = portMUX_INITIALIZER_UNLOCKED;
+volatile int32_t encoderBaseR = 0;
+volatile int32_t encoderBaseL = 0;
+int32_t moveStartR = 0;                     // Extended count at the last clearPCNT() (stop / rotation / new movement)
+int32_t moveStartL = 0;
 
 unsigned long startTime = 0;
 unsigned long stopTime  = 0;
@@ -176,6 +274,59 @@ const int PWM_CHANNEL_H2_Q4 = 3;  // PWM channel for H2 Q4 (backward)
 const int PWM_FREQ = 1000;        // 1 kHz
 const int PWM_RESOLUTION = 8;     // 8-bit resolution (0–255)
 
+// Rotation engine state
+esp_timer_handle_t controlTimer = nullptr;
+volatile bool rotationDone = false;        // Set by the control tick once the target is reached
+bool navconReplyPending    = false;        // NAVCON reports held back until the rotation completes
+
+// SOS fast path -> the UART event task flags a pure tone frame as it arrives, loop() stops before older queued frames
+volatile bool sosStopRequested = false;    // Pure tone frame received (queued or dropped), not yet acted on
+bool sosStopLatched   = false;             // Stopped ahead of the ring -> older NAVCON frames may not start motion
+bool sosReplyPending  = false;             // SOS reply held back until the wheels are at rest
+unsigned long sosStopMs = 0;
+unsigned long rotationStartMs = 0;
+int rotationChannelR = PWM_CHANNEL_H2_Q3;  // LEDC channel carrying the right wheel's PWM
+int rotationChannelL = PWM_CHANNEL_H1_Q4;  // LEDC channel carrying the left wheel's PWM
+
+// Encoder speed estimator state (one per wheel, updated in the control tick)
+struct EdgeSample {
+  int64_t time_us;                          // Control tick in which the count changed
+  int32_t count;                            // Running count (survives clearPCNT())
+};
+
+struct SpeedEstimator {
+  EdgeSample ring[SPEED_RING_SIZE];
+  int        head;                          // Next slot to write
+  int        filled;
+  int32_t    total;                         // Extended count at the last edge (counts since boot)
+  float      speed;                         // Latest estimate (mm/s)
+};
+
+SpeedEstimator speedEstR = {};
+SpeedEstimator speedEstL = {};
+
+// Motion profile state -> jerk-limited ramp of the commanded speed towards vTarget
+struct MotionProfile {
+  float   v;                                // Commanded speed (mm/s)
+  float   a;                                // Commanded acceleration (mm/s^2)
+  float   vTarget;                          // Speed the profile is ramping to (mm/s)
+};
+
+// Wheel speed controller state (one per wheel, updated in the control tick)
+struct WheelController {
+  int           channel;                    // LEDC channel carrying this wheel's PWM
+  float         target;                     // Requested tangential speed (mm/s)
+  float         measured;                   // Estimator speed at the last tick (mm/s)
+  float         integral;                   // PI integrator (drive levels)
+  MotionProfile profile;                    // Ramp between the current and requested speed
+};
+
+WheelController speedCtrlR = {};
+WheelController speedCtrlL = {};
+volatile bool speedControlActive = false;
+volatile bool rampStopping       = false;   // Both profiles ramping to 0 for a NAVCON stop
+volatile bool rampStopDone       = false;   // Set by the control tick once both wheels are at 0
+
 // Interrupt debounce variables
 uint32_t currentTime = 0;
 uint32_t lastTime    = 0;
@@ -196,6 +347,8 @@ uint8_t tanSpeedL = 38;
 
 // Function Declaration
 void clearPCNT();
+int32_t encoderCount(pcnt_unit_t unit);
+void encoderEvent(void* arg);
 
 void Calibrate();
 
@@ -206,6 +359,7 @@ void forward(float desiredSpeedR, float desiredSpeedL);
 void backward(float desiredSpeedR, float desiredSpeedL);
 
 void Stop();
+void rampStop();
 
 //////////////////// MIGHT NEED TO SWAP OUT
 //void forward();
@@ -215,14 +369,69 @@ void right();
 ///////////////////
 
 void angularRotation();
+int32_t countsToUnits(int32_t counts, int32_t unitsPerCountQ16);
+void rotationSetTarget();
+void rotationWatch();
+void controlTick(void* arg);
+void rotationTick(float speedR, float speedL);
+void speedStart(int channelR, int channelL, float desiredSpeedR, float desiredSpeedL);
+bool speedRetarget(uint8_t direction, float desiredSpeedR, float desiredSpeedL);
+void wheelStart(WheelController& wheel, int channel, float target);
+void wheelTick(WheelController& wheel, float measured, float trim, float* const table[]);
+void profileTick(MotionProfile& profile);
+void speedEstimatorTick(SpeedEstimator& est, int32_t count, int64_t now);
+float speedEstimate(const SpeedEstimator& est, int64_t now);
+float feedForwardDrive(float* const table[], float speed);
+void finishRotation();
+void sosStop();
 void distance();
 void tangentialSpeed();
+void navconReport();
 
 void Receive_and_Sort(); 
+void onScsReceive();
+void scsPushFrame(const uint8_t* bytes);
 void Process();
 void System_State();
 void TX_Ready();
 void Transmit(uint8_t sys, uint8_t sub, uint8_t ist, uint8_t dat1, uint8_t dat0, uint8_t dec);
+void linkReply(uint8_t op, uint8_t dat0, uint8_t dec);
+void linkSetRate(uint8_t index);
+
+void handleIgnored();
+void handleCalibrate();
+void handleTouch();
+void handlePureTone();
+void handleNavcon();
+void handleEndOfMaze();
+void handleLinkTraining();
+
+////////////////////////////////////////////// SCS Dispatch Table //////////////////////////////////////////////
+
+// One handler per control byte (SYS<1:0> | SUB<1:0> | IST<3:0>) -> Process() is a single lookup, built at compile time
+typedef void (*PacketHandler)();
+
+constexpr uint8_t controlByteOf(uint8_t sys, uint8_t sub, uint8_t ist) {
+  return ((sys & 0b11) << 6) | ((sub & 0b11) << 4) | (ist & 0b1111);
+}
+
+constexpr PacketHandler packetHandlerFor(uint8_t control) {
+  return (control == controlByteOf(0b01, 0b11, 0b0000)) ? handleCalibrate :   // CAL  / SS  / IST0 -> calibration start
+         (control == controlByteOf(0b01, 0b01, 0b0000)) ? handleTouch     :   // CAL  / SNC / IST0 -> touch
+         (control == controlByteOf(0b10, 0b01, 0b0001)) ? handlePureTone  :   // MAZE / SNC / IST1 -> pure tone
+         (control == controlByteOf(0b10, 0b01, 0b0011)) ? handleNavcon    :   // MAZE / SNC / IST3 -> NAVCON
+         (control == controlByteOf(0b10, 0b11, 0b0011)) ? handleEndOfMaze :   // MAZE / SS  / IST3 -> end of maze
+         (control == controlByteOf(0b00, 0b01, SCS_LINK_IST)) ? handleLinkTraining : // IDLE / SNC / IST15 -> link training
+                                                          handleIgnored;      // IDLE and everything else
+}
+
+#define PACKET_HANDLERS_4(n)   packetHandlerFor(n), packetHandlerFor(n + 1), packetHandlerFor(n + 2), packetHandlerFor(n + 3)
+#define PACKET_HANDLERS_16(n)  PACKET_HANDLERS_4(n), PACKET_HANDLERS_4(n + 4), PACKET_HANDLERS_4(n + 8), PACKET_HANDLERS_4(n + 12)
+#define PACKET_HANDLERS_64(n)  PACKET_HANDLERS_16(n), PACKET_HANDLERS_16(n + 16), PACKET_HANDLERS_16(n + 32), PACKET_HANDLERS_16(n + 48)
+
+constexpr PacketHandler packetHandlers[256] = {
+  PACKET_HANDLERS_64(0), PACKET_HANDLERS_64(64), PACKET_HANDLERS_64(128), PACKET_HANDLERS_64(192)
+};
 
 ///////////////////////////////////////////// Interrupt Function /////////////////////////////////////////////
 
@@ -241,10 +450,16 @@ void IRAM_ATTR handleInterrupt() {
 
 void setup() {
 
-  // Baud Rate
-  USB_PORT.begin(DEBUG_BAUD);
+  // Baud Rate (TX ring must be sized before the driver is installed)
+  USB_PORT.setTxBufferSize(SCS_TX_QUEUE_FRAMES * PACKET_SIZE);
+  USB_PORT.begin(SCS_LINK_RATES[0]);
   // SCS_PORT.begin(SCS_BAUD);
 
+  // SCS receive -> wake the UART event task once a full frame is in the FIFO, or after 2 idle symbols
+  USB_PORT.setRxFIFOFull(PACKET_SIZE);
+  USB_PORT.setRxTimeout(2);
+  USB_PORT.onReceive(onScsReceive, false);
+
   // Interrupts
   pinMode(interruptPin, INPUT); 
   attachInterrupt(digitalPinToInterrupt(interruptPin), handleInterrupt, RISING);
@@ -274,7 +489,7 @@ void setup() {
   pcnt_config1.neg_mode       = PCNT_COUNT_INC;       // count falling edges
   pcnt_config1.lctrl_mode     = PCNT_MODE_KEEP;
   pcnt_config1.hctrl_mode     = PCNT_MODE_KEEP;
-  pcnt_config1.counter_h_lim  = 32767;                // 0 ->  32767 (then saturates)
+  pcnt_config1.counter_h_lim  = ENCODER_H_LIM;        // 0 ->  32767 (then wraps to 0, H_LIM event)
   pcnt_config1.counter_l_lim  = 0;                    // 0 -> -32767
   pcnt_unit_config(&pcnt_config1);
   pcnt_counter_pause(ENCODER_R_UNIT);  
@@ -291,13 +506,23 @@ void setup() {
   pcnt_config2.neg_mode       = PCNT_COUNT_INC;   
   pcnt_config2.lctrl_mode     = PCNT_MODE_KEEP;
   pcnt_config2.hctrl_mode     = PCNT_MODE_KEEP;
-  pcnt_config2.counter_h_lim  = 32767;
+  pcnt_config2.counter_h_lim  = ENCODER_H_LIM;
   pcnt_config2.counter_l_lim  = 0;
   pcnt_unit_config(&pcnt_config2);
   pcnt_counter_pause(ENCODER_L_UNIT); 
   pcnt_counter_clear(ENCODER_L_UNIT);
   pcnt_counter_resume(ENCODER_L_UNIT);
 
+  // H_LIM extends the count past 16 bits; threshold 0 is loaded with the wheel's share of a rotation -> rotationWatch()
+  // cuts the drive on the count
+  pcnt_event_enable(ENCODER_R_UNIT, PCNT_EVT_H_LIM);
+  pcnt_event_enable(ENCODER_L_UNIT, PCNT_EVT_H_LIM);
+  pcnt_event_enable(ENCODER_R_UNIT, PCNT_EVT_THRES_0);
+  pcnt_event_enable(ENCODER_L_UNIT, PCNT_EVT_THRES_0);
+  pcnt_isr_service_install(0);
+  pcnt_isr_handler_add(ENCODER_R_UNIT, encoderEvent, (void*)ENCODER_R_UNIT);
+  pcnt_isr_handler_add(ENCODER_L_UNIT, encoderEvent, (void*)ENCODER_L_UNIT);
+
   // To read counts safely:
   // pcnt_get_counter_value(ENCODER_L_UNIT, &counter_0);   // Reads the current count of the left encoder
   // Serial.print(counter_1);
@@ -308,6 +533,14 @@ void setup() {
     speedCalibrationL[i] = &speedL[i];
   }
 
+  // Default speed table (linear through the deadband and the old fixed duty) until Calibrate() measures one
+  for (int i = 0; i < NUM_CAL_POINTS; i++) {
+    float drive = pwmLevels[i] * 255.0 / 100.0;
+    float speed = FF_VOP_SPEED * (drive - FF_DRIVE_DEADBAND) / (FF_DRIVE_AT_VOP - FF_DRIVE_DEADBAND);
+    speedR[i] = (speed > 0) ? speed : 0;
+    speedL[i] = speedR[i];
+  }
+
   // PWM Config
 
   // Configure H-Bridge 1 outputs (Left Encoder)
@@ -346,6 +579,13 @@ void setup() {
   ledcAttachPin(PIN_H2_Q4, PWM_CHANNEL_H2_Q4);
   ledcWrite(PWM_CHANNEL_H2_Q4, 255);  // 100% duty = HIGH = OFF
 
+  // Motion control tick (500 Hz) -> rotation engine + wheel speed PI
+  esp_timer_create_args_t controlTimerArgs = {};
+  controlTimerArgs.callback = controlTick;
+  controlTimerArgs.name     = "mdps_control";
+  esp_timer_create(&controlTimerArgs, &controlTimer);
+  esp_timer_start_periodic(controlTimer, CONTROL_PERIOD_US);
+
   // USB Debug
   // USB_PORT.println("MDPS subsystem initialized.");
 
@@ -355,13 +595,59 @@ void setup() {
 
 void clearPCNT() {
 
+  // Paused while the count moves into the base -> no edge is lost and the extended count never steps back
+  int16_t rawR = 0;
+  int16_t rawL = 0;
+  portENTER_CRITICAL(&encoderMux);
   pcnt_counter_pause(ENCODER_R_UNIT);  
+  pcnt_get_counter_value(ENCODER_R_UNIT, &rawR);
   pcnt_counter_clear(ENCODER_R_UNIT);
+  encoderBaseR += rawR;
   pcnt_counter_resume(ENCODER_R_UNIT);
   pcnt_counter_pause(ENCODER_L_UNIT); 
+  pcnt_get_counter_value(ENCODER_L_UNIT, &rawL);
   pcnt_counter_clear(ENCODER_L_UNIT);
+  encoderBaseL += rawL;
   pcnt_counter_resume(ENCODER_L_UNIT);
+  moveStartR = encoderBaseR;
+  moveStartL = encoderBaseL;
+  portEXIT_CRITICAL(&encoderMux);
+
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+
+int32_t encoderCount(pcnt_unit_t unit) {
+
+  int16_t raw = 0;
+  portENTER_CRITICAL(&encoderMux);
+  pcnt_get_counter_value(unit, &raw);
+  int32_t count = raw + ((unit == ENCODER_R_UNIT) ? encoderBaseR : encoderBaseL);
+  portEXIT_CRITICAL(&encoderMux);
+  return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+//----------------- PCNT event ISR -> H_LIM: the unit wrapped to 0, extend the count / THRES_0: a wheel reached its rotation share ----------------
+
+void encoderEvent(void* arg) {
+
+  pcnt_unit_t unit = (pcnt_unit_t)(intptr_t)arg;
+  uint32_t status = 0;
+  pcnt_get_event_status(unit, &status);
 
+  if (status & PCNT_EVT_H_LIM) {
+    portENTER_CRITICAL_ISR(&encoderMux);
+    if (unit == ENCODER_R_UNIT) {
+      encoderBaseR += ENCODER_H_LIM;
+    } else {
+      encoderBaseL += ENCODER_H_LIM;
+    }
+    portEXIT_CRITICAL_ISR(&encoderMux);
+  }
+  if (status & PCNT_EVT_THRES_0) {
+    rotationWatch();
+  }
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -400,6 +686,17 @@ void Stop() {
   //  Control Action              : Motor reduces speed to zero.
   //  Additional Notes            : After stopping, DAT1 = 0 right wheel speed, DAT0 = 0 left wheel speed.
 
+  speedControlActive = false;
+  rampStopping       = false;
+  rampStopDone       = false;
+
+  // An external stop (pure tone / NAVCON) aborts a rotation in progress
+  if (isRotating) {
+    isRotating         = false;
+    rotationDone       = false;
+    navconReplyPending = false;
+  }
+
   // All Outputs OFF
   digitalWrite(PIN_H1_Q1, LOW);
   digitalWrite(PIN_H1_Q2, LOW);
@@ -420,6 +717,22 @@ void Stop() {
   moving    = false;
 }
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+//----------------- NAVCON stop -> ramp both wheels down through the motion profile, loop() calls Stop() once they are at rest --------------------------
+
+void rampStop() {
+
+  // Nothing closed-loop to ramp (or a rotation to abort) -> stop immediately
+  if (!speedControlActive || isRotating) {
+    Stop();
+    return;
+  }
+
+  speedCtrlR.profile.vTarget = 0;
+  speedCtrlL.profile.vTarget = 0;
+  rampStopping = true;
+}
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------
 //----------------- Go forwards and return tangential wheel speed ------> DAT1 = right wheel speed in mm/s, DAT0 = left wheel speed in mm/s -------------
 
@@ -433,14 +746,15 @@ void forward(float desiredSpeedR, float desiredSpeedL) {
 
   digitalWrite(PIN_H1_Q1, LOW);
   digitalWrite(PIN_H1_Q2, HIGH);
-  ledcWrite(PWM_CHANNEL_H1_Q3, 90);
   ledcWrite(PWM_CHANNEL_H1_Q4, 255);
 
   digitalWrite(PIN_H2_Q1, LOW);
   digitalWrite(PIN_H2_Q2, HIGH);
-  ledcWrite(PWM_CHANNEL_H2_Q3, 90);
   ledcWrite(PWM_CHANNEL_H2_Q4, 255);
 
+  // Q3 PWM is closed-loop from here on
+  speedStart(PWM_CHANNEL_H2_Q3, PWM_CHANNEL_H1_Q3, desiredSpeedR, desiredSpeedL);
+
   startTime = millis();    // stopTime set in distance calculation
 
   moving = true;
@@ -461,12 +775,13 @@ void backward(float desiredSpeedR, float desiredSpeedL) {
   digitalWrite(PIN_H1_Q1, HIGH);
   digitalWrite(PIN_H1_Q2, LOW);
   ledcWrite(PWM_CHANNEL_H1_Q3, 255);
-  ledcWrite(PWM_CHANNEL_H1_Q4, 90);
 
   digitalWrite(PIN_H2_Q1, HIGH);
   digitalWrite(PIN_H2_Q2, LOW);
   ledcWrite(PWM_CHANNEL_H2_Q3, 255);
-  ledcWrite(PWM_CHANNEL_H2_Q4, 90);
+
+  // Q4 PWM is closed-loop from here on
+  speedStart(PWM_CHANNEL_H2_Q4, PWM_CHANNEL_H1_Q4, desiredSpeedR, desiredSpeedL);
 
   startTime = millis();    // stopTime set in distance calculation
 
@@ -482,16 +797,7 @@ void left() {
 
   RotationDirection = 2; // Left = CCW
 
-  targetRotationDistance = RotationAngle * distancePerDegree;
-  avgRotatedDistance = 0;
-
-  clearPCNT();
-
-  // Record starting distances
-  pcnt_get_counter_value(ENCODER_R_UNIT, &counter_1);
-  pcnt_get_counter_value(ENCODER_L_UNIT, &counter_0);
-  rotationStartDistance_R = counter_1 * distancePerSlot;
-  rotationStartDistance_L = counter_0 * distancePerSlot;
+  rotationSetTarget();
 
   // Wheel 1 (Left) - Backward
   digitalWrite(PIN_H1_Q1, HIGH);                 // Q1 ON
@@ -503,14 +809,21 @@ void left() {
 
   // Wheel 1 (Left) - Backward
   ledcWrite(PWM_CHANNEL_H1_Q3, 255);             // Q3 OFF
-  ledcWrite(PWM_CHANNEL_H1_Q4, 127);             // Q4 PWM
+  ledcWrite(PWM_CHANNEL_H1_Q4, 255);             // Q4 PWM (profile ramps it up)
   
   // Wheel 2 (Right) - Forward
-  ledcWrite(PWM_CHANNEL_H2_Q3, 127);             // Q3 PWM
+  ledcWrite(PWM_CHANNEL_H2_Q3, 255);             // Q3 PWM (profile ramps it up)
   ledcWrite(PWM_CHANNEL_H2_Q4, 255);             // Q4 OFF
 
+  // Control tick ramps and trims these channels from here on
+  rotationChannelL = PWM_CHANNEL_H1_Q4;
+  rotationChannelR = PWM_CHANNEL_H2_Q3;
+  speedStart(rotationChannelR, rotationChannelL, ROT_SPEED, ROT_SPEED);
+
   startTime  = millis();    // stopTime set in distance calculation
+  rotationStartMs = startTime;
   moving     = true;
+  rotationDone = false;
   isRotating = true;
  
 }
@@ -523,16 +836,7 @@ void right() {
 
   RotationDirection = 3; // Right = CW
 
-  targetRotationDistance = RotationAngle * distancePerDegree;
-  avgRotatedDistance = 0;
-
-  clearPCNT();
-
-  // Record starting distances
-  pcnt_get_counter_value(ENCODER_R_UNIT, &counter_1);
-  pcnt_get_counter_value(ENCODER_L_UNIT, &counter_0);
-  rotationStartDistance_R = counter_1 * distancePerSlot;
-  rotationStartDistance_L = counter_0 * distancePerSlot;
+  rotationSetTarget();
 
   // Wheel 1 (Left) - Forward
   digitalWrite(PIN_H1_Q1, LOW);                  // Q1 OFF
@@ -543,15 +847,22 @@ void right() {
   digitalWrite(PIN_H2_Q2, LOW);                  // Q2 OFF
 
   // Wheel 1 (Left) - Forward
-  ledcWrite(PWM_CHANNEL_H1_Q3, 127);             // Q3 PWM
+  ledcWrite(PWM_CHANNEL_H1_Q3, 255);             // Q3 PWM (profile ramps it up)
   ledcWrite(PWM_CHANNEL_H1_Q4, 255);             // Q4 OFF
   
   // Wheel 2 (Right) - Backward
   ledcWrite(PWM_CHANNEL_H2_Q3, 255);             // Q3 OFF
-  ledcWrite(PWM_CHANNEL_H2_Q4, 127);             // Q4 PWM
+  ledcWrite(PWM_CHANNEL_H2_Q4, 255);             // Q4 PWM (profile ramps it up)
+
+  // Control tick ramps and trims these channels from here on
+  rotationChannelL = PWM_CHANNEL_H1_Q3;
+  rotationChannelR = PWM_CHANNEL_H2_Q4;
+  speedStart(rotationChannelR, rotationChannelL, ROT_SPEED, ROT_SPEED);
 
   startTime  = millis();    // stopTime set in distance calculation
+  rotationStartMs = startTime;
   moving     = true;
+  rotationDone = false;
   isRotating = true;
 
 }
@@ -633,39 +944,60 @@ void Calibrate() {
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------
 
-void angularRotation() {
-  
-  if (isRotating) {
+int32_t countsToUnits(int32_t counts, int32_t unitsPerCountQ16) {
 
-    // Rotate until target angle reached
+  // Rounded to the nearest unit; 64-bit product so a full int16 count pair cannot overflow
+  return (int32_t)(((int64_t)counts * unitsPerCountQ16 + Q16_ONE / 2) >> 16);
+}
 
-    while (avgRotatedDistance < targetRotationDistance) {
-    // Get current distances
-    pcnt_get_counter_value(ENCODER_R_UNIT, &counter_1);
-    pcnt_get_counter_value(ENCODER_L_UNIT, &counter_0);
-    float currentDistance_R = counter_1 * distancePerSlot;
-    float currentDistance_L = counter_0 * distancePerSlot;
-  
-    // Calculate how far we've rotated
-    float rotatedDistance_R = currentDistance_R - rotationStartDistance_R;
-    float rotatedDistance_L = currentDistance_L - rotationStartDistance_L;
-  
-    // Use the average of both wheels (they should be similar for rotation)
-    avgRotatedDistance = (rotatedDistance_R + rotatedDistance_L) / 2.0;
-  
-    }
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+//----------------- Rotation target -> angle to a count threshold once per command, loaded into the PCNT watchpoints as well --------------------------
 
-    Stop();
-    
-    // Calculate actual angle rotated
-    float actualAngle = avgRotatedDistance / distancePerDegree;
-    RotationAngle = (uint16_t)(actualAngle + 0.5);  // Round to nearest degree
+void rotationSetTarget() {
 
-    isRotating = false;  // Resets rotating flab
+  // Right + left counts for the angle (each wheel travels RotationAngle * distancePerDegree)
+  rotationTargetCounts = (int32_t)(2.0 * RotationAngle * distancePerDegree / distancePerSlot + 0.5);
 
-    clearPCNT();
-  
+  clearPCNT();
+
+  // Record starting counts
+  pcnt_get_counter_value(ENCODER_R_UNIT, &rotationStartCount_R);
+  pcnt_get_counter_value(ENCODER_L_UNIT, &rotationStartCount_L);
+
+  // Each wheel's share -> the PCNT interrupts on the edge that reaches it instead of waiting for the next tick
+  int16_t share = (int16_t)((rotationTargetCounts + 1) / 2);
+  pcnt_set_event_value(ENCODER_R_UNIT, PCNT_EVT_THRES_0, rotationStartCount_R + share);
+  pcnt_set_event_value(ENCODER_L_UNIT, PCNT_EVT_THRES_0, rotationStartCount_L + share);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+//----------------- PCNT threshold event -> a wheel reached its share; once both together reach the target the drive is cut here --------------------
+
+void rotationWatch() {
+
+  // Thresholds stay loaded after a rotation; edges while driving straight are ignored
+  if (!isRotating || rotationDone) {
+    return;
+  }
+
+  int16_t countR = 0;
+  int16_t countL = 0;
+  pcnt_get_counter_value(ENCODER_R_UNIT, &countR);
+  pcnt_get_counter_value(ENCODER_L_UNIT, &countL);
+  if ((countR - rotationStartCount_R) + (countL - rotationStartCount_L) < rotationTargetCounts) {
+    return;                                 // Other wheel behind -> its own threshold (or the tick) ends it
   }
+
+  ledcWrite(rotationChannelR, 255);
+  ledcWrite(rotationChannelL, 255);
+  rotationDone = true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void angularRotation() {
+
+  // The rotation itself runs in rotationTick(); this only packs the last result
   
   // Split value into MSB and LSB for transmission
   data1 = (RotationAngle >> 8) & 0xFF;   // Upper 8 bits
@@ -673,6 +1005,295 @@ void angularRotation() {
   data2 = RotationDirection;             // 2 = left (CCW), 3 = right (CW)
 }
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+//----------------- Motion control tick (esp_timer task, 500 Hz) -> never blocks, loop() keeps servicing SCS packets ------------------------------------
+
+void controlTick(void* arg) {
+
+  // Speed estimate runs every tick so IST3 also sees rotations and coasting
+  int64_t now = esp_timer_get_time();
+  speedEstimatorTick(speedEstR, encoderCount(ENCODER_R_UNIT), now);
+  speedEstimatorTick(speedEstL, encoderCount(ENCODER_L_UNIT), now);
+
+  if (isRotating && !rotationDone) {
+    rotationTick(speedEstR.speed, speedEstL.speed);
+  }
+  else if (speedControlActive) {
+    wheelTick(speedCtrlR, speedEstR.speed, 0, speedCalibrationR);
+    wheelTick(speedCtrlL, speedEstL.speed, 0, speedCalibrationL);
+
+    // NAVCON stop: both profiles back at rest -> loop() brakes and reports
+    if (rampStopping && speedCtrlR.profile.v == 0 && speedCtrlL.profile.v == 0) {
+      rampStopping       = false;
+      speedControlActive = false;
+      rampStopDone       = true;
+    }
+  }
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+//----------------- Encoder speed -> ring of (time, count) at each slot edge, velocity over the window, zero once edges stop -----------------------------
+
+void speedEstimatorTick(SpeedEstimator& est, int32_t count, int64_t now) {
+
+  // Extended count is monotonic (a tick between an H_LIM wrap and its ISR reads low -> skipped)
+  if (count > est.total) {
+    est.total = count;
+    est.ring[est.head].time_us = now;
+    est.ring[est.head].count   = est.total;
+    est.head = (est.head + 1) % SPEED_RING_SIZE;
+    if (est.filled < SPEED_RING_SIZE) {
+      est.filled++;
+    }
+  }
+
+  est.speed = speedEstimate(est, now);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+
+float speedEstimate(const SpeedEstimator& est, int64_t now) {
+
+  if (est.filled < 2) {
+    return 0;                               // Need two edges for a period
+  }
+
+  const EdgeSample& newest   = est.ring[(est.head + SPEED_RING_SIZE - 1) % SPEED_RING_SIZE];
+  const EdgeSample& previous = est.ring[(est.head + SPEED_RING_SIZE - 2) % SPEED_RING_SIZE];
+
+  // Wheel stopped: no edge for well over one edge period
+  float lastPeriod = (float)(newest.time_us - previous.time_us) / (newest.count - previous.count);
+  float sinceEdge  = (float)(now - newest.time_us);
+  float stopAfter  = SPEED_STOP_FACTOR * lastPeriod;
+  if (sinceEdge > ((stopAfter > SPEED_STOP_MIN_US) ? stopAfter : SPEED_STOP_MIN_US)) {
+    return 0;
+  }
+
+  // Oldest edge still inside the window (always at least the previous edge) -> period measurement at low speed,
+  // many counts per window at high speed
+  const EdgeSample* oldest = &previous;
+  for (int i = 3; i <= est.filled; i++) {
+    const EdgeSample& sample = est.ring[(est.head + SPEED_RING_SIZE - i) % SPEED_RING_SIZE];
+    if (newest.time_us - sample.time_us > SPEED_WINDOW_US) {
+      break;
+    }
+    oldest = &sample;
+  }
+
+  float speed = (newest.count - oldest->count) * distancePerSlot * 1000000.0 / (float)(newest.time_us - oldest->time_us);
+
+  // Overdue edge -> the wheel is slowing; it cannot be faster than one count over the gap
+  if (sinceEdge > lastPeriod) {
+    float bound = distancePerSlot * 1000000.0 / sinceEdge;
+    if (bound < speed) {
+      speed = bound;
+    }
+  }
+
+  return speed;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void rotationTick(float speedR, float speedL) {
+
+  int16_t countR = 0;
+  int16_t countL = 0;
+  pcnt_get_counter_value(ENCODER_R_UNIT, &countR);
+  pcnt_get_counter_value(ENCODER_L_UNIT, &countL);
+
+  // Counts each wheel has rotated (the target check stays in integers)
+  int32_t rotatedR = countR - rotationStartCount_R;
+  int32_t rotatedL = countL - rotationStartCount_L;
+
+  if ((rotatedR + rotatedL >= rotationTargetCounts) || (millis() - rotationStartMs > ROT_TIMEOUT_MS)) {
+    // Target reached (or stalled) -> cut drive now, loop() brakes and reports
+    ledcWrite(rotationChannelR, 255);
+    ledcWrite(rotationChannelL, 255);
+    rotationDone = true;
+    return;
+  }
+
+  // Speed target from the remaining distance: v = sqrt(2 * a * d) at half the accel limit, so the
+  // jerk-limited profile still has room to bring the wheels down to creep speed before the target
+  float remaining = (rotationTargetCounts - rotatedR - rotatedL) * (distancePerSlot / 2);   // mm per wheel
+  float vTarget   = constrain(sqrt(PROFILE_ACCEL_MAX * remaining), ROT_SPEED_MIN, ROT_SPEED);
+  speedCtrlR.profile.vTarget = vTarget;
+  speedCtrlL.profile.vTarget = vTarget;
+
+  // Per-wheel feedback: hold back whichever wheel is ahead so MARV pivots on its centre
+  float imbalance = (rotatedR - rotatedL) * distancePerSlot;  // + = right wheel ahead
+  wheelTick(speedCtrlR, speedR, -ROT_BALANCE_GAIN * imbalance / 2, speedCalibrationR);
+  wheelTick(speedCtrlL, speedL,  ROT_BALANCE_GAIN * imbalance / 2, speedCalibrationL);
+
+  // rotationWatch() may have cut the drive while this tick was writing it
+  if (rotationDone) {
+    ledcWrite(rotationChannelR, 255);
+    ledcWrite(rotationChannelL, 255);
+  }
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+//----------------- Wheel speed PI -> feed-forward from the calibration table + PI on the measured encoder speed --------------------------------------
+
+void speedStart(int channelR, int channelL, float desiredSpeedR, float desiredSpeedL) {
+
+  speedControlActive = false;   // Control tick leaves the wheels alone while they are re-armed
+  rampStopping       = false;
+  rampStopDone       = false;
+
+  wheelStart(speedCtrlR, channelR, desiredSpeedR);
+  wheelStart(speedCtrlL, channelL, desiredSpeedL);
+
+  speedControlActive = true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+//----------------- New speed while already driving that way -> the profiles ramp from the current speed at PROFILE_ACCEL_MAX ------------------------
+
+bool speedRetarget(uint8_t direction, float desiredSpeedR, float desiredSpeedL) {
+
+  bool drivingForward = (speedCtrlR.channel == PWM_CHANNEL_H2_Q3);
+  if (!moving || isRotating || rampStopping || rampStopDone || !speedControlActive ||
+      (direction == 0b00) != drivingForward) {
+    return false;
+  }
+
+  speedCtrlR.target          = desiredSpeedR;
+  speedCtrlL.target          = desiredSpeedL;
+  speedCtrlR.profile.vTarget = desiredSpeedR;
+  speedCtrlL.profile.vTarget = desiredSpeedL;
+  return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void wheelStart(WheelController& wheel, int channel, float target) {
+
+  wheel.channel  = channel;
+  wheel.target   = target;
+  wheel.measured = 0;
+  wheel.integral = 0;
+
+  // Start from rest -> the profile ramps the command up to the target instead of stepping the duty
+  wheel.profile.v       = 0;
+  wheel.profile.a       = 0;
+  wheel.profile.vTarget = target;
+  ledcWrite(channel, 255);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void wheelTick(WheelController& wheel, float measured, float trim, float* const table[]) {
+
+  wheel.measured = measured;
+
+  // Feed-forward and PI follow the profiled speed (plus any rotation balance trim), not the step target
+  profileTick(wheel.profile);
+  float command = wheel.profile.v + trim;
+  if (command < 0) {
+    command = 0;
+  }
+
+  float error = command - wheel.measured;
+  float ff    = feedForwardDrive(table, command);
+  float drive = ff + SPEED_KP * error + wheel.integral;
+
+  // Anti-windup: stop integrating while the output is pinned in the direction of the error
+  bool pinnedHigh = (drive >= 255) && (error > 0);
+  bool pinnedLow  = (drive <= 0)   && (error < 0);
+  if (!pinnedHigh && !pinnedLow) {
+    wheel.integral += SPEED_KI * error * (CONTROL_PERIOD_US / 1000000.0);
+    wheel.integral  = constrain(wheel.integral, -SPEED_I_LIMIT, SPEED_I_LIMIT);
+  }
+
+  drive = constrain(ff + SPEED_KP * error + wheel.integral, 0, 255);
+  ledcWrite(wheel.channel, 255 - (uint8_t)drive);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+//----------------- Motion profile -> jerk-limited trapezoid: acceleration ramps at PROFILE_JERK_MAX up to PROFILE_ACCEL_MAX and back to 0 at vTarget -
+
+void profileTick(MotionProfile& profile) {
+
+  const float dt   = CONTROL_PERIOD_US / 1000000.0;
+  const float jerk = PROFILE_JERK_MAX * dt;          // Largest change in acceleration per tick
+
+  float dv = profile.vTarget - profile.v;
+
+  // Close enough -> hold the target
+  if (fabs(dv) <= jerk * dt && fabs(profile.a) <= jerk) {
+    profile.v = profile.vTarget;
+    profile.a = 0;
+    return;
+  }
+
+  // Ease the acceleration off once the speed still to gain equals what ramping it to 0 will add (a^2 / 2j)
+  float direction = (dv > 0) ? 1.0 : -1.0;
+  float aDesired  = direction * PROFILE_ACCEL_MAX;
+  if ((profile.a * direction > 0) && (fabs(dv) <= profile.a * profile.a / (2 * PROFILE_JERK_MAX))) {
+    aDesired = 0;
+  }
+
+  profile.a = constrain(aDesired, profile.a - jerk, profile.a + jerk);
+  profile.v += profile.a * dt;
+
+  // Never overshoot the target (the ramp-off is only exact to one tick)
+  if ((direction > 0 && profile.v >= profile.vTarget) || (direction < 0 && profile.v <= profile.vTarget)) {
+    profile.v = profile.vTarget;
+    profile.a = 0;
+  }
+  if (profile.v < 0) {
+    profile.v = 0;
+  }
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+
+float feedForwardDrive(float* const table[], float speed) {
+
+  // table[i] is the speed measured at pwmLevels[i] % (descending) -> interpolate the PWM % for this speed
+  if (speed <= 0) {
+    return 0;
+  }
+  if (speed >= *table[0]) {
+    return pwmLevels[0] * 255.0 / 100.0;
+  }
+
+  for (int i = 0; i < NUM_CAL_POINTS - 1; i++) {
+    float hi = *table[i];
+    float lo = *table[i + 1];
+    if (speed <= hi && speed >= lo) {
+      float frac    = (hi > lo) ? (speed - lo) / (hi - lo) : 0;
+      float percent = pwmLevels[i + 1] + frac * (pwmLevels[i] - pwmLevels[i + 1]);
+      return percent * 255.0 / 100.0;
+    }
+  }
+
+  // Slower than the lowest calibrated point -> lowest PWM that still turns the wheels
+  return pwmLevels[NUM_CAL_POINTS - 1] * 255.0 / 100.0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void finishRotation() {
+
+  // Calculate actual angle rotated (includes whatever coasting happened before the brake)
+  int16_t countR = 0;
+  int16_t countL = 0;
+  pcnt_get_counter_value(ENCODER_R_UNIT, &countR);
+  pcnt_get_counter_value(ENCODER_L_UNIT, &countL);
+  int32_t rotated = (countR - rotationStartCount_R) + (countL - rotationStartCount_L);
+  RotationAngle = (uint16_t)countsToUnits(rotated, DEG_PER_COUNT_Q16 / 2);  // Mean of both wheels, nearest degree
+
+  isRotating   = false;  // Resets rotating flag (before Stop() so it is not treated as an abort)
+  rotationDone = false;
+
+  Stop();
+
+  clearPCNT();
+}
+
 //-------------------------------------------------------------------------------------------------------------------------------------------------------
 
 void distance() {
@@ -682,13 +1303,9 @@ void distance() {
   //  Control Action              : DATA = <DAT1:DAT0> contains measured distance in mm.
   //  Additional Notes            : It is the distance the MARV travelled in a straight line to the nearest mm.
 
-  pcnt_get_counter_value(ENCODER_R_UNIT, &counter_1);  // Right 
-  pcnt_get_counter_value(ENCODER_L_UNIT, &counter_0);  // Left
-  distanceTravelled_1 = distancePerSlot * counter_1; 
-  distanceTravelled_0 = distancePerSlot * counter_0;   
-
-  // Round and convert to 16-bit integer
-  CurrentDistance = (uint16_t)(((distanceTravelled_1 + distanceTravelled_0)/2)  + 0.5); // rounds to nearest integer
+  // Delta of the extended counts since this move started, mean of both wheels, rounded to the nearest mm
+  int32_t moved = (encoderCount(ENCODER_R_UNIT) - moveStartR) + (encoderCount(ENCODER_L_UNIT) - moveStartL);
+  CurrentDistance = (uint16_t)countsToUnits(moved, MM_PER_COUNT_Q16 / 2);
 
   // Split value into MSB and LSB
   data6 = (CurrentDistance >> 8) & 0xFF;   // Upper 8 bits -> DAT1
@@ -704,29 +1321,71 @@ void tangentialSpeed() {
   //  Control Action              : DATA bytes contain measured tangential speeds of the wheels.
   //  Additional Notes            : DAT1 = right wheel speed in mm/s, DAT0 = left wheel speed in mm/s. SNC displays the speeds on indicators.
 
-  stopTime = millis(); // startTime set in movement operations
-  elapsed = stopTime - startTime; // ms
-
-  // Check if we're being commanded to stop (dat0 = 0 and dat1 = 0)
-  if ((dat0 == 0) && (dat1 == 0)) {
-    // Stop command received - report zero speed
-    data4 = 0;
-    data3 = 0;
-  }
-
-  else {
-    // Normal movement - calculate actual speeds
-    speedRight = (elapsed > 0) ? (distanceTravelled_1 / (elapsed / 1000.0)) : 0; // mm/s
-    speedLeft = (elapsed > 0) ? (distanceTravelled_0 / (elapsed / 1000.0)) : 0; // mm/s
+  // Instantaneous wheel speeds from the encoder estimator (not the average since startTime), so a
+  // stop reads 0 as soon as the edges stop - including after a stop command (targets in speedCtrlR/L.target)
+  speedRight = speedEstR.speed;
+  speedLeft  = speedEstL.speed;
 
-    data4 = (uint8_t)(speedRight + 0.5); // rounds to nearest integer
-    data3 = (uint8_t)(speedLeft + 0.5);  // rounds to nearest integer
+  data4 = (uint8_t)constrain(speedRight + 0.5, 0, 255); // rounds to nearest integer
+  data3 = (uint8_t)constrain(speedLeft + 0.5, 0, 255);  // rounds to nearest integer
 
-    //data4 = (uint8_t)(startTime + 0.5); // rounds to nearest integer
-    //data3 = (uint8_t)(stopTime + 0.5);  // rounds to nearest integer
+}
 
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+//----------------- NAVCON report -> Odometry, Battery, Rotation, Speed, Distance (sent straight away, or once a rotation completes) ------------------
+
+void navconReport() {
+
+  angularRotation();
+
+  distance();
+
+  tangentialSpeed();
+
+#if ODOMETRY_FRAMES
+  // Odometry record ahead of IST1 -> low 16 bits of the extended counts and when they were read; never reset by a stop,
+  // so the SNC integrates deltas instead of per-move distances
+  int32_t odoR  = encoderCount(ENCODER_R_UNIT);
+  int32_t odoL  = encoderCount(ENCODER_L_UNIT);
+  uint8_t stamp = (uint8_t)(millis() / ODOMETRY_TICK_MS);
+
+  TX_Ready(); 
+  Transmit(0b10, 0b10, 0b0101, (odoR >> 8) & 0xFF, odoR & 0xFF, stamp);  // Right wheel
+
+  TX_Ready(); 
+  Transmit(0b10, 0b10, 0b0110, (odoL >> 8) & 0xFF, odoL & 0xFF, stamp);  // Left wheel
+#endif
+
+  TX_Ready(); 
+  // Transmit Data
+  // USB_PORT.println("Transmitting Battery Level Data"); 
+  Transmit(0b10, 0b10, 0b0001, 0x00, 0x00, 0x00);                        // Specific to next task/state
+
+  TX_Ready(); 
+  // Transmit Data
+  // USB_PORT.println("Transmitting Last Known Angular Rotation Data"); 
+  Transmit(0b10, 0b10, 0b0010, data1, data0, data2);                      // Specific to next task/state
+
+  TX_Ready(); 
+  // Transmit Data
+  // USB_PORT.println("Transmitting Tangential Speed Data"); 
+  Transmit(0b10, 0b10, 0b0011, data4, data3, 0x00);                      // Specific to next task/state
+
+  TX_Ready(); 
+  // Transmit Data
+  // USB_PORT.println("Transmitting MARV Travel Distance Data"); 
+  // First report after Stop() -> wheels braked, distance final: flag motion complete so NAVCON need not wait for IST3 to read 0
+  Transmit(0b10, 0b10, 0b0100, data6, data5, ResetFlag ? MOTION_COMPLETE_FLAG : 0x00);
+
+  if (ResetFlag) {
+    // Reset distances & counters
+    clearPCNT();             // Resets distance counter
+    data6 = 0;               // Resets Distance MSB
+    data5 = 0;               // Resets Distance MSB
+    ResetFlag = false;       // Resets Reset Flag
+    moving = false;          // Resets moving flag
+    isRotating = false;      // Resets rotating flab
   }
-  
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -747,9 +1406,35 @@ void Transmit(uint8_t sys, uint8_t sub, uint8_t ist, uint8_t dat1, uint8_t dat0,
   packet[2] = dat0;
   packet[3] = dec;
 
-  // Transmit the packet
+  // Queue the packet -> the UART driver's TX ring drains it from the TX-empty interrupt
+  // A full queue means the SNC stopped reading; wait rather than drop (a lost frame desyncs the round-robin)
+  if (USB_PORT.availableForWrite() < PACKET_SIZE) {
+    scsStats.txStalls++;
+  }
+
   //SCS_PORT.write(packet, PACKET_SIZE);
   USB_PORT.write(packet, PACKET_SIZE);
+  scsStats.txFrames++;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void linkReply(uint8_t op, uint8_t dat0, uint8_t dec) {
+
+  // IDLE:MDPS:IST15 -> bypasses Transmit()'s IDLE guard, link frames never reach the state machine
+  uint8_t packet[PACKET_SIZE] = { controlByteOf(0b00, SUBSYSTEM_MDPS, SCS_LINK_IST), op, dat0, dec };
+  USB_PORT.write(packet, PACKET_SIZE);
+  scsStats.txFrames++;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void linkSetRate(uint8_t index) {
+
+  // Let the reply drain at the old rate, then drop whatever half frame was assembled at it
+  USB_PORT.flush();
+  USB_PORT.updateBaudRate(SCS_LINK_RATES[index]);
+  scsPartialCount = 0;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -770,39 +1455,91 @@ void TX_Ready() {
 
 void Receive_and_Sort() {
 
-//if (SCS_PORT.available() >= PACKET_SIZE) {
-  if (USB_PORT.available() >= PACKET_SIZE) {
-    
-
-    // Receive Data
-    uint8_t packet[PACKET_SIZE];
-  //SCS_PORT.readBytes(packet, PACKET_SIZE);
-    USB_PORT.readBytes(packet, PACKET_SIZE);
-
-    // Assign each BYTE from the PACKET to a variable/register (8-bits)
-    controlByte = packet[0];
-    dat1        = packet[1];
-    dat0        = packet[2];
-    dec         = packet[3];
-
-    // Section Control Byte
-    sys = (controlByte >> 6) & 0b11;       // nnnn nnxx-- ----           ->  x  =  keep -> & 0bxxxxx
-    sub = (controlByte >> 4) & 0b11;       // nnnn ccxx ----             ->  -  =  shifted out of "register"
-    ist = controlByte        & 0b1111;     // cccc xxxx                  ->  c  =  cleared -> 0
-    //                                                                   ->  n  =  "new bit" from shift -> 0 
-
-    received = true;
-
-    // // Display Received/Sorted Data
-    // currentIST = ist;
-    //  USB_PORT.print("Packet Received -> ");
-    //  USB_PORT.print("SYS: ");                USB_PORT.print(sys);
-    //  USB_PORT.print(" | SUB: ");             USB_PORT.print(sub);
-    //  USB_PORT.print(" | IST: ");             USB_PORT.print(ist);
-    //  USB_PORT.print(" | DAT1: ");            USB_PORT.print(dat1);
-    //  USB_PORT.print(" | DAT0: ");            USB_PORT.print(dat0);
-    //  USB_PORT.print(" | DEC: ");             USB_PORT.println(dec);
+  // Whole frames only -> onScsReceive() has already framed (and resynced) the byte stream
+  uint8_t tail = scsRingTail.load(std::memory_order_relaxed);
+  if (tail == scsRingHead.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  // Assign each BYTE from the PACKET to a variable/register (8-bits)
+  const uint8_t* packet = scsRing[tail];
+  controlByte = packet[0];
+  dat1        = packet[1];
+  dat0        = packet[2];
+  dec         = packet[3];
+
+  scsRingTail.store((tail + 1) & (SCS_RX_RING_FRAMES - 1), std::memory_order_release);
+
+  // Section Control Byte
+  sys = (controlByte >> 6) & 0b11;       // nnnn nnxx-- ----           ->  x  =  keep -> & 0bxxxxx
+  sub = (controlByte >> 4) & 0b11;       // nnnn ccxx ----             ->  -  =  shifted out of "register"
+  ist = controlByte        & 0b1111;     // cccc xxxx                  ->  c  =  cleared -> 0
+  //                                                                   ->  n  =  "new bit" from shift -> 0 
+
+  received = true;
+
+  // // Display Received/Sorted Data
+  // currentIST = ist;
+  //  USB_PORT.print("Packet Received -> ");
+  //  USB_PORT.print("SYS: ");                USB_PORT.print(sys);
+  //  USB_PORT.print(" | SUB: ");             USB_PORT.print(sub);
+  //  USB_PORT.print(" | IST: ");             USB_PORT.print(ist);
+  //  USB_PORT.print(" | DAT1: ");            USB_PORT.print(dat1);
+  //  USB_PORT.print(" | DAT0: ");            USB_PORT.print(dat0);
+  //  USB_PORT.print(" | DEC: ");             USB_PORT.println(dec);
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+//----------------- SCS receive (UART event task) -> frames the byte stream, a half frame followed by a gap is dropped so one lost byte cannot misalign the rest
+
+void onScsReceive() {
+
+  unsigned long now = micros();
+
+  // A half frame followed by a gap means a byte was lost -> drop it and realign on the next frame
+  if (scsPartialCount > 0 && now - scsLastByteTime > SCS_FRAME_GAP_US) {
+    scsPartialCount = 0;
+    scsStats.resyncs++;
+  }
+
+  uint8_t chunk[32];
+  size_t n;
+  while ((n = USB_PORT.read(chunk, sizeof(chunk))) > 0) {
+    scsStats.bytes += n;
+    for (size_t i = 0; i < n; i++) {
+      scsPartial[scsPartialCount++] = chunk[i];
+      if (scsPartialCount == PACKET_SIZE) {
+        scsPushFrame(scsPartial);
+        scsPartialCount = 0;
+      }
     }
+  }
+
+  scsLastByteTime = now;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void scsPushFrame(const uint8_t* bytes) {
+
+  // MAZE / SNC / IST1 with the tone flag -> loop() stops ahead of the frames queued before it
+  // (checked before the full test, so the stop survives even if the ring drops the frame)
+  if (bytes[0] == controlByteOf(0b10, 0b01, 0b0001) && bytes[1] == 0x01) {
+    sosStopRequested = true;
+  }
+
+  uint8_t head = scsRingHead.load(std::memory_order_relaxed);
+  uint8_t next = (head + 1) & (SCS_RX_RING_FRAMES - 1);
+
+  if (next == scsRingTail.load(std::memory_order_acquire)) {
+    scsStats.drops++;                    // loop() fell behind -> keep the older frames
+    return;
+  }
+
+  memcpy(scsRing[head], bytes, PACKET_SIZE);
+
+  scsRingHead.store(next, std::memory_order_release);
+  scsStats.frames++;
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -847,168 +1584,224 @@ void System_State() {
 //-------------------------------------------------------------------------------------------------------------------------------------------------------
 
 void Process() {     
- 
-      // Guard: Do nothing if in IDLE state
-      if (sys == 0b00) {
-        return;  // Exit immediately - no transmissions in IDLE
-      }
 
+  // IDLE and unrecognised control bytes map to handleIgnored() -> no transmissions
+  packetHandlers[controlByte]();
+}
 
-      //ID -> Calibration
-      if (sys == 0b01 && sub == 0b11 && ist == 0b00) {
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
 
-        // USB_PORT.println("ID Match -> Calibration Start");
+void handleIgnored() {
+  // USB_PORT.print("Received Data Ignored");
+}
 
-        Calibrate();    
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
 
-        clearPCNT();
+void handleLinkTraining() {
 
-        TX_Ready();
-        // Transmit Data
-        // USB_PORT.println("Transmitting Tangential Speed Data"); 
-        Transmit(0b01, 0b10, 0b0000, tanSpeedR, tanSpeedL, 0x00);             // Specific to next task/state
+  linkHeardMs = millis();
 
-        TX_Ready();
-        // Transmit Data
-        // USB_PORT.println("Transmitting Battery Level Data"); 
-        Transmit(0b01, 0b10, 0b0001, 0x00, 0x00, 0x00);                       // Specific to next task/state
+  // dat1 = op, dat0 = rate index (or test byte), dec = sequence
+  switch (dat1) {
+    case SCS_LINK_OP_PROPOSE:
+      if (dat0 >= SCS_LINK_RATE_COUNT) {
+        return;                          // Rate we do not have -> no ACK, the SNC stays where it is
       }
+      linkReply(SCS_LINK_OP_ACK, dat0, 0);
+      linkSetRate(dat0);
+      linkTrial       = dat0;
+      linkTrialActive = true;
+      linkTrialMs     = millis();
+      break;
+
+    case SCS_LINK_OP_PATTERN:
+      linkReply(SCS_LINK_OP_PATTERN, dat0, dec);
+      break;
+
+    case SCS_LINK_OP_COMMIT:
+      // Repeated COMMITs (a lost echo) are echoed again
+      if (linkTrialActive && dat0 == linkTrial) {
+        linkRate        = linkTrial;
+        linkTrialActive = false;
+      }
+      if (dat0 == linkRate) {
+        linkReply(SCS_LINK_OP_COMMIT, dat0, 0);
+      }
+      break;
+
+    case SCS_LINK_OP_FALLBACK:
+      // Sent three times -> only the first one switches
+      if (dat0 < linkRate) {
+        linkRate        = dat0;
+        linkTrialActive = false;
+        linkSetRate(linkRate);
+      }
+      break;
 
-      else if (sys == 0b01 && sub == 0b01 && ist == 0b00 && dat1 == 0x00) {
+    default:
+      break;
+  }
+}
 
-        // USB_PORT.println("ID Match -> Touch Not Sensed");
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
 
-        TX_Ready();
-        
-        // Transmit Data
-        // USB_PORT.println("Transmitting Battery Level Data"); 
-        Transmit(0b01, 0b10, 0b0001, 0x00, 0x00, 0x00);                       // Specific to next task/state
-      }
+void handleCalibrate() {
 
-      else if (sys == 0b10 && sub == 0b01 && ist == 0b01 && dat1 == 0x01) {
+  // USB_PORT.println("ID Match -> Calibration Start");
 
-        // USB_PORT.println("ID Match -> Pure Tone Sensed");
+  Calibrate();    
 
-        digitalWrite(bluePin  , LOW);
-        digitalWrite(greenPin , LOW);
-        digitalWrite(redPin   , HIGH);
+  clearPCNT();
 
-        Stop();                                                               
+  TX_Ready();
+  // Transmit Data
+  // USB_PORT.println("Transmitting Tangential Speed Data"); 
+  Transmit(0b01, 0b10, 0b0000, tanSpeedR, tanSpeedL, 0x00);             // Specific to next task/state
 
-        TX_Ready(); 
-        
-        // Transmit Data
-        // USB_PORT.println("Transmitting Motor Stopped"); 
-        Transmit(0b11, 0b10, 0b0100, 0x00, 0x00, 0x00);                       // Specific to next task/state
-      }
+  TX_Ready();
+  // Transmit Data
+  // USB_PORT.println("Transmitting Battery Level Data"); 
+  Transmit(0b01, 0b10, 0b0001, 0x00, 0x00, 0x00);                       // Specific to next task/state
+}
 
-      else if (sys == 0b10 && sub == 0b01 && ist == 0b11) {
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
 
-        // USB_PORT.println("ID Match -> NAVCON");
+void handleTouch() {
 
-        if ((dat1 == 0) && (dat0 == 0)) {
+  if (dat1 != 0x00) {
+    return;
+  }
 
-        Stop();
-        
-        }
+  // USB_PORT.println("ID Match -> Touch Not Sensed");
 
-        else {
+  TX_Ready();
+  
+  // Transmit Data
+  // USB_PORT.println("Transmitting Battery Level Data"); 
+  Transmit(0b01, 0b10, 0b0001, 0x00, 0x00, 0x00);                       // Specific to next task/state
+}
 
-          if (!moving) {
-            clearPCNT();  // Clear counters at start of new movement
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
 
-          switch (dec) {
-            case 0b00:
-              // USB_PORT.println("NAVCON -> FORWARD");
-              forward(tanSpeedR, tanSpeedL);                                                        
-              break;
+void handlePureTone() {
 
-            case 0b01:
-              // USB_PORT.println("NAVCON -> BACKWARD");
-              backward(tanSpeedR, tanSpeedL);                                                       
-              break;
+  if (dat1 != 0x01) {
+    return;
+  }
 
-            case 0b10:
-              // USB_PORT.println("NAVCON -> LEFT (CCW)");
-              left();                                                           
-              break;
+  // USB_PORT.println("ID Match -> Pure Tone Sensed");
 
-            case 0b11:
-              // USB_PORT.println("NAVCON -> RIGHT (CW)");
-              right();                                                          
-              break;
+  digitalWrite(bluePin  , LOW);
+  digitalWrite(greenPin , LOW);
+  digitalWrite(redPin   , HIGH);
 
-            default:
-              // USB_PORT.println("NAVCON -> UNKNOWN");
-              // Haha, Not cool gang!
-              delay(1);
-              break;
-          }  
+  // Normally loop() already stopped when the frame arrived -> every frame before it has now been processed
+  if (!sosStopLatched) {
+    sosStop();
+  }
+  sosStopLatched = false;
 
-          }
+  // Reply once the encoders read 0 -> the SNC times stop-to-halt from this frame
+  sosReplyPending = true;
+}
 
-        }
-        
-        angularRotation();
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+//----------------- SOS stop -> motors off now, the reply waits for the wheels to come to rest ---------------------------------------------------------
 
-        distance();
+void sosStop() {
 
-        tangentialSpeed();
+  Stop();
+  sosStopMs = millis();
+}
 
-        TX_Ready(); 
-        // Transmit Data
-        // USB_PORT.println("Transmitting Battery Level Data"); 
-        Transmit(0b10, 0b10, 0b0001, 0x00, 0x00, 0x00);                        // Specific to next task/state
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
 
-        TX_Ready(); 
-        // Transmit Data
-        // USB_PORT.println("Transmitting Last Known Angular Rotation Data"); 
-        Transmit(0b10, 0b10, 0b0010, data1, data0, data2);                      // Specific to next task/state
+void handleNavcon() {
 
-        TX_Ready(); 
-        // Transmit Data
-        // USB_PORT.println("Transmitting Tangential Speed Data"); 
-        Transmit(0b10, 0b10, 0b0011, data4, data3, 0x00);                      // Specific to next task/state
+  // USB_PORT.println("ID Match -> NAVCON");
 
-        TX_Ready(); 
-        // Transmit Data
-        // USB_PORT.println("Transmitting MARV Travel Distance Data"); 
-        Transmit(0b10, 0b10, 0b0100, data6, data5, 0x00);                      // Specific to next task/state
+  if ((dat1 == 0) && (dat0 == 0)) {
 
-        if (ResetFlag) {
-          // Reset distances & counters
-          distanceTravelled_1 = 0; // Extra Safe
-          distanceTravelled_0 = 0; // Extra Safe
-          clearPCNT();             // Resets distance counter
-          data6 = 0;               // Resets Distance MSB
-          data5 = 0;               // Resets Distance MSB
-          ResetFlag = false;       // Resets Reset Flag
-          moving = false;          // Resets moving flag
-          isRotating = false;      // Resets rotating flab
-        }
+    rampStop();
+  
+  }
 
-      }
-       
-      else if (sys == 0b10 && sub == 0b11 && ist == 0b11) {
-        // USB_PORT.println("ID Match -> End of Maize!");
+  else {
 
-        dat1 = 1;
-        dat0 = 104;
+    // SNC's speed schedule -> DAT1/DAT0 are the wheel speeds for forward/backward
+    float navconSpeedR = constrain((float)dat1, NAVCON_SPEED_MIN, NAVCON_SPEED_MAX);
+    float navconSpeedL = constrain((float)dat0, NAVCON_SPEED_MIN, NAVCON_SPEED_MAX);
 
-        // right();
+    if (moving && (dec == 0b00 || dec == 0b01)) {
+      speedRetarget(dec, navconSpeedR, navconSpeedL);   // No-op unless already driving this way
+    }
 
-        // angularRotation();
+    if (!moving) {
+      clearPCNT();  // Clear counters at start of new movement
+
+      switch (dec) {
+        case 0b00:
+          // USB_PORT.println("NAVCON -> FORWARD");
+          forward(navconSpeedR, navconSpeedL);                                                        
+          break;
+
+        case 0b01:
+          // USB_PORT.println("NAVCON -> BACKWARD");
+          backward(navconSpeedR, navconSpeedL);                                                       
+          break;
+
+        case 0b10:
+          // USB_PORT.println("NAVCON -> LEFT (CCW)");
+          left();                                                           
+          break;
+
+        case 0b11:
+          // USB_PORT.println("NAVCON -> RIGHT (CW)");
+          right();                                                          
+          break;
+
+        default:
+          // USB_PORT.println("NAVCON -> UNKNOWN");
+          // Haha, Not cool gang!
+          delay(1);
+          break;
+      }  
 
-        Stop();
-                                                                     
-        // USB_PORT.println("Motor Stopped -> End of Maize!"); 
+    }
 
-      }
-    
-      else {
-        // USB_PORT.print("Received Data Ignored");
-      }
+  }
+
+  // A pure tone frame is queued behind this one -> stay stopped, just report
+  if (sosStopLatched) {
+    navconReport();
+    return;
+  }
+
+  // A rotation just started (or is still running) or a stop is still ramping down -> reply once the control tick reports completion
+  if (isRotating || rampStopping || rampStopDone) {
+    navconReplyPending = true;
+    return;
+  }
+
+  navconReport();
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------------------------
+
+void handleEndOfMaze() {
+
+  // USB_PORT.println("ID Match -> End of Maize!");
+
+  dat1 = 1;
+  dat0 = 104;
+
+  // right();
 
+  // angularRotation();
+
+  Stop();
+                                                               
+  // USB_PORT.println("Motor Stopped -> End of Maize!"); 
 }
 
 //-------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -1017,14 +1810,65 @@ void Process() {
 
 void loop() {
 
+  // Pure tone frame waiting in the RX ring -> stop before working through the frames ahead of it
+  if (sosStopRequested) {
+    sosStopRequested = false;
+    sosStopLatched   = true;
+    sosStop();
+  }
+
+  // SOS reply once both wheels read 0 (or the encoders never settle)
+  if (sosReplyPending &&
+      ((speedEstR.speed == 0 && speedEstL.speed == 0) || millis() - sosStopMs > SOS_HALT_TIMEOUT_MS)) {
+    sosReplyPending = false;
+
+    TX_Ready();
+
+    // Transmit Data
+    // USB_PORT.println("Transmitting Motor Stopped");
+    Transmit(0b11, 0b10, 0b0100, 0x00, 0x00, 0x00);                     // Specific to next task/state
+  }
+
+  // Trial rate the SNC never committed (its echo test failed) -> back to the last good rate
+  if (linkTrialActive && millis() - linkTrialMs > SCS_LINK_TRIAL_MS) {
+    linkTrialActive = false;
+    linkSetRate(linkRate);
+  }
+
+  // Committed rate but the SNC's keepalive stopped (SNC reset, FALLBACK lost) -> base rate; the SNC retrains once it hears from us again while idle
+  if (linkRate != 0 && !linkTrialActive && millis() - linkHeardMs > SCS_LINK_SILENCE_MS) {
+    linkRate = 0;
+    linkSetRate(0);
+  }
+
   Receive_and_Sort();
 
+  // Rotation engine finished -> brake, then send the NAVCON reports held back in Process()
+  if (rotationDone) {
+    finishRotation();
+
+    if (navconReplyPending) {
+      navconReplyPending = false;
+      navconReport();
+    }
+  }
+
+  // NAVCON stop finished ramping down -> brake, then send the held back reports
+  if (rampStopDone) {
+    Stop();
+
+    if (navconReplyPending) {
+      navconReplyPending = false;
+      navconReport();
+    }
+  }
+
   if (received) {
 
     // System_State();
 
-    // Only process if NOT in IDLE state
-    if (sys != 0b00) {
+    // Only process if NOT in IDLE state (link training is the one IDLE frame with a handler)
+    if (sys != 0b00 || ist == SCS_LINK_IST) {
       Process();
     }
 
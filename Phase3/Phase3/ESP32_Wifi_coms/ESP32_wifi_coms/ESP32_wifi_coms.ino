@@ -11,10 +11,9 @@
  * - GPIO 5  (CS)   -> Main ESP32 GPIO 5 (CS)
  * - GND            -> Main ESP32 GND
  *
- * GPIO Commands to Main ESP32:
- * - GPIO 4  -> Main ESP32 GPIO 4  (Touch Command)
- * - GPIO 2  -> Main ESP32 GPIO 2  (Pure Tone Command)
- * - GPIO 15 -> Main ESP32 GPIO 15 (Send Packet Command)
+ * Dashboard commands (touch, pure tone, send, reset) go to the Main ESP32
+ * as PKT_COMMAND replies on MISO and are acknowledged in its next frame,
+ * so no command GPIOs are wired.
  *
  * Configure WiFi credentials below before upload
  */
@@ -23,11 +22,17 @@
 #include <WebServer.h>
 #include <ArduinoJson.h>
 #include <driver/spi_slave.h>
+#include <LittleFS.h>
+#include <stdarg.h>
 #include "spi_protocol.h"
+#include "dashboard_html.h"
 
 // ==================== FUNCTION DECLARATIONS ====================
-String getTimeString();
+void formatUptime(char* out, size_t size, unsigned long ms);
 bool connectToWiFi();
+void markStatusDirty(uint32_t fields);
+void spiPostTransCallback(spi_slave_transaction_t* trans);
+void storeFlightLogChunk(const FlightLogChunkPayload* chunk, size_t bytes);
 
 // ==================== WIFI CONFIGURATION ====================
 // ESP32 creates its own WiFi hotspot - no existing network needed!
@@ -37,40 +42,63 @@ const char* ap_password = "NoEkweetnie";        // Password to connect to hotspo
 // ==================== PIN DEFINITIONS ====================
 // SPI Pins (Hardware SPI - WiFi ESP32 as Slave)
 #define SPI_SCK   18  // Clock from Main ESP32
-#define SPI_MISO  19  // Data TO Main ESP32 (not used currently)
+#define SPI_MISO  19  // Data TO Main ESP32 (dashboard commands)
 #define SPI_MOSI  23  // Data FROM Main ESP32
 #define SPI_CS    5   // Chip Select from Main ESP32
 
-// GPIO Command Pins (outputs to main ESP32)
-#define CMD_TOUCH_OUT  4
-#define CMD_TONE_OUT   2
-#define CMD_SEND_OUT   15
-
 // Status LED (optional) - using built-in LED
-#define STATUS_LED 2  // Built-in LED, but conflicts with CMD_TONE_OUT - DISABLED
+#define STATUS_LED 2  // Built-in LED - DISABLED
 
 // ==================== GLOBAL VARIABLES ====================
 WebServer server(80);
 
-// SPI Slave buffers (must be DMA-capable memory)
-DMA_ATTR uint8_t spi_slave_tx_buf[sizeof(SPIPacket)];
-DMA_ATTR uint8_t spi_slave_rx_buf[sizeof(SPIPacket)];
+// SPI receive ring - SPI_RX_SLOTS transactions stay queued with the slave
+// driver so a frame never arrives while the only buffer is being parsed
+#define SPI_RX_SLOTS       4
+#define SPI_RX_BUF_SIZE    ((sizeof(SPIPacket) + 3) & ~3)  // DMA lengths are word multiples
+#define SPI_TASK_STACK     4096
+#define SPI_TASK_PRIORITY  2       // Above loop() (1) on the same core
+
+// Per-packet Serial traces in the SPI drain path (build with -DSPI_RX_DEBUG=1)
+#ifndef SPI_RX_DEBUG
+#define SPI_RX_DEBUG 0
+#endif
+
+// Dashboard commands waiting for the SNC's ack; the oldest is on MISO
+#define SPI_COMMAND_FIFO        8
+#define COMMAND_ACK_TIMEOUT_MS  250     // /api/command waits this long for the ack
+
+// SPI Slave buffers (must be DMA-capable memory). The MISO reply (capability
+// header, plus the oldest unacknowledged command) is shared by all slots.
+DMA_ATTR uint8_t spi_slave_tx_buf[SPI_RX_BUF_SIZE];
+DMA_ATTR uint8_t spi_slave_rx_buf[SPI_RX_SLOTS][SPI_RX_BUF_SIZE];
 
 // System Status Structure with "sticky" display (holds values for visibility)
+// Plain PODs only - protocol codes are kept as received and turned into text
+// at the output edge (JSON writer, serial report), so a long run never
+// touches the heap from the SPI path.
+#define DEBUG_MESSAGE_LEN sizeof(DebugMessagePayload::message)
+
 struct {
-    String systemState = "IDLE";
-    String navconState = "UNKNOWN";
-    String lastUpdate = "Never";
+    uint8_t systemStateCode = 0;         // 0=IDLE 1=CAL 2=MAZE 3=SOS
+    uint8_t navconStateCode = 0xFF;      // NavconStatePayload::new_state, 0xFF = UNKNOWN
     uint32_t packetsReceived = 0;
     uint32_t packetsCorrupted = 0;
+    uint32_t packetsDropped = 0;         // Gaps in header.sequence (frames the SNC sent that never arrived)
+    uint32_t spiOverruns = 0;            // Completions that left no transaction queued with the driver
+
+    // Dashboard commands (PKT_COMMAND on MISO -> PKT_COMMAND_ACK)
+    uint32_t commandsQueued = 0;
+    uint32_t commandsAcked = 0;
+    uint32_t commandsRejected = 0;       // FIFO full
+    uint32_t commandAckMs = 0;           // Queued -> ack, last command
+    uint32_t commandAckMaxMs = 0;
     bool connectionStatus = false;
     bool endOfMazeDetected = false;
     unsigned long endOfMazeTime = 0;
 
     // Sensor Data (holds for visual clarity)
-    String sensor1Color = "UNKNOWN";
-    String sensor2Color = "UNKNOWN";
-    String sensor3Color = "UNKNOWN";
+    uint8_t sensorColorCode[3] = {0xFF, 0xFF, 0xFF};  // 0xFF = UNKNOWN
     unsigned long lastSensorUpdate = 0;
     bool sensorDataHeld = false;
 
@@ -83,30 +111,398 @@ struct {
     bool movementDataHeld = false;
 
     // Navigation Data
-    String lineColor = "NONE";
-    float lineAngle = 0.0;
-    String lineType = "NONE";
+    uint8_t lineColorCode = 0xFF;        // 0xFF = NONE
+    uint8_t lineTypeCode = 0xFF;         // 0 = NAVIGABLE, 1 = WALL, 0xFF = NONE
+    uint16_t lineAngleX10 = 0;
     uint16_t incidenceAngle = 0;
     unsigned long lastIncidenceUpdate = 0;
     bool incidenceDataHeld = false;
     uint16_t rotationAngle = 0;
-    String rotationDirection = "NONE";
+    uint8_t rotationDirectionCode = 0;   // 2 = LEFT, 3 = RIGHT, 0 = NONE
     unsigned long lastRotationUpdate = 0;
     bool rotationDataHeld = false;
 
     // Debug Messages
-    String lastDebugMessage = "None";
-    String lastDebugSeverity = "INFO";
+    char lastDebugMessage[DEBUG_MESSAGE_LEN] = "None";
+    uint8_t debugSeverityCode = 0;       // 0=INFO 1=WARN 2=ERROR
 
     // Performance
     unsigned long lastPacketTime = 0;
-    float packetsPerSecond = 0.0;
+    float packetsPerSecond = 0.0;        // Valid frames over the last second (loop())
+
+    // SNC flight recorder upload (PKT_FLIGHT_LOG), kept in LittleFS
+    uint32_t flightLogRunId = 0;
+    uint32_t flightLogBytes = 0;         // Stored so far, contiguous from offset 0
+    uint32_t flightLogTotal = 0;         // 0 = no upload seen
+    bool flightLogComplete = false;
+    bool flightLogIncomplete = false;    // A chunk went missing - re-upload from the SNC
+
+    // SNC turn latency (PKT_LATENCY_STATS, UART frame -> NAVCON reply)
+    uint32_t turnCount = 0;
+    float turnMeanUs = 0.0;
+    float turnP99Us = 0.0;
+    float turnMaxUs = 0.0;
+
+    // SNC dead-reckoned pose (PKT_POSE), frame of the MAZE entry
+    bool poseValid = false;
+    int16_t poseX_mm = 0;
+    int16_t poseY_mm = 0;
+    int16_t poseHeadingX10 = 0;
+    uint32_t poseTravelled_mm = 0;
+    uint16_t poseLines = 0;
+    uint16_t poseWalls = 0;
+    uint16_t poseRotations = 0;
+
+    // Map encounters (PKT_MAP_LINE), records kept in mapLines[]
+    uint16_t mapLineCount = 0;
+    uint16_t mapNextSequence = 0;
+    uint32_t mapLinesMissed = 0;         // Gaps in the encounter sequence
 } systemData;
 
+// Line/wall encounters of the current run, in arrival order (/api/map)
+#define MAP_LINES_KEPT 128
+MapLinePayload mapLines[MAP_LINES_KEPT];
+
+// ==================== STATUS NAMES ====================
+// Output edge only - string literals, nothing allocated
+const char* systemStateName(uint8_t state) {
+    switch(state) {
+        case 0: return "IDLE";
+        case 1: return "CALIBRATION";
+        case 2: return "MAZE";
+        case 3: return "SOS";
+        default: return "UNKNOWN";
+    }
+}
+
+const char* colorName(uint8_t color) {
+    switch(color) {
+        case 0: return "WHITE";
+        case 1: return "RED";
+        case 2: return "GREEN";
+        case 3: return "BLUE";
+        case 4: return "BLACK";
+        default: return "UNKNOWN";
+    }
+}
+
+const char* lineColorName(uint8_t color) {
+    return (color == 0xFF) ? "NONE" : colorName(color);
+}
+
+const char* lineTypeName(uint8_t type) {
+    return (type == 0xFF) ? "NONE" : (type == 0) ? "NAVIGABLE" : "WALL";
+}
+
+const char* navconStateName(uint8_t state) {
+    switch(state) {
+        case 0: return "FORWARD_SCAN";
+        case 1: return "STOP";
+        case 2: return "REVERSE";
+        case 3: return "STOP_BEFORE_ROTATE";
+        case 4: return "ROTATE";
+        case 5: return "EVALUATE_CORRECTION";
+        case 6: return "CROSSING_LINE";
+        default: return "UNKNOWN";
+    }
+}
+
+const char* rotationDirectionName(uint8_t direction) {
+    return (direction == 2) ? "LEFT" : (direction == 3) ? "RIGHT" : (direction == 0) ? "NONE" : "UNKNOWN";
+}
+
+const char* severityName(uint8_t severity) {
+    switch(severity) {
+        case 0: return "INFO";
+        case 1: return "WARN";
+        case 2: return "ERROR";
+        default: return "UNKNOWN";
+    }
+}
+
+// ==================== DASHBOARD PUSH (SSE) ====================
+// Viewers hold an EventSource on /api/events. SPI handlers mark which groups
+// of systemData changed; loop() pushes only those groups, at most once per
+// SSE_MIN_PUSH_MS, so a burst of SPI frames costs one event per viewer.
+#define SSE_MAX_CLIENTS     4       // Simultaneous dashboard viewers
+#define SSE_MIN_PUSH_MS     50      // Coalesce changes into at most 20 events/s
+#define SSE_KEEPALIVE_MS    15000   // Comment line so idle proxies/phones keep the stream open
+#define STATUS_JSON_SIZE    3072    // Largest event (full snapshot with every packet type seen)
+
+enum StatusField : uint32_t {
+    STATUS_LINK      = 1 << 0,   // connectionStatus, lastUpdate, packet counters, packets/s
+    STATUS_STATE     = 1 << 1,   // systemState, navconState
+    STATUS_EOM       = 1 << 2,   // endOfMazeDetected
+    STATUS_SENSORS   = 1 << 3,   // sensor1-3Color, sensorDataHeld
+    STATUS_LINE      = 1 << 4,   // lineColor, lineAngle, lineType
+    STATUS_INCIDENCE = 1 << 5,   // incidenceAngle, incidenceDataHeld
+    STATUS_ROTATION  = 1 << 6,   // rotationAngle, rotationDirection, rotationDataHeld
+    STATUS_MOVEMENT  = 1 << 7,   // wheel speeds, setpoint, distance, movementDataHeld
+    STATUS_DEBUG     = 1 << 8,   // lastDebugMessage, lastDebugSeverity
+    STATUS_LATENCY   = 1 << 9,   // SNC turn latency
+    STATUS_FLIGHT_LOG = 1 << 10, // flightLog* upload progress
+    STATUS_POSE      = 1 << 11,  // SNC pose and map encounter counts
+    STATUS_LINK_METRICS = 1 << 12, // SPI loss/reorder/duplicates and per-type rate/latency (each window)
+    STATUS_ALL       = (1 << 13) - 1,
+    STATUS_JSON_ONLY = STATUS_DEBUG | STATUS_FLIGHT_LOG | STATUS_POSE | STATUS_LINK_METRICS  // Not in the binary frame
+};
+
+uint32_t statusDirty = 0;            // Groups changed since the last push (statusMux)
+portMUX_TYPE statusMux = portMUX_INITIALIZER_UNLOCKED;
+WiFiClient sseClients[SSE_MAX_CLIENTS];
+bool sseBinary[SSE_MAX_CLIENTS];     // Viewer asked for /api/events?format=bin
+unsigned long lastSsePush = 0;
+unsigned long lastSseKeepalive = 0;
+char statusJson[STATUS_JSON_SIZE];   // Shared by /api/status and SSE events
+
+// ==================== BINARY STATUS FRAME ====================
+// Packed little-endian snapshot of systemData for /api/status.bin and
+// /api/events?format=bin (base64 in the SSE data line). Enums travel as their
+// protocol codes (0xFF = none/unknown); the page decodes it with DataView.
+// Bump DASHBOARD_FRAME_VERSION (and STATUS_FRAME_VERSION in the page JS)
+// whenever the layout changes.
+#define DASHBOARD_FRAME_VERSION 1
+
+#define FRAME_FLAG_CONNECTED      0x01
+#define FRAME_FLAG_END_OF_MAZE    0x02
+#define FRAME_FLAG_SENSOR_HELD    0x04
+#define FRAME_FLAG_MOVEMENT_HELD  0x08
+#define FRAME_FLAG_ROTATION_HELD  0x10
+#define FRAME_FLAG_INCIDENCE_HELD 0x20
+
+struct __attribute__((packed)) DashboardStatusFrame {
+    uint8_t  version;               //  0: DASHBOARD_FRAME_VERSION
+    uint8_t  flags;                 //  1: FRAME_FLAG_*
+    uint16_t sequence;              //  2: Increments per frame built
+    uint32_t last_packet_s;         //  4: Uptime (s) at the last valid SPI packet
+    uint32_t packets_received;      //  8
+    uint32_t packets_corrupted;     // 12
+    uint16_t packets_per_second;    // 16
+    uint8_t  system_state;          // 18: 0=IDLE 1=CAL 2=MAZE 3=SOS
+    uint8_t  navcon_state;          // 19: NavconStatePayload::new_state
+    uint8_t  sensor_colors[3];      // 20: 0=WHITE 1=RED 2=GREEN 3=BLUE 4=BLACK
+    uint8_t  line_color;            // 23
+    uint8_t  line_type;             // 24
+    uint8_t  rotation_direction;    // 25
+    uint16_t line_angle_x10;        // 26: Degrees x10
+    uint16_t incidence_angle;       // 28
+    uint16_t rotation_angle;        // 30
+    uint16_t distance_mm;           // 32
+    uint8_t  wheel_speed_r;         // 34
+    uint8_t  wheel_speed_l;         // 35
+    uint8_t  wheel_setpoint;        // 36
+    uint8_t  debug_severity;        // 37: 0=INFO 1=WARN 2=ERROR (text goes as a JSON "debug" event)
+    uint32_t turn_count;            // 38
+    float    turn_mean_us;          // 42
+    float    turn_p99_us;           // 46
+    float    turn_max_us;           // 50
+};
+
+static_assert(sizeof(DashboardStatusFrame) == 54, "DashboardStatusFrame layout changed - update the page decoder");
+
+uint16_t statusFrameSequence = 0;
+
+// Called from the SPI task and loop(); everything else in systemData is
+// read without locking - a torn read only skews one push
+void markStatusDirty(uint32_t fields) {
+    portENTER_CRITICAL(&statusMux);
+    statusDirty |= fields;
+    portEXIT_CRITICAL(&statusMux);
+}
+
+uint32_t takeStatusDirty() {
+    portENTER_CRITICAL(&statusMux);
+    uint32_t fields = statusDirty;
+    statusDirty = 0;
+    portEXIT_CRITICAL(&statusMux);
+    return fields;
+}
+
+// ==================== SPI LINK METRICS ====================
+// header.sequence numbers every frame the SNC sends. The last LINK_SEQ_WINDOW
+// sequences are kept as a bitmap, so a frame behind the newest one is either
+// late (reordered - it was counted as dropped when the gap opened, and is
+// taken back off) or a repeat (duplicate).
+//
+// One-way latency is the record's payload timestamp (SNC millis()) against
+// millis() here, shifted by the SNC clock offset. The offset is the smallest
+// rx - timestamp seen over the current and previous window: the quickest
+// record is taken as ~0 ms in flight, and a new window lets the estimate
+// follow the two crystals drifting apart. Latency therefore reads as delay
+// beyond the fastest delivery (build -> batch -> DMA -> parsed here).
+#define LINK_SEQ_WINDOW        64      // Sequences remembered behind the newest (bitmap width)
+#define LINK_METRICS_WINDOW_MS 10000   // Per-type rate/latency window, published to the dashboard
+#define LINK_TYPE_SLOTS        24      // Distinct packet types tracked
+
+struct LinkTypeMetrics {
+    uint8_t type;                      // PacketType
+    uint32_t received;                 // Records since boot
+    uint32_t windowCount;              // Records this window
+    uint32_t latencySamples;           // Timestamped records this window
+    uint32_t latencySumMs;
+    uint32_t latencyMaxMs;
+
+    // Last completed window (what the dashboard and report show)
+    float rate;                        // Records per second
+    float latencyMeanMs;
+    uint32_t latencyWindowMaxMs;
+};
+
+struct {
+    uint32_t reordered = 0;            // Arrived behind a newer frame (not lost after all)
+    uint32_t duplicates = 0;           // Same sequence seen twice
+    uint32_t resyncs = 0;              // Sequence jumped back past the window (SNC restart)
+    int32_t clockOffsetMs = 0;         // millis() here minus SNC millis(), current estimate
+    bool clockSynced = false;
+    float lossPercent = 0.0;           // dropped / (received + dropped), since boot
+} linkMetrics;
+
+LinkTypeMetrics linkTypes[LINK_TYPE_SLOTS];
+uint8_t linkTypeCount = 0;
+portMUX_TYPE linkMux = portMUX_INITIALIZER_UNLOCKED;   // SPI task updates, loop() rolls the window
+
+// Sequence window (SPI task only)
+uint16_t linkHighestSeq = 0;
+uint64_t linkSeenMask = 0;             // Bit n = (linkHighestSeq - n) arrived
+bool linkHaveSeq = false;
+
+// Offset minima (under linkMux)
+int32_t linkOffsetMinCurrent = INT32_MAX;
+int32_t linkOffsetMinPrevious = INT32_MAX;
+unsigned long linkWindowStartMs = 0;
+
+/**
+ * Account for one valid frame's header.sequence (SPI task)
+ */
+void linkNoteSequence(uint16_t sequence) {
+    if (!linkHaveSeq) {
+        linkHighestSeq = sequence;
+        linkSeenMask = ~0ULL;          // Nothing before the first frame counts as missing
+        linkHaveSeq = true;
+        return;
+    }
+
+    int16_t ahead = (int16_t)(sequence - linkHighestSeq);
+    if (ahead > 0) {
+        // Newest so far - everything skipped is dropped until it turns up late
+        linkSeenMask = (ahead >= LINK_SEQ_WINDOW) ? 0 : linkSeenMask << ahead;
+        linkSeenMask |= 1;
+        linkHighestSeq = sequence;
+        systemData.packetsDropped += ahead - 1;
+        return;
+    }
+
+    uint16_t behind = (uint16_t)(-ahead);
+    if (behind >= LINK_SEQ_WINDOW) {
+        // SNC restarted (its sequence and clock both began again) - resync without counting
+        linkHighestSeq = sequence;
+        linkSeenMask = ~0ULL;
+        linkMetrics.resyncs++;
+        portENTER_CRITICAL(&linkMux);
+        linkOffsetMinCurrent = INT32_MAX;
+        linkOffsetMinPrevious = INT32_MAX;
+        portEXIT_CRITICAL(&linkMux);
+        return;
+    }
+
+    uint64_t bit = 1ULL << behind;
+    if (linkSeenMask & bit) {
+        linkMetrics.duplicates++;
+    } else {
+        linkSeenMask |= bit;
+        linkMetrics.reordered++;
+        if (systemData.packetsDropped > 0) {
+            systemData.packetsDropped--;
+        }
+    }
+}
+
+static LinkTypeMetrics* linkTypeFor(uint8_t type) {
+    for (uint8_t i = 0; i < linkTypeCount; i++) {
+        if (linkTypes[i].type == type) {
+            return &linkTypes[i];
+        }
+    }
+    if (linkTypeCount == LINK_TYPE_SLOTS) {
+        return nullptr;
+    }
+    LinkTypeMetrics* slot = &linkTypes[linkTypeCount++];
+    memset(slot, 0, sizeof(*slot));
+    slot->type = type;
+    return slot;
+}
+
+/**
+ * Count one record (frame or batch record) by type, with its latency if timestamped (SPI task)
+ */
+void linkNoteRecord(uint8_t type, const uint8_t* data, uint8_t length) {
+    // Every payload except these starts with the SNC's millis() at build time
+    bool timestamped = length >= sizeof(uint32_t) && type != PKT_FLIGHT_LOG && type != PKT_COMMAND_ACK;
+    uint32_t now = millis();
+
+    portENTER_CRITICAL(&linkMux);
+    LinkTypeMetrics* m = linkTypeFor(type);
+    if (m != nullptr) {
+        m->received++;
+        m->windowCount++;
+        if (timestamped) {
+            uint32_t sent;
+            memcpy(&sent, data, sizeof(sent));
+            int32_t offset = (int32_t)(now - sent);
+            if (offset < linkOffsetMinCurrent) {
+                linkOffsetMinCurrent = offset;
+            }
+            int32_t best = min(linkOffsetMinCurrent, linkOffsetMinPrevious);
+            uint32_t latency = (uint32_t)(offset - best);
+            m->latencySamples++;
+            m->latencySumMs += latency;
+            if (latency > m->latencyMaxMs) {
+                m->latencyMaxMs = latency;
+            }
+        }
+    }
+    portEXIT_CRITICAL(&linkMux);
+}
+
+/**
+ * Publish the window that just ended and start the next one (loop())
+ */
+void linkMetricsRoll() {
+    unsigned long now = millis();
+    float seconds = (now - linkWindowStartMs) / 1000.0f;
+    if (seconds <= 0) {
+        return;
+    }
+
+    portENTER_CRITICAL(&linkMux);
+    for (uint8_t i = 0; i < linkTypeCount; i++) {
+        LinkTypeMetrics& m = linkTypes[i];
+        m.rate = m.windowCount / seconds;
+        m.latencyMeanMs = m.latencySamples ? (float)m.latencySumMs / m.latencySamples : 0.0f;
+        m.latencyWindowMaxMs = m.latencyMaxMs;
+        m.windowCount = 0;
+        m.latencySamples = 0;
+        m.latencySumMs = 0;
+        m.latencyMaxMs = 0;
+    }
+    int32_t best = min(linkOffsetMinCurrent, linkOffsetMinPrevious);
+    linkMetrics.clockSynced = best != INT32_MAX;
+    linkMetrics.clockOffsetMs = linkMetrics.clockSynced ? best : 0;
+    linkOffsetMinPrevious = linkOffsetMinCurrent;
+    linkOffsetMinCurrent = INT32_MAX;
+    portEXIT_CRITICAL(&linkMux);
+
+    uint32_t sent = systemData.packetsReceived + systemData.packetsDropped;
+    linkMetrics.lossPercent = sent ? 100.0f * systemData.packetsDropped / sent : 0.0f;
+    linkWindowStartMs = now;
+    markStatusDirty(STATUS_LINK_METRICS);
+}
+
 // SPI Communication Class
 class WiFiSPIReceiver {
 private:
-    SPIPacket rx_packet;
+    const SPIPacket* rx_packet = nullptr;  // Completed DMA slot, parsed in place
+    size_t rx_length = 0;   // Bytes actually clocked in by the master
     uint32_t last_successful_read = 0;
 
     uint8_t calculateChecksum(const uint8_t* data, size_t length) {
@@ -118,165 +514,277 @@ private:
     }
 
     bool verifyPacket() {
-        if (rx_packet.header.sync1 != 0xAA || rx_packet.header.sync2 != 0x55) {
+        if (rx_packet->header.sync1 != 0xAA || rx_packet->header.sync2 != 0x55) {
+            return false;
+        }
+
+        uint8_t calc_header = calculateChecksum((const uint8_t*)&rx_packet->header, sizeof(SPIPacketHeader) - 1);
+        if (calc_header != rx_packet->header.checksum_header) {
             return false;
         }
 
-        uint8_t calc_header = calculateChecksum((uint8_t*)&rx_packet.header, sizeof(SPIPacketHeader) - 1);
-        if (calc_header != rx_packet.header.checksum_header) {
+        if (rx_packet->header.data_length > MAX_PAYLOAD_SIZE) {
             return false;
         }
 
-        uint8_t calc_payload = calculateChecksum(rx_packet.payload, rx_packet.header.data_length);
-        if (calc_payload != rx_packet.checksum_payload) {
+        // Length-prefixed frames carry the checksum straight after the payload
+        uint8_t expected_payload = rx_packet->checksum_payload;
+        if (rx_packet->header.flags & SPI_FLAG_VARLEN) {
+            size_t used = sizeof(SPIPacketHeader) + rx_packet->header.data_length + 1;
+            if (rx_length < used) {
+                return false;   // Master released CS early
+            }
+            expected_payload = ((const uint8_t*)rx_packet)[used - 1];
+        } else if (rx_length < sizeof(SPIPacket)) {
+            return false;   // Short fixed frame - the tail is a previous frame's bytes
+        }
+
+        uint8_t calc_payload = calculateChecksum(rx_packet->payload, rx_packet->header.data_length);
+        if (calc_payload != expected_payload) {
             return false;
         }
 
         return true;
     }
 
+    // Reply clocked back on MISO: the header tells the master we accept
+    // VARLEN frames, and carries the oldest unacknowledged command if any.
+    // A transfer caught mid-rewrite fails its checksum and is simply repeated.
+    // Caller holds commandMux.
+    void prepareReply() {
+        SPIPacketHeader* reply = (SPIPacketHeader*)spi_slave_tx_buf;
+        uint8_t* payload = spi_slave_tx_buf + sizeof(SPIPacketHeader);
+
+        memset(payload, 0, sizeof(spi_slave_tx_buf) - sizeof(SPIPacketHeader));
+        if (commandCount > 0) {
+            memcpy(payload, &commandFifo[commandHead], sizeof(CommandPayload));
+            payload[sizeof(CommandPayload)] = calculateChecksum(payload, sizeof(CommandPayload));
+        }
+
+        reply->sync1 = 0xAA;
+        reply->sync2 = 0x55;
+        reply->packet_type = commandCount > 0 ? PKT_COMMAND : PKT_HEARTBEAT;
+        reply->data_length = commandCount > 0 ? sizeof(CommandPayload) : 0;
+        reply->sequence = commandCount > 0 ? commandFifo[commandHead].sequence : 0;
+        reply->flags = SPI_FLAG_VARLEN;
+        reply->checksum_header = calculateChecksum((uint8_t*)reply, sizeof(SPIPacketHeader) - 1);
+    }
+
+    // PKT_COMMAND_ACK: retire the command on MISO and present the next one
+    void processCommandAck(const uint8_t* data, uint8_t length) {
+        if (length < sizeof(CommandPayload)) {
+            return;
+        }
+        const CommandPayload* ack = (const CommandPayload*)data;
+
+        bool retired = false;
+        uint32_t ackMs = 0;
+        portENTER_CRITICAL(&commandMux);
+        if (commandCount > 0 && ack->sequence == commandFifo[commandHead].sequence) {
+            ackMs = millis() - commandQueuedMs[commandHead];
+            commandHead = (commandHead + 1) % SPI_COMMAND_FIFO;
+            commandCount--;
+            prepareReply();
+            retired = true;
+        }
+        portEXIT_CRITICAL(&commandMux);
+
+        // Repeat acks (the SNC saw our reply again before this one landed) are ignored
+        if (retired) {
+            systemData.commandsAcked++;
+            systemData.commandAckMs = ackMs;
+            if (ackMs > systemData.commandAckMaxMs) {
+                systemData.commandAckMaxMs = ackMs;
+            }
+            markStatusDirty(STATUS_LINK);
+        }
+    }
+
     void processPacket() {
         if (!verifyPacket()) {
             systemData.packetsCorrupted++;
             systemData.connectionStatus = false;  // Corrupted = disconnected
+            markStatusDirty(STATUS_LINK);
             return;
         }
 
         systemData.packetsReceived++;
         systemData.lastPacketTime = millis();
-        systemData.lastUpdate = getTimeString();
         systemData.connectionStatus = true;  // Mark as connected on valid packet
         last_successful_read = millis();
+        markStatusDirty(STATUS_LINK);
 
-        // Calculate packets per second
-        static uint32_t lastPacketCount = 0;
-        static unsigned long lastCalcTime = 0;
-        if (millis() - lastCalcTime > 1000) {
-            systemData.packetsPerSecond = (systemData.packetsReceived - lastPacketCount);
-            lastPacketCount = systemData.packetsReceived;
-            lastCalcTime = millis();
-        }
+        // The SNC numbers every frame; a forward gap is frames that never
+        // arrived intact (corrupted ones included) - see SPI LINK METRICS
+        linkNoteSequence(rx_packet->header.sequence);
 
-        // DEBUG: Log packet type received (reduced frequency)
+#if SPI_RX_DEBUG
+        // Log packet type received (reduced frequency)
         static unsigned long lastPacketLog = 0;
         static uint8_t lastPacketType = 0xFF;
-        if (rx_packet.header.packet_type != lastPacketType || millis() - lastPacketLog > 10000) {
+        if (rx_packet->header.packet_type != lastPacketType || millis() - lastPacketLog > 10000) {
             Serial.printf("[PKT-RX] Type=0x%02X (%s) Seq=%d Len=%d\n",
-                         rx_packet.header.packet_type,
-                         getPacketTypeName(rx_packet.header.packet_type),
-                         rx_packet.header.sequence,
-                         rx_packet.header.data_length);
-            lastPacketType = rx_packet.header.packet_type;
+                         rx_packet->header.packet_type,
+                         getPacketTypeName(rx_packet->header.packet_type),
+                         rx_packet->header.sequence,
+                         rx_packet->header.data_length);
+            lastPacketType = rx_packet->header.packet_type;
             lastPacketLog = millis();
         }
+#endif
+
+        if (rx_packet->header.packet_type == PKT_BATCH) {
+            processBatch();
+        } else {
+            dispatchRecord(rx_packet->header.packet_type, rx_packet->payload, rx_packet->header.data_length);
+        }
+    }
+
+    // Walk the TLV records of a PKT_BATCH frame
+    void processBatch() {
+        const uint8_t* cursor = rx_packet->payload;
+        const uint8_t* end = rx_packet->payload + rx_packet->header.data_length;
+
+        while (cursor + sizeof(BatchRecordHeader) <= end) {
+            const BatchRecordHeader* rec = (const BatchRecordHeader*)cursor;
+            const uint8_t* data = cursor + sizeof(BatchRecordHeader);
+            if (data + rec->length > end) {
+                systemData.packetsCorrupted++;  // Truncated record - stop here
+                markStatusDirty(STATUS_LINK);
+                break;
+            }
+            dispatchRecord(rec->type, data, rec->length);
+            cursor = data + rec->length;
+        }
+    }
+
+    void dispatchRecord(uint8_t type, const uint8_t* data, uint8_t length) {
+        linkNoteRecord(type, data, length);
 
-        switch (rx_packet.header.packet_type) {
+        switch (type) {
             case PKT_SYSTEM_STATE:
-                processSystemState();
+                processSystemState(data);
                 break;
             case PKT_SENSOR_COLORS:
-                processSensorColors();
+                processSensorColors(data);
                 break;
             case PKT_INCIDENCE_ANGLE:
-                processIncidenceAngle();
+                processIncidenceAngle(data);
                 break;
             case PKT_WHEEL_SPEEDS:
-                processWheelSpeeds();
+                processWheelSpeeds(data);
                 break;
             case PKT_DISTANCE:
-                processDistance();
+                processDistance(data);
                 break;
             case PKT_ROTATION_ANGLE:
-                processRotationAngle();
+                processRotationAngle(data);
                 break;
             case PKT_END_OF_MAZE:
                 processEndOfMaze();
                 break;
             case PKT_NAVCON_STATE:
-                processNavconState();
+                processNavconState(data);
                 break;
             case PKT_LINE_DETECTION:
-                processLineDetection();
+                processLineDetection(data);
                 break;
             case PKT_DEBUG_MESSAGE:
-                processDebugMessage();
+                processDebugMessage(data);
                 break;
             case PKT_HEARTBEAT:
                 systemData.connectionStatus = true;
                 last_successful_read = millis();
                 break;
+            case PKT_LATENCY_STATS:
+                processLatencyStats(data);
+                break;
+            case PKT_POSE:
+                processPose(data);
+                break;
+            case PKT_MAP_LINE:
+                processMapLine(data);
+                break;
+            case PKT_COMMAND_ACK:
+                processCommandAck(data, length);
+                break;
+            case PKT_TOUCH_DETECTED:
+            case PKT_PURE_TONE:
+                break;  // Events only - the state they cause arrives in PKT_SYSTEM_STATE
+            case PKT_FLIGHT_LOG:
+                if (length >= offsetof(FlightLogChunkPayload, data)) {
+                    storeFlightLogChunk((const FlightLogChunkPayload*)data,
+                                        length - offsetof(FlightLogChunkPayload, data));
+                }
+                break;
             default:
-                Serial.printf("[PKT-RX] UNKNOWN packet type: 0x%02X\n", rx_packet.header.packet_type);
+                Serial.printf("[PKT-RX] UNKNOWN packet type: 0x%02X\n", type);
                 break;
         }
     }
 
-    void processSystemState() {
-        SystemStatePayload* p = (SystemStatePayload*)rx_packet.payload;
-        switch(p->system_state) {
-            case 0: systemData.systemState = "IDLE"; break;
-            case 1: systemData.systemState = "CALIBRATION"; break;
-            case 2: systemData.systemState = "MAZE"; break;
-            case 3: systemData.systemState = "SOS"; break;
-            default: systemData.systemState = "UNKNOWN"; break;
-        }
+    void processSystemState(const uint8_t* data) {
+        const SystemStatePayload* p = (const SystemStatePayload*)data;
+        systemData.systemStateCode = p->system_state;
+        markStatusDirty(STATUS_STATE);
     }
 
-    void processSensorColors() {
-        SensorColorsPayload* p = (SensorColorsPayload*)rx_packet.payload;
-
-        String newS1 = getColorName(p->sensor1_color);
-        String newS2 = getColorName(p->sensor2_color);
-        String newS3 = getColorName(p->sensor3_color);
+    void processSensorColors(const uint8_t* data) {
+        const SensorColorsPayload* p = (const SensorColorsPayload*)data;
 
-        // DEBUG: Log sensor color updates (reduced frequency)
+#if SPI_RX_DEBUG
+        // Log sensor color updates (reduced frequency)
         static unsigned long lastDebugPrint = 0;
         if (millis() - lastDebugPrint > 10000) { // Every 10 seconds
             Serial.printf("[SENSOR-COLORS] Received: S1=%s(%d) S2=%s(%d) S3=%s(%d)\n",
-                         newS1.c_str(), p->sensor1_color,
-                         newS2.c_str(), p->sensor2_color,
-                         newS3.c_str(), p->sensor3_color);
+                         colorName(p->sensor1_color), p->sensor1_color,
+                         colorName(p->sensor2_color), p->sensor2_color,
+                         colorName(p->sensor3_color), p->sensor3_color);
             lastDebugPrint = millis();
         }
+#endif
+
+        // Push if colors actually changed
+        uint8_t* codes = systemData.sensorColorCode;
+        if (p->sensor1_color != codes[0] || p->sensor2_color != codes[1] || p->sensor3_color != codes[2]) {
+            markStatusDirty(STATUS_SENSORS);
+#if SPI_RX_DEBUG
+            Serial.printf("[SENSOR-COLORS] DISPLAY UPDATE: S1=%s S2=%s S3=%s\n",
+                         colorName(p->sensor1_color), colorName(p->sensor2_color), colorName(p->sensor3_color));
+#endif
+        }
 
         // Update immediately - no hold timer
-        systemData.sensor1Color = newS1;
-        systemData.sensor2Color = newS2;
-        systemData.sensor3Color = newS3;
+        codes[0] = p->sensor1_color;
+        codes[1] = p->sensor2_color;
+        codes[2] = p->sensor3_color;
         systemData.lastSensorUpdate = millis();
         systemData.sensorDataHeld = true;
-
-        // Log if colors actually changed
-        static String lastS1 = "UNKNOWN", lastS2 = "UNKNOWN", lastS3 = "UNKNOWN";
-        if (newS1 != lastS1 || newS2 != lastS2 || newS3 != lastS3) {
-            Serial.printf("[SENSOR-COLORS] DISPLAY UPDATE: S1=%s S2=%s S3=%s\n",
-                         newS1.c_str(), newS2.c_str(), newS3.c_str());
-            lastS1 = newS1;
-            lastS2 = newS2;
-            lastS3 = newS3;
-        }
     }
 
-    void processIncidenceAngle() {
-        IncidenceAnglePayload* p = (IncidenceAnglePayload*)rx_packet.payload;
+    void processIncidenceAngle(const uint8_t* data) {
+        const IncidenceAnglePayload* p = (const IncidenceAnglePayload*)data;
         if (p->angle != systemData.incidenceAngle) {
             systemData.incidenceAngle = p->angle;
             systemData.lastIncidenceUpdate = millis();
             systemData.incidenceDataHeld = true;
+            markStatusDirty(STATUS_INCIDENCE);
         }
     }
 
-    void processRotationAngle() {
-        RotationAnglePayload* p = (RotationAnglePayload*)rx_packet.payload;
+    void processRotationAngle(const uint8_t* data) {
+        const RotationAnglePayload* p = (const RotationAnglePayload*)data;
         systemData.rotationAngle = p->angle;
-        systemData.rotationDirection = (p->direction == 2) ? "LEFT" : (p->direction == 3) ? "RIGHT" : "UNKNOWN";
+        systemData.rotationDirectionCode = p->direction;
         systemData.lastRotationUpdate = millis();
         systemData.rotationDataHeld = true;
+        markStatusDirty(STATUS_ROTATION);
     }
 
     void processEndOfMaze() {
         systemData.endOfMazeDetected = true;
         systemData.endOfMazeTime = millis();
+        markStatusDirty(STATUS_EOM);
         Serial.println("\n╔═══════════════════════════════════════╗");
         Serial.println("║  🎉 END OF MAZE DETECTED! 🎉         ║");
         Serial.println("║  WiFi Client Received EOM Packet     ║");
@@ -286,16 +794,17 @@ private:
         Serial.println("[END-OF-MAZE] Web page should now show MAZE COMPLETE banner!");
     }
 
-    void processWheelSpeeds() {
-        WheelSpeedsPayload* p = (WheelSpeedsPayload*)rx_packet.payload;
+    void processWheelSpeeds(const uint8_t* data) {
+        const WheelSpeedsPayload* p = (const WheelSpeedsPayload*)data;
 
-        // Debug: Log wheel speeds every time (temporarily)
+#if SPI_RX_DEBUG
         static unsigned long lastWheelDebug = 0;
         if (millis() - lastWheelDebug > 1000) {
             Serial.printf("[WHEEL-SPEEDS] Received: vR=%d vL=%d setpoint=%d\n",
                          p->vR, p->vL, p->vop_setpoint);
             lastWheelDebug = millis();
         }
+#endif
 
         // Update and mark as held for visibility
         if (p->vR != systemData.wheelSpeedR || p->vL != systemData.wheelSpeedL ||
@@ -305,69 +814,162 @@ private:
             systemData.wheelSetpoint = p->vop_setpoint;
             systemData.lastMovementUpdate = millis();
             systemData.movementDataHeld = true;
+            markStatusDirty(STATUS_MOVEMENT);
 
+#if SPI_RX_DEBUG
             Serial.printf("[WHEEL-SPEEDS] Updated systemData: R=%d L=%d Set=%d\n",
                          systemData.wheelSpeedR, systemData.wheelSpeedL, systemData.wheelSetpoint);
+#endif
         }
     }
 
-    void processDistance() {
-        DistancePayload* p = (DistancePayload*)rx_packet.payload;
+    void processDistance(const uint8_t* data) {
+        const DistancePayload* p = (const DistancePayload*)data;
 
         if (p->distance_mm != systemData.distance_mm) {
             systemData.distance_mm = p->distance_mm;
             systemData.lastMovementUpdate = millis();
             systemData.movementDataHeld = true;
+            markStatusDirty(STATUS_MOVEMENT);
         }
     }
 
-    void processNavconState() {
-        NavconStatePayload* p = (NavconStatePayload*)rx_packet.payload;
-        systemData.navconState = getNavconStateName(p->new_state);
+    void processNavconState(const uint8_t* data) {
+        const NavconStatePayload* p = (const NavconStatePayload*)data;
+        systemData.navconStateCode = p->new_state;
+        markStatusDirty(STATUS_STATE);
+    }
+
+    void processLineDetection(const uint8_t* data) {
+        const LineDetectionPayload* p = (const LineDetectionPayload*)data;
+        systemData.lineColorCode = p->color;
+        systemData.lineTypeCode = (p->line_type == 0) ? 0 : 1;
+        systemData.lineAngleX10 = p->angle;
+        markStatusDirty(STATUS_LINE);
     }
 
-    void processLineDetection() {
-        LineDetectionPayload* p = (LineDetectionPayload*)rx_packet.payload;
-        systemData.lineColor = getColorName(p->color);
-        systemData.lineAngle = p->angle / 10.0;
-        systemData.lineType = (p->line_type == 0) ? "NAVIGABLE" : "WALL";
+    void processDebugMessage(const uint8_t* data) {
+        const DebugMessagePayload* p = (const DebugMessagePayload*)data;
+        // The SNC may fill the whole field - always terminate our copy
+        memcpy(systemData.lastDebugMessage, p->message, DEBUG_MESSAGE_LEN - 1);
+        systemData.lastDebugMessage[DEBUG_MESSAGE_LEN - 1] = '\0';
+        systemData.debugSeverityCode = p->severity;
+        markStatusDirty(STATUS_DEBUG);
     }
 
-    void processDebugMessage() {
-        DebugMessagePayload* p = (DebugMessagePayload*)rx_packet.payload;
-        systemData.lastDebugMessage = String(p->message);
-        switch(p->severity) {
-            case 0: systemData.lastDebugSeverity = "INFO"; break;
-            case 1: systemData.lastDebugSeverity = "WARN"; break;
-            case 2: systemData.lastDebugSeverity = "ERROR"; break;
-            default: systemData.lastDebugSeverity = "UNKNOWN"; break;
+    void processLatencyStats(const uint8_t* data) {
+        const LatencyStatsPayload* p = (const LatencyStatsPayload*)data;
+        if (p->stage_count != LATENCY_STAGE_COUNT) {
+            return;
         }
+        // Last stage is the end-to-end turn
+        const LatencyStageStats& turn = p->stages[LATENCY_STAGE_COUNT - 1];
+        systemData.turnCount = turn.count;
+        systemData.turnMeanUs = turn.mean_ns / 1000.0;
+        systemData.turnP99Us = turn.p99_ns / 1000.0;
+        systemData.turnMaxUs = turn.max_ns / 1000.0;
+        markStatusDirty(STATUS_LATENCY);
     }
 
-    String getColorName(uint8_t color) {
-        switch(color) {
-            case 0: return "WHITE";
-            case 1: return "RED";
-            case 2: return "GREEN";
-            case 3: return "BLUE";
-            case 4: return "BLACK";
-            default: return "UNKNOWN";
+    void processPose(const uint8_t* data) {
+        const PosePayload* p = (const PosePayload*)data;
+        systemData.poseValid = true;
+        systemData.poseX_mm = p->x_mm;
+        systemData.poseY_mm = p->y_mm;
+        systemData.poseHeadingX10 = p->heading_ddeg;
+        systemData.poseTravelled_mm = p->travelled_mm;
+        systemData.poseLines = p->lines;
+        systemData.poseWalls = p->walls;
+        systemData.poseRotations = p->rotations;
+        markStatusDirty(STATUS_POSE);
+    }
+
+    void processMapLine(const uint8_t* data) {
+        const MapLinePayload* p = (const MapLinePayload*)data;
+        // The SNC numbers encounters from 0 per run - going back means a new run
+        if (p->sequence < systemData.mapNextSequence) {
+            systemData.mapLineCount = 0;
+            systemData.mapNextSequence = 0;
+            systemData.mapLinesMissed = 0;
+        }
+        systemData.mapLinesMissed += p->sequence - systemData.mapNextSequence;
+        systemData.mapNextSequence = p->sequence + 1;
+        if (systemData.mapLineCount < MAP_LINES_KEPT) {
+            mapLines[systemData.mapLineCount++] = *p;   // Later ones only count in poseLines/poseWalls
         }
+        markStatusDirty(STATUS_POSE);
     }
 
-    String getNavconStateName(uint8_t state) {
-        switch(state) {
-            case 0: return "FORWARD_SCAN";
-            case 1: return "STOP";
-            case 2: return "REVERSE";
-            case 3: return "STOP_BEFORE_ROTATE";
-            case 4: return "ROTATE";
-            case 5: return "EVALUATE_CORRECTION";
-            case 6: return "CROSSING_LINE";
-            default: return "UNKNOWN";
+private:
+    bool initialized = false;
+    spi_slave_transaction_t trans[SPI_RX_SLOTS];
+
+    // Dashboard command FIFO: loop() adds, the SPI task retires on ack
+    CommandPayload commandFifo[SPI_COMMAND_FIFO];
+    unsigned long commandQueuedMs[SPI_COMMAND_FIFO];
+    uint8_t commandHead = 0;
+    uint8_t commandCount = 0;
+    uint16_t nextCommandSeq = 0;
+    portMUX_TYPE commandMux = portMUX_INITIALIZER_UNLOCKED;
+    QueueHandle_t completed = NULL;     // Slot indices, filled by onTransactionDone()
+    volatile uint8_t queued = 0;        // Slots currently owned by the driver
+    portMUX_TYPE queuedMux = portMUX_INITIALIZER_UNLOCKED;
+
+    void queueSlot(uint8_t slot) {
+        spi_slave_transaction_t& t = trans[slot];
+        t.length = sizeof(SPIPacket) * 8;
+        t.trans_len = 0;
+        t.rx_buffer = spi_slave_rx_buf[slot];
+        t.tx_buffer = spi_slave_tx_buf;
+        t.user = (void*)(uintptr_t)slot;
+
+        portENTER_CRITICAL(&queuedMux);
+        queued++;
+        portEXIT_CRITICAL(&queuedMux);
+        spi_slave_queue_trans(VSPI_HOST, &t, portMAX_DELAY);
+    }
+
+    // Parse one completed slot straight out of its DMA buffer, then hand it back
+    void processSlot(uint8_t slot) {
+        // Retire the driver's copy of the result; the transaction is ours already
+        spi_slave_transaction_t* rtrans;
+        spi_slave_get_trans_result(VSPI_HOST, &rtrans, 0);
+
+        rx_packet = (const SPIPacket*)spi_slave_rx_buf[slot];
+        rx_length = trans[slot].trans_len / 8;
+        if (rx_length > sizeof(SPIPacket)) {
+            rx_length = sizeof(SPIPacket);
+        }
+
+#if SPI_RX_DEBUG
+        static unsigned long lastDebug = 0;
+        if (millis() - lastDebug > 5000) {
+            Serial.printf("[SPI] Received %d bytes, sync1=0x%02X, sync2=0x%02X, type=0x%02X\n",
+                         (int)rx_length, rx_packet->header.sync1,
+                         rx_packet->header.sync2, rx_packet->header.packet_type);
+            lastDebug = millis();
+        }
+#endif
+
+        // Process if valid
+        if (rx_packet->header.sync1 == 0xAA && rx_packet->header.sync2 == 0x55) {
+            processPacket();
+        }
+
+        queueSlot(slot);
+    }
+
+    static void taskEntry(void* arg) {
+        WiFiSPIReceiver* self = (WiFiSPIReceiver*)arg;
+        uint8_t slot;
+        for (;;) {
+            if (xQueueReceive(self->completed, &slot, portMAX_DELAY) == pdTRUE) {
+                self->processSlot(slot);
+            }
         }
     }
 
+public:
     const char* getPacketTypeName(uint8_t type) {
         switch(type) {
             case PKT_SYSTEM_STATE: return "SYS_STATE";
@@ -384,17 +986,84 @@ private:
             case PKT_ROTATION_COMMAND: return "ROT_CMD";
             case PKT_ROTATION_FEEDBACK: return "ROT_FEEDBACK";
             case PKT_ANGLE_EVALUATION: return "ANGLE_EVAL";
+            case PKT_POSE: return "POSE";
+            case PKT_MAP_LINE: return "MAP_LINE";
             case PKT_DEBUG_MESSAGE: return "DEBUG";
             case PKT_HEARTBEAT: return "HEARTBEAT";
+            case PKT_LATENCY_STATS: return "LATENCY";
+            case PKT_FLIGHT_LOG: return "FLIGHT_LOG";
+            case PKT_BATCH: return "BATCH";
+            case PKT_COMMAND_ACK: return "COMMAND_ACK";
             default: return "UNKNOWN";
         }
     }
 
-private:
-    bool initialized = false;
-    spi_slave_transaction_t trans;
+    /**
+     * Queue a dashboard command for the SNC
+     * @param command: WiFiCommand
+     * @param sequence: Set to the command's sequence (see isCommandAcked)
+     * @return: false if the FIFO is full
+     */
+    bool queueCommand(uint8_t command, uint16_t& sequence) {
+        bool queued = false;
+        portENTER_CRITICAL(&commandMux);
+        if (commandCount < SPI_COMMAND_FIFO) {
+            uint8_t slot = (commandHead + commandCount) % SPI_COMMAND_FIFO;
+            commandFifo[slot].sequence = nextCommandSeq;
+            commandFifo[slot].command = command;
+            commandFifo[slot].reserved = 0;
+            commandQueuedMs[slot] = millis();
+            sequence = nextCommandSeq++;
+            if (commandCount++ == 0) {
+                prepareReply();
+            }
+            queued = true;
+        }
+        portEXIT_CRITICAL(&commandMux);
+
+        if (queued) {
+            systemData.commandsQueued++;
+        } else {
+            systemData.commandsRejected++;
+        }
+        markStatusDirty(STATUS_LINK);
+        return queued;
+    }
+
+    /**
+     * Has the SNC acknowledged this command?
+     * The FIFO holds the sequences just below nextCommandSeq, so anything
+     * further back than its length has been retired.
+     */
+    bool isCommandAcked(uint16_t sequence) {
+        portENTER_CRITICAL(&commandMux);
+        bool acked = (uint16_t)(nextCommandSeq - sequence) > commandCount;
+        portEXIT_CRITICAL(&commandMux);
+        return acked;
+    }
+
+    /**
+     * post_trans_cb (ISR): pass the finished slot to the SPI task
+     * An overrun is a completion that leaves the driver with nothing queued -
+     * the master's next frame has no buffer until the task re-queues a slot.
+     */
+    void IRAM_ATTR onTransactionDone(spi_slave_transaction_t* t) {
+        uint8_t slot = (uint8_t)(uintptr_t)t->user;
+        BaseType_t woken = pdFALSE;
+
+        portENTER_CRITICAL_ISR(&queuedMux);
+        queued--;
+        if (queued == 0) {
+            systemData.spiOverruns++;   // Reported with the next frame's STATUS_LINK
+        }
+        portEXIT_CRITICAL_ISR(&queuedMux);
+
+        xQueueSendFromISR(completed, &slot, &woken);
+        if (woken) {
+            portYIELD_FROM_ISR();
+        }
+    }
 
-public:
     void begin() {
         // Configuration for VSPI slave
         spi_bus_config_t buscfg = {
@@ -409,10 +1078,10 @@ public:
         spi_slave_interface_config_t slvcfg = {
             .spics_io_num = SPI_CS,
             .flags = 0,
-            .queue_size = 3,
+            .queue_size = SPI_RX_SLOTS,
             .mode = 0,
             .post_setup_cb = NULL,
-            .post_trans_cb = NULL
+            .post_trans_cb = spiPostTransCallback
         };
 
         // Enable pull-ups on SPI lines for stability
@@ -420,6 +1089,12 @@ public:
         gpio_set_pull_mode((gpio_num_t)SPI_SCK, GPIO_PULLUP_ONLY);
         gpio_set_pull_mode((gpio_num_t)SPI_CS, GPIO_PULLUP_ONLY);
 
+        completed = xQueueCreate(SPI_RX_SLOTS, sizeof(uint8_t));
+        if (completed == NULL) {
+            Serial.println("❌ SPI receive queue allocation failed");
+            return;
+        }
+
         // Initialize SPI slave
         esp_err_t ret = spi_slave_initialize(VSPI_HOST, &buscfg, &slvcfg, SPI_DMA_CH_AUTO);
 
@@ -429,82 +1104,71 @@ public:
             Serial.printf("   MOSI: GPIO %d, MISO: GPIO %d, SCK: GPIO %d, CS: GPIO %d\n",
                          SPI_MOSI, SPI_MISO, SPI_SCK, SPI_CS);
 
-            // Prepare first transaction
-            memset(&trans, 0, sizeof(trans));
-            memset(spi_slave_rx_buf, 0, sizeof(spi_slave_rx_buf));
-            trans.length = sizeof(SPIPacket) * 8;
-            trans.rx_buffer = spi_slave_rx_buf;
-            trans.tx_buffer = spi_slave_tx_buf;
-
-            // Queue the transaction
-            spi_slave_queue_trans(VSPI_HOST, &trans, portMAX_DELAY);
-            Serial.println("   SPI slave ready to receive data");
+            // Frames are parsed on core 1 next to loop(), away from the WiFi stack
+            xTaskCreatePinnedToCore(taskEntry, "spi_rx", SPI_TASK_STACK, this,
+                                    SPI_TASK_PRIORITY, NULL, 1);
+
+            // Pre-queue every slot so back-to-back frames always find a buffer.
+            // Sequences start at random so a restarted WiFi ESP32 can't reuse
+            // the one the SNC saw last (it would be taken as a repeat).
+            nextCommandSeq = (uint16_t)esp_random();
+            portENTER_CRITICAL(&commandMux);
+            prepareReply();
+            portEXIT_CRITICAL(&commandMux);
+            memset(trans, 0, sizeof(trans));
+            for (uint8_t slot = 0; slot < SPI_RX_SLOTS; slot++) {
+                queueSlot(slot);
+            }
+            Serial.printf("   SPI slave ready to receive data (%d DMA slots)\n", SPI_RX_SLOTS);
         } else {
             Serial.printf("❌ SPI Slave init failed: %d\n", ret);
             initialized = false;
         }
     }
-
-    void poll() {
-        if (!initialized) {
-            systemData.connectionStatus = false;
-            return;
-        }
-
-        // Try to get completed transaction (non-blocking, 0ms timeout)
-        spi_slave_transaction_t *rtrans;
-        esp_err_t ret = spi_slave_get_trans_result(VSPI_HOST, &rtrans, 0);
-
-        if (ret == ESP_OK) {
-            // Transaction completed! Copy data
-            memcpy(&rx_packet, spi_slave_rx_buf, sizeof(SPIPacket));
-
-            // Debug output
-            static unsigned long lastDebug = 0;
-            if (millis() - lastDebug > 5000) {
-                Serial.printf("[SPI] Received %d bytes, sync1=0x%02X, sync2=0x%02X, type=0x%02X\n",
-                             rtrans->trans_len / 8, rx_packet.header.sync1,
-                             rx_packet.header.sync2, rx_packet.header.packet_type);
-                lastDebug = millis();
-            }
-
-            // Process if valid
-            if (rx_packet.header.sync1 == 0xAA && rx_packet.header.sync2 == 0x55) {
-                processPacket();
-            }
-
-            // Queue next transaction immediately
-            memset(&trans, 0, sizeof(trans));
-            memset(spi_slave_rx_buf, 0, sizeof(spi_slave_rx_buf));
-            trans.length = sizeof(SPIPacket) * 8;
-            trans.rx_buffer = spi_slave_rx_buf;
-            trans.tx_buffer = spi_slave_tx_buf;
-            spi_slave_queue_trans(VSPI_HOST, &trans, portMAX_DELAY);
-        }
-    }
 };
 
 WiFiSPIReceiver spiReceiver;
 
+void IRAM_ATTR spiPostTransCallback(spi_slave_transaction_t* trans) {
+    spiReceiver.onTransactionDone(trans);
+}
+
 // ==================== UTILITY FUNCTIONS ====================
-String getTimeString() {
-    unsigned long seconds = millis() / 1000;
+void formatUptime(char* out, size_t size, unsigned long ms) {
+    unsigned long seconds = ms / 1000;
     unsigned long minutes = seconds / 60;
     unsigned long hours = minutes / 60;
     seconds %= 60;
     minutes %= 60;
     hours %= 24;
 
-    char timeStr[20];
-    sprintf(timeStr, "%02lu:%02lu:%02lu", hours, minutes, seconds);
-    return String(timeStr);
+    snprintf(out, size, "%02lu:%02lu:%02lu", hours, minutes, seconds);
 }
 
-void sendGPIOCommand(uint8_t pin, const String& commandName) {
-    digitalWrite(pin, HIGH);
-    delay(100);  // Hold high for 100ms
-    digitalWrite(pin, LOW);
-    Serial.println("Sent " + commandName + " command via GPIO " + String(pin));
+// Queue a command for the SNC and wait (briefly) for its ack
+// @return: true if acknowledged; ackMs is the queue -> ack time
+bool sendSPICommand(uint8_t command, const char* commandName, uint32_t& ackMs) {
+    uint16_t sequence;
+    unsigned long start = millis();
+    ackMs = 0;
+    if (!spiReceiver.queueCommand(command, sequence)) {
+        Serial.printf("%s command not sent - %d commands already waiting for the SNC\n",
+                      commandName, SPI_COMMAND_FIFO);
+        return false;
+    }
+
+    // The SPI task (higher priority, same core) retires it when the ack lands
+    while (!spiReceiver.isCommandAcked(sequence)) {
+        if (millis() - start > COMMAND_ACK_TIMEOUT_MS) {
+            Serial.printf("Sent %s command via SPI (seq %u) - no ack yet, still queued\n", commandName, sequence);
+            return false;
+        }
+        delay(1);
+    }
+    ackMs = millis() - start;
+    Serial.printf("Sent %s command via SPI (seq %u) - acknowledged in %lu ms\n",
+                  commandName, sequence, (unsigned long)ackMs);
+    return true;
 }
 
 bool connectToWiFi() {
@@ -519,7 +1183,7 @@ bool connectToWiFi() {
     bool success = WiFi.softAP(ap_ssid, ap_password);
 
     if (success) {
-        // digitalWrite(STATUS_LED, HIGH);  // Disabled - conflicts with CMD_TONE_OUT
+        // digitalWrite(STATUS_LED, HIGH);  // Disabled
         Serial.println("✅ MARV WiFi hotspot created successfully!");
         Serial.print("📱 Connect your phone to: ");
         Serial.println(ap_ssid);
@@ -535,601 +1199,469 @@ bool connectToWiFi() {
 }
 
 // ==================== WEB SERVER HANDLERS ====================
+// Page is web/dashboard.html, gzipped into dashboard_html.h by
+// web/build_dashboard.py and streamed straight from flash. The ETag is the
+// page hash, so a reload of an unchanged firmware is answered with a 304.
 void handleRoot() {
-    String html = R"=====(
-<!DOCTYPE html>
-<html>
-<head>
-    <title>MARV System Monitor</title>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <style>
-        * { margin: 0; padding: 0; box-sizing: border-box; }
-        body {
-            font-family: 'Segoe UI', Tahoma, Geneva, Verdana, sans-serif;
-            background: linear-gradient(135deg, #667eea 0%, #764ba2 100%);
-            color: #333;
-            min-height: 100vh;
-        }
-        .container {
-            max-width: 1400px;
-            margin: 0 auto;
-            padding: 20px;
-        }
-        .header {
-            text-align: center;
-            color: white;
-            margin-bottom: 30px;
-            text-shadow: 2px 2px 4px rgba(0,0,0,0.3);
-        }
-        .header h1 { font-size: 2.5em; margin-bottom: 10px; }
-        .header p { font-size: 1.2em; opacity: 0.9; }
-        .status-grid {
-            display: grid;
-            grid-template-columns: repeat(auto-fit, minmax(300px, 1fr));
-            gap: 20px;
-            margin-bottom: 30px;
-        }
-        .card {
-            background: rgba(255,255,255,0.95);
-            border-radius: 15px;
-            padding: 25px;
-            box-shadow: 0 8px 32px rgba(0,0,0,0.1);
-            backdrop-filter: blur(10px);
-            border: 1px solid rgba(255,255,255,0.2);
-            transition: transform 0.3s ease;
-        }
-        .card:hover { transform: translateY(-5px); }
-        .card h3 {
-            color: #4a5568;
-            margin-bottom: 15px;
-            font-size: 1.3em;
-            border-bottom: 2px solid #e2e8f0;
-            padding-bottom: 8px;
-        }
-        .status-item {
-            display: flex;
-            justify-content: space-between;
-            align-items: center;
-            margin: 12px 0;
-            padding: 8px 0;
-        }
-        .status-label { font-weight: 600; color: #2d3748; }
-        .status-value {
-            font-weight: 500;
-            padding: 4px 12px;
-            border-radius: 20px;
-            background: #f7fafc;
-            border: 1px solid #e2e8f0;
-        }
-        .status-online { background: #c6f6d5; color: #22543d; border-color: #9ae6b4; }
-        .status-offline { background: #fed7d7; color: #742a2a; border-color: #fc8181; }
-        .status-active { background: #bee3f8; color: #2a4365; border-color: #90cdf4; }
-        .status-held {
-            background: #fef3c7;
-            color: #78350f;
-            border-color: #fbbf24;
-            animation: pulse-hold 1s ease-in-out infinite;
-        }
-        @keyframes pulse-hold {
-            0%, 100% { opacity: 1; }
-            50% { opacity: 0.7; }
-        }
-        .controls {
-            background: rgba(255,255,255,0.95);
-            border-radius: 15px;
-            padding: 25px;
-            margin-bottom: 20px;
-            box-shadow: 0 8px 32px rgba(0,0,0,0.1);
-        }
-        .controls h3 {
-            color: #4a5568;
-            margin-bottom: 20px;
-            font-size: 1.3em;
-            text-align: center;
-        }
-        .button-grid {
-            display: grid;
-            grid-template-columns: repeat(auto-fit, minmax(150px, 1fr));
-            gap: 15px;
-        }
-        .control-btn {
-            background: linear-gradient(135deg, #4299e1, #3182ce);
-            color: white;
-            border: none;
-            padding: 15px 20px;
-            border-radius: 10px;
-            cursor: pointer;
-            font-size: 1em;
-            font-weight: 600;
-            transition: all 0.3s ease;
-            box-shadow: 0 4px 15px rgba(66, 153, 225, 0.3);
-        }
-        .control-btn:hover {
-            background: linear-gradient(135deg, #3182ce, #2c5282);
-            transform: translateY(-2px);
-            box-shadow: 0 6px 20px rgba(66, 153, 225, 0.4);
-        }
-        .control-btn:active { transform: translateY(0); }
-        .sensor-colors {
-            display: flex;
-            justify-content: space-around;
-            align-items: center;
-            margin: 15px 0;
-        }
-        .sensor-color {
-            width: 60px;
-            height: 60px;
-            border-radius: 50%;
-            border: 3px solid #fff;
-            box-shadow: 0 4px 15px rgba(0,0,0,0.2);
-            display: flex;
-            align-items: center;
-            justify-content: center;
-            font-weight: bold;
-            color: white;
-            text-shadow: 1px 1px 2px rgba(0,0,0,0.5);
-            font-size: 0.8em;
-        }
-        .color-white { background: #f7fafc; color: #2d3748; }
-        .color-red { background: #e53e3e; }
-        .color-green { background: #38a169; }
-        .color-blue { background: #3182ce; }
-        .color-black { background: #2d3748; }
-        .color-unknown { background: #a0aec0; }
-        .completion-banner {
-            display: none;
-            background: linear-gradient(135deg, #667eea 0%, #764ba2 100%);
-            color: white;
-            padding: 30px;
-            text-align: center;
-            font-size: 2em;
-            font-weight: bold;
-            border-radius: 15px;
-            margin-bottom: 20px;
-            box-shadow: 0 10px 40px rgba(102, 126, 234, 0.4);
-            animation: celebrate 2s ease-in-out infinite;
+    server.sendHeader("ETag", DASHBOARD_HTML_ETAG);
+    server.sendHeader("Cache-Control", "no-cache");
+    if (server.header("If-None-Match") == DASHBOARD_HTML_ETAG) {
+        server.send(304);
+        return;
+    }
+    server.sendHeader("Content-Encoding", "gzip");
+    server.send_P(200, "text/html", (const char*)DASHBOARD_HTML_GZ, DASHBOARD_HTML_GZ_LEN);
+}
+
+// ==================== STATUS JSON ====================
+// Fixed buffer instead of DynamicJsonDocument + String - the same writer
+// serves /api/status (every group) and SSE events (changed groups only)
+struct StatusWriter {
+    char* out;
+    size_t size;
+    size_t used;
+    bool first;
+};
+
+static void statusAppend(StatusWriter& w, const char* format, ...) {
+    if (w.used >= w.size) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(w.out + w.used, w.size - w.used, format, args);
+    va_end(args);
+    // Truncated (or failed) -> mark full so writeStatusJson() reports it
+    w.used = (n < 0 || w.used + n >= w.size) ? w.size : w.used + n;
+}
+
+static void statusKey(StatusWriter& w, const char* key) {
+    statusAppend(w, w.first ? "\"%s\":" : ",\"%s\":", key);
+    w.first = false;
+}
+
+static void statusString(StatusWriter& w, const char* key, const char* value) {
+    statusKey(w, key);
+    statusAppend(w, "\"");
+    // Debug messages come from the SNC verbatim - escape what JSON cannot carry raw
+    for (const char* c = value; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            statusAppend(w, "\\%c", *c);
+        } else if ((uint8_t)*c < 0x20) {
+            statusAppend(w, "\\u%04x", (uint8_t)*c);
+        } else {
+            statusAppend(w, "%c", *c);
         }
-        .completion-banner.active { display: block; }
-        @keyframes celebrate {
-            0%, 100% { transform: scale(1); }
-            50% { transform: scale(1.05); }
+    }
+    statusAppend(w, "\"");
+}
+
+static void statusBool(StatusWriter& w, const char* key, bool value) {
+    statusKey(w, key);
+    statusAppend(w, value ? "true" : "false");
+}
+
+static void statusUint(StatusWriter& w, const char* key, uint32_t value) {
+    statusKey(w, key);
+    statusAppend(w, "%lu", (unsigned long)value);
+}
+
+static void statusFloat(StatusWriter& w, const char* key, float value) {
+    statusKey(w, key);
+    statusAppend(w, "%.2f", value);
+}
+
+/**
+ * Write the requested groups of systemData as one JSON object
+ * @return: Length written, or 0 if it did not fit
+ */
+size_t writeStatusJson(char* out, size_t size, uint32_t fields) {
+    StatusWriter w = {out, size, 0, true};
+
+    statusAppend(w, "{");
+    if (fields & STATUS_LINK) {
+        statusBool(w, "connectionStatus", systemData.connectionStatus);
+        char lastUpdate[12] = "Never";
+        if (systemData.packetsReceived > 0) {
+            formatUptime(lastUpdate, sizeof(lastUpdate), systemData.lastPacketTime);
         }
-        .performance-bar {
-            width: 100%;
-            height: 8px;
-            background: #e2e8f0;
-            border-radius: 4px;
-            overflow: hidden;
-            margin: 10px 0;
+        statusString(w, "lastUpdate", lastUpdate);
+        statusUint(w, "packetsReceived", systemData.packetsReceived);
+        statusUint(w, "packetsCorrupted", systemData.packetsCorrupted);
+        statusUint(w, "packetsDropped", systemData.packetsDropped);
+        statusUint(w, "spiOverruns", systemData.spiOverruns);
+        statusUint(w, "commandsQueued", systemData.commandsQueued);
+        statusUint(w, "commandsAcked", systemData.commandsAcked);
+        statusUint(w, "commandsRejected", systemData.commandsRejected);
+        statusUint(w, "commandAckMs", systemData.commandAckMs);
+        statusUint(w, "commandAckMaxMs", systemData.commandAckMaxMs);
+        statusFloat(w, "packetsPerSecond", systemData.packetsPerSecond);
+    }
+    if (fields & STATUS_STATE) {
+        statusString(w, "systemState", systemStateName(systemData.systemStateCode));
+        statusString(w, "navconState", navconStateName(systemData.navconStateCode));
+    }
+    if (fields & STATUS_EOM) {
+        statusBool(w, "endOfMazeDetected", systemData.endOfMazeDetected);
+    }
+    if (fields & STATUS_SENSORS) {
+        statusString(w, "sensor1Color", colorName(systemData.sensorColorCode[0]));
+        statusString(w, "sensor2Color", colorName(systemData.sensorColorCode[1]));
+        statusString(w, "sensor3Color", colorName(systemData.sensorColorCode[2]));
+        statusBool(w, "sensorDataHeld", systemData.sensorDataHeld);
+    }
+    if (fields & STATUS_LINE) {
+        statusString(w, "lineColor", lineColorName(systemData.lineColorCode));
+        statusFloat(w, "lineAngle", systemData.lineAngleX10 / 10.0);
+        statusString(w, "lineType", lineTypeName(systemData.lineTypeCode));
+    }
+    if (fields & STATUS_INCIDENCE) {
+        statusUint(w, "incidenceAngle", systemData.incidenceAngle);
+        statusBool(w, "incidenceDataHeld", systemData.incidenceDataHeld);
+    }
+    if (fields & STATUS_ROTATION) {
+        statusUint(w, "rotationAngle", systemData.rotationAngle);
+        statusString(w, "rotationDirection", rotationDirectionName(systemData.rotationDirectionCode));
+        statusBool(w, "rotationDataHeld", systemData.rotationDataHeld);
+    }
+    if (fields & STATUS_MOVEMENT) {
+        statusUint(w, "wheelSpeedR", systemData.wheelSpeedR);
+        statusUint(w, "wheelSpeedL", systemData.wheelSpeedL);
+        statusUint(w, "wheelSetpoint", systemData.wheelSetpoint);
+        statusUint(w, "distance", systemData.distance_mm);
+        statusBool(w, "movementDataHeld", systemData.movementDataHeld);
+    }
+    if (fields & STATUS_DEBUG) {
+        statusString(w, "lastDebugMessage", systemData.lastDebugMessage);
+        statusString(w, "lastDebugSeverity", severityName(systemData.debugSeverityCode));
+    }
+    if (fields & STATUS_LATENCY) {
+        statusUint(w, "turnCount", systemData.turnCount);
+        statusFloat(w, "turnMeanUs", systemData.turnMeanUs);
+        statusFloat(w, "turnP99Us", systemData.turnP99Us);
+        statusFloat(w, "turnMaxUs", systemData.turnMaxUs);
+    }
+    if (fields & STATUS_FLIGHT_LOG) {
+        statusUint(w, "flightLogRun", systemData.flightLogRunId);
+        statusUint(w, "flightLogBytes", systemData.flightLogBytes);
+        statusUint(w, "flightLogTotal", systemData.flightLogTotal);
+        statusBool(w, "flightLogComplete", systemData.flightLogComplete);
+        statusBool(w, "flightLogIncomplete", systemData.flightLogIncomplete);
+    }
+    if (fields & STATUS_POSE) {
+        statusBool(w, "poseValid", systemData.poseValid);
+        statusFloat(w, "poseX", systemData.poseX_mm);
+        statusFloat(w, "poseY", systemData.poseY_mm);
+        statusFloat(w, "poseHeading", systemData.poseHeadingX10 / 10.0);
+        statusUint(w, "poseTravelled", systemData.poseTravelled_mm);
+        statusUint(w, "poseLines", systemData.poseLines);
+        statusUint(w, "poseWalls", systemData.poseWalls);
+        statusUint(w, "poseRotations", systemData.poseRotations);
+        statusUint(w, "mapLines", systemData.mapLineCount);
+        statusUint(w, "mapLinesMissed", systemData.mapLinesMissed);
+    }
+    if (fields & STATUS_LINK_METRICS) {
+        statusFloat(w, "lossPercent", linkMetrics.lossPercent);
+        statusUint(w, "packetsReordered", linkMetrics.reordered);
+        statusUint(w, "packetsDuplicated", linkMetrics.duplicates);
+        statusUint(w, "sequenceResyncs", linkMetrics.resyncs);
+        statusBool(w, "clockSynced", linkMetrics.clockSynced);
+        statusKey(w, "clockOffsetMs");
+        statusAppend(w, "%ld", (long)linkMetrics.clockOffsetMs);
+        statusKey(w, "linkTypes");
+        statusAppend(w, "[");
+        for (uint8_t i = 0; i < linkTypeCount; i++) {
+            const LinkTypeMetrics& m = linkTypes[i];
+            statusAppend(w, "%s{\"type\":\"%s\",\"received\":%lu,\"rate\":%.2f,\"latencyMeanMs\":%.2f,\"latencyMaxMs\":%lu}",
+                         i ? "," : "", spiReceiver.getPacketTypeName(m.type), (unsigned long)m.received,
+                         m.rate, m.latencyMeanMs, (unsigned long)m.latencyWindowMaxMs);
         }
-        .performance-fill {
-            height: 100%;
-            background: linear-gradient(90deg, #48bb78, #38a169);
-            transition: width 0.3s ease;
+        statusAppend(w, "]");
+    }
+    statusAppend(w, "}");
+
+    return (w.used < w.size) ? w.used : 0;
+}
+
+void handleApiStatus() {
+    // One-shot snapshot for tools/scripts - the dashboard itself uses /api/events
+    size_t length = writeStatusJson(statusJson, sizeof(statusJson), STATUS_ALL);
+    if (length == 0) {
+        server.send(500, "application/json", "{\"error\":\"status too large\"}");
+        return;
+    }
+    server.send(200, "application/json", statusJson);
+}
+
+// Encounters of the current run for the dashboard map, streamed a few records
+// per chunk so the list never needs a buffer of its own
+void handleApiMap() {
+    char chunk[256];
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "application/json", "");
+
+    snprintf(chunk, sizeof(chunk),
+             "{\"pose\":{\"valid\":%s,\"x\":%d,\"y\":%d,\"heading\":%.1f},\"missed\":%lu,\"lines\":[",
+             systemData.poseValid ? "true" : "false", systemData.poseX_mm, systemData.poseY_mm,
+             systemData.poseHeadingX10 / 10.0, (unsigned long)systemData.mapLinesMissed);
+    server.sendContent(chunk);
+
+    uint16_t count = systemData.mapLineCount;
+    for (uint16_t i = 0; i < count; i++) {
+        const MapLinePayload& line = mapLines[i];
+        snprintf(chunk, sizeof(chunk),
+                 "%s{\"seq\":%u,\"x\":%d,\"y\":%d,\"heading\":%d,\"color\":\"%s\",\"sensor\":%u,"
+                 "\"angle\":%u,\"measured\":%s}", i ? "," : "", line.sequence, line.x_mm, line.y_mm,
+                 line.heading_deg, colorName(line.color), line.sensor, line.angle,
+                 line.angle_valid ? "true" : "false");
+        server.sendContent(chunk);
+    }
+    server.sendContent("]}");
+    server.sendContent("");
+}
+
+void fillStatusFrame(DashboardStatusFrame& f) {
+    uint8_t flags = 0;
+    if (systemData.connectionStatus)  flags |= FRAME_FLAG_CONNECTED;
+    if (systemData.endOfMazeDetected) flags |= FRAME_FLAG_END_OF_MAZE;
+    if (systemData.sensorDataHeld)    flags |= FRAME_FLAG_SENSOR_HELD;
+    if (systemData.movementDataHeld)  flags |= FRAME_FLAG_MOVEMENT_HELD;
+    if (systemData.rotationDataHeld)  flags |= FRAME_FLAG_ROTATION_HELD;
+    if (systemData.incidenceDataHeld) flags |= FRAME_FLAG_INCIDENCE_HELD;
+
+    f.version = DASHBOARD_FRAME_VERSION;
+    f.flags = flags;
+    f.sequence = statusFrameSequence++;
+    f.last_packet_s = systemData.lastPacketTime / 1000;
+    f.packets_received = systemData.packetsReceived;
+    f.packets_corrupted = systemData.packetsCorrupted;
+    f.packets_per_second = (uint16_t)systemData.packetsPerSecond;
+    f.system_state = systemData.systemStateCode;
+    f.navcon_state = systemData.navconStateCode;
+    memcpy(f.sensor_colors, systemData.sensorColorCode, sizeof(f.sensor_colors));
+    f.line_color = systemData.lineColorCode;
+    f.line_type = systemData.lineTypeCode;
+    f.rotation_direction = systemData.rotationDirectionCode;
+    f.line_angle_x10 = systemData.lineAngleX10;
+    f.incidence_angle = systemData.incidenceAngle;
+    f.rotation_angle = systemData.rotationAngle;
+    f.distance_mm = systemData.distance_mm;
+    f.wheel_speed_r = systemData.wheelSpeedR;
+    f.wheel_speed_l = systemData.wheelSpeedL;
+    f.wheel_setpoint = systemData.wheelSetpoint;
+    f.debug_severity = systemData.debugSeverityCode;
+    f.turn_count = systemData.turnCount;
+    f.turn_mean_us = systemData.turnMeanUs;
+    f.turn_p99_us = systemData.turnP99Us;
+    f.turn_max_us = systemData.turnMaxUs;
+}
+
+// ==================== FLIGHT LOG ====================
+// The SNC streams its flight recorder log after the run in offset order.
+// Chunks are appended to FLIGHT_LOG_PATH; one out of order means an SPI frame
+// was lost and the copy is marked incomplete ('F' on the SNC console resends).
+#define FLIGHT_LOG_PATH "/flight.bin"
+
+bool flightLogStorage = false;   // LittleFS mounted
+File flightLogFile;
+
+void storeFlightLogChunk(const FlightLogChunkPayload* chunk, size_t bytes) {
+    if (!flightLogStorage) {
+        return;
+    }
+
+    if (chunk->offset == 0) {
+        if (flightLogFile) flightLogFile.close();
+        flightLogFile = LittleFS.open(FLIGHT_LOG_PATH, "w");
+        systemData.flightLogRunId = chunk->run_id;
+        systemData.flightLogBytes = 0;
+        systemData.flightLogTotal = chunk->total;
+        systemData.flightLogComplete = false;
+        systemData.flightLogIncomplete = !flightLogFile;
+        Serial.printf("[FLIGHT] Receiving run %lu (%lu bytes)\n",
+                      (unsigned long)chunk->run_id, (unsigned long)chunk->total);
+    }
+    if (!flightLogFile || chunk->run_id != systemData.flightLogRunId) {
+        return;
+    }
+
+    if (chunk->offset != systemData.flightLogBytes) {
+        Serial.printf("[FLIGHT] Chunk at %lu, expected %lu - upload incomplete\n",
+                      (unsigned long)chunk->offset, (unsigned long)systemData.flightLogBytes);
+        flightLogFile.close();
+        systemData.flightLogIncomplete = true;
+        markStatusDirty(STATUS_FLIGHT_LOG);
+        return;
+    }
+
+    flightLogFile.write(chunk->data, bytes);
+    systemData.flightLogBytes += bytes;
+    if (systemData.flightLogBytes >= systemData.flightLogTotal) {
+        flightLogFile.close();
+        systemData.flightLogComplete = true;
+        Serial.printf("[FLIGHT] Run %lu stored - download at /api/flightlog\n",
+                      (unsigned long)systemData.flightLogRunId);
+    }
+    markStatusDirty(STATUS_FLIGHT_LOG);
+}
+
+void handleApiFlightLog() {
+    if (!systemData.flightLogComplete) {
+        server.send(404, "text/plain", "No complete flight log - upload one from the SNC ('F')");
+        return;
+    }
+    File log = LittleFS.open(FLIGHT_LOG_PATH, "r");
+    if (!log) {
+        server.send(500, "text/plain", "Flight log missing from flash");
+        return;
+    }
+
+    char disposition[64];
+    snprintf(disposition, sizeof(disposition), "attachment; filename=\"marv_run_%lu.bin\"",
+             (unsigned long)systemData.flightLogRunId);
+    server.sendHeader("Content-Disposition", disposition);
+    server.streamFile(log, "application/octet-stream");
+    log.close();
+}
+
+void handleApiStatusBinary() {
+    DashboardStatusFrame frame;
+    fillStatusFrame(frame);
+    server.send_P(200, "application/octet-stream", (const char*)&frame, sizeof(frame));
+}
+
+// SSE data lines are text - the binary frame goes base64 encoded (72 chars)
+static size_t base64Encode(const uint8_t* in, size_t length, char* out) {
+    static const char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t o = 0;
+    for (size_t i = 0; i < length; i += 3) {
+        uint32_t chunk = (uint32_t)in[i] << 16;
+        if (i + 1 < length) chunk |= (uint32_t)in[i + 1] << 8;
+        if (i + 2 < length) chunk |= in[i + 2];
+        out[o++] = ALPHABET[(chunk >> 18) & 0x3F];
+        out[o++] = ALPHABET[(chunk >> 12) & 0x3F];
+        out[o++] = (i + 1 < length) ? ALPHABET[(chunk >> 6) & 0x3F] : '=';
+        out[o++] = (i + 2 < length) ? ALPHABET[chunk & 0x3F] : '=';
+    }
+    return o;
+}
+
+// ==================== SSE PUSH ====================
+// Text viewers get "data: {...}" with the changed groups. Binary viewers get
+// "event: status" with the whole frame, plus "event: debug" JSON for the text.
+// A short write means the viewer fell behind or left.
+static bool sseWrite(WiFiClient& client, const char* event, const char* data, size_t length) {
+    if (event != nullptr) {
+        if (client.write("event: ", 7) != 7 ||
+            client.write(event, strlen(event)) != strlen(event) ||
+            client.write("\n", 1) != 1) {
+            return false;
         }
-        @media (max-width: 768px) {
-            .container { padding: 15px; }
-            .header h1 { font-size: 2em; }
-            .button-grid { grid-template-columns: 1fr; }
+    }
+    return client.write("data: ", 6) == 6 &&
+           client.write((const uint8_t*)data, length) == length &&
+           client.write("\n\n", 2) == 2;
+}
+
+static bool sseSendEvent(WiFiClient& client, bool binary, uint32_t fields) {
+    if (!binary) {
+        size_t length = writeStatusJson(statusJson, sizeof(statusJson), fields);
+        return length == 0 || sseWrite(client, nullptr, statusJson, length);  // Nothing sane to send - keep the viewer
+    }
+
+    if (fields & ~STATUS_JSON_ONLY) {
+        DashboardStatusFrame frame;
+        fillStatusFrame(frame);
+        char encoded[(sizeof(frame) + 2) / 3 * 4];
+        size_t length = base64Encode((const uint8_t*)&frame, sizeof(frame), encoded);
+        if (!sseWrite(client, "status", encoded, length)) {
+            return false;
         }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <div id="completion-banner" class="completion-banner">
-            🎉 MAZE COMPLETE! 🎉
-        </div>
-        <div id="debug-banner" style="background: #333; color: #0f0; padding: 10px; text-align: center; font-family: monospace; font-size: 0.9em; display: none;">
-            DEBUG: End-of-Maze Flag = <span id="debug-eom-flag">false</span> | Last Update: <span id="debug-timestamp">--</span>
-        </div>
-        <div class="header">
-            <h1>🤖 MARV System Monitor</h1>
-            <p>Real-time navigation and sensor data monitoring</p>
-        </div>
-
-        <div class="status-grid">
-            <div class="card">
-                <h3>🔧 System Status</h3>
-                <div class="status-item">
-                    <span class="status-label">Connection:</span>
-                    <span id="connection-status" class="status-value">Checking...</span>
-                </div>
-                <div class="status-item">
-                    <span class="status-label">System State:</span>
-                    <span id="system-state" class="status-value">Loading...</span>
-                </div>
-                <div class="status-item">
-                    <span class="status-label">Navigation:</span>
-                    <span id="navcon-state" class="status-value">Loading...</span>
-                </div>
-                <div class="status-item">
-                    <span class="status-label">Last Update:</span>
-                    <span id="last-update" class="status-value">Never</span>
-                </div>
-                <div class="status-item">
-                    <span class="status-label">End of Maze:</span>
-                    <span id="end-of-maze" class="status-value">No</span>
-                </div>
-            </div>
-
-            <div class="card">
-                <h3>🎨 Sensor Colors</h3>
-                <div class="sensor-colors">
-                    <div class="sensor-color" id="sensor1">S1</div>
-                    <div class="sensor-color" id="sensor2">S2</div>
-                    <div class="sensor-color" id="sensor3">S3</div>
-                </div>
-                <div class="status-item">
-                    <span class="status-label">Line Color:</span>
-                    <span id="line-color" class="status-value">None</span>
-                </div>
-                <div class="status-item">
-                    <span class="status-label">Line Angle:</span>
-                    <span id="line-angle" class="status-value">0.0°</span>
-                </div>
-                <div class="status-item">
-                    <span class="status-label">Incidence:</span>
-                    <span id="incidence-angle" class="status-value">0°</span>
-                </div>
-            </div>
-
-            <div class="card">
-                <h3>🔄 Rotation Data</h3>
-                <div class="status-item">
-                    <span class="status-label">Angle:</span>
-                    <span id="rotation-angle" class="status-value">0°</span>
-                </div>
-                <div class="status-item">
-                    <span class="status-label">Direction:</span>
-                    <span id="rotation-direction" class="status-value">NONE</span>
-                </div>
-            </div>
-
-            <div class="card">
-                <h3>⚡ Movement Data</h3>
-                <div class="status-item">
-                    <span class="status-label">Right Wheel:</span>
-                    <span id="wheel-r" class="status-value">0 mm/s</span>
-                </div>
-                <div class="status-item">
-                    <span class="status-label">Left Wheel:</span>
-                    <span id="wheel-l" class="status-value">0 mm/s</span>
-                </div>
-                <div class="status-item">
-                    <span class="status-label">Setpoint:</span>
-                    <span id="wheel-setpoint" class="status-value">0 mm/s</span>
-                </div>
-                <div class="status-item">
-                    <span class="status-label">Distance:</span>
-                    <span id="distance" class="status-value">0 mm</span>
-                </div>
-            </div>
-
-            <div class="card">
-                <h3>📊 Performance</h3>
-                <div class="status-item">
-                    <span class="status-label">Packets/sec:</span>
-                    <span id="packets-per-sec" class="status-value">0</span>
-                </div>
-                <div class="status-item">
-                    <span class="status-label">Data Quality:</span>
-                    <span id="data-quality" class="status-value">Excellent</span>
-                </div>
-                <div class="performance-bar">
-                    <div id="performance-fill" class="performance-fill" style="width: 0%"></div>
-                </div>
-            </div>
-        </div>
-
-        <div class="controls">
-            <h3>🎮 Manual Controls</h3>
-            <div class="button-grid">
-                <button class="control-btn" onclick="sendCommand('touch')">Touch Sensor</button>
-                <button class="control-btn" onclick="sendCommand('tone')">Pure Tone</button>
-                <button class="control-btn" onclick="sendCommand('send')">Send Packet</button>
-            </div>
-        </div>
-
-        <div class="controls">
-            <h3>🔄 System Reset</h3>
-            <div class="button-grid">
-                <button class="control-btn" style="background: linear-gradient(135deg, #f56565, #c53030);" onclick="confirmReset('wifi')">Reset WiFi ESP32</button>
-                <button class="control-btn" style="background: linear-gradient(135deg, #ed8936, #c05621);" onclick="sendCommand('reset_main')">Reset Main ESP32</button>
-            </div>
-        </div>
-
-        <div class="card">
-            <h3>🐛 Debug Information</h3>
-            <div class="status-item">
-                <span class="status-label">Last Message:</span>
-                <span id="debug-message" class="status-value">None</span>
-            </div>
-            <div class="status-item">
-                <span class="status-label">Severity:</span>
-                <span id="debug-severity" class="status-value">INFO</span>
-            </div>
-        </div>
-    </div>
-
-    <script>
-        let isUpdating = false; // Prevent overlapping requests
-        let lastUpdateTime = 0;
-        let updateTimeout = null;
-
-        function updateStatus() {
-            // Skip if already updating OR if last update was < 5ms ago (prevents spam)
-            const now = Date.now();
-            if (isUpdating || (now - lastUpdateTime < 5)) return;
-
-            isUpdating = true;
-            lastUpdateTime = now;
-
-            // Safety timeout - reset lock after 100ms if stuck
-            if (updateTimeout) clearTimeout(updateTimeout);
-            updateTimeout = setTimeout(() => {
-                if (isUpdating) {
-                    console.warn('Request timeout - resetting lock');
-                    isUpdating = false;
-                }
-            }, 100);
-
-            fetch('/api/status', {
-                method: 'GET',
-                cache: 'no-cache',
-                priority: 'high'
-            })
-                .then(response => response.json())
-                .then(data => {
-                    clearTimeout(updateTimeout);
-                    isUpdating = false;
-                    // Connection status
-                    const connStatus = document.getElementById('connection-status');
-                    connStatus.textContent = data.connectionStatus ? 'Connected' : 'Disconnected';
-                    connStatus.className = 'status-value ' + (data.connectionStatus ? 'status-online' : 'status-offline');
-
-                    // System states
-                    document.getElementById('system-state').textContent = data.systemState;
-                    document.getElementById('navcon-state').textContent = data.navconState;
-                    document.getElementById('last-update').textContent = data.lastUpdate;
-
-                    // End of maze indicator
-                    const eom = document.getElementById('end-of-maze');
-                    eom.textContent = data.endOfMazeDetected ? 'YES! 🎉' : 'No';
-                    eom.className = 'status-value ' + (data.endOfMazeDetected ? 'status-online' : '');
-
-                    // Show/hide completion banner
-                    const banner = document.getElementById('completion-banner');
-                    if (data.endOfMazeDetected) {
-                        console.log('END-OF-MAZE DETECTED! Showing banner...');
-                        banner.classList.add('active');
-                    } else {
-                        banner.classList.remove('active');
-                    }
-
-                    // Debug: Log end-of-maze status every time it changes
-                    if (window.lastEomStatus !== data.endOfMazeDetected) {
-                        console.log('End-of-Maze Status Changed:', data.endOfMazeDetected);
-                        window.lastEomStatus = data.endOfMazeDetected;
-                    }
-
-                    // Update visible debug banner (for mobile debugging)
-                    const debugBanner = document.getElementById('debug-banner');
-                    const debugFlag = document.getElementById('debug-eom-flag');
-                    const debugTimestamp = document.getElementById('debug-timestamp');
-                    debugFlag.textContent = data.endOfMazeDetected ? 'TRUE ✅' : 'FALSE';
-                    debugFlag.style.color = data.endOfMazeDetected ? '#0f0' : '#f00';
-                    debugTimestamp.textContent = new Date().toLocaleTimeString();
-                    // Show debug banner if user taps header 5 times
-                    if (!window.debugTapCount) window.debugTapCount = 0;
-
-                    // Sensor colors (no hold indicator - just display)
-                    updateSensorColor('sensor1', data.sensor1Color, false);
-                    updateSensorColor('sensor2', data.sensor2Color, false);
-                    updateSensorColor('sensor3', data.sensor3Color, false);
-
-                    document.getElementById('line-color').textContent = data.lineColor;
-                    document.getElementById('line-angle').textContent = data.lineAngle + '°';
-
-                    // Incidence angle (no hold indicator, just display)
-                    const incAngle = document.getElementById('incidence-angle');
-                    incAngle.textContent = data.incidenceAngle + '°';
-                    incAngle.className = 'status-value';
-
-                    // Rotation data (no hold indicator, just display)
-                    const rotAngle = document.getElementById('rotation-angle');
-                    rotAngle.textContent = data.rotationAngle + '°';
-                    rotAngle.className = 'status-value';
-
-                    const rotDir = document.getElementById('rotation-direction');
-                    rotDir.textContent = data.rotationDirection;
-                    if (data.rotationDirection === 'LEFT') {
-                        rotDir.className = 'status-value status-active';
-                    } else if (data.rotationDirection === 'RIGHT') {
-                        rotDir.className = 'status-value status-online';
-                    } else {
-                        rotDir.className = 'status-value';
-                    }
-
-                    // Movement data (no hold indicator, just display)
-                    document.getElementById('wheel-r').textContent = data.wheelSpeedR + ' mm/s';
-                    document.getElementById('wheel-l').textContent = data.wheelSpeedL + ' mm/s';
-                    document.getElementById('wheel-setpoint').textContent = data.wheelSetpoint + ' mm/s';
-                    document.getElementById('distance').textContent = data.distance + ' mm';
-
-                    // Performance
-                    document.getElementById('packets-per-sec').textContent = data.packetsPerSecond;
-
-                    // Data quality indicator
-                    const quality = document.getElementById('data-quality');
-                    if (data.packetsCorrupted > 10) {
-                        quality.textContent = 'Poor';
-                        quality.className = 'status-value status-offline';
-                    } else if (data.packetsCorrupted > 0) {
-                        quality.textContent = 'Good';
-                        quality.className = 'status-value';
-                    } else {
-                        quality.textContent = 'Excellent';
-                        quality.className = 'status-value status-online';
-                    }
-
-                    // Performance bar (0-30 packets/sec scale for better visualization)
-                    const perfPercent = Math.min(data.packetsPerSecond / 30 * 100, 100);
-                    document.getElementById('performance-fill').style.width = perfPercent + '%';
-
-                    // Debug info
-                    document.getElementById('debug-message').textContent = data.lastDebugMessage;
-                    document.getElementById('debug-severity').textContent = data.lastDebugSeverity;
-                })
-                .catch(error => {
-                    clearTimeout(updateTimeout);
-                    isUpdating = false;
-                    console.error('Error fetching status:', error);
-                    document.getElementById('connection-status').textContent = 'Error';
-                    document.getElementById('connection-status').className = 'status-value status-offline';
-                });
+    }
+    if (fields & STATUS_JSON_ONLY) {
+        size_t length = writeStatusJson(statusJson, sizeof(statusJson), fields & STATUS_JSON_ONLY);
+        if (length > 0 && !sseWrite(client, "debug", statusJson, length)) {
+            return false;
         }
+    }
+    return true;
+}
 
-        function updateSensorColor(elementId, color, isHeld) {
-            const element = document.getElementById(elementId);
-            element.className = 'sensor-color color-' + color.toLowerCase();
-            element.textContent = elementId.toUpperCase();
-
-            // Add pulsing border if held
-            if (isHeld) {
-                element.style.border = '4px solid #fbbf24';
-                element.style.animation = 'pulse-hold 1s ease-in-out infinite';
-            } else {
-                element.style.border = '3px solid #fff';
-                element.style.animation = 'none';
-            }
+void handleApiEvents() {
+    // Take over the request's socket: the WebServer drops its own handle after
+    // this returns, our copy keeps the connection open as an event stream
+    WiFiClient client = server.client();
+
+    int slot = -1;
+    for (int i = 0; i < SSE_MAX_CLIENTS; i++) {
+        if (!sseClients[i].connected()) {
+            sseClients[i].stop();
+            slot = i;
+            break;
         }
+    }
+    if (slot < 0) {
+        server.send(503, "text/plain", "Too many dashboard viewers");
+        return;
+    }
 
-        function sendCommand(command) {
-            fetch('/api/command', {
-                method: 'POST',
-                headers: { 'Content-Type': 'application/json' },
-                body: JSON.stringify({ command: command })
-            })
-            .then(response => response.json())
-            .then(data => {
-                if (data.success) {
-                    // Visual feedback
-                    event.target.style.background = 'linear-gradient(135deg, #38a169, #2f855a)';
-                    setTimeout(() => {
-                        event.target.style.background = 'linear-gradient(135deg, #4299e1, #3182ce)';
-                    }, 300);
-                }
-            })
-            .catch(error => console.error('Error sending command:', error));
-        }
+    client.setNoDelay(true);
+    client.print("HTTP/1.1 200 OK\r\n"
+                 "Content-Type: text/event-stream\r\n"
+                 "Cache-Control: no-cache\r\n"
+                 "Connection: keep-alive\r\n"
+                 "\r\n"
+                 "retry: 1000\n\n");
+
+    // New viewer starts from a full snapshot, then only sees changes
+    bool binary = (server.arg("format") == "bin");
+    if (sseSendEvent(client, binary, STATUS_ALL)) {
+        sseClients[slot] = client;
+        sseBinary[slot] = binary;
+        Serial.printf("[SSE] Viewer %d connected from %s (%s)\n", slot,
+                      client.remoteIP().toString().c_str(), binary ? "binary" : "json");
+    } else {
+        client.stop();
+    }
+}
 
-        // Toggle debug banner by tapping header 5 times
-        function toggleDebugBanner() {
-            if (!window.debugTapCount) window.debugTapCount = 0;
-            window.debugTapCount++;
-
-            if (window.debugTapCount >= 5) {
-                const debugBanner = document.getElementById('debug-banner');
-                if (debugBanner.style.display === 'none') {
-                    debugBanner.style.display = 'block';
-                    console.log('Debug banner ENABLED');
-                } else {
-                    debugBanner.style.display = 'none';
-                    console.log('Debug banner DISABLED');
-                }
-                window.debugTapCount = 0;
-            }
+void ssePush() {
+    unsigned long now = millis();
+    if (now - lastSsePush < SSE_MIN_PUSH_MS) {
+        return;
+    }
 
-            // Reset counter after 2 seconds
-            setTimeout(() => { window.debugTapCount = 0; }, 2000);
-        }
+    bool keepalive = (now - lastSseKeepalive >= SSE_KEEPALIVE_MS);
+    if (statusDirty == 0 && !keepalive) {
+        return;
+    }
 
-        // Attach to header
-        document.addEventListener('DOMContentLoaded', function() {
-            const header = document.querySelector('.header h1');
-            if (header) {
-                header.addEventListener('click', toggleDebugBanner);
-                header.style.cursor = 'pointer';
-            }
-        });
-
-        function confirmReset(type) {
-            if (type === 'wifi') {
-                if (confirm('⚠️ Reset WiFi ESP32? You will lose connection and need to reconnect.')) {
-                    fetch('/api/command', {
-                        method: 'POST',
-                        headers: { 'Content-Type': 'application/json' },
-                        body: JSON.stringify({ command: 'reset_wifi' })
-                    });
-                    setTimeout(() => {
-                        alert('WiFi ESP32 resetting... Please wait 5 seconds and refresh the page.');
-                    }, 100);
-                }
-            }
-        }
+    // Changes since the last push are coalesced into one event (latest values)
+    uint32_t fields = takeStatusDirty();
+    lastSsePush = now;
+    if (keepalive) {
+        lastSseKeepalive = now;
+    }
 
-        // Update status every 10ms (100Hz - matches SPI rate, ultra-low latency)
-        setInterval(updateStatus, 10);
-        updateStatus(); // Initial load
-    </script>
-</body>
-</html>
-)=====";
+    for (int i = 0; i < SSE_MAX_CLIENTS; i++) {
+        WiFiClient& client = sseClients[i];
+        if (!client.connected()) {
+            continue;
+        }
 
-    server.send(200, "text/html", html);
-}
+        bool ok = true;
+        if (fields != 0) {
+            ok = sseSendEvent(client, sseBinary[i], fields);
+        } else {
+            ok = client.write(":\n\n", 3) == 3;
+        }
 
-void handleApiStatus() {
-    DynamicJsonDocument doc(1024);
-
-    doc["systemState"] = systemData.systemState;
-    doc["navconState"] = systemData.navconState;
-    doc["lastUpdate"] = systemData.lastUpdate;
-    doc["packetsReceived"] = systemData.packetsReceived;
-    doc["packetsCorrupted"] = systemData.packetsCorrupted;
-    doc["connectionStatus"] = systemData.connectionStatus;
-    doc["sensor1Color"] = systemData.sensor1Color;
-    doc["sensor2Color"] = systemData.sensor2Color;
-    doc["sensor3Color"] = systemData.sensor3Color;
-    doc["wheelSpeedR"] = systemData.wheelSpeedR;
-    doc["wheelSpeedL"] = systemData.wheelSpeedL;
-    doc["wheelSetpoint"] = systemData.wheelSetpoint;
-    doc["distance"] = systemData.distance_mm;
-    doc["lineColor"] = systemData.lineColor;
-    doc["lineAngle"] = systemData.lineAngle;
-    doc["lineType"] = systemData.lineType;
-    doc["incidenceAngle"] = systemData.incidenceAngle;
-    doc["rotationAngle"] = systemData.rotationAngle;
-    doc["rotationDirection"] = systemData.rotationDirection;
-    doc["rotationDataHeld"] = systemData.rotationDataHeld;
-    doc["incidenceDataHeld"] = systemData.incidenceDataHeld;
-    doc["sensorDataHeld"] = systemData.sensorDataHeld;
-    doc["movementDataHeld"] = systemData.movementDataHeld;
-    doc["endOfMazeDetected"] = systemData.endOfMazeDetected;
-    doc["lastDebugMessage"] = systemData.lastDebugMessage;
-    doc["lastDebugSeverity"] = systemData.lastDebugSeverity;
-    doc["packetsPerSecond"] = systemData.packetsPerSecond;
-
-    // Debug: Log end-of-maze status when sending JSON
-    static bool lastEomState = false;
-    if (systemData.endOfMazeDetected != lastEomState) {
-        Serial.printf("[JSON-API] endOfMazeDetected changed to: %d\n", systemData.endOfMazeDetected);
-        lastEomState = systemData.endOfMazeDetected;
-    }
-
-    String response;
-    serializeJson(doc, response);
-
-    // Debug: Print full JSON when end-of-maze is detected (once per second)
-    static unsigned long lastEomJsonPrint = 0;
-    if (systemData.endOfMazeDetected && (millis() - lastEomJsonPrint > 1000)) {
-        Serial.println("[JSON-API] Sending end-of-maze=true to web page");
-        Serial.printf("[JSON-API] JSON contains: endOfMazeDetected=%d\n", systemData.endOfMazeDetected);
-        lastEomJsonPrint = millis();
-    }
-
-    server.send(200, "application/json", response);
+        if (!ok) {
+            // EventSource reconnects by itself and gets a fresh snapshot
+            Serial.printf("[SSE] Viewer %d dropped\n", i);
+            client.stop();
+        }
+    }
 }
 
 void handleApiCommand() {
@@ -1144,15 +1676,18 @@ void handleApiCommand() {
 
     String command = doc["command"];
     bool success = false;
+    bool acked = false;
+    uint32_t ackMs = 0;
 
+    // success = the command reached the SNC's queue; acked = it confirmed in time
     if (command == "touch") {
-        sendGPIOCommand(CMD_TOUCH_OUT, "TOUCH");
+        acked = sendSPICommand(WIFI_CMD_TOUCH, "TOUCH", ackMs);
         success = true;
     } else if (command == "tone") {
-        sendGPIOCommand(CMD_TONE_OUT, "PURE TONE");
+        acked = sendSPICommand(WIFI_CMD_PURE_TONE, "PURE TONE", ackMs);
         success = true;
     } else if (command == "send") {
-        sendGPIOCommand(CMD_SEND_OUT, "SEND PACKET");
+        acked = sendSPICommand(WIFI_CMD_SEND, "SEND PACKET", ackMs);
         success = true;
     } else if (command == "reset_wifi") {
         Serial.println("WiFi ESP32 reset requested via web interface");
@@ -1167,17 +1702,16 @@ void handleApiCommand() {
         ESP.restart();
         return;
     } else if (command == "reset_main") {
-        Serial.println("Main ESP32 reset requested - sending reset pulse on GPIO 15");
-        // Send a long pulse to trigger reset on main ESP32
-        digitalWrite(CMD_SEND_OUT, HIGH);
-        delay(2000); // Hold for 2 seconds to distinguish from normal command
-        digitalWrite(CMD_SEND_OUT, LOW);
+        Serial.println("Main ESP32 reset requested - sending reset command via SPI");
+        acked = sendSPICommand(WIFI_CMD_RESET_MAIN, "RESET", ackMs);
         success = true;
     }
 
-    DynamicJsonDocument response(100);
+    DynamicJsonDocument response(128);
     response["success"] = success;
     response["command"] = command;
+    response["acked"] = acked;
+    response["ackMs"] = ackMs;
 
     String responseStr;
     serializeJson(response, responseStr);
@@ -1198,25 +1732,18 @@ void setup() {
     Serial.print("Will create WiFi hotspot: ");
     Serial.println(ap_ssid);
 
-    // Initialize GPIO pins
-    pinMode(CMD_TOUCH_OUT, OUTPUT);
-    pinMode(CMD_TONE_OUT, OUTPUT);
-    pinMode(CMD_SEND_OUT, OUTPUT);
-    // pinMode(STATUS_LED, OUTPUT);  // Disabled - conflicts with CMD_TONE_OUT
-
-    digitalWrite(CMD_TOUCH_OUT, LOW);
-    digitalWrite(CMD_TONE_OUT, LOW);
-    digitalWrite(CMD_SEND_OUT, LOW);
-
-    Serial.println("GPIO pins initialized for communication with main ESP32");
-    Serial.println("  Touch Command   -> GPIO 4");
-    Serial.println("  Tone Command    -> GPIO 2");
-    Serial.println("  Send Command    -> GPIO 15");
+    // pinMode(STATUS_LED, OUTPUT);  // Disabled
+    Serial.println("Dashboard commands go to the main ESP32 over SPI MISO (acknowledged)");
 
     delay(1000); // Give some time for serial output
     Serial.println("About to initialize SPI...");
     Serial.flush(); // Ensure serial output is sent
 
+    // Flash for the SNC's post-run flight log (formatted on first boot)
+    flightLogStorage = LittleFS.begin(true);
+    Serial.println(flightLogStorage ? "LittleFS mounted for flight log uploads"
+                                    : "LittleFS mount failed - flight log download disabled");
+
     // Initialize SPI
     spiReceiver.begin();
     Serial.println("SPI initialization complete");
@@ -1240,9 +1767,15 @@ void setup() {
         Serial.println("❌ WiFi hotspot failed - continuing with SPI monitoring only");
     }
 
-    // Setup web server routes
+    // Setup web server routes (If-None-Match lets handleRoot answer 304)
+    static const char* collectedHeaders[] = { "If-None-Match" };
+    server.collectHeaders(collectedHeaders, 1);
     server.on("/", handleRoot);
     server.on("/api/status", handleApiStatus);
+    server.on("/api/status.bin", handleApiStatusBinary);
+    server.on("/api/events", handleApiEvents);
+    server.on("/api/flightlog", handleApiFlightLog);
+    server.on("/api/map", handleApiMap);
     server.on("/api/command", handleApiCommand);
 
     server.begin();
@@ -1266,12 +1799,8 @@ void loop() {
     // Handle web server requests
     server.handleClient();
 
-    // Poll SPI data (efficient polling every 10ms)
-    static unsigned long lastSPIPoll = 0;
-    if (millis() - lastSPIPoll > 10) {
-        spiReceiver.poll();
-        lastSPIPoll = millis();
-    }
+    // Push whatever changed to the dashboard viewers (rate-limited)
+    ssePush();
 
     // Clear hold flags after timeout (2 seconds for sensors, 500ms for others)
     static unsigned long lastHoldCheck = 0;
@@ -1284,16 +1813,19 @@ void loop() {
         // Clear movement hold after 500ms
         if (systemData.movementDataHeld && (now - systemData.lastMovementUpdate > 500)) {
             systemData.movementDataHeld = false;
+            markStatusDirty(STATUS_MOVEMENT);
         }
 
         // Clear rotation hold after 500ms
         if (systemData.rotationDataHeld && (now - systemData.lastRotationUpdate > 500)) {
             systemData.rotationDataHeld = false;
+            markStatusDirty(STATUS_ROTATION);
         }
 
         // Clear incidence hold after 500ms
         if (systemData.incidenceDataHeld && (now - systemData.lastIncidenceUpdate > 500)) {
             systemData.incidenceDataHeld = false;
+            markStatusDirty(STATUS_INCIDENCE);
         }
 
         lastHoldCheck = now;
@@ -1311,7 +1843,7 @@ void loop() {
         lastWiFiCheck = millis();
     }
 
-    // Status LED heartbeat - DISABLED due to conflict with CMD_TONE_OUT on GPIO 2
+    // Status LED heartbeat - DISABLED
     // static unsigned long lastHeartbeat = 0;
     // if (millis() - lastHeartbeat > 1000) {
     //     // Check if AP is active and SPI connection is good
@@ -1323,22 +1855,59 @@ void loop() {
     //     lastHeartbeat = millis();
     // }
 
-    // Performance monitoring - print stats every 10 seconds
+    // Packets/second over exactly the last second (stays honest when frames stop arriving)
+    static unsigned long lastRateMs = 0;
+    static uint32_t lastRateCount = 0;
+    if (millis() - lastRateMs >= 1000) {
+        unsigned long now = millis();
+        uint32_t received = systemData.packetsReceived;
+        float rate = (received - lastRateCount) * 1000.0f / (now - lastRateMs);
+        if (rate != systemData.packetsPerSecond) {
+            systemData.packetsPerSecond = rate;
+            markStatusDirty(STATUS_LINK);
+        }
+        lastRateCount = received;
+        lastRateMs = now;
+    }
+
+    // Performance monitoring - close the link metrics window and print stats every 10 seconds
     static unsigned long lastStats = 0;
-    if (millis() - lastStats > 10000) {
+    if (millis() - lastStats > LINK_METRICS_WINDOW_MS) {
+        linkMetricsRoll();
+
         Serial.println("\n╔════════════════════════════════════════════════════╗");
         Serial.println("║       WiFi Communications Status Report           ║");
         Serial.println("╠════════════════════════════════════════════════════╣");
         Serial.printf("║ Packets received:    %6d                      ║\n", systemData.packetsReceived);
         Serial.printf("║ Packets corrupted:   %6d                      ║\n", systemData.packetsCorrupted);
+        Serial.printf("║ Packets dropped:     %6d                      ║\n", systemData.packetsDropped);
+        Serial.printf("║ SPI overruns:        %6d                      ║\n", systemData.spiOverruns);
         Serial.printf("║ Packets/second:      %6.1f                      ║\n", systemData.packetsPerSecond);
+        Serial.printf("║ Loss:                %6.2f%%                     ║\n", linkMetrics.lossPercent);
+        Serial.printf("║ Reordered / dup:     %6lu / %-6lu               ║\n",
+                      (unsigned long)linkMetrics.reordered, (unsigned long)linkMetrics.duplicates);
+        if (linkMetrics.clockSynced) {
+            Serial.printf("║ SNC clock offset:    %6ld ms                   ║\n", (long)linkMetrics.clockOffsetMs);
+        }
         Serial.printf("║ SPI connection:      %-10s                ║\n", systemData.connectionStatus ? "Active" : "Inactive");
+        int viewers = 0;
+        for (int i = 0; i < SSE_MAX_CLIENTS; i++) {
+            if (sseClients[i].connected()) viewers++;
+        }
+        Serial.printf("║ Dashboard viewers:   %6d                      ║\n", viewers);
+        Serial.println("╠════════════════════════════════════════════════════╣");
+        Serial.println("║ Per type (10 s):     rate/s   latency ms mean/max ║");
+        for (uint8_t i = 0; i < linkTypeCount; i++) {
+            const LinkTypeMetrics& m = linkTypes[i];
+            Serial.printf("║   %-14s   %7.1f   %9.1f / %-5lu    ║\n", spiReceiver.getPacketTypeName(m.type),
+                          m.rate, m.latencyMeanMs, (unsigned long)m.latencyWindowMaxMs);
+        }
         Serial.println("╠════════════════════════════════════════════════════╣");
         Serial.printf("║ Current Data:                                      ║\n");
         Serial.printf("║   Sensors: S1=%-7s S2=%-7s S3=%-7s    ║\n",
-                     systemData.sensor1Color.c_str(),
-                     systemData.sensor2Color.c_str(),
-                     systemData.sensor3Color.c_str());
+                     colorName(systemData.sensorColorCode[0]),
+                     colorName(systemData.sensorColorCode[1]),
+                     colorName(systemData.sensorColorCode[2]));
         Serial.printf("║   Wheel Speeds: R=%3d L=%3d Set=%3d             ║\n",
                      systemData.wheelSpeedR,
                      systemData.wheelSpeedL,
@@ -1346,12 +1915,17 @@ void loop() {
         Serial.printf("║   Distance: %5d mm                              ║\n", systemData.distance_mm);
         Serial.printf("║   Rotation: %3d° %-10s                     ║\n",
                      systemData.rotationAngle,
-                     systemData.rotationDirection.c_str());
+                     rotationDirectionName(systemData.rotationDirectionCode));
         Serial.printf("║   End of Maze: %s                                 ║\n",
                      systemData.endOfMazeDetected ? "YES 🎉" : "No");
         Serial.println("╠════════════════════════════════════════════════════╣");
         Serial.printf("║ WiFi signal: %d dBm                              ║\n", WiFi.RSSI());
         Serial.printf("║ Free heap:   %d bytes                          ║\n", ESP.getFreeHeap());
+        // High-water mark: lowest free heap since boot, and the largest block still
+        // allocatable (falls away from free heap when the heap fragments)
+        Serial.printf("║ Heap peak:   %d / %d bytes used              ║\n",
+                      ESP.getHeapSize() - ESP.getMinFreeHeap(), ESP.getHeapSize());
+        Serial.printf("║ Max block:   %d bytes                          ║\n", ESP.getMaxAllocHeap());
         Serial.println("╚════════════════════════════════════════════════════╝\n");
         lastStats = millis();
     }
@@ -1369,7 +1943,7 @@ void loop() {
  *
  * FEATURES:
  * - Professional web interface accessible from any device
- * - Real-time SPI data monitoring with 100ms updates
+ * - Real-time SPI data pushed to the dashboard over SSE (/api/events)
  * - GPIO command transmission to main ESP32
  * - Performance monitoring and statistics
  * - Responsive design for mobile devices
@@ -1382,8 +1956,9 @@ void loop() {
  * - Common ground connection is essential
  *
  * PERFORMANCE:
- * - SPI polling every 10ms (100Hz max packet rate)
- * - Web updates every 100ms for responsive UI
+ * - SPI frames land in 4 pre-queued DMA slots and are parsed in place by an
+ *   event-driven task (no polling, no copies); drops and overruns are counted
+ * - Dashboard events carry only changed fields, coalesced to one per 50ms
  * - Efficient memory usage with minimal heap fragmentation
  * - Automatic WiFi reconnection on disconnection
  */
\ No newline at end of file
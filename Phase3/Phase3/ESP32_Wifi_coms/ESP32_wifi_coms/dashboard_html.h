@@ -0,0 +1,482 @@
+/*
+ * dashboard_html.h
+ * GENERATED by web/build_dashboard.py from web/dashboard.html - do not edit.
+ * 32393 bytes of HTML, 7412 bytes gzipped.
+ */
+
+#ifndef DASHBOARD_HTML_H
+#define DASHBOARD_HTML_H
+
+#include <Arduino.h>
+
+#define DASHBOARD_HTML_ETAG "\"742ab032568b2bb9\""
+#define DASHBOARD_HTML_GZ_LEN 7412
+
+static const uint8_t DASHBOARD_HTML_GZ[DASHBOARD_HTML_GZ_LEN] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xcd, 0x3d, 0xdb, 0x92, 0xdb, 0xca,
+    0x71, 0xef, 0xfa, 0x8a, 0x39, 0x7b, 0xea, 0x84, 0xa0, 0x45, 0x72, 0x41, 0x72, 0xb9, 0x5a, 0x71,
+    0x2f, 0xc7, 0xab, 0x5d, 0xae, 0xce, 0xc6, 0x7b, 0xcb, 0x72, 0x25, 0x59, 0x51, 0x4e, 0xa9, 0x86,
+    0xc0, 0x60, 0x09, 0x0b, 0x04, 0x68, 0x00, 0xdc, 0x8b, 0x65, 0xbd, 0x25, 0x0f, 0xc9, 0x83, 0x93,
+    0xaa, 0xb8, 0x92, 0x2a, 0x27, 0x55, 0x8e, 0xab, 0x52, 0x95, 0x3c, 0xa5, 0xfc, 0x98, 0xca, 0xa3,
+    0x3f, 0xc5, 0x3f, 0x90, 0x7c, 0x42, 0xba, 0x67, 0x06, 0x20, 0x2e, 0x33, 0x20, 0xb9, 0x92, 0x8e,
+    0xac, 0x73, 0x11, 0x09, 0x4c, 0xf7, 0x74, 0xf7, 0xf4, 0x6d, 0x7a, 0x1a, 0xe0, 0xce, 0x57, 0x87,
+    0xe7, 0x07, 0x57, 0xaf, 0x2f, 0x06, 0x64, 0x1c, 0x4f, 0xbc, 0xbd, 0x47, 0x3b, 0xc9, 0x5f, 0x8c,
+    0xda, 0x7b, 0x8f, 0x08, 0xfc, 0xd9, 0x89, 0xdd, 0xd8, 0x63, 0x7b, 0xa7, 0xfb, 0x97, 0x2f, 0xc9,
+    0xf0, 0x3e, 0x8a, 0xd9, 0x84, 0x9c, 0x06, 0xbe, 0x1b, 0x07, 0xe1, 0xce, 0xba, 0xb8, 0x25, 0x86,
+    0x4d, 0x58, 0x4c, 0x89, 0x35, 0xa6, 0x61, 0xc4, 0xe2, 0xdd, 0xb5, 0x17, 0x57, 0x47, 0xcd, 0xad,
+    0xb5, 0xec, 0x2d, 0x9f, 0x4e, 0xd8, 0xee, 0xda, 0x8d, 0xcb, 0x6e, 0xa7, 0x41, 0x18, 0xaf, 0x11,
+    0x2b, 0xf0, 0x63, 0xe6, 0xc3, 0xd0, 0x5b, 0xd7, 0x8e, 0xc7, 0xbb, 0x36, 0xbb, 0x71, 0x2d, 0xd6,
+    0xe4, 0x5f, 0x1a, 0xc4, 0x85, 0x09, 0x5c, 0xea, 0x35, 0x23, 0x8b, 0x7a, 0x6c, 0xb7, 0xdd, 0x32,
+    0x13, 0x54, 0x51, 0x7c, 0x9f, 0xcc, 0x88, 0x7f, 0x7e, 0x44, 0xde, 0x93, 0x09, 0x0d, 0xaf, 0x5d,
+    0xbf, 0x4f, 0xcc, 0x6d, 0x32, 0xa5, 0xb6, 0xed, 0xfa, 0xd7, 0xfc, 0xf3, 0x28, 0xb8, 0x6b, 0x46,
+    0xee, 0x2f, 0xf8, 0xd7, 0x51, 0x10, 0xda, 0x2c, 0x6c, 0xc2, 0xa5, 0x6d, 0xf2, 0x21, 0x05, 0x1e,
+    0x05, 0xf6, 0x3d, 0x79, 0x9f, 0x7e, 0xc5, 0x3f, 0x0e, 0x10, 0xd5, 0x74, 0xe8, 0xc4, 0xf5, 0xee,
+    0xfb, 0xa4, 0x36, 0x64, 0xd7, 0x01, 0x23, 0x2f, 0x8e, 0x6b, 0x0d, 0x72, 0x45, 0xc7, 0xc1, 0x84,
+    0x36, 0xc8, 0x73, 0xe6, 0xb3, 0x1b, 0xf8, 0xfb, 0x25, 0x0b, 0x6d, 0xea, 0xc3, 0x87, 0x88, 0xfa,
+    0x51, 0x33, 0x62, 0xa1, 0xeb, 0x6c, 0xe7, 0x30, 0x8d, 0xa8, 0xf5, 0xee, 0x3a, 0x0c, 0x66, 0xbe,
+    0xdd, 0x27, 0x9e, 0xeb, 0x33, 0x1a, 0x36, 0xaf, 0x43, 0x6a, 0xbb, 0xc0, 0xb2, 0xd1, 0xee, 0xf6,
+    0x6c, 0x76, 0xdd, 0x20, 0x5f, 0x6f, 0x6e, 0x3e, 0x61, 0x8c, 0x12, 0xf3, 0x1b, 0xf8, 0xfc, 0x64,
+    0x73, 0x63, 0x44, 0x3b, 0xa4, 0x6d, 0x9a, 0xdf, 0xd4, 0xf3, 0xa8, 0xac, 0xc0, 0x0b, 0xc2, 0x3e,
+    0xf9, 0xba, 0xdb, 0xed, 0xe6, 0x6f, 0x4c, 0x5c, 0xbf, 0x39, 0x66, 0xee, 0xf5, 0x38, 0xee, 0x23,
+    0xdc, 0xcd, 0x78, 0x7e, 0x7b, 0xce, 0x65, 0x0b, 0x05, 0x4d, 0x81, 0x82, 0xb0, 0xc0, 0xeb, 0x84,
+    0xde, 0x09, 0x71, 0x03, 0xf0, 0x86, 0x69, 0x4e, 0xef, 0x0a, 0xc8, 0x13, 0xb1, 0x12, 0x3a, 0x8b,
+    0x83, 0xfc, 0xbd, 0x54, 0xce, 0x9d, 0x1c, 0x58, 0x66, 0x52, 0xd4, 0x9f, 0xd2, 0x8c, 0x31, 0xbb,
+    0x8b, 0x9b, 0xd4, 0x73, 0xaf, 0x01, 0xad, 0x05, 0x82, 0x60, 0xa1, 0x92, 0xd1, 0xdb, 0xb1, 0x1b,
+    0x33, 0x15, 0x31, 0xb0, 0x80, 0x71, 0x1c, 0x4c, 0xfa, 0xa4, 0x5b, 0xa2, 0x96, 0xa3, 0x8e, 0xc6,
+    0xd4, 0x0e, 0x6e, 0x81, 0xaa, 0xe9, 0x1d, 0xff, 0x6f, 0x03, 0xfe, 0x0b, 0xaf, 0x47, 0xd4, 0x30,
+    0x1b, 0xfc, 0x9f, 0x56, 0xb7, 0x5e, 0x45, 0xec, 0xb8, 0x0d, 0xda, 0xc4, 0x35, 0x00, 0xf4, 0x86,
+    0x01, 0x9a, 0x56, 0x8f, 0x4d, 0xb6, 0x8b, 0x73, 0xb7, 0x71, 0x6e, 0x05, 0xf4, 0x34, 0x0f, 0xdc,
+    0x6e, 0x75, 0x10, 0x38, 0x98, 0x52, 0xcb, 0x8d, 0x41, 0x99, 0xcc, 0xd6, 0xd3, 0x1c, 0x54, 0x14,
+    0xd3, 0x78, 0x16, 0x81, 0x4e, 0xb8, 0x76, 0x41, 0x4a, 0xb6, 0x1b, 0x4d, 0x3d, 0x0a, 0x20, 0x78,
+    0x2f, 0xcf, 0x25, 0x5e, 0x69, 0x82, 0x05, 0xc2, 0xfd, 0x98, 0x35, 0x41, 0x5c, 0xb3, 0x89, 0x1f,
+    0xf5, 0x49, 0xc8, 0xa6, 0x8c, 0xc6, 0x06, 0xae, 0x53, 0xd3, 0x71, 0xe3, 0x06, 0x2a, 0x06, 0xac,
+    0xae, 0xd1, 0xc5, 0x55, 0x6d, 0x90, 0xb6, 0x13, 0xd6, 0x0b, 0x2a, 0x75, 0x4d, 0xa7, 0xc5, 0xc5,
+    0x5b, 0x28, 0xe6, 0xac, 0x4a, 0xd1, 0xb0, 0x48, 0x75, 0x56, 0xdf, 0xb9, 0xcc, 0x3b, 0xbd, 0x5e,
+    0x23, 0xf9, 0x0f, 0x98, 0xef, 0x15, 0x28, 0x90, 0x26, 0x89, 0x26, 0x31, 0x03, 0x16, 0xda, 0xbd,
+    0x22, 0x2d, 0x73, 0x1d, 0x2b, 0xdd, 0xe2, 0xa6, 0x2d, 0xd7, 0xda, 0x24, 0x5b, 0xb0, 0xca, 0xdd,
+    0x4e, 0x71, 0xa9, 0xdb, 0xf5, 0xb2, 0x3d, 0xda, 0x61, 0x30, 0x05, 0x01, 0x79, 0xa0, 0x78, 0xe0,
+    0x13, 0xbc, 0x59, 0x68, 0xe0, 0x62, 0x2a, 0x09, 0x03, 0x8a, 0x00, 0x63, 0x14, 0x78, 0xb0, 0x3c,
+    0x0a, 0x76, 0x3a, 0x05, 0xa0, 0x38, 0x04, 0x37, 0x00, 0x2e, 0x2b, 0x00, 0xcd, 0xe6, 0x9f, 0x9d,
+    0x20, 0x9c, 0xc0, 0x9a, 0x77, 0x23, 0xc2, 0x68, 0xc4, 0xb4, 0x42, 0xec, 0x8f, 0x83, 0x1b, 0x34,
+    0x93, 0x39, 0x90, 0x84, 0xc7, 0x05, 0x7e, 0x6d, 0x34, 0x7b, 0x48, 0x5e, 0x49, 0xf2, 0xe3, 0x6e,
+    0x41, 0xf8, 0x89, 0x87, 0xd8, 0xa0, 0xbd, 0xde, 0xe6, 0x56, 0xe5, 0x9a, 0x96, 0x05, 0x9d, 0x53,
+    0xda, 0x2e, 0x28, 0xad, 0x6a, 0x9d, 0x12, 0xf0, 0x4e, 0x2a, 0x95, 0xaf, 0x59, 0x87, 0x6d, 0x39,
+    0xa6, 0x72, 0xd1, 0xd2, 0xe1, 0x5b, 0x1a, 0x05, 0x92, 0xda, 0xef, 0x62, 0x34, 0xd1, 0x68, 0xbf,
+    0xe3, 0xb1, 0x02, 0xa1, 0x3f, 0x9b, 0x45, 0xb1, 0xeb, 0xdc, 0x37, 0x65, 0xe4, 0xe8, 0x93, 0x08,
+    0x8c, 0x8b, 0x35, 0x47, 0x2c, 0xbe, 0x65, 0xcc, 0xcf, 0x8f, 0xe5, 0x5e, 0x86, 0xe3, 0x8f, 0xd4,
+    0xbe, 0x26, 0x71, 0x6f, 0x6d, 0xe4, 0xc8, 0xd4, 0xa8, 0xde, 0x56, 0xfe, 0x5e, 0x99, 0x01, 0x8f,
+    0x8e, 0x98, 0x97, 0x18, 0xfe, 0xad, 0x74, 0xc5, 0x9b, 0x26, 0x84, 0x9f, 0x64, 0x49, 0x3a, 0x76,
+    0xf7, 0xc9, 0xc6, 0x96, 0xca, 0xf4, 0x6f, 0xa8, 0x37, 0x63, 0xaa, 0xf8, 0x93, 0xe0, 0xe9, 0x99,
+    0x3a, 0xba, 0xd0, 0xb1, 0x21, 0xe1, 0x95, 0x26, 0x55, 0x36, 0xef, 0xac, 0x8d, 0x7e, 0xed, 0x3c,
+    0x71, 0xa8, 0x63, 0x2d, 0xd2, 0xfd, 0xd2, 0x2a, 0x97, 0xf9, 0x08, 0x7c, 0x8c, 0x6f, 0x20, 0x84,
+    0x1c, 0x7a, 0x6b, 0xd3, 0xd9, 0xb4, 0x7b, 0x19, 0x39, 0x74, 0x7a, 0x1b, 0x5d, 0x7b, 0x3b, 0x21,
+    0x32, 0xb9, 0xfc, 0x94, 0xb2, 0xcd, 0xd1, 0x86, 0x4a, 0x3c, 0x81, 0xe3, 0xa8, 0xf0, 0x3a, 0xcc,
+    0x7e, 0x62, 0x3f, 0x99, 0xe3, 0x7d, 0xb2, 0xd1, 0xa1, 0x1d, 0x5a, 0xc2, 0xeb, 0x58, 0x5b, 0xed,
+    0xad, 0xb6, 0x0a, 0x2f, 0xb5, 0x62, 0xf7, 0xa6, 0x84, 0x76, 0xc4, 0x58, 0xd7, 0xd9, 0xca, 0x90,
+    0x4b, 0x37, 0xba, 0x9b, 0xbd, 0x32, 0xb9, 0xa6, 0x65, 0x3b, 0x4a, 0x72, 0xc7, 0xcc, 0xab, 0x72,
+    0x89, 0x40, 0xb7, 0xd3, 0xb5, 0x9e, 0xa8, 0x03, 0xfb, 0x93, 0xad, 0x6e, 0xcf, 0x74, 0x94, 0x8b,
+    0x99, 0xf2, 0x33, 0x1a, 0x39, 0x9d, 0x8d, 0x82, 0x8e, 0xfb, 0xee, 0x84, 0x0a, 0x9f, 0x33, 0x9d,
+    0x79, 0x11, 0x6b, 0x8e, 0x03, 0xa0, 0xa1, 0x2d, 0x5c, 0x4e, 0x13, 0x6c, 0x3e, 0x98, 0xc5, 0x90,
+    0x49, 0x39, 0x98, 0x4c, 0x29, 0x5d, 0xd0, 0x8f, 0xdf, 0xb1, 0x7b, 0x27, 0x84, 0xbc, 0x2c, 0xca,
+    0x22, 0xc8, 0x33, 0x81, 0xb9, 0x09, 0xe6, 0x24, 0x20, 0xb0, 0x34, 0x96, 0xe5, 0xe4, 0x8a, 0x7f,
+    0x7a, 0xf9, 0xfb, 0x66, 0xeb, 0x49, 0x76, 0x44, 0x21, 0x17, 0x09, 0x03, 0x2f, 0xfa, 0x82, 0xc1,
+    0xa3, 0xe0, 0x0f, 0x15, 0x56, 0xb2, 0x62, 0x74, 0x51, 0xb1, 0xf7, 0x31, 0x1e, 0xba, 0x4c, 0x51,
+    0xb5, 0x87, 0xae, 0xca, 0xaa, 0x32, 0xb4, 0x8d, 0x66, 0x80, 0xde, 0xff, 0xbc, 0x09, 0x47, 0xbb,
+    0x57, 0x99, 0x70, 0xe4, 0xd7, 0xa9, 0x2c, 0xb7, 0xe6, 0x28, 0xf6, 0x2b, 0x34, 0x43, 0x9b, 0x46,
+    0x6f, 0x74, 0x9e, 0x3e, 0x65, 0x6d, 0xf8, 0xd0, 0x6d, 0x6f, 0x75, 0x2c, 0x56, 0x5f, 0x36, 0xab,
+    0x4c, 0xdc, 0x9d, 0x1f, 0xf8, 0x4c, 0xa3, 0x3f, 0x48, 0xb2, 0x52, 0x47, 0xf2, 0x0a, 0x58, 0x1a,
+    0x60, 0xcd, 0xc2, 0x08, 0x67, 0x9d, 0x06, 0x6e, 0x39, 0xf6, 0x64, 0xd7, 0xb3, 0xb8, 0x9a, 0xa5,
+    0x48, 0xa2, 0xcd, 0x33, 0xa8, 0xe7, 0xa9, 0x32, 0x8c, 0xb2, 0x0a, 0xf3, 0x68, 0xd1, 0x4b, 0x54,
+    0x78, 0x73, 0x13, 0x16, 0xa8, 0xd7, 0x6d, 0x10, 0xf0, 0xc8, 0x0d, 0xa2, 0xcd, 0x89, 0x33, 0x4b,
+    0x92, 0x24, 0x29, 0xab, 0x2f, 0x8c, 0x58, 0x0f, 0xf8, 0xd0, 0xb1, 0x7a, 0x9d, 0x2d, 0x65, 0xd2,
+    0x54, 0xce, 0x79, 0x3a, 0x8a, 0x94, 0x2c, 0xcb, 0xce, 0xa6, 0x5c, 0x11, 0x35, 0x3b, 0x1b, 0x8b,
+    0xd9, 0x49, 0x23, 0x80, 0x9a, 0x00, 0x33, 0x9f, 0x71, 0x45, 0xcc, 0x87, 0x95, 0x14, 0x8e, 0x38,
+    0xfa, 0xe8, 0x64, 0x85, 0x72, 0x91, 0x3d, 0x34, 0x57, 0xe9, 0xe9, 0xf3, 0x91, 0x0c, 0x95, 0x05,
+    0x22, 0xe5, 0x1e, 0x6f, 0xb3, 0xa4, 0xa3, 0xe3, 0x54, 0xcb, 0x16, 0xa8, 0x37, 0xb8, 0x77, 0xb5,
+    0xe1, 0x74, 0xe7, 0x79, 0x82, 0xe3, 0x38, 0xcb, 0xeb, 0x60, 0xe2, 0x46, 0x8b, 0x1a, 0x51, 0x21,
+    0xcf, 0x85, 0x42, 0x2a, 0x09, 0x5c, 0x35, 0x28, 0x67, 0x5d, 0x23, 0x88, 0x76, 0xcb, 0xba, 0x8a,
+    0xdc, 0xfe, 0x12, 0xd3, 0xa3, 0xb6, 0xdc, 0x63, 0xe6, 0xf8, 0x29, 0xc6, 0xa9, 0x8c, 0xa1, 0x9b,
+    0xad, 0xad, 0xac, 0xa9, 0xe7, 0x54, 0x13, 0x26, 0x6d, 0xf2, 0x39, 0x4b, 0xc9, 0x8e, 0xc8, 0xd1,
+    0xaa, 0x92, 0x49, 0x01, 0x1d, 0x32, 0xbb, 0x08, 0xcb, 0x7a, 0x5d, 0xd6, 0x65, 0x8a, 0xb1, 0xd7,
+    0x21, 0x64, 0xcb, 0xc5, 0xd1, 0xdd, 0x2d, 0xda, 0xde, 0x7c, 0xaa, 0x18, 0x3d, 0xe2, 0x49, 0x6a,
+    0x61, 0x30, 0x37, 0x6b, 0xe5, 0x60, 0x18, 0x56, 0x1c, 0xad, 0x25, 0x7a, 0xe6, 0xbf, 0xf3, 0x83,
+    0xdb, 0x12, 0x29, 0xd4, 0xa4, 0xcc, 0x32, 0x0b, 0xe3, 0x21, 0x02, 0x31, 0x74, 0x7b, 0xcd, 0x11,
+    0xf5, 0xcb, 0xa5, 0x8c, 0x54, 0x6f, 0xca, 0x9e, 0xfc, 0xd3, 0xd7, 0x61, 0x14, 0xda, 0x91, 0x86,
+    0x0b, 0x4d, 0x61, 0xa2, 0xa2, 0xe6, 0x91, 0xad, 0x37, 0x54, 0xc6, 0x82, 0xb2, 0xb6, 0x2e, 0xcc,
+    0x82, 0x56, 0x4c, 0x75, 0x30, 0x8a, 0x91, 0x8d, 0xd4, 0xb3, 0xb6, 0xcd, 0x0e, 0xb8, 0xd6, 0x0e,
+    0xf8, 0xd7, 0x4e, 0x77, 0xa3, 0xe8, 0x5a, 0x0b, 0xf9, 0xa7, 0xc5, 0x3c, 0x36, 0x0a, 0xc1, 0x7d,
+    0x92, 0xce, 0xf2, 0xe9, 0x67, 0x79, 0x59, 0x5b, 0xa9, 0x6b, 0x4e, 0x57, 0x74, 0xe4, 0x05, 0xd6,
+    0xbb, 0x6d, 0x75, 0xd2, 0x3a, 0x9f, 0x55, 0x9b, 0xb3, 0x66, 0x5c, 0x3c, 0xaf, 0x25, 0x1a, 0xed,
+    0xba, 0x3a, 0x79, 0x2d, 0x0f, 0x6c, 0x99, 0xbd, 0xba, 0x26, 0x8d, 0x9d, 0xb2, 0x10, 0x87, 0x52,
+    0x1f, 0xb7, 0x9f, 0x54, 0xe3, 0x70, 0x91, 0x02, 0xb5, 0xc3, 0xdd, 0xaa, 0xdc, 0x98, 0xa9, 0xf6,
+    0xd5, 0x85, 0xa5, 0xde, 0x28, 0x22, 0xc0, 0x00, 0xed, 0x78, 0xb8, 0x8c, 0x63, 0xd7, 0xb6, 0x8b,
+    0x9b, 0xe1, 0x34, 0x7e, 0x98, 0xda, 0xf8, 0x91, 0xe5, 0xc8, 0x71, 0x21, 0xb3, 0x78, 0xaf, 0xa4,
+    0xbc, 0xcc, 0x53, 0x95, 0x7d, 0x3d, 0x35, 0x65, 0x7e, 0xb6, 0x35, 0x1a, 0x3d, 0xd9, 0x6a, 0x24,
+    0x5e, 0xa6, 0xa2, 0x76, 0xc2, 0x45, 0x57, 0x5d, 0x37, 0xf9, 0xf1, 0x84, 0xd9, 0x2e, 0x25, 0x46,
+    0xa6, 0x7c, 0xf9, 0x64, 0x13, 0x24, 0x5a, 0x2f, 0x90, 0x9c, 0xad, 0x7b, 0xe6, 0xf3, 0xb9, 0xa2,
+    0x02, 0x68, 0xeb, 0x7f, 0x58, 0xc0, 0x2b, 0x0c, 0xcd, 0x65, 0xd1, 0xba, 0xf4, 0x18, 0xf2, 0xdf,
+    0xb2, 0xe2, 0xec, 0xac, 0xcb, 0xda, 0xf5, 0xce, 0xba, 0x28, 0xae, 0xef, 0x60, 0xfd, 0x59, 0x96,
+    0xb5, 0x6d, 0xf7, 0x86, 0x58, 0x1e, 0x8d, 0xa2, 0xdd, 0xb5, 0x94, 0xec, 0xb5, 0x79, 0x99, 0x9b,
+    0xdf, 0x77, 0x6d, 0xbc, 0x59, 0xb0, 0x98, 0xb5, 0x39, 0x58, 0xf1, 0xce, 0x5e, 0x8e, 0xf2, 0xff,
+    0xfb, 0xed, 0xaf, 0xfe, 0x96, 0x9c, 0xee, 0xff, 0xe5, 0x80, 0x1c, 0x9c, 0x9f, 0x5e, 0x9c, 0x0c,
+    0xae, 0x06, 0x5f, 0xf1, 0x6b, 0xf3, 0x39, 0xd6, 0x61, 0x12, 0xc5, 0x94, 0x36, 0x1b, 0xcd, 0xae,
+    0xd3, 0xd9, 0x38, 0x0f, 0xbb, 0x6b, 0xf9, 0x70, 0xd0, 0xed, 0xce, 0x43, 0x94, 0xe9, 0x64, 0xeb,
+    0xf0, 0xa2, 0x58, 0xaa, 0xf0, 0x81, 0xf9, 0x4a, 0xfb, 0x24, 0xf0, 0x03, 0x9e, 0x1f, 0x6d, 0xe7,
+    0x43, 0xe6, 0x53, 0x5c, 0x81, 0xbc, 0x73, 0x2f, 0xb0, 0x75, 0x38, 0x78, 0xf6, 0xe2, 0x79, 0x9f,
+    0x0c, 0x7c, 0xbb, 0x19, 0x38, 0xcd, 0x53, 0xfa, 0x0b, 0x46, 0x8e, 0x3c, 0x7a, 0x4d, 0x76, 0xc9,
+    0x0e, 0x20, 0xf4, 0x33, 0x1c, 0xb0, 0x60, 0xd2, 0x74, 0xe0, 0xd6, 0xda, 0x9e, 0x43, 0x61, 0xaf,
+    0x0b, 0xcb, 0x01, 0xf7, 0xf7, 0xc8, 0x2f, 0xc9, 0x09, 0x8d, 0x62, 0xf2, 0x62, 0x6a, 0xc3, 0x12,
+    0xf6, 0x4b, 0x50, 0xb1, 0x0b, 0x8e, 0x26, 0xa6, 0x93, 0xe9, 0xda, 0x5e, 0xb3, 0x29, 0x61, 0x2a,
+    0x45, 0x26, 0x97, 0x43, 0xa8, 0x54, 0x81, 0xd8, 0x9d, 0x71, 0x7b, 0xef, 0xff, 0x7e, 0xfb, 0xef,
+    0xff, 0x44, 0x94, 0x87, 0x29, 0x70, 0x33, 0x3f, 0x7a, 0xba, 0x77, 0xc9, 0xa8, 0xc7, 0x49, 0x20,
+    0x3e, 0xbd, 0x71, 0xaf, 0xb9, 0xb3, 0x05, 0xb7, 0x6b, 0x13, 0x91, 0xee, 0x11, 0xa0, 0x99, 0xa2,
+    0xf0, 0x10, 0x01, 0xc8, 0x7b, 0x67, 0x7d, 0x5a, 0x22, 0x4e, 0x49, 0x5d, 0xa6, 0xf8, 0x5c, 0x24,
+    0x31, 0xab, 0x89, 0x34, 0x2c, 0xde, 0x16, 0x5c, 0x74, 0x81, 0x8b, 0x5f, 0xff, 0x47, 0xc2, 0xc0,
+    0x90, 0x23, 0x03, 0xfa, 0xbb, 0x8a, 0xb1, 0xe5, 0x49, 0x31, 0x85, 0x53, 0x60, 0x15, 0xa7, 0x3b,
+    0x28, 0xfc, 0xfc, 0x70, 0x5e, 0x61, 0x5b, 0xdb, 0x3b, 0x08, 0x40, 0xff, 0x2c, 0xee, 0x24, 0x8a,
+    0xab, 0x50, 0xc6, 0x20, 0x2c, 0x25, 0x01, 0x68, 0x0a, 0x4c, 0x6b, 0x05, 0xc4, 0xbc, 0xfc, 0x06,
+    0x88, 0xc7, 0xcc, 0x7a, 0x07, 0xb2, 0x6b, 0xb5, 0x5a, 0x3a, 0xc4, 0x85, 0x65, 0xfe, 0xe4, 0xbc,
+    0x65, 0xe4, 0xc8, 0x96, 0xe4, 0x2e, 0xe2, 0x20, 0x9c, 0x33, 0xa6, 0x61, 0xec, 0x24, 0xa0, 0xf6,
+    0x97, 0xe5, 0xeb, 0x2c, 0xd5, 0xd9, 0x25, 0xb9, 0x02, 0x25, 0xb7, 0xe4, 0x7a, 0xfd, 0xe9, 0x72,
+    0x95, 0x75, 0x17, 0xcb, 0xb1, 0x05, 0x58, 0xe2, 0xe6, 0x8c, 0x43, 0x68, 0xb8, 0x3a, 0x63, 0x10,
+    0xbf, 0xbf, 0x14, 0x43, 0xe0, 0x3b, 0x49, 0xe0, 0x10, 0xf4, 0x9d, 0x4b, 0x32, 0xc4, 0x84, 0xb7,
+    0x9d, 0x00, 0x84, 0x8e, 0xa1, 0x60, 0x05, 0x6e, 0x8a, 0x9e, 0x6a, 0x25, 0x3f, 0xf4, 0xab, 0xff,
+    0x24, 0x43, 0xe1, 0x0c, 0x0f, 0xf8, 0x0e, 0x7d, 0x09, 0x3f, 0x94, 0xdd, 0xd0, 0xeb, 0xc4, 0xa5,
+    0x19, 0xbf, 0x26, 0xac, 0x8f, 0x5f, 0x69, 0x83, 0xe5, 0xb6, 0x35, 0x8b, 0xb3, 0x2c, 0x8e, 0x0e,
+    0xe0, 0xe8, 0x7c, 0x24, 0x8e, 0x2e, 0xe0, 0xe8, 0xea, 0x94, 0xe4, 0x73, 0x1b, 0x03, 0x56, 0xe8,
+    0xb9, 0xe0, 0x97, 0xb5, 0x05, 0x00, 0x48, 0x58, 0xd0, 0x68, 0x8e, 0xcf, 0xbe, 0x98, 0x69, 0x23,
+    0x37, 0xfb, 0xfe, 0xb5, 0xc7, 0x56, 0xe1, 0x86, 0x22, 0x80, 0x86, 0x1b, 0xb3, 0x65, 0xfe, 0xe1,
+    0xf7, 0x5f, 0x8a, 0x9d, 0x63, 0xdf, 0x72, 0x61, 0x2f, 0x60, 0x2d, 0xcb, 0x8d, 0x9b, 0x8c, 0xaf,
+    0x66, 0x69, 0x25, 0x86, 0x3e, 0xca, 0xb6, 0x7f, 0xfd, 0xd7, 0xe4, 0x32, 0x88, 0x45, 0xd6, 0x73,
+    0x08, 0xa9, 0xce, 0x67, 0xce, 0x31, 0x56, 0x59, 0xf9, 0x50, 0xd2, 0xf5, 0x09, 0x45, 0xf5, 0x49,
+    0x79, 0x39, 0x74, 0xc3, 0x95, 0xd2, 0xa5, 0x94, 0x1f, 0x3b, 0x01, 0xd4, 0xd9, 0xe7, 0xf9, 0xd9,
+    0xe0, 0x87, 0x59, 0xff, 0x3f, 0xfe, 0xe6, 0x77, 0x90, 0x1c, 0xdf, 0xb0, 0x09, 0xec, 0x18, 0x7e,
+    0x88, 0xe5, 0xbf, 0xc4, 0x2d, 0x2e, 0x79, 0x35, 0x66, 0xcc, 0x5b, 0x52, 0x68, 0xb7, 0x38, 0xb6,
+    0xa9, 0xf3, 0x64, 0x26, 0x99, 0x4c, 0xd6, 0xa3, 0x2f, 0xe6, 0xcb, 0x98, 0xf3, 0x10, 0x66, 0xbc,
+    0x3f, 0x49, 0x66, 0x86, 0x2c, 0xe6, 0x07, 0x29, 0x2b, 0xb1, 0x12, 0x49, 0xa0, 0x3f, 0x49, 0x8e,
+    0x0e, 0x5d, 0xf8, 0xbe, 0xbc, 0x6b, 0xb6, 0xe5, 0xf0, 0x0a, 0x5e, 0x7e, 0x28, 0xa7, 0xfc, 0x8f,
+    0x7f, 0x47, 0x2e, 0xe6, 0xc5, 0xa2, 0xcf, 0x6c, 0x93, 0x17, 0xd4, 0x7a, 0xc7, 0xe2, 0x68, 0x3d,
+    0x62, 0xd6, 0x92, 0x92, 0x9a, 0x0a, 0x88, 0xe6, 0x94, 0x85, 0xa0, 0x01, 0x96, 0x4e, 0x60, 0x5f,
+    0x6c, 0xdd, 0x71, 0xc7, 0xfe, 0x17, 0x33, 0xea, 0xe1, 0x41, 0xf9, 0x92, 0x6b, 0x0f, 0x20, 0xcd,
+    0x9f, 0x0b, 0x10, 0x0d, 0x3b, 0x83, 0x3b, 0x8b, 0x79, 0x1e, 0xf8, 0xc9, 0x8f, 0x60, 0xab, 0x50,
+    0xd3, 0xac, 0x4a, 0x8c, 0xb9, 0x9c, 0x0b, 0x05, 0xc3, 0x35, 0x15, 0x1e, 0x71, 0x43, 0xd6, 0x8c,
+    0x64, 0xb1, 0xce, 0xfc, 0x66, 0x6d, 0x6f, 0xf9, 0x6c, 0xf5, 0xe3, 0x54, 0xf5, 0x77, 0x64, 0x78,
+    0x71, 0x4c, 0x20, 0xad, 0x7b, 0xf7, 0x99, 0xf5, 0xf4, 0x24, 0x88, 0xa2, 0xe5, 0x73, 0xc6, 0x77,
+    0x4d, 0x0f, 0xc6, 0x6b, 0xd6, 0xb2, 0x5c, 0x66, 0xfa, 0xa1, 0x74, 0xf3, 0x92, 0xf1, 0x2a, 0x33,
+    0xb3, 0xc9, 0x3a, 0x39, 0x9c, 0x4d, 0x3d, 0xd7, 0x82, 0x1d, 0xeb, 0x4a, 0x6c, 0x85, 0x02, 0x83,
+    0xd6, 0x4b, 0xad, 0x93, 0x2f, 0x66, 0x78, 0xc3, 0xb3, 0x03, 0x72, 0x80, 0x67, 0x09, 0xe4, 0xdc,
+    0x71, 0x20, 0x34, 0xac, 0xc2, 0x56, 0xc0, 0x21, 0xb4, 0x1b, 0x96, 0x98, 0x44, 0xf7, 0xa0, 0xed,
+    0xf6, 0x43, 0x58, 0x4b, 0xe7, 0x88, 0xef, 0xa7, 0x2c, 0x4a, 0x6d, 0x65, 0xa9, 0xea, 0xe8, 0x16,
+    0x6f, 0x4f, 0xe5, 0xc7, 0x51, 0x4d, 0x7e, 0xbf, 0x4f, 0xa6, 0x21, 0x56, 0x48, 0xf5, 0x76, 0xb4,
+    0x4c, 0x71, 0x50, 0x61, 0x52, 0xc2, 0x9c, 0xfe, 0xf9, 0x7f, 0xfe, 0xf7, 0xbf, 0xff, 0x9e, 0xd7,
+    0x09, 0xe0, 0x7f, 0xd3, 0xb2, 0x45, 0xed, 0x58, 0xd4, 0xbf, 0xa1, 0x11, 0xe7, 0x09, 0x6b, 0x03,
+    0xcd, 0x09, 0x9d, 0xae, 0x89, 0x92, 0xfe, 0xee, 0x5a, 0xd7, 0x34, 0xd7, 0xe4, 0x31, 0x82, 0xfc,
+    0x92, 0x77, 0x0b, 0xfc, 0x64, 0x21, 0xdb, 0x93, 0xcc, 0x9b, 0x57, 0xb7, 0xf3, 0x47, 0x23, 0x6d,
+    0xda, 0x31, 0x3b, 0xd6, 0x76, 0xf1, 0x38, 0x04, 0xcf, 0x53, 0x90, 0x6b, 0x31, 0xbf, 0xbe, 0xa0,
+    0x59, 0xad, 0x40, 0x55, 0x61, 0x28, 0x88, 0xf4, 0x91, 0x3a, 0x13, 0x7b, 0x60, 0x98, 0x46, 0x4b,
+    0x5e, 0x88, 0xb3, 0x4e, 0x15, 0x0e, 0xd5, 0x6a, 0x7d, 0x0a, 0xa2, 0x07, 0xbe, 0x05, 0x62, 0x8b,
+    0x59, 0x18, 0x2d, 0x41, 0x3a, 0x2c, 0x55, 0x93, 0xa5, 0x00, 0xab, 0x44, 0xcd, 0x55, 0x34, 0x4b,
+    0xb6, 0x47, 0x29, 0xb5, 0xeb, 0x57, 0xff, 0x05, 0x5a, 0xe5, 0x43, 0x98, 0x23, 0x07, 0x72, 0x98,
+    0x42, 0xc3, 0x32, 0xc8, 0x32, 0x27, 0x31, 0x2a, 0xb9, 0x88, 0xdb, 0x85, 0x99, 0xb1, 0xfd, 0x63,
+    0x8d, 0x04, 0xbe, 0x05, 0xbe, 0xed, 0x1d, 0xaf, 0x9f, 0xd8, 0x07, 0xc1, 0x04, 0x62, 0x95, 0x6d,
+    0xd4, 0xe2, 0x60, 0x66, 0x8d, 0x6b, 0xf5, 0xb5, 0xbd, 0x2b, 0xfc, 0x20, 0x8b, 0x4a, 0x3b, 0xeb,
+    0x02, 0xcf, 0xa7, 0x99, 0xc0, 0x67, 0x88, 0xff, 0x62, 0x16, 0x32, 0x72, 0xc5, 0xcb, 0x1c, 0x9f,
+    0x0e, 0x39, 0x7e, 0x41, 0xe4, 0x40, 0xb6, 0x4d, 0x44, 0xd6, 0xa4, 0x46, 0xff, 0xa9, 0x96, 0x0b,
+    0xf6, 0xe6, 0xb2, 0x6e, 0x7d, 0xc9, 0x22, 0x9c, 0xec, 0xf3, 0xac, 0x95, 0xe2, 0xbc, 0x49, 0x7b,
+    0x8a, 0xef, 0xf4, 0x36, 0xe1, 0x1f, 0xf8, 0x60, 0xf5, 0xba, 0x66, 0xd7, 0xac, 0x6f, 0x67, 0x84,
+    0x05, 0x48, 0x1d, 0x37, 0x9c, 0x70, 0x5a, 0x8d, 0xda, 0xad, 0xeb, 0xb8, 0x28, 0x2d, 0xfe, 0x95,
+    0xbc, 0x72, 0x8f, 0x5c, 0x32, 0x18, 0x5e, 0x74, 0x3b, 0x0f, 0x5b, 0x91, 0x55, 0x68, 0x64, 0xf6,
+    0xd6, 0xd3, 0xee, 0x26, 0xd2, 0x68, 0xf6, 0x36, 0x3b, 0xed, 0x1c, 0x8d, 0xb9, 0x05, 0x0d, 0x91,
+    0xb4, 0xb7, 0x13, 0xea, 0xfa, 0x73, 0x42, 0x4f, 0xe1, 0x5b, 0x15, 0xa1, 0x9f, 0xc2, 0xc9, 0xff,
+    0xc3, 0xbf, 0x90, 0x43, 0x3c, 0xf9, 0x22, 0xc7, 0x3e, 0x4f, 0xe3, 0xb0, 0x14, 0x50, 0xbd, 0xb8,
+    0x0f, 0x76, 0x50, 0xbc, 0x92, 0x7e, 0xca, 0xa2, 0x88, 0x5e, 0x2f, 0xe3, 0x5d, 0xc5, 0x81, 0xdc,
+    0x44, 0x8c, 0x5f, 0xb1, 0x7a, 0xf8, 0xb9, 0x7c, 0xec, 0x10, 0x0b, 0xf7, 0x55, 0xa9, 0x7c, 0x91,
+    0xfc, 0x48, 0x02, 0x68, 0xe8, 0x3f, 0x3e, 0x3b, 0x3a, 0xff, 0x21, 0xe9, 0x3f, 0xf2, 0x78, 0xd1,
+    0xe3, 0x24, 0xb8, 0x5e, 0x82, 0x03, 0x87, 0x0f, 0x86, 0xdc, 0xf5, 0xfa, 0xe3, 0xa4, 0x9f, 0xf9,
+    0x9a, 0x55, 0xd1, 0x9d, 0xc8, 0x0a, 0xdd, 0x69, 0x3c, 0x1f, 0xb7, 0xbe, 0x4e, 0xf6, 0xa7, 0x90,
+    0x86, 0xb2, 0x08, 0x6c, 0x84, 0x91, 0xe1, 0x70, 0x40, 0x40, 0x7a, 0x7e, 0x4c, 0x9a, 0xe2, 0x6f,
+    0xbc, 0xec, 0xdd, 0x13, 0x50, 0xe5, 0xf0, 0x9e, 0xc4, 0x63, 0x46, 0xd0, 0xfa, 0xa6, 0x11, 0x7c,
+    0xa4, 0x31, 0x3e, 0x89, 0xe6, 0x5f, 0x33, 0x3b, 0x45, 0xe6, 0xcc, 0x7c, 0x4b, 0x1c, 0x9f, 0x02,
+    0xca, 0x7b, 0x71, 0x66, 0x69, 0xe0, 0xd6, 0xaa, 0xd8, 0x37, 0x00, 0xb3, 0xce, 0x0f, 0x1b, 0x89,
+    0x60, 0x30, 0x37, 0xc0, 0x75, 0x88, 0x51, 0x9b, 0x1f, 0x2f, 0x0a, 0x54, 0x35, 0x02, 0xa6, 0xa9,
+    0x42, 0x27, 0x1a, 0x87, 0x7c, 0xd0, 0x74, 0x04, 0x11, 0x83, 0xc9, 0x2e, 0xb1, 0x03, 0x6b, 0x86,
+    0x85, 0xad, 0xd6, 0x35, 0x8b, 0x07, 0x1e, 0xaf, 0x71, 0x3d, 0xbb, 0x3f, 0xb6, 0xb3, 0x88, 0xe5,
+    0xb9, 0x65, 0xad, 0xd0, 0x2e, 0x21, 0x11, 0x4a, 0x54, 0x2d, 0x3c, 0x5b, 0x3f, 0x10, 0x2d, 0x6f,
+    0x88, 0x16, 0x28, 0x68, 0x15, 0x69, 0x23, 0xdf, 0x92, 0x9a, 0x64, 0x89, 0xd9, 0x35, 0xd2, 0x27,
+    0xb5, 0x43, 0x37, 0xb2, 0xd2, 0x0b, 0x95, 0xe8, 0xf9, 0x3a, 0x9f, 0xd1, 0x09, 0x03, 0xe4, 0xb5,
+    0xdc, 0x83, 0x0b, 0x35, 0xf2, 0x98, 0x18, 0xda, 0xf9, 0x72, 0xcf, 0x06, 0xf0, 0x39, 0xf3, 0x6d,
+    0xfd, 0x2a, 0xae, 0xb4, 0x32, 0xc9, 0x1c, 0xa0, 0xd5, 0xea, 0x2a, 0x8e, 0x71, 0x80, 0x38, 0x92,
+    0xdb, 0x7e, 0x54, 0x42, 0x0b, 0x0b, 0x9a, 0x29, 0x58, 0x2c, 0x3f, 0x6b, 0xa1, 0x92, 0xa0, 0x9e,
+    0x59, 0x0e, 0x82, 0x09, 0x86, 0x0c, 0xe4, 0x60, 0xab, 0xe7, 0xe7, 0xbb, 0x7e, 0xb9, 0x85, 0x07,
+    0x45, 0xb1, 0x71, 0x67, 0x15, 0x84, 0x1a, 0x3d, 0x49, 0xc6, 0x55, 0x28, 0x49, 0xb6, 0x24, 0xa0,
+    0x92, 0x24, 0xaa, 0x68, 0x96, 0xbc, 0x83, 0x20, 0x0c, 0x67, 0x53, 0x58, 0x6c, 0xb2, 0x07, 0x89,
+    0xb6, 0x4a, 0x45, 0xf1, 0x8f, 0x44, 0x58, 0x60, 0xb3, 0x76, 0x11, 0x04, 0xa1, 0x42, 0x49, 0xb2,
+    0x10, 0x7a, 0x2d, 0x29, 0xac, 0x7a, 0x19, 0xcd, 0x07, 0xc2, 0xbc, 0x88, 0x55, 0x52, 0xbc, 0x2a,
+    0xc1, 0xcf, 0x83, 0xc0, 0x7e, 0x28, 0xc1, 0x7a, 0x0a, 0x57, 0x22, 0x21, 0x2d, 0xc8, 0x7c, 0xb4,
+    0xe0, 0x7c, 0x9d, 0xdc, 0x16, 0x29, 0x3a, 0xc1, 0xc6, 0x34, 0xc3, 0x6c, 0x76, 0x4d, 0x32, 0x9d,
+    0x57, 0xd1, 0x44, 0x73, 0x1b, 0xec, 0x23, 0x43, 0x32, 0x62, 0x31, 0xe4, 0xfa, 0xe4, 0xc6, 0x8d,
+    0x90, 0x98, 0x5f, 0xf0, 0x48, 0x5f, 0xd7, 0xe8, 0x24, 0x16, 0x75, 0x00, 0xb7, 0x25, 0xd8, 0x3b,
+    0xa5, 0xf1, 0xb8, 0x35, 0x71, 0x7d, 0x43, 0x69, 0x02, 0xb0, 0xcb, 0x87, 0x39, 0x7f, 0x84, 0x3b,
+    0x3a, 0xde, 0x86, 0xb7, 0x8a, 0xa5, 0x17, 0x8b, 0x47, 0x60, 0x74, 0x3c, 0xbb, 0x6a, 0x89, 0xc6,
+    0xb0, 0xdd, 0x1c, 0x21, 0x8f, 0x49, 0xed, 0x9b, 0x82, 0x64, 0x0a, 0x52, 0x01, 0x89, 0xc8, 0x24,
+    0x95, 0xf7, 0x14, 0x28, 0xfc, 0xb8, 0x68, 0xa4, 0xe0, 0xad, 0x17, 0x95, 0x2e, 0x5c, 0x4b, 0x71,
+    0xb6, 0x13, 0x43, 0xed, 0x22, 0x32, 0x53, 0xac, 0x20, 0x89, 0x6c, 0x2f, 0x84, 0x1a, 0xaf, 0x18,
+    0xa1, 0xc0, 0x5b, 0x16, 0x82, 0x3c, 0xe2, 0xc7, 0x4d, 0xb9, 0xc6, 0xfd, 0x70, 0x61, 0x40, 0xfe,
+    0x79, 0xee, 0xe0, 0xfe, 0xfe, 0x90, 0xc5, 0x32, 0x58, 0x2c, 0x8c, 0x6a, 0x2c, 0x98, 0x54, 0x79,
+    0xaa, 0x4c, 0xab, 0x80, 0xca, 0x51, 0x01, 0xb4, 0x8a, 0xb5, 0x12, 0x21, 0x18, 0x52, 0x5e, 0x0f,
+    0x86, 0xa2, 0x65, 0x8d, 0x87, 0x93, 0xb3, 0xa0, 0xa6, 0x46, 0xb7, 0x4c, 0xc4, 0x52, 0xe2, 0x2f,
+    0x87, 0x2c, 0xa4, 0x58, 0x65, 0x65, 0xc3, 0x71, 0x70, 0xbb, 0x3e, 0x76, 0x6d, 0x46, 0xe6, 0x5d,
+    0x77, 0x44, 0x74, 0xc8, 0x69, 0xa4, 0x24, 0xbb, 0x96, 0x2b, 0xe3, 0x7e, 0xa1, 0x7f, 0xaf, 0xd2,
+    0xaf, 0x97, 0x18, 0xd0, 0xb9, 0x48, 0x9c, 0x3e, 0x00, 0xfb, 0x81, 0xa4, 0xcd, 0xa8, 0x0d, 0xce,
+    0x0e, 0x9b, 0xe7, 0x47, 0x4d, 0xde, 0x05, 0x78, 0x38, 0xb8, 0x1a, 0x1c, 0x5c, 0x0d, 0x0e, 0xbf,
+    0xe2, 0xdc, 0xb8, 0xfe, 0xb5, 0xa4, 0xb1, 0xd5, 0x6a, 0xa9, 0x66, 0x16, 0xad, 0x9e, 0x7c, 0x00,
+    0x17, 0xf0, 0x89, 0x1b, 0xc5, 0x2d, 0x6a, 0x03, 0xe1, 0xa2, 0x65, 0x57, 0x05, 0x53, 0xe9, 0x38,
+    0x4b, 0xc8, 0x42, 0x36, 0x09, 0x6e, 0x58, 0x25, 0x3e, 0x75, 0x6c, 0xc5, 0xbc, 0xba, 0x8f, 0x29,
+    0x2c, 0xc9, 0x28, 0x9b, 0xf4, 0x9f, 0x98, 0x28, 0x62, 0x72, 0x88, 0x2d, 0x74, 0x6e, 0x92, 0x14,
+    0x46, 0x4a, 0xb9, 0x82, 0x0c, 0xec, 0xe0, 0x96, 0xa7, 0x12, 0x83, 0x60, 0x22, 0x33, 0x99, 0xaf,
+    0x76, 0x75, 0x1a, 0xb9, 0x9c, 0xc0, 0x33, 0x6d, 0x89, 0x12, 0xe3, 0x81, 0xc8, 0x4b, 0xfb, 0xb5,
+    0x86, 0x0e, 0xb1, 0x5a, 0xf8, 0x4a, 0xf2, 0x74, 0xc4, 0x2d, 0x2b, 0x3b, 0x91, 0x33, 0x61, 0x08,
+    0x70, 0x47, 0x10, 0x15, 0xf8, 0x16, 0x25, 0xd1, 0x55, 0x03, 0x63, 0xc4, 0x24, 0x18, 0xb9, 0xc9,
+    0x8d, 0x6b, 0x50, 0x12, 0x5d, 0x7c, 0xe0, 0x03, 0x64, 0xe3, 0xa5, 0x3e, 0x6b, 0xc9, 0xf5, 0x61,
+    0x2a, 0x33, 0xc0, 0x04, 0xcd, 0xd2, 0x4e, 0xe1, 0xea, 0xf2, 0xc5, 0x80, 0xfc, 0xf1, 0x5f, 0xff,
+    0x86, 0xdb, 0xeb, 0xd1, 0xfe, 0xc9, 0x70, 0x50, 0xab, 0x42, 0x2b, 0x82, 0x89, 0x78, 0x4a, 0xa6,
+    0x0a, 0x2d, 0xb6, 0xb1, 0x72, 0x94, 0x5f, 0x3b, 0xa6, 0x59, 0x8a, 0x31, 0x4b, 0x39, 0xf0, 0x42,
+    0xff, 0x68, 0xc9, 0x87, 0xfb, 0xec, 0x16, 0xf3, 0x42, 0x66, 0xc0, 0x8d, 0xe0, 0x24, 0xc0, 0xb0,
+    0x7c, 0x05, 0x83, 0x87, 0x31, 0x76, 0x72, 0x1a, 0x45, 0xcf, 0x83, 0x5e, 0x47, 0xb4, 0x39, 0xc9,
+    0x07, 0x91, 0x0c, 0x3f, 0x20, 0xfc, 0x71, 0xcd, 0xd4, 0x9f, 0xc3, 0xb6, 0x08, 0x9f, 0x81, 0x49,
+    0xfa, 0x65, 0xeb, 0x8a, 0x60, 0x27, 0xfa, 0x96, 0x78, 0xbf, 0x4e, 0xa5, 0x6b, 0x17, 0xb9, 0xb6,
+    0x98, 0x90, 0x8f, 0x4e, 0x61, 0x13, 0xb5, 0xcd, 0xa2, 0x6a, 0x10, 0xde, 0x51, 0xab, 0x58, 0x4f,
+    0x2d, 0x9e, 0x4e, 0x1e, 0x4f, 0xe7, 0xa1, 0x78, 0xba, 0x79, 0x3c, 0xdd, 0x0a, 0x3c, 0x05, 0x0b,
+    0xe0, 0x02, 0x41, 0x4f, 0xbf, 0x58, 0x1a, 0xfa, 0x7d, 0x49, 0xda, 0xcc, 0xa4, 0xd9, 0x96, 0x24,
+    0xe8, 0xb7, 0x57, 0xc4, 0xc9, 0x9b, 0x4a, 0xf4, 0x38, 0x79, 0xa3, 0x0a, 0xa6, 0x3f, 0x7f, 0xf8,
+    0xfd, 0xc2, 0xfc, 0x27, 0x6d, 0x02, 0x22, 0x1c, 0xa9, 0x42, 0x6f, 0x1a, 0x8b, 0xd4, 0x26, 0xed,
+    0x0b, 0xe2, 0xf3, 0x2e, 0x91, 0x13, 0x00, 0x80, 0x20, 0xb1, 0xc2, 0x19, 0x14, 0x9a, 0x8d, 0x94,
+    0xd1, 0x4e, 0xa2, 0x51, 0x89, 0x21, 0x4f, 0x93, 0x52, 0x16, 0x39, 0x14, 0xcb, 0x26, 0xfc, 0x65,
+    0x01, 0xa6, 0x1d, 0x48, 0xbc, 0xd9, 0xfa, 0x01, 0xe2, 0x4b, 0x5a, 0x6b, 0x96, 0x95, 0x1e, 0x8c,
+    0x5f, 0x28, 0xbd, 0x7c, 0xfb, 0x91, 0x4a, 0x78, 0x09, 0x16, 0x95, 0xf0, 0x72, 0x14, 0x69, 0x65,
+    0x97, 0x62, 0xa8, 0x92, 0x9d, 0x9e, 0x87, 0x43, 0x37, 0x5c, 0x8a, 0x83, 0xb4, 0xe1, 0x48, 0xc3,
+    0x05, 0xe0, 0xa9, 0xe2, 0x21, 0x6d, 0x74, 0xaa, 0xc8, 0x96, 0x4a, 0x63, 0xc9, 0x2e, 0xc4, 0xf5,
+    0xda, 0xc9, 0xe0, 0xe8, 0xaa, 0xa6, 0x8b, 0xe3, 0x72, 0xe6, 0x85, 0x1b, 0x34, 0x99, 0xae, 0x2c,
+    0xde, 0xd8, 0x6a, 0x88, 0xb8, 0x3c, 0x7e, 0xfe, 0xdd, 0xc7, 0x53, 0xa1, 0xdf, 0x26, 0x56, 0xe5,
+    0x60, 0x8b, 0xb0, 0x2b, 0xb7, 0x9d, 0xd5, 0xd6, 0x92, 0x36, 0x6c, 0x3d, 0xd4, 0x5a, 0x78, 0xef,
+    0xce, 0x70, 0xca, 0x98, 0x7d, 0xf9, 0x30, 0xa7, 0x2c, 0x9b, 0xb2, 0xd4, 0xde, 0x33, 0x83, 0x1d,
+    0xf5, 0x9e, 0xb7, 0x00, 0xd5, 0xb6, 0x57, 0x45, 0xee, 0x2d, 0x42, 0x7e, 0xf2, 0x11, 0xc8, 0x93,
+    0xb6, 0xa5, 0xaa, 0x39, 0xe4, 0x90, 0x07, 0xcd, 0x92, 0xb4, 0x12, 0xa9, 0xf1, 0x27, 0x77, 0x25,
+    0xea, 0x85, 0xde, 0x51, 0x9c, 0x15, 0xb8, 0xbe, 0x13, 0x28, 0xa2, 0x2b, 0xe4, 0xaa, 0xfc, 0xbe,
+    0xac, 0xf1, 0x3f, 0x6c, 0x3d, 0x73, 0x65, 0x7f, 0x7d, 0xf9, 0x2f, 0x3b, 0xd1, 0xf6, 0xaa, 0xd8,
+    0x93, 0xaa, 0xfc, 0x02, 0xf4, 0x49, 0xb5, 0x7f, 0x91, 0x50, 0x64, 0x55, 0x1d, 0xb6, 0x00, 0x90,
+    0xb9, 0x78, 0x01, 0xb5, 0x89, 0x13, 0xc2, 0x36, 0x19, 0x4b, 0xd4, 0xd8, 0x86, 0x60, 0x50, 0x07,
+    0x0b, 0x2f, 0xf8, 0x35, 0x9c, 0xf9, 0x0a, 0x1b, 0x10, 0x85, 0x76, 0xd8, 0xd1, 0x3c, 0xbb, 0x8f,
+    0xd9, 0x32, 0xa5, 0xe5, 0x14, 0xa0, 0xca, 0xe3, 0xce, 0xcb, 0xf7, 0x95, 0x5b, 0xcb, 0x14, 0xd7,
+    0x81, 0xd8, 0x91, 0x32, 0x9d, 0x6f, 0x4a, 0x07, 0x42, 0x30, 0x86, 0x0d, 0xc3, 0x77, 0x57, 0xa7,
+    0x27, 0xe8, 0x40, 0x76, 0x28, 0x19, 0x87, 0xcc, 0xd9, 0x5d, 0x5b, 0xa7, 0x53, 0x77, 0x5d, 0x0c,
+    0xc2, 0x23, 0x83, 0xbd, 0xcb, 0x99, 0xcf, 0xb7, 0xe0, 0xf9, 0x59, 0xf0, 0x2a, 0xea, 0x9a, 0x01,
+    0xb7, 0x94, 0xd3, 0xa8, 0xff, 0xf0, 0x12, 0x14, 0x3f, 0x6c, 0x2b, 0x50, 0xcd, 0x45, 0x46, 0xd6,
+    0x49, 0xdb, 0xec, 0x6c, 0xd4, 0x39, 0xe6, 0x9f, 0x3c, 0xab, 0xef, 0xac, 0xd3, 0xbd, 0x25, 0x5c,
+    0x74, 0x8a, 0x04, 0x92, 0xa6, 0xa5, 0x99, 0x2f, 0x54, 0xfe, 0xe6, 0xa0, 0x90, 0x8f, 0xe3, 0x21,
+    0x9e, 0x2f, 0x57, 0x1f, 0x56, 0x7e, 0x15, 0x12, 0xae, 0x20, 0x5c, 0x78, 0x55, 0xc5, 0x4f, 0x2d,
+    0x05, 0x97, 0xcc, 0x62, 0xee, 0x0d, 0xee, 0xe8, 0xab, 0x44, 0x9a, 0x11, 0x60, 0xdb, 0xc4, 0x72,
+    0x9d, 0x5a, 0x8c, 0x0a, 0xa2, 0xea, 0xaa, 0xc2, 0xdb, 0xc2, 0x58, 0xa3, 0x25, 0x17, 0x0f, 0x8d,
+    0x1e, 0x10, 0x68, 0xd0, 0x90, 0xb0, 0xdf, 0x82, 0x3f, 0x0e, 0x37, 0xa1, 0xd3, 0xb2, 0x15, 0xe1,
+    0xdd, 0x97, 0xd4, 0x73, 0xab, 0xab, 0x58, 0xfc, 0x38, 0x08, 0xfb, 0x3b, 0xc4, 0x61, 0xd0, 0xc2,
+    0x72, 0xe2, 0xc5, 0x31, 0x1e, 0xee, 0xbe, 0x23, 0x13, 0x06, 0x1b, 0x35, 0x0b, 0xf6, 0x61, 0xa2,
+    0xc2, 0xd0, 0x36, 0x49, 0x24, 0xf7, 0xe8, 0x75, 0xe5, 0x3e, 0xe3, 0xdd, 0x15, 0x36, 0xf8, 0x2c,
+    0x26, 0x05, 0x9b, 0xd5, 0x4e, 0x05, 0x6e, 0x35, 0x45, 0x0a, 0xda, 0xf2, 0x67, 0x5b, 0x25, 0x0c,
+    0xc5, 0x87, 0xe5, 0x2b, 0xb6, 0x1e, 0xa2, 0x33, 0x4d, 0xe3, 0x06, 0xe1, 0x8e, 0x2c, 0xbd, 0xc2,
+    0x8e, 0xf5, 0xc8, 0xbd, 0x63, 0xb6, 0xd1, 0x51, 0x2a, 0x43, 0xf5, 0x0c, 0xb2, 0x49, 0xac, 0xf2,
+    0x3c, 0x65, 0xde, 0x8a, 0x86, 0x16, 0xbc, 0x3e, 0xf7, 0x1b, 0xf2, 0x7e, 0xda, 0x9e, 0x66, 0xaf,
+    0x32, 0xb3, 0xe8, 0xe3, 0x52, 0x4f, 0x6c, 0x61, 0x6f, 0xd8, 0x90, 0xf7, 0x71, 0x91, 0x6f, 0x33,
+    0x97, 0x44, 0xb7, 0xd8, 0x69, 0x24, 0x02, 0x62, 0x24, 0x6b, 0x8f, 0x49, 0xcb, 0x57, 0x81, 0x71,
+    0x30, 0x7b, 0x48, 0xaa, 0x6e, 0xb1, 0x30, 0x53, 0xc3, 0x86, 0xae, 0x5c, 0xb2, 0x05, 0xd4, 0xae,
+    0x47, 0x30, 0x86, 0xc6, 0xa0, 0x3c, 0xd4, 0x5f, 0x9f, 0xd0, 0x3b, 0x40, 0xf8, 0x57, 0x7e, 0xad,
+    0xf8, 0xd0, 0x7f, 0x48, 0x0c, 0xe1, 0xd6, 0x63, 0x2c, 0xda, 0x26, 0xbb, 0x3e, 0xa1, 0x40, 0x2a,
+    0xbd, 0xe1, 0x33, 0x3e, 0xde, 0x25, 0xb0, 0x2c, 0x30, 0x04, 0x44, 0x64, 0x0f, 0xd0, 0xaa, 0xb9,
+    0xfb, 0x8b, 0x5b, 0x38, 0x6f, 0xba, 0x5e, 0xed, 0x3a, 0xde, 0x1e, 0xc6, 0x34, 0x8c, 0x8d, 0xad,
+    0x7a, 0x85, 0x7b, 0x88, 0x5b, 0xf8, 0x48, 0xb3, 0x6f, 0xdd, 0x9f, 0x02, 0xa9, 0xa7, 0x91, 0x12,
+    0xc1, 0xd3, 0x7a, 0x66, 0x75, 0xe6, 0x00, 0xf4, 0x4e, 0x48, 0xab, 0xc4, 0xd9, 0x87, 0x15, 0x96,
+    0x8a, 0xb7, 0xc3, 0x95, 0x56, 0x0a, 0x39, 0xdd, 0x56, 0x59, 0x00, 0x66, 0x9e, 0x58, 0x64, 0x9b,
+    0xe0, 0x6b, 0x86, 0xe6, 0x7d, 0x4c, 0x58, 0x9f, 0x65, 0xc2, 0xfd, 0xf2, 0x68, 0x04, 0xb7, 0x09,
+    0x64, 0x50, 0x3e, 0xda, 0x2c, 0x8f, 0xbf, 0x7c, 0x60, 0xa9, 0x2c, 0x28, 0xa4, 0x7f, 0xba, 0x7f,
+    0xf1, 0xf6, 0xe0, 0xfc, 0xe4, 0xfc, 0x72, 0x08, 0x33, 0xbf, 0xbf, 0x1c, 0x1c, 0xf2, 0x72, 0x10,
+    0xef, 0x31, 0xa9, 0x35, 0xc8, 0xf3, 0xcb, 0xc1, 0xe0, 0x0c, 0xaf, 0x88, 0x87, 0xdb, 0xe1, 0xca,
+    0xb3, 0x93, 0x17, 0x03, 0x7e, 0x81, 0xbf, 0x8d, 0x88, 0x5f, 0xd8, 0x3f, 0xf8, 0x09, 0x5e, 0x11,
+    0x4f, 0xf4, 0xd7, 0x3e, 0xcc, 0x49, 0x47, 0x45, 0x01, 0x62, 0xf8, 0xb9, 0x20, 0x20, 0x47, 0x57,
+    0xd5, 0x27, 0xef, 0x6f, 0xd0, 0x5b, 0xf5, 0x45, 0xf5, 0xe2, 0x43, 0x83, 0x37, 0x91, 0x44, 0x7d,
+    0xf2, 0xe6, 0xfb, 0x32, 0xe0, 0x11, 0x8b, 0xad, 0x31, 0x68, 0xea, 0x2e, 0x69, 0xb6, 0xb7, 0x15,
+    0x8e, 0xc0, 0x0e, 0xe9, 0xed, 0x29, 0x9d, 0x1a, 0xf5, 0xd2, 0x6b, 0xa8, 0xf8, 0x49, 0xb4, 0xe8,
+    0xd3, 0xab, 0xc8, 0x15, 0x92, 0xf6, 0xbd, 0x5a, 0xe9, 0x15, 0x18, 0x1c, 0x3e, 0xbe, 0x03, 0x60,
+    0x81, 0x05, 0x41, 0xf9, 0x02, 0xdd, 0xc5, 0x46, 0xad, 0x63, 0x97, 0x00, 0xe2, 0x3b, 0xb0, 0x23,
+    0x46, 0x43, 0x88, 0x4a, 0xb1, 0x61, 0x36, 0x08, 0xfc, 0x2b, 0x01, 0xe5, 0xab, 0x5e, 0xe5, 0x37,
+    0xd1, 0x1a, 0xa8, 0x9c, 0x8e, 0xe7, 0xba, 0x48, 0xae, 0x94, 0x18, 0xaf, 0x81, 0x44, 0x2d, 0xf8,
+    0x66, 0x18, 0x10, 0x8d, 0x76, 0xf7, 0xc8, 0x1b, 0xaf, 0x75, 0x07, 0xf2, 0x6a, 0xdd, 0x7f, 0x5f,
+    0x40, 0x80, 0xde, 0x37, 0x81, 0x42, 0x21, 0xb7, 0xb8, 0x88, 0xeb, 0x12, 0x65, 0x6b, 0x3a, 0x8b,
+    0xc6, 0xc6, 0x9b, 0xdc, 0x00, 0xc0, 0x93, 0xfb, 0x5e, 0x42, 0x99, 0x03, 0x45, 0x86, 0x8a, 0x03,
+    0x30, 0x01, 0x74, 0x63, 0x51, 0x79, 0x8e, 0xc7, 0x18, 0x87, 0x23, 0xc6, 0xfc, 0x06, 0x79, 0x7c,
+    0x47, 0x42, 0x9e, 0x17, 0x62, 0xc4, 0x7a, 0x7c, 0x0f, 0xa9, 0x61, 0x83, 0x80, 0x2f, 0x00, 0xe1,
+    0x00, 0x8f, 0x6d, 0x32, 0x21, 0xd4, 0x0a, 0xc1, 0xc5, 0x96, 0x1c, 0x0a, 0xef, 0xbf, 0xd8, 0xc5,
+    0x93, 0x34, 0x53, 0x49, 0x09, 0x38, 0x8c, 0x01, 0xb5, 0xc6, 0x86, 0xf1, 0x06, 0x68, 0x07, 0x72,
+    0x51, 0x20, 0xef, 0x13, 0x28, 0x71, 0x54, 0x47, 0xef, 0x0c, 0xfc, 0xde, 0x20, 0x9d, 0x56, 0x07,
+    0x42, 0x3d, 0xbf, 0x48, 0x47, 0x91, 0x71, 0x57, 0x2f, 0x5d, 0xba, 0xaf, 0xe3, 0x4b, 0x2f, 0x94,
+    0xeb, 0x20, 0x8e, 0x0e, 0x77, 0x73, 0xeb, 0x07, 0xd6, 0x8f, 0x98, 0x95, 0xcb, 0x86, 0x4a, 0x02,
+    0x53, 0x20, 0x3d, 0x05, 0x90, 0x0e, 0xf8, 0x87, 0x3b, 0x98, 0x95, 0x63, 0x54, 0xc2, 0xe2, 0xf1,
+    0x37, 0xd0, 0x92, 0x81, 0x15, 0x0a, 0xc2, 0x81, 0x9b, 0xe4, 0x5e, 0x0d, 0x9c, 0x57, 0x90, 0x54,
+    0x30, 0x42, 0x49, 0x14, 0xc9, 0x33, 0x28, 0x27, 0x9e, 0x32, 0x0e, 0xb1, 0x2a, 0x8c, 0xc2, 0x4a,
+    0x2d, 0x1e, 0x14, 0x8a, 0xd7, 0xf5, 0xbe, 0x27, 0xbf, 0xfc, 0x25, 0x18, 0xb0, 0x78, 0x25, 0x8d,
+    0xaa, 0x53, 0x42, 0x62, 0xe0, 0xda, 0x3d, 0xbd, 0x33, 0x40, 0x0f, 0xeb, 0x40, 0x5e, 0xb7, 0x01,
+    0x1c, 0xc0, 0x97, 0x7b, 0xf9, 0x65, 0x13, 0xfe, 0x2d, 0x06, 0xf2, 0x25, 0x35, 0x55, 0x97, 0xf2,
+    0x8f, 0x33, 0xf6, 0xc0, 0xc7, 0xe3, 0x1b, 0x07, 0x50, 0xd9, 0xe4, 0x5a, 0x42, 0x9e, 0x02, 0x49,
+    0xf0, 0x96, 0xa9, 0xa6, 0x39, 0x8a, 0xc3, 0xe0, 0x1d, 0x4b, 0xf8, 0x06, 0x0f, 0x65, 0x59, 0x4f,
+    0x37, 0x46, 0x1a, 0x06, 0x51, 0x9a, 0xaf, 0xe4, 0xf9, 0x6b, 0x47, 0x3d, 0x64, 0xc4, 0xae, 0x5d,
+    0xff, 0x02, 0xe6, 0x35, 0xea, 0xea, 0x01, 0x34, 0xb4, 0x50, 0x3e, 0x79, 0x53, 0xab, 0x73, 0x31,
+    0xe5, 0xcd, 0x0d, 0xae, 0xf5, 0xb8, 0x97, 0xe8, 0xcc, 0x39, 0xd1, 0xe0, 0xc4, 0xf3, 0xa2, 0xab,
+    0x60, 0x49, 0xb4, 0x75, 0x3d, 0x6f, 0x4a, 0x1c, 0xa0, 0xa1, 0xed, 0x94, 0x04, 0x2b, 0x88, 0x8c,
+    0xb1, 0x12, 0x2d, 0xac, 0xef, 0x7c, 0x58, 0xe4, 0xfa, 0x30, 0xac, 0x5e, 0x25, 0x72, 0x63, 0xf5,
+    0x7c, 0x6e, 0x9e, 0x9c, 0x16, 0x94, 0x61, 0xde, 0x33, 0x91, 0x64, 0xba, 0x2b, 0x6d, 0xac, 0x11,
+    0xaa, 0x14, 0x61, 0x6b, 0xb8, 0x0f, 0x2b, 0xed, 0xae, 0x70, 0xe8, 0x4f, 0x79, 0xb4, 0x6f, 0x68,
+    0x37, 0x15, 0x2a, 0x98, 0xd7, 0x1c, 0xa6, 0x4e, 0x26, 0x93, 0x46, 0x26, 0x85, 0x83, 0x1b, 0xdf,
+    0x49, 0x65, 0xd5, 0xd5, 0x1e, 0xb3, 0x52, 0xc6, 0x00, 0x29, 0x23, 0x63, 0x1c, 0xce, 0x58, 0x83,
+    0xdc, 0xf5, 0xe7, 0x88, 0x7e, 0x0a, 0x2e, 0x2f, 0xf3, 0xf5, 0x75, 0x83, 0x48, 0x3b, 0xe8, 0x97,
+    0x26, 0xfb, 0xf0, 0xa0, 0x6c, 0x24, 0xdf, 0x18, 0xad, 0x49, 0x5a, 0x61, 0x12, 0x7c, 0x76, 0x58,
+    0x24, 0x89, 0xdc, 0xf9, 0xa8, 0xe5, 0x94, 0x8e, 0x7e, 0x45, 0x3d, 0x4f, 0x8c, 0xbe, 0xc5, 0x4f,
+    0xf3, 0x93, 0x69, 0x98, 0x8e, 0x63, 0x3a, 0x75, 0xa3, 0x48, 0x1c, 0x45, 0xf1, 0x9d, 0x31, 0x51,
+    0xdd, 0xe4, 0x19, 0x29, 0xff, 0x58, 0x4f, 0x8f, 0xab, 0x95, 0xfa, 0x91, 0xc0, 0xf1, 0xe3, 0xcc,
+    0x79, 0xf6, 0xa0, 0xd2, 0x96, 0x5c, 0x6e, 0x91, 0x03, 0x2e, 0x2f, 0x92, 0x83, 0x03, 0x8d, 0x5a,
+    0x92, 0x59, 0xa1, 0x6c, 0x20, 0xb7, 0x32, 0x8c, 0x90, 0xbb, 0xdb, 0xb0, 0xf5, 0xb3, 0x28, 0xf0,
+    0x8d, 0x7a, 0x72, 0x15, 0x46, 0xc8, 0xd0, 0x34, 0x4f, 0x7c, 0xe0, 0xd3, 0xf6, 0x3c, 0x57, 0xc1,
+    0xb8, 0xa3, 0x54, 0xad, 0x16, 0x64, 0xfa, 0xe8, 0xc7, 0x99, 0x88, 0x07, 0xf2, 0x84, 0x95, 0x85,
+    0x21, 0x1e, 0x04, 0x01, 0xa8, 0xa0, 0x04, 0xf2, 0x26, 0xd7, 0x83, 0x94, 0xbc, 0x41, 0x58, 0xd1,
+    0x06, 0xb5, 0x3b, 0xd3, 0xf9, 0xdc, 0x8b, 0xad, 0x12, 0xe2, 0xfa, 0x33, 0xd7, 0xa7, 0xb0, 0xd9,
+    0x93, 0x67, 0xcb, 0xfc, 0x2d, 0x54, 0xc4, 0x38, 0xa4, 0xd1, 0x78, 0x14, 0xd0, 0xd0, 0x16, 0x87,
+    0xb2, 0x47, 0xfc, 0x2a, 0x6c, 0xf3, 0x30, 0xbf, 0x8c, 0xde, 0x21, 0x65, 0xe8, 0x25, 0x26, 0x58,
+    0xf6, 0x9c, 0x20, 0x1f, 0xe4, 0x70, 0x7f, 0xf8, 0xdd, 0xb3, 0xf3, 0xfd, 0xcb, 0xc3, 0xb7, 0x47,
+    0x97, 0xfb, 0xa7, 0x83, 0xb7, 0x2f, 0x07, 0x97, 0xc3, 0xe3, 0xf3, 0xb3, 0x42, 0xfa, 0x39, 0xbc,
+    0xda, 0xbf, 0x7a, 0x31, 0xcc, 0x0f, 0xc1, 0x34, 0x60, 0xbb, 0x38, 0xee, 0xf5, 0xf0, 0x6a, 0x70,
+    0xfa, 0xf6, 0x0c, 0x86, 0x61, 0xa2, 0xfa, 0xa6, 0x76, 0x7c, 0x78, 0x32, 0x40, 0x3b, 0x3d, 0xd8,
+    0x3f, 0x39, 0x7e, 0x76, 0xb9, 0x7f, 0x05, 0x70, 0xf8, 0x15, 0x4f, 0xfd, 0xf1, 0xef, 0xe1, 0xf9,
+    0xb0, 0xf6, 0x7d, 0x11, 0x09, 0x8f, 0x7a, 0x19, 0x1c, 0xaf, 0xbe, 0x3b, 0xbe, 0xe2, 0xa3, 0x21,
+    0xed, 0xc5, 0xbf, 0x78, 0xb6, 0x8b, 0x1f, 0x30, 0xc9, 0x15, 0x7f, 0x43, 0x6e, 0x5b, 0xc6, 0x73,
+    0xb6, 0xff, 0xf2, 0xe0, 0xfc, 0x2c, 0x83, 0xe8, 0xe8, 0xfc, 0xf2, 0x15, 0x72, 0x3a, 0x3c, 0xd8,
+    0xe7, 0xf0, 0xc3, 0xab, 0xf3, 0x0b, 0x81, 0x17, 0x59, 0x1a, 0x24, 0x97, 0xde, 0x3e, 0x1b, 0xc0,
+    0xc8, 0xc1, 0xdb, 0xcb, 0x73, 0xe0, 0x5a, 0x4c, 0x2c, 0x3f, 0x2d, 0xa8, 0x09, 0xd5, 0x06, 0x2f,
+    0xf7, 0x4f, 0x5e, 0xc0, 0x48, 0x08, 0xdc, 0x97, 0x97, 0x83, 0x83, 0x84, 0xdb, 0x83, 0xcb, 0xf3,
+    0xe1, 0xf0, 0xf8, 0xec, 0xf9, 0xdb, 0x93, 0xe3, 0xb3, 0x41, 0x99, 0xce, 0x21, 0x4e, 0x7f, 0x7c,
+    0xf5, 0x3a, 0x2b, 0xb6, 0xb3, 0xa3, 0x73, 0x84, 0x04, 0x72, 0x39, 0x86, 0xc1, 0xe5, 0xe5, 0xf9,
+    0x25, 0x42, 0x96, 0xdd, 0xb2, 0x68, 0x8c, 0x7e, 0x31, 0xc5, 0xc3, 0x5d, 0x23, 0xe2, 0x4d, 0x4f,
+    0x91, 0x3a, 0xd3, 0x86, 0xbd, 0x12, 0x26, 0x32, 0x3e, 0x57, 0x5c, 0x79, 0xb4, 0xeb, 0x67, 0xb6,
+    0x50, 0x1d, 0x98, 0xc8, 0x2c, 0xda, 0x6d, 0xc8, 0xe2, 0x59, 0xe8, 0x23, 0xac, 0xc1, 0x9d, 0xaa,
+    0xe3, 0x05, 0xa0, 0xe8, 0x72, 0x1e, 0xec, 0xae, 0xda, 0x34, 0xcd, 0x3a, 0xf9, 0x86, 0xc8, 0x02,
+    0x57, 0x1f, 0xfd, 0x83, 0x76, 0xf0, 0x26, 0x1f, 0x8a, 0xff, 0xcf, 0x0e, 0x4d, 0xee, 0xf3, 0x3b,
+    0xba, 0x1d, 0xd5, 0x33, 0x1a, 0xb1, 0xcd, 0x0d, 0xa9, 0xe6, 0xcd, 0x3d, 0xa1, 0xd0, 0xf8, 0x39,
+    0x18, 0xfd, 0x0c, 0xf2, 0x1d, 0x12, 0x8d, 0x29, 0x6c, 0x71, 0x69, 0xc4, 0x6f, 0xfc, 0xf9, 0x10,
+    0xd4, 0x53, 0xb4, 0xe5, 0x36, 0x48, 0x14, 0xe4, 0xda, 0x6c, 0xeb, 0x90, 0x01, 0x87, 0x37, 0xe0,
+    0x7f, 0x46, 0x41, 0x3c, 0x56, 0x6c, 0x56, 0x80, 0x18, 0x9b, 0x65, 0xac, 0xc7, 0x40, 0x87, 0x6b,
+    0x97, 0x1d, 0x94, 0xec, 0xa5, 0xe1, 0xa5, 0xa9, 0x5d, 0xf2, 0x02, 0xb2, 0xdf, 0xad, 0xfd, 0x30,
+    0xa4, 0xf7, 0x2d, 0xdc, 0xe1, 0x19, 0x34, 0x0e, 0x46, 0x29, 0x64, 0x03, 0xf6, 0xd0, 0xc2, 0x5b,
+    0xb4, 0xf0, 0x37, 0x29, 0x0e, 0xe0, 0xe2, 0x3e, 0xec, 0x3f, 0xea, 0xca, 0xc4, 0x16, 0x7f, 0x94,
+    0x62, 0x7e, 0x22, 0x4f, 0x5f, 0xc2, 0x57, 0x83, 0xcf, 0xd2, 0x1a, 0xcd, 0x1c, 0x87, 0x85, 0x0a,
+    0xbf, 0x8a, 0x20, 0x18, 0x2b, 0x38, 0x11, 0x80, 0x97, 0xbb, 0x56, 0x95, 0xc9, 0x2a, 0x37, 0xec,
+    0x62, 0x81, 0xfd, 0x99, 0xe7, 0x55, 0xc5, 0xa4, 0xa4, 0xb6, 0x4b, 0xaf, 0x91, 0xdd, 0xfc, 0x8c,
+    0x6d, 0xf5, 0xc6, 0x4c, 0x36, 0x36, 0x18, 0x28, 0x04, 0xce, 0x7e, 0xc6, 0xb0, 0xdf, 0xe0, 0x45,
+    0x91, 0xd0, 0xbe, 0x38, 0xfb, 0xc9, 0xd9, 0xf9, 0xab, 0xb3, 0x9a, 0x0a, 0x87, 0x3d, 0x3f, 0x9f,
+    0x2a, 0xcc, 0xd9, 0xe9, 0x29, 0x27, 0xe5, 0x29, 0x14, 0x16, 0x3b, 0x4a, 0xe3, 0x37, 0xd4, 0xe3,
+    0x61, 0xbf, 0x23, 0x9e, 0x50, 0x29, 0x40, 0x74, 0x3b, 0xc6, 0x46, 0x83, 0xc7, 0x78, 0xb5, 0x41,
+    0x28, 0x53, 0xe1, 0x5c, 0xe7, 0x71, 0x9f, 0x18, 0x42, 0x5c, 0x7f, 0x46, 0xcc, 0x3b, 0xb3, 0x2d,
+    0x56, 0xc5, 0x2c, 0xfb, 0x90, 0x52, 0xcf, 0x47, 0x1e, 0xb0, 0xa3, 0x05, 0x14, 0x6d, 0x06, 0xa8,
+    0x24, 0xdf, 0x31, 0xaf, 0x00, 0xb5, 0xa1, 0x85, 0x9a, 0xc8, 0x43, 0x31, 0x35, 0xdc, 0x96, 0x16,
+    0x2e, 0x3d, 0x32, 0x54, 0xc1, 0xb5, 0x4d, 0x2d, 0x5c, 0x7a, 0x38, 0xae, 0x04, 0xec, 0xe8, 0x01,
+    0xe7, 0x7d, 0xd4, 0xfd, 0xe2, 0xca, 0x6c, 0xc9, 0x95, 0x81, 0x94, 0x24, 0xe7, 0xfe, 0xe6, 0xab,
+    0x59, 0xe7, 0xa5, 0x31, 0xdc, 0xf6, 0x2a, 0xbc, 0x76, 0x5a, 0xd7, 0xc3, 0xda, 0x34, 0xca, 0x5b,
+    0x83, 0x5e, 0x0b, 0x99, 0x36, 0x04, 0x97, 0x40, 0xdb, 0x9d, 0x45, 0xb0, 0x69, 0x6b, 0x6a, 0x1e,
+    0xb6, 0xbd, 0x69, 0xb4, 0x37, 0xb5, 0xb0, 0x99, 0xb6, 0xcd, 0x7e, 0x2e, 0xc8, 0xbe, 0x29, 0x58,
+    0xe2, 0x56, 0x3d, 0x6f, 0x54, 0x65, 0x54, 0x99, 0x4e, 0xcd, 0x7e, 0x2e, 0x44, 0x16, 0x51, 0x3d,
+    0x5d, 0x88, 0x2a, 0xdb, 0x77, 0xd3, 0x17, 0xf6, 0x5e, 0xf0, 0x45, 0xb0, 0xbc, 0x75, 0x1d, 0x5c,
+    0xa7, 0x0a, 0xae, 0xad, 0x87, 0xeb, 0x56, 0xc1, 0x75, 0x54, 0x70, 0x69, 0xeb, 0x4b, 0xbf, 0xe8,
+    0x14, 0xba, 0x75, 0x7e, 0xf0, 0x6d, 0xde, 0x1d, 0x1d, 0x61, 0x7a, 0x8b, 0xef, 0x13, 0xc1, 0xec,
+    0x55, 0x89, 0xba, 0xab, 0x43, 0x8d, 0xfe, 0xa6, 0x9f, 0xf1, 0x3c, 0x0a, 0x84, 0x46, 0xfe, 0x2e,
+    0xbf, 0xb5, 0xff, 0xf2, 0xf8, 0xf9, 0xfe, 0xb3, 0x13, 0x7e, 0x1f, 0x02, 0xfd, 0xc9, 0x49, 0xad,
+    0x5e, 0x61, 0x75, 0xe9, 0x2b, 0x54, 0xb2, 0x3e, 0x11, 0x70, 0x75, 0x10, 0x17, 0x6f, 0x1e, 0xc0,
+    0x69, 0xf2, 0xf7, 0xba, 0x78, 0x4f, 0x9c, 0xe9, 0x97, 0x6f, 0x9a, 0x59, 0xfa, 0xd2, 0x45, 0xd6,
+    0xf1, 0x28, 0x5e, 0x47, 0x53, 0xd4, 0xd8, 0x4e, 0xa2, 0xb1, 0xfc, 0x8c, 0xab, 0xc2, 0xf6, 0x35,
+    0xe0, 0x7a, 0x43, 0xcb, 0x75, 0x85, 0x94, 0x00, 0xbb, 0xa6, 0x16, 0x30, 0x39, 0x33, 0x2e, 0xc3,
+    0xe8, 0x2d, 0x33, 0x73, 0x10, 0x5f, 0xd4, 0x90, 0xee, 0x46, 0xe5, 0xf8, 0x93, 0xd2, 0xf8, 0x9e,
+    0x76, 0x7c, 0xf2, 0xda, 0x90, 0x22, 0xc4, 0x66, 0x5d, 0xed, 0xfb, 0x72, 0xa7, 0xbc, 0xfd, 0x42,
+    0x96, 0x58, 0x30, 0xd6, 0xee, 0x93, 0x85, 0xc6, 0x8a, 0x51, 0xeb, 0x00, 0x77, 0x8e, 0x25, 0x9f,
+    0xd5, 0xd5, 0x2f, 0x03, 0x02, 0x61, 0xd1, 0xfd, 0x45, 0x34, 0x87, 0x3a, 0xf2, 0x02, 0xca, 0xc3,
+    0x63, 0xa7, 0x12, 0xec, 0xe2, 0xe9, 0x53, 0x25, 0xd4, 0x66, 0xf5, 0x64, 0xf4, 0x4e, 0x05, 0xd5,
+    0x4b, 0x16, 0x3c, 0x9f, 0xa1, 0xe8, 0x92, 0xc5, 0x21, 0x66, 0x78, 0x21, 0xc1, 0xb2, 0x28, 0xbe,
+    0x99, 0x57, 0x54, 0xd4, 0x65, 0x72, 0x78, 0x4f, 0x68, 0x18, 0xe2, 0x7b, 0x7d, 0xf9, 0x7b, 0xe4,
+    0xf1, 0x08, 0xad, 0x49, 0xfc, 0x80, 0x4c, 0x03, 0x0f, 0xf4, 0xfc, 0xba, 0x9c, 0x10, 0xca, 0xb0,
+    0x3e, 0xe0, 0xd9, 0xa4, 0x31, 0xe2, 0x9b, 0x2e, 0x75, 0x2e, 0x28, 0x9f, 0x03, 0x13, 0xb9, 0x1b,
+    0x1f, 0x3f, 0x0c, 0x66, 0xa1, 0xc5, 0x24, 0x10, 0xda, 0x1b, 0xdf, 0x9e, 0x8a, 0x71, 0xdf, 0x8a,
+    0xc8, 0xb5, 0x0b, 0x37, 0xb9, 0x05, 0x66, 0x6e, 0x15, 0x73, 0x70, 0x71, 0xb5, 0x15, 0xf8, 0xb2,
+    0xf1, 0x00, 0x93, 0x2a, 0x7e, 0x8d, 0x67, 0x55, 0xd9, 0xe4, 0x16, 0x13, 0x5f, 0x48, 0xe8, 0xc3,
+    0x88, 0x89, 0x01, 0x2d, 0x5e, 0xaa, 0x51, 0xa3, 0xa3, 0xb6, 0xcd, 0x89, 0xc4, 0x86, 0x67, 0xe6,
+    0x33, 0x6c, 0x63, 0x14, 0xcf, 0x78, 0x35, 0xb2, 0xd8, 0x75, 0x25, 0x3f, 0x5b, 0x6c, 0x9a, 0x15,
+    0xe9, 0xf2, 0x7c, 0x5e, 0xfd, 0xc1, 0x3e, 0xf7, 0x40, 0x98, 0x72, 0xea, 0x0e, 0x94, 0x71, 0x11,
+    0xf9, 0x76, 0x95, 0x17, 0xa8, 0xa7, 0xc8, 0x34, 0x58, 0x36, 0xc5, 0xd7, 0x85, 0x93, 0x40, 0x6c,
+    0x67, 0xc5, 0x56, 0xc0, 0xa3, 0xf7, 0xf8, 0x6a, 0xe7, 0x26, 0x1e, 0x54, 0x78, 0xfc, 0x01, 0x7d,
+    0x12, 0x07, 0x7c, 0x03, 0x50, 0xd9, 0x11, 0x7d, 0x4b, 0x43, 0xdf, 0xa8, 0xc9, 0x07, 0xe1, 0xf3,
+    0x7b, 0x68, 0x50, 0x8b, 0x08, 0x17, 0xbe, 0x49, 0xa2, 0x5b, 0x17, 0x28, 0xc0, 0xd2, 0x90, 0x44,
+    0x49, 0xd4, 0xeb, 0x53, 0x10, 0xac, 0xe5, 0x61, 0x91, 0x4c, 0x33, 0x26, 0xaf, 0x4e, 0xba, 0x1e,
+    0xd3, 0x79, 0xa2, 0xb9, 0xe8, 0x30, 0x3a, 0x3d, 0xab, 0xcd, 0x3e, 0x45, 0x58, 0x5d, 0xdd, 0xd5,
+    0xae, 0x3f, 0xef, 0x3f, 0xc9, 0x2f, 0xff, 0x12, 0xca, 0xa5, 0x53, 0x56, 0x5e, 0x12, 0x41, 0x55,
+    0xd5, 0xe8, 0x11, 0x3e, 0x0a, 0x32, 0x37, 0x12, 0x64, 0x37, 0x14, 0x4f, 0x57, 0x12, 0x17, 0x9f,
+    0xa6, 0xbc, 0xf5, 0xb7, 0xc5, 0x32, 0xbb, 0x61, 0x62, 0x5b, 0x44, 0xf4, 0xaa, 0x84, 0x4c, 0x0a,
+    0x91, 0xb8, 0x60, 0xd4, 0x60, 0xa9, 0xb0, 0xf0, 0x91, 0x4f, 0xa7, 0xd1, 0x38, 0x88, 0x1f, 0xe9,
+    0x16, 0x5c, 0x16, 0x68, 0x64, 0xaf, 0x7a, 0x14, 0x87, 0x8c, 0x4e, 0x08, 0x2c, 0x54, 0xcc, 0x3b,
+    0x23, 0x92, 0xdc, 0xdd, 0xbf, 0x5e, 0xe9, 0x59, 0x40, 0xc5, 0xf3, 0x91, 0xa5, 0x87, 0xaf, 0x70,
+    0xde, 0xda, 0x47, 0xe2, 0x7c, 0xe0, 0x23, 0x6d, 0x6a, 0xff, 0x98, 0x7a, 0xb6, 0x72, 0x23, 0x33,
+    0x13, 0x84, 0x1c, 0xdb, 0x0d, 0x91, 0x02, 0x35, 0x40, 0xc2, 0x98, 0xb2, 0x6b, 0xfc, 0x9d, 0x18,
+    0x5d, 0x71, 0x74, 0x97, 0xe2, 0x2b, 0xea, 0x88, 0xb8, 0x5e, 0xe0, 0x2b, 0xfb, 0xab, 0x11, 0xe2,
+    0xa5, 0xfc, 0x58, 0x21, 0xe0, 0x9f, 0x78, 0x57, 0xfa, 0x2d, 0x0b, 0x0f, 0x68, 0xd9, 0xb2, 0x12,
+    0x64, 0x79, 0xc1, 0xa7, 0x53, 0x03, 0xe8, 0x8b, 0xe9, 0x74, 0x0e, 0x5a, 0x3c, 0x1e, 0xdb, 0xb7,
+    0x6d, 0xfe, 0x83, 0x43, 0xfc, 0xa9, 0x13, 0x7e, 0xd0, 0x8f, 0x5e, 0x0a, 0x7f, 0x41, 0xa9, 0xb4,
+    0xcf, 0x56, 0x0b, 0x23, 0x4b, 0x83, 0x68, 0xe9, 0x97, 0x68, 0x80, 0xa7, 0x8d, 0xcc, 0x6f, 0x52,
+    0xf0, 0x1f, 0x4d, 0x52, 0x3d, 0x27, 0x94, 0x83, 0x4d, 0xdf, 0x63, 0x8f, 0xe0, 0x8b, 0x7f, 0x49,
+    0xa9, 0xb6, 0x64, 0x6d, 0x51, 0x47, 0x60, 0xfe, 0x47, 0x33, 0x56, 0xa3, 0xce, 0x2f, 0x37, 0xcb,
+    0x54, 0x9f, 0x20, 0x64, 0xdf, 0x29, 0x60, 0x89, 0xbf, 0x8b, 0xc2, 0xcc, 0x96, 0x71, 0xe5, 0x10,
+    0x70, 0x48, 0x8a, 0xd2, 0x30, 0x8b, 0xc7, 0x01, 0x6c, 0xa1, 0x6a, 0x17, 0xe7, 0xc3, 0x2b, 0x45,
+    0xb6, 0x23, 0x5e, 0x79, 0x0d, 0x99, 0xc4, 0x7b, 0xfe, 0xb8, 0x31, 0x2a, 0x45, 0x13, 0xf3, 0xef,
+    0x1a, 0x80, 0xa0, 0x4f, 0xc3, 0x7e, 0x0d, 0x20, 0x69, 0x1d, 0xcb, 0xc2, 0x35, 0xf2, 0xa1, 0x8c,
+    0x00, 0xdf, 0x87, 0xde, 0xe7, 0x4e, 0x1f, 0x0f, 0x4b, 0x40, 0x39, 0x5c, 0xe7, 0xde, 0x78, 0x4f,
+    0x24, 0x4d, 0xfd, 0xe4, 0x43, 0xb1, 0x4a, 0x5c, 0xf8, 0x2a, 0xca, 0xcd, 0x21, 0x8b, 0xa6, 0x60,
+    0x31, 0x8c, 0x57, 0xa2, 0xe5, 0xe7, 0xa4, 0x20, 0xad, 0x18, 0x2e, 0x02, 0xa4, 0xca, 0x65, 0xa6,
+    0x45, 0xf4, 0x68, 0x66, 0x59, 0x90, 0x0b, 0x54, 0x44, 0xcf, 0x97, 0xfc, 0x49, 0x4a, 0x90, 0x27,
+    0xb3, 0x31, 0x28, 0xea, 0xe3, 0x55, 0x2b, 0xa6, 0x21, 0x98, 0x6d, 0xa2, 0x19, 0xe9, 0x7b, 0x23,
+    0x70, 0x85, 0xf5, 0xbf, 0xa5, 0xc3, 0xdf, 0x9d, 0x8f, 0xbf, 0xa5, 0xe3, 0x6c, 0xf5, 0x7a, 0xb4,
+    0xae, 0x79, 0xb2, 0x34, 0x62, 0x31, 0x3e, 0x46, 0x02, 0x0a, 0x6b, 0xe8, 0xa2, 0xc0, 0xc7, 0xd3,
+    0x52, 0xfc, 0xc1, 0x25, 0x0d, 0x2d, 0x1f, 0x1a, 0xf8, 0x16, 0x9f, 0xfa, 0xc2, 0xe6, 0xae, 0xc2,
+    0x8a, 0x88, 0x6a, 0xbf, 0x8c, 0x65, 0xa5, 0x7a, 0x3f, 0xf7, 0xee, 0x5c, 0xaf, 0xd1, 0x7d, 0x24,
+    0xca, 0x81, 0x55, 0x7f, 0xbc, 0x51, 0xd7, 0x56, 0x33, 0xaf, 0x82, 0xeb, 0xeb, 0xe2, 0x33, 0x4e,
+    0xa3, 0x7b, 0x12, 0x83, 0x6a, 0x22, 0x22, 0xf9, 0x1b, 0x00, 0x3d, 0xfe, 0xac, 0x58, 0x54, 0x36,
+    0xa4, 0x98, 0x83, 0xf3, 0x0d, 0xc2, 0x33, 0x0e, 0x6c, 0xa8, 0x8e, 0xe3, 0xbe, 0x92, 0x8f, 0x69,
+    0xf1, 0x59, 0xae, 0xe8, 0x94, 0x67, 0xff, 0x75, 0xa2, 0xba, 0x0a, 0x02, 0x2e, 0x1c, 0xce, 0xaa,
+    0x46, 0x3d, 0x7e, 0xbc, 0x5d, 0x7e, 0x6e, 0x45, 0x89, 0x6e, 0x6f, 0x97, 0xf4, 0xf4, 0xc7, 0xc5,
+    0xf6, 0x9c, 0xf0, 0xc5, 0x8f, 0x68, 0x2d, 0x78, 0x00, 0x71, 0x8e, 0x4a, 0x6a, 0x8d, 0xec, 0xe6,
+    0x16, 0x0d, 0xed, 0xdc, 0x45, 0xe9, 0xac, 0xa4, 0x02, 0x96, 0xd4, 0xf8, 0x4f, 0x7d, 0xd4, 0xb6,
+    0x17, 0x3f, 0x56, 0x77, 0x98, 0x5d, 0xc3, 0xc1, 0x19, 0xee, 0xe8, 0x0f, 0x57, 0x7e, 0x00, 0xb1,
+    0x92, 0x14, 0x5f, 0xdd, 0x94, 0x58, 0x4d, 0xc9, 0xe1, 0xf1, 0x50, 0x4f, 0xca, 0x23, 0xcd, 0x03,
+    0x7d, 0x0b, 0x74, 0x42, 0xf1, 0x3c, 0x0a, 0x7f, 0x15, 0x8c, 0x3c, 0x90, 0x94, 0xe9, 0x59, 0x87,
+    0xc8, 0x82, 0xfe, 0xa3, 0x6a, 0x57, 0xa0, 0x9f, 0x14, 0x6d, 0xb5, 0x63, 0x9a, 0xfa, 0xc3, 0x80,
+    0xfd, 0x38, 0xa6, 0xb0, 0x35, 0x80, 0xac, 0x5c, 0x58, 0xca, 0xa3, 0x52, 0x56, 0x55, 0x4e, 0x6e,
+    0x0f, 0xcf, 0x4f, 0x65, 0x20, 0xc0, 0xd7, 0xb6, 0xf3, 0xa3, 0xb9, 0xc4, 0x9e, 0x34, 0x9d, 0x49,
+    0xd2, 0x0a, 0x33, 0x1a, 0xfa, 0xf3, 0x19, 0x0b, 0xef, 0x87, 0x10, 0x12, 0xad, 0x18, 0xad, 0x7f,
+    0xfe, 0x5b, 0x1d, 0xaa, 0xd3, 0x4e, 0x71, 0x53, 0xa5, 0x7c, 0xe2, 0x8e, 0x82, 0x46, 0xfe, 0xee,
+    0x1d, 0x20, 0xac, 0x64, 0xdf, 0x8a, 0x45, 0x94, 0x48, 0xe4, 0x43, 0x84, 0xfc, 0x17, 0xde, 0x78,
+    0xca, 0x20, 0x7e, 0xe3, 0x4d, 0x1f, 0x97, 0xeb, 0xaa, 0x43, 0xa4, 0xdc, 0x1b, 0x89, 0xb0, 0xdd,
+    0x4d, 0xe5, 0x4f, 0xe2, 0xa4, 0x7e, 0x25, 0x5f, 0x59, 0xa4, 0x09, 0x50, 0x12, 0x97, 0x51, 0xfb,
+    0xe3, 0x6f, 0xfe, 0x0d, 0xdf, 0xd1, 0x56, 0x7c, 0xaf, 0xd1, 0xb7, 0xe4, 0x75, 0x30, 0x83, 0xc5,
+    0x87, 0xac, 0x1d, 0x37, 0x4a, 0x99, 0xba, 0x39, 0xdf, 0xeb, 0xf9, 0x10, 0xb1, 0x70, 0x65, 0xd3,
+    0xa4, 0xbc, 0x55, 0xab, 0x6b, 0xdb, 0x8e, 0x97, 0xcc, 0x16, 0x96, 0xcd, 0x1a, 0x3e, 0x59, 0xf6,
+    0xb0, 0x6c, 0x16, 0x21, 0xdf, 0xac, 0xc4, 0xe5, 0xa9, 0x3b, 0x70, 0xfe, 0x50, 0xff, 0xe8, 0xe0,
+    0x4a, 0x3d, 0x16, 0xc6, 0x46, 0x6d, 0xbe, 0x06, 0xbc, 0x19, 0x3c, 0x8e, 0xc5, 0x8f, 0x17, 0x90,
+    0x0b, 0x6c, 0xfb, 0x62, 0xe4, 0x96, 0xba, 0x31, 0xc4, 0x9c, 0xe4, 0x38, 0x0e, 0x17, 0x23, 0x64,
+    0x0e, 0x8c, 0x1c, 0xf3, 0x8d, 0x18, 0x6e, 0xc2, 0xb5, 0x8f, 0x63, 0x7f, 0xd0, 0xbd, 0x5d, 0xe1,
+    0xc3, 0x52, 0x67, 0xd9, 0xe7, 0x53, 0x26, 0xcf, 0xa8, 0x73, 0xfb, 0x33, 0xd7, 0x27, 0xb2, 0x76,
+    0x32, 0x09, 0x6c, 0x06, 0x09, 0xb8, 0xf8, 0x25, 0xf6, 0x74, 0xb7, 0x27, 0x4b, 0x39, 0x49, 0x69,
+    0x27, 0xbb, 0x57, 0xac, 0x3f, 0x52, 0xef, 0xb8, 0x33, 0x27, 0x3a, 0x3b, 0xeb, 0xc9, 0x4b, 0x7e,
+    0x76, 0xd6, 0xc5, 0xcf, 0xdf, 0xec, 0xac, 0x8b, 0x5f, 0x9c, 0xff, 0x7f, 0x6b, 0xb5, 0x82, 0x8c,
+    0x89, 0x7e, 0x00, 0x00,
+};
+
+#endif // DASHBOARD_HTML_H
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""
+web/build_dashboard.py
+Compresses web/dashboard.html into dashboard_html.h next to the sketch:
+a gzip blob in PROGMEM plus an ETag taken from the page content, which
+handleRoot() streams from flash with Content-Encoding: gzip. Run it after
+every edit to dashboard.html (the Arduino IDE has no pre-build step, so
+the generated header is committed). Output is deterministic, so an
+unchanged page gives an unchanged header and the same ETag.
+
+    python3 web/build_dashboard.py
+    python3 web/build_dashboard.py --check    # fail if the header is stale
+"""
+
+import argparse
+import gzip
+import hashlib
+import os
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SOURCE = os.path.join(HERE, "dashboard.html")
+HEADER = os.path.join(HERE, "..", "dashboard_html.h")
+BYTES_PER_LINE = 16
+
+
+def render(html):
+    # mtime=0 and no file name in the gzip header keep the output reproducible
+    blob = gzip.compress(html, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(html).hexdigest()[:16]
+    lines = [
+        "/*",
+        " * dashboard_html.h",
+        " * GENERATED by web/build_dashboard.py from web/dashboard.html - do not edit.",
+        " * %d bytes of HTML, %d bytes gzipped." % (len(html), len(blob)),
+        " */",
+        "",
+        "#ifndef DASHBOARD_HTML_H",
+        "#define DASHBOARD_HTML_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "#define DASHBOARD_HTML_ETAG \"\\\"%s\\\"\"" % etag,
+        "#define DASHBOARD_HTML_GZ_LEN %d" % len(blob),
+        "",
+        "static const uint8_t DASHBOARD_HTML_GZ[DASHBOARD_HTML_GZ_LEN] PROGMEM = {",
+    ]
+    for i in range(0, len(blob), BYTES_PER_LINE):
+        chunk = blob[i:i + BYTES_PER_LINE]
+        lines.append("    " + ", ".join("0x%02x" % b for b in chunk) + ",")
+    lines += ["};", "", "#endif // DASHBOARD_HTML_H", ""]
+    return "\n".join(lines), len(html), len(blob)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate dashboard_html.h from dashboard.html")
+    parser.add_argument("--check", action="store_true",
+                        help="exit 1 if dashboard_html.h does not match dashboard.html")
+    args = parser.parse_args()
+
+    with open(SOURCE, "rb") as f:
+        text, raw, packed = render(f.read())
+
+    if args.check:
+        try:
+            with open(HEADER) as f:
+                current = f.read()
+        except FileNotFoundError:
+            current = ""
+        if current != text:
+            print("dashboard_html.h is stale - run web/build_dashboard.py", file=sys.stderr)
+            return 1
+        return 0
+
+    with open(HEADER, "w", newline="\n") as f:
+        f.write(text)
+    print("dashboard_html.h: %d -> %d bytes (%.0f%%)" % (raw, packed, 100.0 * packed / raw))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
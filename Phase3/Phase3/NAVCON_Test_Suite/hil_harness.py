@@ -0,0 +1,475 @@
+#!/usr/bin/env python3
+"""
+MARV NAVCON Hardware-in-the-Loop Harness
+Headless, multi-board QTP regression runner
+
+Replays the HUB's recorded QTP sessions (HUB/QTP*.txt) against several SNC
+boards at once and reports pass/fail plus per-turn response latency for
+each firmware build. Also reachable as `navcon_tester.py --headless ...`.
+
+    python hil_harness.py --dut COM12=Phase3 --dut COM13=ALL_QTP_Complaint
+    python hil_harness.py --dut /dev/ttyUSB0=Phase3 --suite ../HUB/QTP3.txt \\
+        --repeat 5 --reset --json results.json --trace traces/
+
+SUITES:
+=======
+Each "Start QTPn" section of a HUB log is one suite; sections that end in
+an "Error:" line (aborted runs) are skipped. A suite is a list of turns:
+a run of "Sent:" frames followed by the run of "Received:" frames the SNC
+answered with. The harness sends a turn's frames, resending them every
+--resend-ms like the HUB does, until the recorded reply appears in what
+the SNC sent back during that turn, or --turn-timeout expires (the suite
+then stops, like the HUB's "QTP terminated"). "QTP complete ... Ctrl"
+lines become checkpoints on the turn they follow, so the report names
+the QTP item (N1.1, N3.2, ...) that failed.
+
+MATCHING:
+=========
+--match control (default) compares only the control byte (SYS-SUB-IST),
+so builds with different speeds or distances can share one recording.
+--match frame compares all four bytes, for a log captured from the build
+under test. Physical steps in the recording (touch, pure tone) still need
+the fixture or an operator within --turn-timeout.
+
+TIMING:
+=======
+Every frame is stamped with time.perf_counter_ns(): on the way out just
+before the write, on the way in by a per-port reader thread as soon as the
+read returns. Turn latency is the first frame of the matched reply minus
+the last frame sent before it. USB-serial bridges deliver in bursts (FTDI
+latency timer 16 ms by default, CP210x/CH340 a few ms), so set the bridge
+latency to 1 ms for sub-millisecond figures.
+
+FRAMING:
+========
+The SNC sends each frame in one go, so a partial frame followed by
+--rx-gap-ms of silence means a byte was lost or is left over from boot
+text; it is dropped and counted as a resync (the same rule as the SNC's
+own receive, SCS_FRAME_GAP_US, widened for the bridge's burst delivery).
+Without it one lost byte would misalign every later frame of the run.
+"""
+
+import argparse
+import asyncio
+import csv
+import json
+import os
+import re
+import statistics
+import sys
+import threading
+import time
+from dataclasses import dataclass, field
+from typing import Dict, List, Optional, Tuple
+
+import serial
+
+from navcon_tester import SCSPacket
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_SUITES = os.path.join(HERE, "..", "HUB")
+
+LOG_FRAME = re.compile(r"\|\|\s*(\d+)\s*\|\|\s*(Sent|Received):\s*\|\|.*\|\|\s*(\d+)\s*\|\s*(\d+)\s*\|\s*(\d+)\s*\|\|\s*(\d+)\s*\|\|")
+LOG_START = re.compile(r"Start (QTP\w*)")
+LOG_CHECKPOINT = re.compile(r"^QTP complete \(QS\s*\d+\)\. Ctrl \((\d)-(\d)-(\d+)\):\s*(.*)$")
+
+# ==================== SUITES ====================
+
+@dataclass
+class Turn:
+    send: List[SCSPacket]
+    expect: List[SCSPacket]
+    checkpoints: List[str] = field(default_factory=list)
+
+@dataclass
+class Suite:
+    name: str
+    turns: List[Turn]
+
+def packet_bytes(packet: SCSPacket) -> bytes:
+    return bytes([packet.control, packet.dat1, packet.dat0, packet.dec])
+
+def ctrl_name(control: int) -> str:
+    return f"({(control >> 6) & 3}-{(control >> 4) & 3}-{control & 0x0F})"
+
+def load_suites(path: str) -> List[Suite]:
+    """Split a HUB log into suites, one per completed "Start QTPn" section"""
+    suites, sections = [], []
+    current = None
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            start = LOG_START.search(line)
+            if start:
+                current = {"name": start.group(1), "lines": [], "aborted": False}
+                sections.append(current)
+            elif current is not None:
+                if line.startswith("Error:"):
+                    current["aborted"] = True
+                current["lines"].append(line.rstrip("\n"))
+
+    base = os.path.splitext(os.path.basename(path))[0]
+    completed = [section for section in sections if not section["aborted"]]
+    for index, section in enumerate(completed):
+        turns: List[Turn] = []
+        for line in section["lines"]:
+            frame = LOG_FRAME.search(line)
+            if frame:
+                packet = SCSPacket(int(frame.group(6)), int(frame.group(3)),
+                                   int(frame.group(4)), int(frame.group(5)))
+                if frame.group(2) == "Sent":
+                    if not turns or turns[-1].expect:
+                        turns.append(Turn([], []))
+                    turns[-1].send.append(packet)
+                elif turns:
+                    turns[-1].expect.append(packet)
+                continue
+            checkpoint = LOG_CHECKPOINT.match(line)
+            if checkpoint and turns:
+                turns[-1].checkpoints.append(
+                    f"({checkpoint.group(1)}-{checkpoint.group(2)}-{checkpoint.group(3)}) {checkpoint.group(4)}")
+        name = section["name"] if section["name"] == base else f"{base}:{section['name']}"
+        if len(completed) > 1:
+            name += f"#{index + 1}"
+        suites.append(Suite(name, turns))
+    return suites
+
+# ==================== DUT LINK ====================
+
+class DutLink:
+    """One SNC board: a reader thread stamps incoming frames, asyncio consumes them"""
+
+    def __init__(self, port: str, build: str, baud: int, rx_gap_ms: float, loop: asyncio.AbstractEventLoop):
+        self.port = port
+        self.build = build
+        self.loop = loop
+        self.frames: asyncio.Queue = asyncio.Queue()
+        self.trace: List[Tuple[int, str, bytes]] = []
+        self.serial = serial.serial_for_url(port, baudrate=baud, timeout=0.05)
+        self.running = True
+        self.resync = False
+        self.resyncs = 0
+        self.rx_gap_ns = int(rx_gap_ms * 1e6)
+        self.buffer = bytearray()
+        self.reader = threading.Thread(target=self._read_loop, name=f"rx-{port}", daemon=True)
+        self.reader.start()
+
+    def _read_loop(self):
+        last = 0
+        while self.running:
+            try:
+                data = self.serial.read(self.serial.in_waiting or 1)
+            except (serial.SerialException, OSError, TypeError):
+                break
+            if not data:
+                continue
+            stamp = time.perf_counter_ns()
+            if self.resync:
+                self.buffer.clear()
+                self.resync = False
+            elif self.buffer and stamp - last > self.rx_gap_ns:
+                # A partial frame went quiet: it will never complete, start over with this byte
+                self.buffer.clear()
+                self.resyncs += 1
+            last = stamp
+            self.buffer.extend(data)
+            while len(self.buffer) >= 4:
+                frame = bytes(self.buffer[:4])
+                del self.buffer[:4]
+                self.loop.call_soon_threadsafe(self.frames.put_nowait, (stamp, frame))
+
+    def send(self, frame: bytes) -> int:
+        stamp = time.perf_counter_ns()
+        self.serial.write(frame)
+        self.trace.append((stamp, "tx", frame))
+        return stamp
+
+    async def receive(self, timeout: float) -> Optional[Tuple[int, bytes]]:
+        try:
+            stamp, frame = await asyncio.wait_for(self.frames.get(), timeout)
+        except asyncio.TimeoutError:
+            return None
+        self.trace.append((stamp, "rx", frame))
+        return stamp, frame
+
+    def drain(self) -> int:
+        """Drop frames nobody asked for (boot noise, late replies); returns the count"""
+        dropped = 0
+        while not self.frames.empty():
+            stamp, frame = self.frames.get_nowait()
+            self.trace.append((stamp, "rx", frame))
+            dropped += 1
+        return dropped
+
+    async def reset(self, boot_wait: float):
+        """Pulse EN through RTS (ESP32 DevKit auto-reset wiring), then discard boot output"""
+        self.serial.dtr = False
+        self.serial.rts = True
+        await asyncio.sleep(0.1)
+        self.serial.rts = False
+        await asyncio.sleep(boot_wait)
+        self.serial.reset_input_buffer()
+        self.resync = True  # boot text may have left a partial frame behind
+        await asyncio.sleep(0.05)
+        self.drain()
+
+    def close(self):
+        self.running = False
+        self.reader.join(timeout=1.0)
+        self.serial.close()
+
+# ==================== RUNNER ====================
+
+@dataclass
+class TurnResult:
+    index: int
+    passed: bool
+    latency_ns: Optional[int]
+    sends: int
+    received: List[bytes]
+
+@dataclass
+class RunResult:
+    port: str
+    build: str
+    suite: str
+    run: int
+    passed: bool
+    turns: List[TurnResult]
+    failed_checkpoints: List[str]
+    unsolicited: int
+    resyncs: int
+    elapsed_s: float
+    trace: List[Tuple[int, str, bytes]]
+
+def find_reply(received: List[Tuple[int, bytes]], expect: List[bytes], mask: bytes) -> int:
+    """Index in received where expect starts (compared through mask), or -1"""
+    n = len(expect)
+    for start in range(len(received) - n + 1):
+        if all(bytes(a & m for a, m in zip(received[start + k][1], mask)) ==
+               bytes(b & m for b, m in zip(expect[k], mask)) for k in range(n)):
+            return start
+    return -1
+
+async def run_turn(link: DutLink, turn: Turn, index: int, args, mask: bytes) -> Tuple[TurnResult, int]:
+    unsolicited = link.drain()
+    send = [packet_bytes(p) for p in turn.send]
+    expect = [packet_bytes(p) for p in turn.expect]
+    sent_at: List[int] = []
+    received: List[Tuple[int, bytes]] = []
+    sends = 0
+    start = time.monotonic()
+    next_send = start
+
+    while True:
+        now = time.monotonic()
+        if now >= next_send:
+            for frame in send:
+                sent_at.append(link.send(frame))
+                if args.frame_gap_ms:
+                    await asyncio.sleep(args.frame_gap_ms / 1000.0)
+            sends += 1
+            next_send = now + args.resend_ms / 1000.0 if args.resend_ms else float("inf")
+            if not expect:
+                return TurnResult(index, True, None, sends, []), unsolicited
+
+        remaining = args.turn_timeout - (time.monotonic() - start)
+        if remaining <= 0:
+            return TurnResult(index, False, None, sends, [f for _, f in received]), unsolicited
+        got = await link.receive(min(remaining, max(next_send - time.monotonic(), 0.001)))
+        if got is None:
+            continue
+        received.append(got)
+        at = find_reply(received, expect, mask)
+        if at >= 0:
+            first = received[at][0]
+            before = [t for t in sent_at if t <= first]
+            latency = first - before[-1] if before else None
+            return TurnResult(index, True, latency, sends, [f for _, f in received]), unsolicited
+
+async def run_dut(link: DutLink, suites: List[Suite], args) -> List[RunResult]:
+    mask = b"\xff\xff\xff\xff" if args.match == "frame" else b"\xff\x00\x00\x00"
+    results = []
+    for suite in suites:
+        for run in range(args.repeat):
+            if args.reset:
+                await link.reset(args.boot_wait)
+            link.trace = []
+            resyncs_before = link.resyncs
+            started = time.monotonic()
+            turns, failed_checkpoints, unsolicited = [], [], 0
+            link_lost = None
+            for index, turn in enumerate(suite.turns):
+                try:
+                    result, dropped = await run_turn(link, turn, index, args, mask)
+                except (serial.SerialException, OSError) as e:
+                    link_lost = str(e)
+                    result, dropped = TurnResult(index, False, None, 0, []), 0
+                unsolicited += dropped
+                turns.append(result)
+                if not result.passed:
+                    # Everything from here on is a checkpoint this run did not reach
+                    for later in suite.turns[index:]:
+                        failed_checkpoints.extend(later.checkpoints)
+                    break
+            passed = all(t.passed for t in turns) and len(turns) == len(suite.turns)
+            result = RunResult(link.port, link.build, suite.name, run, passed, turns,
+                               failed_checkpoints, unsolicited, link.resyncs - resyncs_before,
+                               time.monotonic() - started, link.trace)
+            results.append(result)
+            status = "PASS" if passed else f"FAIL at turn {turns[-1].index}"
+            if result.resyncs:
+                status += f" - {result.resyncs} partial frame(s) dropped"
+            if link_lost:
+                status += f" - link lost: {link_lost}"
+            print(f"[{link.port} {link.build}] {suite.name} run {run + 1}/{args.repeat}: "
+                  f"{status} ({result.elapsed_s:.1f} s)", flush=True)
+            if link_lost:
+                return results
+            if not passed and args.verbose:
+                failed = turns[-1]
+                expected = " ".join(ctrl_name(p.control) for p in suite.turns[failed.index].expect)
+                got = " ".join(ctrl_name(f[0]) for f in failed.received) or "nothing"
+                print(f"    expected {expected}, got {got} over {failed.sends} sends", flush=True)
+    return results
+
+# ==================== REPORT ====================
+
+def percentile(values: List[float], p: float) -> float:
+    ordered = sorted(values)
+    k = (len(ordered) - 1) * p / 100.0
+    lo, hi = int(k), min(int(k) + 1, len(ordered) - 1)
+    return ordered[lo] + (ordered[hi] - ordered[lo]) * (k - lo)
+
+def latency_stats(values_ms: List[float]) -> Dict[str, float]:
+    return {
+        "n": len(values_ms),
+        "min": min(values_ms),
+        "p50": percentile(values_ms, 50),
+        "p95": percentile(values_ms, 95),
+        "max": max(values_ms),
+        "mean": statistics.fmean(values_ms),
+    }
+
+def build_report(results: List[RunResult], suites: List[Suite]) -> Dict:
+    report: Dict = {}
+    for r in results:
+        build = report.setdefault(r.build, {})
+        entry = build.setdefault(r.suite, {"runs": 0, "passed": 0, "resyncs": 0, "ports": [],
+                                           "failed_checkpoints": {}, "turns": {}})
+        entry["runs"] += 1
+        entry["passed"] += int(r.passed)
+        entry["resyncs"] += r.resyncs
+        if r.port not in entry["ports"]:
+            entry["ports"].append(r.port)
+        for checkpoint in r.failed_checkpoints:
+            entry["failed_checkpoints"][checkpoint] = entry["failed_checkpoints"].get(checkpoint, 0) + 1
+        for t in r.turns:
+            if t.latency_ns is not None:
+                entry["turns"].setdefault(t.index, []).append(t.latency_ns / 1e6)
+
+    turn_labels = {s.name: s.turns for s in suites}
+    for build in report.values():
+        for suite_name, entry in build.items():
+            turns = turn_labels[suite_name]
+            all_values = [v for values in entry["turns"].values() for v in values]
+            entry["latency_ms"] = latency_stats(all_values) if all_values else None
+            entry["turns"] = {
+                str(index): dict(latency_stats(values),
+                                 reply=" ".join(ctrl_name(p.control) for p in turns[index].expect))
+                for index, values in sorted(entry["turns"].items())
+            }
+    return report
+
+def print_report(report: Dict, per_turn: bool):
+    print()
+    for build, suites in sorted(report.items()):
+        print(f"=== {build} ===")
+        for suite_name, entry in suites.items():
+            latency = entry["latency_ms"]
+            summary = (f"p50 {latency['p50']:.2f} / p95 {latency['p95']:.2f} / max {latency['max']:.2f} ms"
+                       if latency else "no replies")
+            print(f"  {suite_name:28} {entry['passed']}/{entry['runs']} passed   {summary}")
+            if entry["resyncs"]:
+                print(f"      {entry['resyncs']} partial frame(s) dropped on a receive gap")
+            for checkpoint, count in entry["failed_checkpoints"].items():
+                print(f"      not reached x{count}: {checkpoint}")
+            if per_turn:
+                print(f"      {'turn':>4}  {'reply':24} {'n':>3} {'min':>7} {'p50':>7} {'p95':>7} {'max':>7}")
+                for index, t in entry["turns"].items():
+                    print(f"      {index:>4}  {t['reply'][:24]:24} {t['n']:>3} {t['min']:7.2f} "
+                          f"{t['p50']:7.2f} {t['p95']:7.2f} {t['max']:7.2f}")
+
+def write_traces(results: List[RunResult], directory: str):
+    os.makedirs(directory, exist_ok=True)
+    for r in results:
+        safe_port = re.sub(r"[^\w.-]", "_", r.port)
+        safe_suite = re.sub(r"[^\w.-]", "_", r.suite)
+        path = os.path.join(directory, f"{r.build}_{safe_port}_{safe_suite}_run{r.run + 1}.csv")
+        origin = r.trace[0][0] if r.trace else 0
+        with open(path, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(["t_us", "dir", "ctrl", "control", "dat1", "dat0", "dec"])
+            for stamp, direction, frame in sorted(r.trace, key=lambda e: e[0]):
+                writer.writerow([f"{(stamp - origin) / 1000:.1f}", direction, ctrl_name(frame[0]), *frame])
+
+# ==================== MAIN ====================
+
+def parse_args(argv=None):
+    parser = argparse.ArgumentParser(description="Headless multi-board QTP regression harness for the SNC")
+    parser.add_argument("--dut", action="append", required=True, metavar="PORT=BUILD",
+                        help="serial port (or pyserial URL) and the firmware build on it; repeat per board")
+    parser.add_argument("--suite", action="append", metavar="LOG",
+                        help="HUB log to replay (default: every HUB/QTP*.txt)")
+    parser.add_argument("--baud", type=int, default=115200, help="SCS base rate (SCS_LINK_RATES[0])")
+    parser.add_argument("--repeat", type=int, default=1, help="runs of each suite per board")
+    parser.add_argument("--match", choices=["control", "frame"], default="control")
+    parser.add_argument("--turn-timeout", type=float, default=10.0, help="seconds per turn (HUB: 10)")
+    parser.add_argument("--resend-ms", type=int, default=1000, help="resend a turn's frames this often, 0 = never")
+    parser.add_argument("--frame-gap-ms", type=float, default=0.0, help="pause between frames of one turn")
+    parser.add_argument("--rx-gap-ms", type=float, default=25.0,
+                        help="silence after a partial frame that drops it (keep above the bridge latency)")
+    parser.add_argument("--reset", action="store_true", help="reset the board through RTS before every run")
+    parser.add_argument("--boot-wait", type=float, default=1.5, help="seconds to wait after a reset")
+    parser.add_argument("--json", metavar="FILE", help="write the report as JSON")
+    parser.add_argument("--trace", metavar="DIR", help="write one timestamped frame CSV per run")
+    parser.add_argument("--per-turn", action="store_true", help="print the latency distribution of every turn")
+    parser.add_argument("-v", "--verbose", action="store_true", help="show expected/received frames on failure")
+    return parser.parse_args(argv)
+
+async def run_all(args, suites: List[Suite]) -> List[RunResult]:
+    loop = asyncio.get_running_loop()
+    links = []
+    try:
+        for spec in args.dut:
+            port, _, build = spec.partition("=")
+            links.append(DutLink(port, build or port, args.baud, args.rx_gap_ms, loop))
+        per_dut = await asyncio.gather(*(run_dut(link, suites, args) for link in links))
+    finally:
+        for link in links:
+            link.close()
+    return [r for results in per_dut for r in results]
+
+def main(argv=None) -> int:
+    args = parse_args(argv)
+    paths = args.suite or sorted(
+        os.path.join(DEFAULT_SUITES, name) for name in os.listdir(DEFAULT_SUITES)
+        if re.match(r"QTP.*\.txt$", name))
+    suites = [s for path in paths for s in load_suites(path) if s.turns]
+    if not suites:
+        print("No QTP suites found", file=sys.stderr)
+        return 2
+    print(f"{len(suites)} suites, {sum(len(s.turns) for s in suites)} turns, "
+          f"{len(args.dut)} boards, {args.repeat} run(s) each", flush=True)
+
+    results = asyncio.run(run_all(args, suites))
+    report = build_report(results, suites)
+    print_report(report, args.per_turn)
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(report, f, indent=2)
+    if args.trace:
+        write_traces(results, args.trace)
+    return 0 if all(r.passed for r in results) else 1
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -32,8 +32,11 @@ Date: 2025-01-15
 
 import serial
 import serial.tools.list_ports
-import tkinter as tk
-from tkinter import ttk, messagebox, scrolledtext
+try:
+    import tkinter as tk
+    from tkinter import ttk, messagebox, scrolledtext
+except ImportError:
+    tk = None  # Headless machine: only --headless (hil_harness) is available
 import threading
 import time
 import queue
@@ -1532,6 +1535,11 @@ class NAVCONTester:
 # ==================== MAIN EXECUTION ====================
 
 if __name__ == "__main__":
+    # --headless hands the rest of the command line to the multi-board QTP harness
+    if len(sys.argv) > 1 and sys.argv[1] == "--headless":
+        import hil_harness
+        sys.exit(hil_harness.main(sys.argv[2:]))
+
     try:
         app = NAVCONTester()
         app.run()
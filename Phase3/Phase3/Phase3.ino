@@ -7,7 +7,15 @@
  * - navcon_core.h/.cpp     (NAVCON navigation system)
  * - scs_protocol.h/.cpp    (SCS packet handling)
  * - system_state.h/.cpp    (System state management)
- * - gpio_commands.h/.cpp   (GPIO pin handling)
+ * - gpio_commands.h/.cpp   (dashboard commands, pure tone input)
+ * - debug_log.h/.cpp       (buffered, compile-time levelled logging)
+ * - latency_trace.h/.cpp   (cycle-counter turn latency histograms)
+ * - pc_profiler.h/.cpp     (PC sampling profiler, IRAM budget)
+ * - maze_map.h/.cpp        (dead-reckoning pose and line/wall map)
+ * - maze_route.h/.cpp      (second run: route from the stored map)
+ *
+ * Runs as three FreeRTOS tasks (see TASK ARCHITECTURE below) instead of a
+ * single loop(): comms on core 0, NAVCON/state on core 1, telemetry on core 0.
  */
 
 // ==================== INCLUDES ====================
@@ -16,6 +24,12 @@
 #include "navcon_core.h"
 #include "gpio_commands.h"
 #include "edge_case_matrix.h"
+#include "debug_log.h"
+#include "latency_trace.h"
+#include "pc_profiler.h"
+#include "flight_recorder.h"
+#include "maze_map.h"
+#include "maze_route.h"
 
 #include "spi_protocol.h"
 // Note: spi_protocol_impl.cpp will be automatically included by Arduino IDE
@@ -29,12 +43,15 @@ struct {
     unsigned long lastSensorData = 0;
     unsigned long lastMovementData = 0;
     unsigned long lastHeartbeat = 0;
+    unsigned long lastDebugMessage = 0;
+    unsigned long lastPose = 0;
+    unsigned long lastFrame = 0;
     uint8_t updateCounter = 0;
 } spiTiming;
 
-// Startup delay to prevent spurious GPIO readings during power-up
-const unsigned long STARTUP_DELAY_MS = 3000; // 3 seconds
-unsigned long systemStartTime = 0;
+// The WiFi ESP32 can only answer (dashboard commands on MISO) while we clock,
+// so an idle link still gets a heartbeat frame this often
+const unsigned long SPI_COMMAND_POLL_MS = 20;
 
 // Cache latest sensor and movement data from packets
 struct SPIDataCache {
@@ -49,11 +66,98 @@ struct SPIDataCache {
     uint16_t rotation_angle = 0;      // Last rotation angle
     uint8_t rotation_direction = 0;   // 2=LEFT, 3=RIGHT
     bool endOfMazeDetected = false;   // End of maze flag
-    bool hasNewSensorData = false;
-    bool hasNewMovementData = false;
-    bool hasNewRotation = false;      // Flag for new rotation data
+    uint8_t system_state = 0;         // Last SNC state/IST reported
+    uint8_t system_ist = 0;
+    bool touchDetected = false;
+    bool pureToneDetected = false;
+    uint16_t dirty = 0;               // TELEM_* bits changed since last sent
+    unsigned long lastKeyframe = 0;
 };
 SPIDataCache spiDataCache;
+
+// Per-record dirty bits - a record only goes out when one of its fields changed
+#define TELEM_SYSTEM_STATE  0x0001
+#define TELEM_TOUCH         0x0002
+#define TELEM_PURE_TONE     0x0004
+#define TELEM_COLORS        0x0008
+#define TELEM_WHEELS        0x0010
+#define TELEM_INCIDENCE     0x0020
+#define TELEM_ROTATION      0x0040
+#define TELEM_DISTANCE      0x0080
+#define TELEM_END_OF_MAZE   0x0100
+#define TELEM_ALL           0x01FF
+#define TELEM_EVENTS        (TELEM_TOUCH | TELEM_PURE_TONE)
+
+// Every state record is resent at this interval so a dashboard that missed a
+// delta (or just connected) resyncs; touch and pure tone are events, sent on change only
+const unsigned long SPI_KEYFRAME_INTERVAL_MS = 250;
+
+// ==================== TASK ARCHITECTURE ====================
+/*
+ * commsTask     (core 0, prio 5) - sole owner of ssHandler / mdpsHandler.
+ *                                  Moves RX frames into sncInbox and drains
+ *                                  sncOutbox onto the UARTs.
+ * controlTask   (core 1, prio 4) - GPIO, pure tone, state transitions and
+ *                                  NAVCON. Sole writer of systemStatus,
+ *                                  navcon_status and the navcon_core globals.
+ * telemetryTask (core 0, prio 1) - sole owner of spi_comm (dashboard
+ *                                  commands leave it through a queue, see
+ *                                  receiveCommand). Sends dirty
+ *                                  records from a snapshot of spiDataCache.
+ *
+ * spiDataCache is written by controlTask (cacheSet) and snapshotted by
+ * telemetryTask, both under cacheMux. Nothing else crosses tasks except
+ * the two queues, so a slow SPI burst can no longer delay a NAVCON reply.
+ */
+#define PORT_SS    0x01
+#define PORT_MDPS  0x02
+
+#define SNC_INBOX_FRAMES   32
+#define SNC_OUTBOX_FRAMES  32
+
+const uint32_t COMMS_IDLE_WAIT_MS = 1;      // Comms wake-up without RX/TX activity
+const uint32_t CONTROL_IDLE_WAIT_MS = 1;    // Control cycle rate with no frames
+const uint32_t OUTBOX_WAIT_MS = 2;          // Control task waits this long for outbox room (comms drains every 1 ms)
+const uint32_t SPI_UPDATE_INTERVAL_MS = 5;  // Telemetry tick (200Hz)
+
+struct InboundFrame {
+    SCSPacket packet;
+    uint8_t port;          // PORT_SS or PORT_MDPS
+    uint32_t rx_us;        // micros() when the comms task took it off the ring
+};
+
+struct OutboundFrame {
+    SCSPacket packet;
+    uint8_t ports;         // PORT_* mask
+    bool flush;            // Wait for the wire afterwards (EOM forward)
+};
+
+// Task health (per-stage turn latency lives in latency_trace)
+struct TaskLatencyStats {
+    uint32_t cycle_max_us;  // Longest control cycle (idle wait excluded)
+    uint32_t inbox_full;    // Times RX frames were held back (comms task)
+    uint32_t outbox_drops;  // TX frames lost to an outbox still full after OUTBOX_WAIT_MS (control task)
+};
+
+// Pure tone in MAZE: the SOS frame jumps the outbox instead of waiting for
+// the SNC's turn, and the MDPS answers it once the wheels are at rest
+struct SOSStopStats {
+    uint32_t stops;         // SOS frames injected ahead of the round-robin
+    uint32_t confirmed;     // ...answered by the MDPS halt (SOS:MDPS:IST4)
+    uint32_t last_us;       // Injection -> halt reply received
+    uint32_t max_us;
+    uint32_t inject_us;     // micros() of the unanswered injection
+    bool pending;
+};
+
+QueueHandle_t sncInbox = nullptr;
+QueueHandle_t sncOutbox = nullptr;
+TaskHandle_t commsTaskHandle = nullptr;
+TaskHandle_t controlTaskHandle = nullptr;
+TaskHandle_t telemetryTaskHandle = nullptr;
+portMUX_TYPE cacheMux = portMUX_INITIALIZER_UNLOCKED;
+TaskLatencyStats taskStats = {0, 0, 0};
+SOSStopStats sosStats = {0, 0, 0, 0, 0, false};
 // ==================== PIN DEFINITIONS ====================
 // UART pins for subsystem communication
 #define RX_SS   21
@@ -65,6 +169,119 @@ SPIDataCache spiDataCache;
 SerialPacketHandler ssHandler(&Serial1, RX_SS, TX_SS);
 SerialPacketHandler mdpsHandler(&Serial2, RX_MDPS, TX_MDPS);
 
+// ==================== TELEMETRY CACHE HELPERS ====================
+// Store a cache field; flag its record dirty only if the value changed
+// (controlTask side - the lock keeps each field + dirty bit update atomic)
+void cacheSet(uint8_t& field, uint8_t value, uint16_t dirty_bit) {
+    taskENTER_CRITICAL(&cacheMux);
+    if (field != value) {
+        field = value;
+        spiDataCache.dirty |= dirty_bit;
+    }
+    taskEXIT_CRITICAL(&cacheMux);
+}
+
+void cacheSet(uint16_t& field, uint16_t value, uint16_t dirty_bit) {
+    taskENTER_CRITICAL(&cacheMux);
+    if (field != value) {
+        field = value;
+        spiDataCache.dirty |= dirty_bit;
+    }
+    taskEXIT_CRITICAL(&cacheMux);
+}
+
+void cacheSet(bool& field, bool value, uint16_t dirty_bit) {
+    taskENTER_CRITICAL(&cacheMux);
+    if (field != value) {
+        field = value;
+        spiDataCache.dirty |= dirty_bit;
+    }
+    taskEXIT_CRITICAL(&cacheMux);
+}
+
+// Wake the telemetry task so changed records go out without waiting a tick
+void requestTelemetry() {
+    if (telemetryTaskHandle != nullptr) {
+        xTaskNotifyGive(telemetryTaskHandle);
+    }
+}
+
+// Send the records flagged in pending from a cache snapshot (telemetryTask only)
+void sendTelemetryRecords(const SPIDataCache& snapshot, uint16_t pending) {
+    if (pending == 0) {
+        return;
+    }
+
+    if (pending & TELEM_SYSTEM_STATE) {
+        spi_comm.sendSystemState((SystemState)snapshot.system_state,
+                                 (Subsystem)SUB_SNC, snapshot.system_ist);
+    }
+    if (pending & TELEM_TOUCH) {
+        spi_comm.sendTouchDetected(snapshot.touchDetected,
+                                   (SystemState)snapshot.system_state, 140);
+    }
+    if (pending & TELEM_PURE_TONE) {
+        spi_comm.sendPureTone(snapshot.pureToneDetected, 1000, 80);
+    }
+    if (pending & TELEM_COLORS) {
+        spi_comm.sendSensorColors(
+            (Color)snapshot.sensor1_color,
+            (Color)snapshot.sensor2_color,
+            (Color)snapshot.sensor3_color
+        );
+    }
+    if (pending & TELEM_WHEELS) {
+        spi_comm.sendWheelSpeeds(snapshot.wheelSpeedR, snapshot.wheelSpeedL,
+                                 snapshot.wheelSetpoint);
+    }
+    if (pending & TELEM_INCIDENCE) {
+        spi_comm.sendIncidenceAngle(snapshot.incidence_angle, 0, 0, 0);
+    }
+    if (pending & TELEM_ROTATION) {
+        spi_comm.sendRotationAngle(snapshot.rotation_angle, snapshot.rotation_direction);
+    }
+    if (pending & TELEM_DISTANCE) {
+        spi_comm.sendDistance(snapshot.distance_mm);
+    }
+    if ((pending & TELEM_END_OF_MAZE) && snapshot.endOfMazeDetected) {
+        spi_comm.sendEndOfMaze();
+    }
+}
+
+// Queue a frame for the comms task; never blocks the control task
+void queueTransmit(const SCSPacket& packet, uint8_t ports, bool flush = false) {
+    OutboundFrame frame;
+    frame.packet = packet;
+    frame.ports = ports;
+    frame.flush = flush;
+
+    // A lost SCS frame desyncs the round-robin - give the comms task a moment to drain
+    if (xQueueSend(sncOutbox, &frame, pdMS_TO_TICKS(OUTBOX_WAIT_MS)) != pdPASS) {
+        taskStats.outbox_drops++;
+        LOG(SYSTEM, WARN, "Outbox full - 0x%02X dropped (%lu drops)", packet.control,
+            (unsigned long)taskStats.outbox_drops);
+        return;
+    }
+    xTaskNotifyGive(commsTaskHandle);
+}
+
+// Queue a frame ahead of everything already in the outbox
+bool queueTransmitUrgent(const SCSPacket& packet, uint8_t ports) {
+    OutboundFrame frame;
+    frame.packet = packet;
+    frame.ports = ports;
+    frame.flush = false;
+
+    if (xQueueSendToFront(sncOutbox, &frame, pdMS_TO_TICKS(OUTBOX_WAIT_MS)) != pdPASS) {
+        taskStats.outbox_drops++;
+        LOG(SYSTEM, WARN, "Outbox full - urgent 0x%02X dropped (%lu drops)", packet.control,
+            (unsigned long)taskStats.outbox_drops);
+        return false;
+    }
+    xTaskNotifyGive(commsTaskHandle);
+    return true;
+}
+
 // ==================== ARDUINO SETUP ====================
 void setup() {
     Serial.begin(460800);
@@ -75,10 +292,18 @@ void setup() {
     Serial.println("Main ESP32 with Modular Architecture");
     Serial.println("========================================");
 
-    // Initialize UART handlers
-    ssHandler.begin(460800);
-    mdpsHandler.begin(460800);
-    Serial.println("UART handlers initialized (460800 baud)");
+    // Initialize UART handlers at the common base rate, then train each link as fast as its wiring allows
+    ssHandler.begin(SCS_LINK_RATES[0]);
+    mdpsHandler.begin(SCS_LINK_RATES[0]);
+    unsigned long ssBaud = ssHandler.trainLink(SUB_SS);
+    unsigned long mdpsBaud = mdpsHandler.trainLink(SUB_MDPS);
+    Serial.printf("UART handlers initialized (SS %lu baud, MDPS %lu baud)\n", ssBaud, mdpsBaud);
+
+    // Log records are buffered in RAM and drained off the control loop
+    initializeDebugLog(LOG_SINK_USB | LOG_SINK_SPI);
+    initializeLatencyTrace();
+    initializePcProfiler();
+    initializeFlightRecorder();
     
     // Initialize all modules
     setupGPIOCommands();
@@ -90,306 +315,440 @@ void setup() {
     Serial.println("========================================");
     Serial.println("Commands available:");
     Serial.println("   Serial: T (touch), P (pure tone), S (send), ? (status)");
-    Serial.println("   Serial: N (NAVCON debug)");
-    Serial.println("   GPIO: Connect WiFi ESP32 to pins 4, 2, 15");
+    Serial.println("   Serial: N (NAVCON debug), L (reset latency trace)");
+    Serial.println("   Serial: F (upload flight log), R (upload previous run's log)");
+    Serial.println("   Serial: B (NAVCON benchmark, IDLE only)");
+    Serial.println("   Serial: G (maze map/route), O (second-run route), V (adaptive forward speed)");
+    Serial.println("   Serial: C (PC profile / IRAM budget)");
+    Serial.println("   Dashboard: touch / tone / send / reset over SPI (MISO, acknowledged)");
     Serial.println("========================================");
     Serial.println("System ready!");
     Serial.println("========================================\n");
 
-    // Record system start time for startup delay
-    systemStartTime = millis();
-    Serial.printf("Startup delay active: GPIO pins will be ignored for %lu ms\n", STARTUP_DELAY_MS);
-
     printSystemStatus();
-}
 
-// ==================== MAIN CONTROL LOOP ====================
-void loop() {
-    // Startup delay: Ignore GPIO pins for the first 3 seconds to prevent spurious readings
-    bool startupDelayActive = (millis() - systemStartTime) < STARTUP_DELAY_MS;
+    // Hand everything over to the pinned tasks (see TASK ARCHITECTURE)
+    sncInbox = xQueueCreate(SNC_INBOX_FRAMES, sizeof(InboundFrame));
+    sncOutbox = xQueueCreate(SNC_OUTBOX_FRAMES, sizeof(OutboundFrame));
 
-    if (!startupDelayActive) {
-        // Check for GPIO commands from WiFi ESP32
-        checkWiFiCommands();
+    xTaskCreatePinnedToCore(commsTask, "scs_comms", 4096, nullptr, 5, &commsTaskHandle, 0);
+    ssHandler.setRxNotify(commsTaskHandle);
+    mdpsHandler.setRxNotify(commsTaskHandle);
 
-        // Check pure tone ADC input (every loop for high responsiveness)
-        // The flag will be sent in the next SNC packet when it's our turn
-        checkPureToneADC();
-    }
+    xTaskCreatePinnedToCore(telemetryTask, "spi_telemetry", 4096, nullptr, 1, &telemetryTaskHandle, 0);
+    xTaskCreatePinnedToCore(controlTask, "navcon_control", 8192, nullptr, 4, &controlTaskHandle, 1);
+    Serial.println("Tasks started: comms+telemetry on core 0, NAVCON control on core 1");
+}
 
-    // Send periodic SPI updates to WiFi ESP32 (200Hz rate = 5ms interval)
-    static unsigned long lastSPIUpdate = 0;
-    if (millis() - lastSPIUpdate >= 5) { // 200Hz update rate (5ms interval)
-        sendSPIUpdates();
-        lastSPIUpdate = millis();
+// ==================== ARDUINO LOOP ====================
+// All work runs in the tasks created by setup(); free the loop task's stack
+void loop() {
+    vTaskDelete(nullptr);
+}
+
+// ==================== CONTROL TASK (core 1) ====================
+// SS port frame - returns false to end the control cycle (EOM latched)
+bool handleSSFrame(const SCSPacket& packet) {
+    // If EOM detected, do ABSOLUTELY NOTHING - no forwarding, no processing, NOTHING
+    if (systemStatus.eomLatched) {
+        return false;  // STOP - do NOTHING after EOM
     }
 
-    SCSPacket packet;
-    
-    // ==================== HANDLE SS PACKETS ====================
-    if (ssHandler.readPacket(packet)) {
-        // If EOM detected, do ABSOLUTELY NOTHING - no forwarding, no processing, NOTHING
-        if (systemStatus.eomLatched) {
-            return;  // STOP - do NOTHING after EOM
-        }
+    // printPacket(packet, "RX SS:");  // Disabled for performance
+    systemStatus.lastSSPacket = "Received SS packet";
 
-        // printPacket(packet, "RX SS:");  // Disabled for performance
-        systemStatus.lastSSPacket = "Received SS packet";
+    // Cache sensor data for SPI display
+    SystemState pktState = getSystemState(packet.control);
+    SubsystemID pktSub = getSubsystemID(packet.control);
+    uint8_t pktIST = getInternalState(packet.control);
 
-        // Cache sensor data for SPI display
-        SystemState pktState = getSystemState(packet.control);
-        SubsystemID pktSub = getSubsystemID(packet.control);
-        uint8_t pktIST = getInternalState(packet.control);
+    // Log ALL SS packet data for debugging
+    // Serial.printf("[SS-PKT] State=%d Sub=%d IST=%d | dat1=%d dat0=%d dec=%d\n",
+    //              pktState, pktSub, pktIST, packet.dat1, packet.dat0, packet.dec);
 
-        // Log ALL SS packet data for debugging
-        // Serial.printf("[SS-PKT] State=%d Sub=%d IST=%d | dat1=%d dat0=%d dec=%d\n",
-        //              pktState, pktSub, pktIST, packet.dat1, packet.dat0, packet.dec);
+    // Check for end-of-maze (SS sends IST=3 in MAZE state)
+    if (pktSub == SUB_SS && pktState == SYS_MAZE && pktIST == 3) {
+        if (!systemStatus.eomLatched) {
+            Serial.println("🎉 END OF MAZE DETECTED (via Serial1) - Setting flags!");
 
-        // Check for end-of-maze (SS sends IST=3 in MAZE state)
-        if (pktSub == SUB_SS && pktState == SYS_MAZE && pktIST == 3) {
-            if (!systemStatus.eomLatched) {
-                Serial.println("🎉 END OF MAZE DETECTED (via Serial1) - Setting flags!");
+            // Set end of maze flags ONCE
+            cacheSet(spiDataCache.endOfMazeDetected, true, TELEM_END_OF_MAZE);
+            systemStatus.eomLatched = true;
 
-                // Set end of maze flags ONCE
-                spiDataCache.endOfMazeDetected = true;
-                systemStatus.eomLatched = true;
+            // Close the flight log; it streams to the WiFi ESP32 once flushed
+            flightRecorderRequestUpload(false);
 
-                // Transition SNC to IDLE (but don't send IDLE packet)
-                systemStatus.currentSystemState = SYS_IDLE;
-                systemStatus.nextExpectedSubsystem = SUB_SNC;
-                systemStatus.nextExpectedIST = 0;
+            // This run's map becomes the route for the next one
+            mazeRouteSaveRun();
 
-                // Send WiFi notification ONCE
-                spi_comm.sendSensorColors(COLOR_RED, COLOR_RED, COLOR_RED);
-                delayMicroseconds(500);
-                spi_comm.sendEndOfMaze();
+            // Transition SNC to IDLE (but don't send IDLE packet)
+            systemStatus.currentSystemState = SYS_IDLE;
+            systemStatus.nextExpectedSubsystem = SUB_SNC;
+            systemStatus.nextExpectedIST = 0;
 
-                // FORWARD the end-of-maze packet to MDPS (opposite port)
-                mdpsHandler.sendPacket(packet);
-                Serial.println("📤 EOM packet forwarded to MDPS");
+            // Send WiFi notification ONCE (all RED sensors emphasise completion)
+            cacheSet(spiDataCache.sensor1_color, (uint8_t)COLOR_RED, TELEM_COLORS);
+            cacheSet(spiDataCache.sensor2_color, (uint8_t)COLOR_RED, TELEM_COLORS);
+            cacheSet(spiDataCache.sensor3_color, (uint8_t)COLOR_RED, TELEM_COLORS);
+            requestTelemetry();
 
-                Serial.println("EOM flags set. SNC transitioned to IDLE. SNC will NOT transmit any packets.");
-            }
+            // FORWARD the end-of-maze packet to MDPS (opposite port)
+            // Flushed: SNC goes silent after this, so it must be on the wire
+            queueTransmit(packet, PORT_MDPS, true);
+            Serial.println("📤 EOM packet forwarded to MDPS");
 
-            // STOP - SNC does NOTHING after EOM
-            return;
+            Serial.println("EOM flags set. SNC transitioned to IDLE. SNC will NOT transmit any packets.");
         }
 
-        // Extract sensor data based on SS IST
-        if (pktSub == SUB_SS) {
-            switch(pktIST) {
-                case 1: // Sensor colors in dat0 and dat1
-                    // Colors are packed in 16 bits: (dat1 << 8) | dat0
-                    // Each color is 3 bits: S1 (bits 6-8), S2 (bits 3-5), S3 (bits 0-2)
-                    // Color values: 0=WHITE, 1=RED, 2=GREEN, 3=BLUE, 4=BLACK
-                    {
-                        uint16_t colorData = (packet.dat1 << 8) | packet.dat0;
-                        spiDataCache.sensor1_color = (colorData >> 6) & 0x07;  // Sensor 1
-                        spiDataCache.sensor2_color = (colorData >> 3) & 0x07;  // Sensor 2
-                        spiDataCache.sensor3_color = colorData & 0x07;          // Sensor 3
-                        spiDataCache.hasNewSensorData = true;
-
-                        // Serial.printf("[SS-COLOR] State=%d Received: S1=%d S2=%d S3=%d (colorData=0x%04X)\n",
-                        //              systemStatus.currentSystemState,
-                        //              spiDataCache.sensor1_color, spiDataCache.sensor2_color,
-                        //              spiDataCache.sensor3_color, colorData);  // Disabled for performance
-
-                        // Send immediately
-                        spi_comm.sendSensorColors(
-                            (Color)spiDataCache.sensor1_color,
-                            (Color)spiDataCache.sensor2_color,
-                            (Color)spiDataCache.sensor3_color
-                        );
-                    }
-                    break;
-
-                case 2: // Incidence angle in dat1
-                    spiDataCache.incidence_angle = packet.dat1;
-                    // Serial.printf("  -> Incidence angle: %d degrees\n", packet.dat1);
-                    // Send angle data immediately
-                    spi_comm.sendIncidenceAngle(packet.dat1, 0, 0, 0);
-                    break;
-
-                default:
-                    // Serial.printf("  -> Unknown SS IST=%d\n", pktIST);
-                    break;
-            }
+        // STOP - SNC does NOTHING after EOM
+        return false;
+    }
+
+    // Extract sensor data based on SS IST
+    if (pktSub == SUB_SS) {
+        switch(pktIST) {
+            case 1: // Sensor colors in dat0 and dat1
+                // Colors are packed in 16 bits: (dat1 << 8) | dat0
+                // Each color is 3 bits: S1 (bits 6-8), S2 (bits 3-5), S3 (bits 0-2)
+                // Color values: 0=WHITE, 1=RED, 2=GREEN, 3=BLUE, 4=BLACK
+                {
+                    uint16_t colorData = (packet.dat1 << 8) | packet.dat0;
+                    cacheSet(spiDataCache.sensor1_color, (colorData >> 6) & 0x07, TELEM_COLORS);  // Sensor 1
+                    cacheSet(spiDataCache.sensor2_color, (colorData >> 3) & 0x07, TELEM_COLORS);  // Sensor 2
+                    cacheSet(spiDataCache.sensor3_color, colorData & 0x07, TELEM_COLORS);         // Sensor 3
+
+                    // Serial.printf("[SS-COLOR] State=%d Received: S1=%d S2=%d S3=%d (colorData=0x%04X)\n",
+                    //              systemStatus.currentSystemState,
+                    //              spiDataCache.sensor1_color, spiDataCache.sensor2_color,
+                    //              spiDataCache.sensor3_color, colorData);  // Disabled for performance
+
+                    // Send immediately, but only if the colours changed
+                    requestTelemetry();
+                }
+                break;
+
+            case 2: // Incidence angle in dat1
+                cacheSet(spiDataCache.incidence_angle, (uint16_t)packet.dat1, TELEM_INCIDENCE);
+                // Serial.printf("  -> Incidence angle: %d degrees\n", packet.dat1);
+                // Send angle data immediately (if changed)
+                requestTelemetry();
+                break;
+
+            default:
+                // Serial.printf("  -> Unknown SS IST=%d\n", pktIST);
+                break;
         }
-        // Process MDPS packets that come through SS serial (forwarded from MDPS)
-        else if (pktSub == SUB_MDPS) {
-            switch(pktIST) {
-                case 1: // Battery/Level indicator
-                    // Ignore - not needed for display
-                    break;
-
-                case 2: // Rotation angle (NAVCON)
-                    spiDataCache.rotation_angle = (packet.dat1 << 8) | packet.dat0;
-                    spiDataCache.rotation_direction = packet.dec;
-                    spiDataCache.hasNewRotation = true;
-                    break;
-
-                case 3: // Movement speeds (NAVCON forward)
-                    spiDataCache.wheelSpeedR = packet.dat1;
-                    spiDataCache.wheelSpeedL = packet.dat0;
-                    spiDataCache.wheelSetpoint = packet.dat1;
-                    spiDataCache.hasNewMovementData = true;
-                    // Send immediately to display
-                    spi_comm.sendWheelSpeeds(packet.dat1, packet.dat0, packet.dat1);
-                    break;
-
-                case 4: // Distance traveled
-                    spiDataCache.distance_mm = (packet.dat1 << 8) | packet.dat0;
-                    break;
-
-                default:
-                    break;
-            }
+    }
+    // Process MDPS packets that come through SS serial (forwarded from MDPS)
+    else if (pktSub == SUB_MDPS) {
+        switch(pktIST) {
+            case 1: // Battery/Level indicator
+                // Ignore - not needed for display
+                break;
+
+            case 2: // Rotation angle (NAVCON)
+                cacheSet(spiDataCache.rotation_angle, (uint16_t)((packet.dat1 << 8) | packet.dat0), TELEM_ROTATION);
+                cacheSet(spiDataCache.rotation_direction, packet.dec, TELEM_ROTATION);
+                break;
+
+            case 3: // Movement speeds (NAVCON forward)
+                cacheSet(spiDataCache.wheelSpeedR, packet.dat1, TELEM_WHEELS);
+                cacheSet(spiDataCache.wheelSpeedL, packet.dat0, TELEM_WHEELS);
+                cacheSet(spiDataCache.wheelSetpoint, packet.dat1, TELEM_WHEELS);
+                // Send immediately to display (if changed)
+                requestTelemetry();
+                break;
+
+            case 4: // Distance traveled
+                cacheSet(spiDataCache.distance_mm, (uint16_t)((packet.dat1 << 8) | packet.dat0), TELEM_DISTANCE);
+                break;
+
+            default:
+                break;
         }
+    }
 
-        // Process state transitions
-        processStateTransition(packet);
+    // Process state transitions
+    processStateTransition(packet);
+    traceMark(TRACE_STATE);
 
-        // Update NAVCON with incoming data
-        handleNavconIncomingData(packet);
+    // Update NAVCON with incoming data
+    handleNavconIncomingData(packet);
+    traceMark(TRACE_NAVCON_RX);
+
+    // Forward to MDPS
+    queueTransmit(packet, PORT_MDPS);
+    // Serial.println("Forwarded SS packet to MDPS");  // Disabled for performance
+
+    return true;
+}
 
-        // Forward to MDPS
-        mdpsHandler.sendPacket(packet);
-        // Serial.println("Forwarded SS packet to MDPS");  // Disabled for performance
+// MDPS port frame - returns false to end the control cycle (EOM latched)
+bool handleMDPSFrame(const SCSPacket& packet) {
+    // If EOM detected, do ABSOLUTELY NOTHING - no forwarding, no processing, NOTHING
+    if (systemStatus.eomLatched) {
+        return false;  // STOP - do NOTHING after EOM
     }
-    
-    // ==================== HANDLE MDPS PACKETS ====================
-    if (mdpsHandler.readPacket(packet)) {
-        // If EOM detected, do ABSOLUTELY NOTHING - no forwarding, no processing, NOTHING
-        if (systemStatus.eomLatched) {
-            return;  // STOP - do NOTHING after EOM
-        }
 
-        // printPacket(packet, "RX MDPS:");  // Disabled for performance
-        systemStatus.lastMDPSPacket = "Received MDPS packet";
+    // printPacket(packet, "RX MDPS:");  // Disabled for performance
+    systemStatus.lastMDPSPacket = "Received MDPS packet";
 
-        // Cache movement data for SPI display
-        SystemState pktState = getSystemState(packet.control);
-        SubsystemID pktSub = getSubsystemID(packet.control);
-        uint8_t pktIST = getInternalState(packet.control);
+    // Cache movement data for SPI display
+    SystemState pktState = getSystemState(packet.control);
+    SubsystemID pktSub = getSubsystemID(packet.control);
+    uint8_t pktIST = getInternalState(packet.control);
 
-        // Log ALL MDPS packet data for debugging
-        // Serial.printf("[MDPS-PKT] State=%d Sub=%d IST=%d | dat1=%d dat0=%d dec=%d\n",
-        //              pktState, pktSub, pktIST, packet.dat1, packet.dat0, packet.dec);
+    // Log ALL MDPS packet data for debugging
+    // Serial.printf("[MDPS-PKT] State=%d Sub=%d IST=%d | dat1=%d dat0=%d dec=%d\n",
+    //              pktState, pktSub, pktIST, packet.dat1, packet.dat0, packet.dec);
 
-        // Check for end-of-maze (SS sends IST=3 in MAZE state) - same check as SS handler
-        if (pktSub == SUB_SS && pktState == SYS_MAZE && pktIST == 3) {
-            if (!systemStatus.eomLatched) {
-                Serial.println("🎉 END OF MAZE DETECTED (via Serial2) - Setting flags!");
+    // Check for end-of-maze (SS sends IST=3 in MAZE state) - same check as SS handler
+    if (pktSub == SUB_SS && pktState == SYS_MAZE && pktIST == 3) {
+        if (!systemStatus.eomLatched) {
+            Serial.println("🎉 END OF MAZE DETECTED (via Serial2) - Setting flags!");
 
-                // Set end of maze flags ONCE
-                spiDataCache.endOfMazeDetected = true;
-                systemStatus.eomLatched = true;
+            // Set end of maze flags ONCE
+            cacheSet(spiDataCache.endOfMazeDetected, true, TELEM_END_OF_MAZE);
+            systemStatus.eomLatched = true;
 
-                // Transition SNC to IDLE (but don't send IDLE packet)
-                systemStatus.currentSystemState = SYS_IDLE;
-                systemStatus.nextExpectedSubsystem = SUB_SNC;
-                systemStatus.nextExpectedIST = 0;
+            // Close the flight log; it streams to the WiFi ESP32 once flushed
+            flightRecorderRequestUpload(false);
 
-                // Send WiFi notification ONCE
-                spi_comm.sendSensorColors(COLOR_RED, COLOR_RED, COLOR_RED);
-                delayMicroseconds(500);
-                spi_comm.sendEndOfMaze();
+            // This run's map becomes the route for the next one
+            mazeRouteSaveRun();
 
-                Serial.println("EOM flags set. SNC transitioned to IDLE. SNC will NOT transmit any packets.");
-            }
+            // Transition SNC to IDLE (but don't send IDLE packet)
+            systemStatus.currentSystemState = SYS_IDLE;
+            systemStatus.nextExpectedSubsystem = SUB_SNC;
+            systemStatus.nextExpectedIST = 0;
 
-            // STOP - do NOT forward anything after EOM
-            return;
+            // Send WiFi notification ONCE (all RED sensors emphasise completion)
+            cacheSet(spiDataCache.sensor1_color, (uint8_t)COLOR_RED, TELEM_COLORS);
+            cacheSet(spiDataCache.sensor2_color, (uint8_t)COLOR_RED, TELEM_COLORS);
+            cacheSet(spiDataCache.sensor3_color, (uint8_t)COLOR_RED, TELEM_COLORS);
+            requestTelemetry();
+
+            Serial.println("EOM flags set. SNC transitioned to IDLE. SNC will NOT transmit any packets.");
         }
 
-        // Process packets by subsystem (MDPS packets AND forwarded SS packets)
-        if (pktSub == SUB_MDPS) {
-            // MDPS packets - DIFFERENT ISTs have DIFFERENT meanings!
-            switch(pktIST) {
-                case 1: // Battery/Level indicator (NOT wheel speeds!)
-                    // dat1 = battery level (e.g., 90, 80)
-                    // dat0 = reserved/level indicator
-                    // DO NOT treat as wheel speeds - ignore this packet
-                    // Serial.printf("  -> Battery level: %d%%\n", packet.dat1);
-                    break;
-
-                case 2: // Rotation angle (NAVCON)
-                    // dat0 contains rotation angle in degrees (low byte)
-                    // dat1 contains rotation angle (high byte) or direction
-                    // dec contains direction (2=LEFT/CCW, 3=RIGHT/CW)
-                    spiDataCache.rotation_angle = (packet.dat1 << 8) | packet.dat0;
-                    spiDataCache.rotation_direction = packet.dec;
-                    spiDataCache.hasNewRotation = true;
-                    // Serial.printf("  -> Rotation: %d degrees, direction=%d\n",
-                    //              spiDataCache.rotation_angle, spiDataCache.rotation_direction);
-                    break;
-
-                case 3: // Movement speeds (NAVCON forward)
-                    spiDataCache.wheelSpeedR = packet.dat1;
-                    spiDataCache.wheelSpeedL = packet.dat0;
-                    spiDataCache.wheelSetpoint = packet.dat1; // Use dat1 as setpoint
-                    spiDataCache.hasNewMovementData = true;
-                    // Serial.printf("  -> Movement speeds: R=%d L=%d\n", packet.dat1, packet.dat0);
-                    // Send immediately to display
-                    spi_comm.sendWheelSpeeds(packet.dat1, packet.dat0, packet.dat1);
-                    break;
-
-                case 4: // Distance traveled
-                    // Distance is in dat0 (low byte) for short distances
-                    // or (dat1 << 8) | dat0 for longer distances
-                    spiDataCache.distance_mm = (packet.dat1 << 8) | packet.dat0;
-                    // Serial.printf("  -> Distance: %d mm\n", spiDataCache.distance_mm);
-                    // Don't send here - will be sent in periodic update to avoid lag
-                    break;
-
-                default:
-                    // Serial.printf("  -> Unknown MDPS IST=%d\n", pktIST);
-                    break;
-            }
+        // STOP - do NOT forward anything after EOM
+        return false;
+    }
+
+    // Process packets by subsystem (MDPS packets AND forwarded SS packets)
+    if (pktSub == SUB_MDPS) {
+        // MDPS packets - DIFFERENT ISTs have DIFFERENT meanings!
+        switch(pktIST) {
+            case 1: // Battery/Level indicator (NOT wheel speeds!)
+                // dat1 = battery level (e.g., 90, 80)
+                // dat0 = reserved/level indicator
+                // DO NOT treat as wheel speeds - ignore this packet
+                // Serial.printf("  -> Battery level: %d%%\n", packet.dat1);
+                break;
+
+            case 2: // Rotation angle (NAVCON)
+                // dat0 contains rotation angle in degrees (low byte)
+                // dat1 contains rotation angle (high byte) or direction
+                // dec contains direction (2=LEFT/CCW, 3=RIGHT/CW)
+                cacheSet(spiDataCache.rotation_angle, (uint16_t)((packet.dat1 << 8) | packet.dat0), TELEM_ROTATION);
+                cacheSet(spiDataCache.rotation_direction, packet.dec, TELEM_ROTATION);
+                // Serial.printf("  -> Rotation: %d degrees, direction=%d\n",
+                //              spiDataCache.rotation_angle, spiDataCache.rotation_direction);
+                break;
+
+            case 3: // Movement speeds (NAVCON forward)
+                cacheSet(spiDataCache.wheelSpeedR, packet.dat1, TELEM_WHEELS);
+                cacheSet(spiDataCache.wheelSpeedL, packet.dat0, TELEM_WHEELS);
+                cacheSet(spiDataCache.wheelSetpoint, packet.dat1, TELEM_WHEELS); // Use dat1 as setpoint
+                // Serial.printf("  -> Movement speeds: R=%d L=%d\n", packet.dat1, packet.dat0);
+                // Send immediately to display (if changed)
+                requestTelemetry();
+                break;
+
+            case 4: // Distance traveled
+                // Distance is in dat0 (low byte) for short distances
+                // or (dat1 << 8) | dat0 for longer distances
+                cacheSet(spiDataCache.distance_mm, (uint16_t)((packet.dat1 << 8) | packet.dat0), TELEM_DISTANCE);
+                // Serial.printf("  -> Distance: %d mm\n", spiDataCache.distance_mm);
+                // Don't send here - will be sent in periodic update to avoid lag
+                break;
+
+            default:
+                // Serial.printf("  -> Unknown MDPS IST=%d\n", pktIST);
+                break;
         }
-        else if (pktSub == SUB_SS) {
-            // SS packets forwarded through MDPS - process sensor data
-            switch(pktIST) {
-                case 1: // Sensor colors in dat0 and dat1
-                    {
-                        uint16_t colorData = (packet.dat1 << 8) | packet.dat0;
-                        spiDataCache.sensor1_color = (colorData >> 6) & 0x07;  // Sensor 1
-                        spiDataCache.sensor2_color = (colorData >> 3) & 0x07;  // Sensor 2
-                        spiDataCache.sensor3_color = colorData & 0x07;          // Sensor 3
-                        spiDataCache.hasNewSensorData = true;
-
-                        // Serial.printf("[MDPS-SS-COLOR] State=%d Received: S1=%d S2=%d S3=%d (colorData=0x%04X)\n",
-                        //              systemStatus.currentSystemState,
-                        //              spiDataCache.sensor1_color, spiDataCache.sensor2_color,
-                        //              spiDataCache.sensor3_color, colorData);  // Disabled for performance
-
-                        // Send immediately
-                        spi_comm.sendSensorColors(
-                            (Color)spiDataCache.sensor1_color,
-                            (Color)spiDataCache.sensor2_color,
-                            (Color)spiDataCache.sensor3_color
-                        );
-                    }
-                    break;
-
-                case 2: // Incidence angle
-                    spiDataCache.incidence_angle = packet.dat1;
-                    spi_comm.sendIncidenceAngle(packet.dat1, 0, 0, 0);
-                    break;
-            }
+    }
+    else if (pktSub == SUB_SS) {
+        // SS packets forwarded through MDPS - process sensor data
+        switch(pktIST) {
+            case 1: // Sensor colors in dat0 and dat1
+                {
+                    uint16_t colorData = (packet.dat1 << 8) | packet.dat0;
+                    cacheSet(spiDataCache.sensor1_color, (colorData >> 6) & 0x07, TELEM_COLORS);  // Sensor 1
+                    cacheSet(spiDataCache.sensor2_color, (colorData >> 3) & 0x07, TELEM_COLORS);  // Sensor 2
+                    cacheSet(spiDataCache.sensor3_color, colorData & 0x07, TELEM_COLORS);         // Sensor 3
+
+                    // Serial.printf("[MDPS-SS-COLOR] State=%d Received: S1=%d S2=%d S3=%d (colorData=0x%04X)\n",
+                    //              systemStatus.currentSystemState,
+                    //              spiDataCache.sensor1_color, spiDataCache.sensor2_color,
+                    //              spiDataCache.sensor3_color, colorData);  // Disabled for performance
+
+                    // Send immediately, but only if the colours changed
+                    requestTelemetry();
+                }
+                break;
+
+            case 2: // Incidence angle
+                cacheSet(spiDataCache.incidence_angle, (uint16_t)packet.dat1, TELEM_INCIDENCE);
+                requestTelemetry();
+                break;
         }
+    }
 
-        // Process state transitions
-        processStateTransition(packet);
+    // Process state transitions
+    processStateTransition(packet);
+    traceMark(TRACE_STATE);
 
-        // Update NAVCON with incoming data
-        handleNavconIncomingData(packet);
+    // Update NAVCON with incoming data
+    handleNavconIncomingData(packet);
+    traceMark(TRACE_NAVCON_RX);
 
-        // Forward to SS
-        ssHandler.sendPacket(packet);
-        // Serial.println("Forwarded MDPS packet to SS");  // Disabled for performance
+    // Forward to SS - except the MDPS odometry record, which only the SNC reads
+    bool odometry = pktSub == SUB_MDPS &&
+                    (pktIST == MDPS_IST_ODOMETRY_RIGHT || pktIST == MDPS_IST_ODOMETRY_LEFT);
+    if (!odometry) {
+        queueTransmit(packet, PORT_SS);
     }
-    
+    // Serial.println("Forwarded MDPS packet to SS");  // Disabled for performance
+
+    return true;
+}
+
+// Copy NAVCON-owned values into the SPI cache (telemetry reads only the cache)
+void publishTelemetry() {
+    // System state and touch/tone flags (only flagged when they change)
+    cacheSet(spiDataCache.system_state, (uint8_t)systemStatus.currentSystemState, TELEM_SYSTEM_STATE);
+    cacheSet(spiDataCache.system_ist, systemStatus.nextExpectedIST, TELEM_SYSTEM_STATE);
+    cacheSet(spiDataCache.touchDetected, systemStatus.touchDetected, TELEM_TOUCH);
+    cacheSet(spiDataCache.pureToneDetected, systemStatus.pureToneDetected, TELEM_PURE_TONE);
+
+    // Update cache from NAVCON's current_colors (ONLY in MAZE state - NAVCON is active)
+    // In CAL state, colors come directly from SS packets and should NOT be overwritten
+    extern uint8_t current_colors[3]; // From navcon_core.h
+    extern uint8_t received_incidence_angle; // From navcon_core.h
+    extern uint16_t current_rotation; // From navcon_core.h
+    extern uint8_t current_rotation_dir; // From navcon_core.h
+    extern uint16_t current_distance; // From navcon_core.h
+
+    // Only use NAVCON colors in MAZE state (when NAVCON is running)
+    if (systemStatus.currentSystemState == SYS_MAZE) {
+        cacheSet(spiDataCache.sensor1_color, current_colors[0], TELEM_COLORS);
+        cacheSet(spiDataCache.sensor2_color, current_colors[1], TELEM_COLORS);
+        cacheSet(spiDataCache.sensor3_color, current_colors[2], TELEM_COLORS);
+        cacheSet(spiDataCache.incidence_angle, (uint16_t)received_incidence_angle, TELEM_INCIDENCE);
+    }
+    // In other states (CAL, IDLE, SOS), colors come from SS packets and are already in cache
+
+    // Update rotation data from NAVCON if available
+    if (current_rotation > 0) {
+        cacheSet(spiDataCache.rotation_angle, current_rotation, TELEM_ROTATION);
+        cacheSet(spiDataCache.rotation_direction, current_rotation_dir, TELEM_ROTATION);
+    }
+
+    // Update distance from NAVCON (smoother than packet-only updates)
+    if (current_distance > 0) {
+        cacheSet(spiDataCache.distance_mm, current_distance, TELEM_DISTANCE);
+    }
+
+    // Sync end-of-maze flag from system status (in case cache wasn't set)
+    if (systemStatus.eomLatched && !spiDataCache.endOfMazeDetected) {
+        cacheSet(spiDataCache.endOfMazeDetected, true, TELEM_END_OF_MAZE);
+        LOG(SYSTEM, INFO, "[EOM-SYNC] Syncing eomLatched -> spiDataCache.endOfMazeDetected");
+    }
+
+    // After EOM keep all sensors RED to emphasise completion
+    if (spiDataCache.endOfMazeDetected) {
+        cacheSet(spiDataCache.sensor1_color, (uint8_t)COLOR_RED, TELEM_COLORS);
+        cacheSet(spiDataCache.sensor2_color, (uint8_t)COLOR_RED, TELEM_COLORS);
+        cacheSet(spiDataCache.sensor3_color, (uint8_t)COLOR_RED, TELEM_COLORS);
+    }
+}
+
+// ==================== SOS FAST PATH ====================
+// A pure tone in MAZE goes out as MAZE:SNC:IST1 (dat1=1) straight away, out
+// of turn, so the MDPS stops without waiting for the rest of the round. The
+// flag stays set if the outbox is full, so the next cycle tries again.
+void injectSOSTransition() {
+    if (systemStatus.currentSystemState != SYS_MAZE || !systemStatus.pureToneDetected ||
+        systemStatus.eomLatched) {
+        return;
+    }
+
+    SCSPacket packet;
+    packet.control = createControlByte(SYS_MAZE, SUB_SNC, 1);
+    packet.dat1 = 1;
+    packet.dat0 = 0;
+    packet.dec = 0;
+
+    if (!queueTransmitUrgent(packet, PORT_SS | PORT_MDPS)) {
+        return;
+    }
+    systemStatus.pureToneDetected = false;
+    sosStats.stops++;
+    sosStats.inject_us = micros();
+    sosStats.pending = true;
+
+    LOG(SYSTEM, INFO, "SOS: pure tone -> stop sent ahead of the round (expected was %s:IST%d)",
+        subsystemToString(systemStatus.nextExpectedSubsystem), systemStatus.nextExpectedIST);
+    processStateTransition(packet);
+    systemStatus.lastSNCPacket = "Sent SNC packet";
+}
+
+// The MDPS sends SOS:MDPS:IST4 once its wheels have stopped turning
+void noteSOSHalt(const InboundFrame& frame) {
+    if (!sosStats.pending || frame.packet.control != createControlByte(SYS_SOS, SUB_MDPS, 4)) {
+        return;
+    }
+    uint32_t latency = frame.rx_us - sosStats.inject_us;
+    sosStats.pending = false;
+    sosStats.confirmed++;
+    sosStats.last_us = latency;
+    if (latency > sosStats.max_us) sosStats.max_us = latency;
+    LOG(SYSTEM, INFO, "SOS: MDPS halted %lu ms after the stop was sent", (unsigned long)(latency / 1000));
+}
+
+// One pass of the old loop(): wait briefly for a frame, then run the state machine
+void runControlCycle() {
+    InboundFrame frame;
+    bool haveFrame = xQueueReceive(sncInbox, &frame, pdMS_TO_TICKS(CONTROL_IDLE_WAIT_MS)) == pdPASS;
+    uint32_t cycleStart = micros();
+
+    // Flight recorder erases (tens of ms with the cache off on both cores) wait until off the maze
+    flightRecorderSetIdle(systemStatus.currentSystemState != SYS_MAZE);
+
+    // Dashboard commands taken off SPI by the telemetry task
+    checkWiFiCommands();
+
+    // Check pure tone ADC input (every loop for high responsiveness)
+    checkPureToneADC();
+
+    // In MAZE the tone (ADC, WiFi or serial P) skips the SNC's turn
+    injectSOSTransition();
+
+    // ==================== HANDLE SS / MDPS FRAMES ====================
+    if (haveFrame) {
+        traceFrameReceived(cycleStart - frame.rx_us);
+        if (frame.port == PORT_MDPS) noteSOSHalt(frame);
+
+        bool proceed = (frame.port == PORT_SS) ? handleSSFrame(frame.packet)
+                                               : handleMDPSFrame(frame.packet);
+        if (!proceed) {
+            return;
+        }
+    }
+
+    publishTelemetry();
+
     // ==================== SEND SNC PACKETS ====================
     if (shouldSendSNCPacket()) {
         if (shouldSendSNCPacketNow()) {
@@ -410,8 +769,9 @@ void loop() {
                 processStateTransition(sncPacket);
 
                 // Send to both subsystems
-                ssHandler.sendPacket(sncPacket);
-                mdpsHandler.sendPacket(sncPacket);
+                queueTransmit(sncPacket, PORT_SS | PORT_MDPS);
+
+                traceReplySent();
 
                 // Serial.println("SNC packet sent");  // Disabled for performance
                 
@@ -427,22 +787,26 @@ void loop() {
     // ==================== PERIODIC STATUS UPDATES ====================
     updateStatusDisplay();
 
-    // Delay removed - timing controlled by millis() checks for maximum responsiveness
+    uint32_t cycle = micros() - cycleStart;
+    if (cycle > taskStats.cycle_max_us) taskStats.cycle_max_us = cycle;
 }
 
 // ==================== INTEGRATION NOTES ====================
 /*
  * SYSTEM ARCHITECTURE SUMMARY:
  * 
- * 1. **Main Loop (this file)**:
- *    - Handles UART communication
- *    - Coordinates all modules
- *    - Manages packet forwarding
+ * 1. **Tasks (this file)**:
+ *    - commsTask: UART RX/TX for both ports
+ *    - controlTask: coordinates all modules, packet forwarding
+ *    - telemetryTask: SPI updates to the WiFi ESP32
  * 
  * 2. **NAVCON Module (navcon_core.h/.cpp)**:
  *    - Complete navigation state machine
  *    - Line detection and angle correction
  *    - Called automatically when MAZE:SNC:IST=3
+ *    - Dead-reckoned pose and line/wall map (maze_map.h/.cpp)
+ *    - Second-run route from the stored map (maze_route.h/.cpp, serial O)
+ *    - Forward speed scheduler: VOP_CRUISE on clear white stretches (serial V)
  * 
  * 3. **SCS Protocol (scs_protocol.h/.cpp)**:
  *    - Packet parsing and creation
@@ -455,14 +819,13 @@ void loop() {
  *    - Status reporting
  * 
  * 5. **GPIO Commands (gpio_commands.h/.cpp)**:
- *    - Physical pin handling
- *    - WiFi ESP32 interface
- *    - Command debouncing
+ *    - Dashboard commands from the WiFi ESP32 (SPI MISO, acknowledged)
+ *    - Pure tone detections (GPIO 36)
  * 
  * TESTING WORKFLOW:
  * 1. Upload this code to ESP32
  * 2. Use serial commands (T, P, ?, N) for basic testing
- * 3. Connect WiFi ESP32 to pins 4, 2, 15 for GPIO testing
+ * 3. Connect the WiFi ESP32 SPI lines (18, 19, 23, 5) for dashboard commands
  * 4. Monitor serial output for state transitions
  * 5. Test NAVCON by reaching MAZE state with SNC IST=3
  * 
@@ -477,154 +840,197 @@ void loop() {
  * - Optimized update rates to prevent system overload
  */
 
-// ==================== SPI COMMUNICATION FUNCTIONS ====================
-// Called every 10ms from main loop - sends fast periodic updates (100Hz)
+// ==================== TELEMETRY TASK (core 0) ====================
+// Runs every SPI_UPDATE_INTERVAL_MS, or early when requestTelemetry() wakes it.
+// Only this task touches spi_comm once setup() has finished.
 void sendSPIUpdates() {
     unsigned long currentTime = millis();
     spiTiming.updateCounter++;
 
-    // Send system state (every call = 100Hz)
-    spi_comm.sendSystemState(
-        (SystemState)systemStatus.currentSystemState,
-        (Subsystem)SUB_SNC,
-        systemStatus.nextExpectedIST
-    );
-    delayMicroseconds(500); // Small delay between SPI packets
-
-    // Send touch/tone status if detected
-    if (systemStatus.touchDetected) {
-        spi_comm.sendTouchDetected(true, (SystemState)systemStatus.currentSystemState, 140);
-        delayMicroseconds(500);
+    // Take any dashboard command the slave clocked back so its ack joins this batch
+    spi_comm.poll();
+
+    // Take the dirty records and a consistent copy of the cache in one go
+    SPIDataCache snapshot;
+    taskENTER_CRITICAL(&cacheMux);
+    // Periodic keyframe: resend every state record regardless of change
+    bool keyframe = currentTime - spiDataCache.lastKeyframe >= SPI_KEYFRAME_INTERVAL_MS;
+    if (keyframe) {
+        spiDataCache.dirty |= TELEM_ALL & ~TELEM_EVENTS;
+        spiDataCache.lastKeyframe = currentTime;
     }
-    if (systemStatus.pureToneDetected) {
-        spi_comm.sendPureTone(true, 1000, 80);
-        delayMicroseconds(500);
+    snapshot = spiDataCache;
+    spiDataCache.dirty = 0;
+    taskEXIT_CRITICAL(&cacheMux);
+
+    // Everything below goes out as one PKT_BATCH frame (single CS assertion)
+    spi_comm.beginBatch();
+
+    // Only the records that changed (or all of them on a keyframe)
+    sendTelemetryRecords(snapshot, snapshot.dirty);
+
+    // Pose when it moved (rate limited), and on keyframes; new map encounters as they come
+    MazePose pose;
+    if ((keyframe || currentTime - spiTiming.lastPose >= MAP_POSE_INTERVAL_MS) &&
+        mazeMapTakePose(pose, keyframe)) {
+        PosePayload payload;
+        payload.timestamp = currentTime;
+        payload.x_mm = (int16_t)lroundf(pose.x_mm);
+        payload.y_mm = (int16_t)lroundf(pose.y_mm);
+        payload.heading_ddeg = (int16_t)lroundf(pose.heading_deg * 10.0f);
+        payload.lines = pose.lines;
+        payload.travelled_mm = pose.travelled_mm;
+        payload.walls = pose.walls;
+        payload.legs = pose.legs;
+        payload.rotations = pose.rotations;
+        memset(payload.reserved, 0, sizeof(payload.reserved));
+        spi_comm.sendPose(payload);
+        spiTiming.lastPose = currentTime;
     }
-
-    // Update cache from NAVCON's current_colors (ONLY in MAZE state - NAVCON is active)
-    // In CAL state, colors come directly from SS packets and should NOT be overwritten
-    extern uint8_t current_colors[3]; // From navcon_core.h
-    extern uint8_t received_incidence_angle; // From navcon_core.h
-    extern uint16_t current_rotation; // From navcon_core.h
-    extern uint8_t current_rotation_dir; // From navcon_core.h
-    extern uint16_t current_distance; // From navcon_core.h
-
-    // Only use NAVCON colors in MAZE state (when NAVCON is running)
-    if (systemStatus.currentSystemState == SYS_MAZE) {
-        spiDataCache.sensor1_color = current_colors[0];
-        spiDataCache.sensor2_color = current_colors[1];
-        spiDataCache.sensor3_color = current_colors[2];
-        spiDataCache.incidence_angle = received_incidence_angle;
+    MapLineRecord line;
+    for (int i = 0; i < 2 && mazeMapTakeLine(line); i++) {
+        MapLinePayload payload;
+        payload.timestamp = currentTime;
+        payload.sequence = line.sequence;
+        payload.x_mm = line.x_mm;
+        payload.y_mm = line.y_mm;
+        payload.heading_deg = line.heading_deg;
+        payload.color = line.color;
+        payload.sensor = line.sensor;
+        payload.angle = line.angle;
+        payload.angle_valid = line.angle_valid;
+        spi_comm.sendMapLine(payload);
     }
-    // In other states (CAL, IDLE, SOS), colors come from SS packets and are already in cache
 
-    // Update rotation data from NAVCON if available
-    if (current_rotation > 0) {
-        spiDataCache.rotation_angle = current_rotation;
-        spiDataCache.rotation_direction = current_rotation_dir;
-    }
-
-    // Update distance from NAVCON (smoother than packet-only updates)
-    if (current_distance > 0) {
-        spiDataCache.distance_mm = current_distance;
-    }
-
-    // Send cached sensor colors (every call = 100Hz)
-    // static unsigned long lastColorDebug = 0;
-    // if (millis() - lastColorDebug > 2000) { // Every 2 seconds
-    //     Serial.printf("[SPI-TX] State=%d Sending colors: S1=%d S2=%d S3=%d\n",
-    //                  systemStatus.currentSystemState,
-    //                  spiDataCache.sensor1_color,
-    //                  spiDataCache.sensor2_color,
-    //                  spiDataCache.sensor3_color);
-    //     lastColorDebug = millis();
-    // }
-    spi_comm.sendSensorColors(
-        (Color)spiDataCache.sensor1_color,
-        (Color)spiDataCache.sensor2_color,
-        (Color)spiDataCache.sensor3_color
-    );
-    delayMicroseconds(500); // Small delay between SPI packets
-
-    // Send cached wheel speeds (every call = 100Hz)
-    spi_comm.sendWheelSpeeds(
-        spiDataCache.wheelSpeedR,
-        spiDataCache.wheelSpeedL,
-        spiDataCache.wheelSetpoint
-    );
-    delayMicroseconds(500); // Small delay between SPI packets
-
-    // Send incidence angle periodically (every call = 100Hz)
-    spi_comm.sendIncidenceAngle(spiDataCache.incidence_angle, 0, 0, 0);
-    delayMicroseconds(500); // Small delay between SPI packets
-
-    // Send rotation data (every call = 100Hz for smooth updates)
-    if (spiDataCache.hasNewRotation || spiDataCache.rotation_angle > 0) {
-        spi_comm.sendRotationAngle(spiDataCache.rotation_angle, spiDataCache.rotation_direction);
-        delayMicroseconds(500);
-        // Clear flag after sending once
-        if (spiDataCache.hasNewRotation) {
-            spiDataCache.hasNewRotation = false;
-        }
-    }
-
-    // Send distance data (every call = 100Hz for smooth updates)
-    spi_comm.sendDistance(spiDataCache.distance_mm);
-    delayMicroseconds(500);
-
-    // Sync end-of-maze flag from system status (in case cache wasn't set)
-    if (systemStatus.eomLatched && !spiDataCache.endOfMazeDetected) {
-        spiDataCache.endOfMazeDetected = true;
-        Serial.println("[EOM-SYNC] Syncing eomLatched -> spiDataCache.endOfMazeDetected");
-    }
-
-    // Send end-of-maze status (every call = 100Hz when detected for reliability)
-    if (spiDataCache.endOfMazeDetected) {
-        // Serial.println("[EOM-SPI] >>> SENDING PKT_END_OF_MAZE NOW <<<");
-        spi_comm.sendEndOfMaze();
-        delayMicroseconds(500);
-        // Also send all RED sensors to emphasize completion
-        spi_comm.sendSensorColors(COLOR_RED, COLOR_RED, COLOR_RED);
-        delayMicroseconds(500);
-    }
-
-    // Debug: Print flag status every second to verify it's set
-    // static unsigned long lastFlagCheck = 0;
-    // if (millis() - lastFlagCheck > 1000) {
-    //     if (spiDataCache.endOfMazeDetected) {
-    //         Serial.printf("[EOM-DEBUG] Flag is SET: eomCache=%d, eomSys=%d, updateCounter=%d\n",
-    //                      spiDataCache.endOfMazeDetected,
-    //                      systemStatus.eomLatched,
-    //                      spiTiming.updateCounter);
-    //     }
-    //     lastFlagCheck = millis();
-    // }
-
-    // Heartbeat every 100th call (1 second at 100Hz)
-    if (spiTiming.updateCounter % 100 == 0) {
+    // Heartbeat and turn latency summary every second
+    if (currentTime - spiTiming.lastHeartbeat >= 1000) {
         spi_comm.sendHeartbeat();
 
-        // Performance monitoring every 10 seconds
-        // if (spiTiming.updateCounter % 1000 == 0) {
-        //     Serial.printf("[SPI] Sent %d updates, Uptime: %lu ms\n",
-        //                  spiTiming.updateCounter, currentTime);
-        // }
+        LatencyStatsPayload latency;
+        traceSnapshot(latency);
+        spi_comm.sendLatencyStats(latency);
+
+        spiTiming.lastHeartbeat = currentTime;
     }
 
-    // Debug messages every 10 seconds (1000 calls at 100Hz)
-    if (spiTiming.updateCounter % 1000 == 0) {
+    // Debug messages every 10 seconds
+    if (currentTime - spiTiming.lastDebugMessage >= 10000) {
         char debugMsg[100];
-        if (spiDataCache.endOfMazeDetected) {
+        if (snapshot.endOfMazeDetected) {
             snprintf(debugMsg, sizeof(debugMsg),
                     "🎉 MAZE COMPLETE! Uptime=%lus",
                     currentTime / 1000);
         } else {
             snprintf(debugMsg, sizeof(debugMsg),
                     "State=%d IST=%d Uptime=%lus",
-                    systemStatus.currentSystemState,
-                    systemStatus.nextExpectedIST,
+                    snapshot.system_state,
+                    snapshot.system_ist,
                     currentTime / 1000);
         }
         spi_comm.sendDebug(0, debugMsg);
+        spiTiming.lastDebugMessage = currentTime;
+    }
+
+    // One buffered log record per tick keeps the batch within a frame or two
+    logDrainToSPI(1);
+
+    spi_comm.sendCommandAck();
+
+    if (spi_comm.commitBatch()) {
+        spiTiming.lastFrame = currentTime;
+    } else if (currentTime - spiTiming.lastFrame >= SPI_COMMAND_POLL_MS) {
+        // Nothing changed - clock a heartbeat so a waiting command gets through
+        spi_comm.sendHeartbeat();
+        spiTiming.lastFrame = currentTime;
+    }
+
+    // Flight log upload goes out as its own frames so a DMA drop is retried
+    flightRecorderPumpSPI();
+}
+
+void telemetryTask(void* param) {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(SPI_UPDATE_INTERVAL_MS));
+        sendSPIUpdates();
     }
-}
\ No newline at end of file
+}
+
+// ==================== COMMS TASK (core 0) ====================
+// Move whole frames from a port's RX ring into the control inbox. A full
+// inbox leaves frames in the ring (whose own drop counter then applies).
+void forwardRxFrames(SerialPacketHandler& handler, uint8_t port) {
+    while (const SCSPacket* packet = handler.peekPacket()) {
+        // Link training replies and keepalive echoes stay on the comms task
+        if (scsIsLinkFrame(packet->control)) {
+            handler.noteLinkFrame();
+            handler.consumePacket();
+            continue;
+        }
+
+        InboundFrame frame;
+        frame.packet = *packet;
+        frame.port = port;
+        frame.rx_us = micros();
+
+        if (xQueueSend(sncInbox, &frame, 0) != pdPASS) {
+            taskStats.inbox_full++;
+            return;
+        }
+        handler.consumePacket();
+        flightRecord(FR_SCS_RX, port, &frame.packet, sizeof(SCSPacket));
+    }
+}
+
+void commsTask(void* param) {
+    OutboundFrame out;
+
+    while (true) {
+        // Woken by the UART RX callbacks or queueTransmit()
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(COMMS_IDLE_WAIT_MS));
+
+        forwardRxFrames(ssHandler, PORT_SS);
+        forwardRxFrames(mdpsHandler, PORT_MDPS);
+
+        // Error burst -> both ends of that link drop one rate (silent peer -> base rate)
+        if (ssHandler.monitorLink()) LOG(SYSTEM, WARN, "SS link fell back to %lu baud", ssHandler.getBaud());
+        if (mdpsHandler.monitorLink()) LOG(SYSTEM, WARN, "MDPS link fell back to %lu baud", mdpsHandler.getBaud());
+
+        // Peer booted late or came back after a fallback -> train up again.
+        // Training blocks this task, so only between runs.
+        if (systemStatus.currentSystemState == SYS_IDLE) {
+            if (ssHandler.retrainLink(SUB_SS)) LOG(SYSTEM, INFO, "SS link retrained to %lu baud", ssHandler.getBaud());
+            if (mdpsHandler.retrainLink(SUB_MDPS)) LOG(SYSTEM, INFO, "MDPS link retrained to %lu baud", mdpsHandler.getBaud());
+        }
+
+        while (xQueueReceive(sncOutbox, &out, 0) == pdPASS) {
+            if (out.ports & PORT_SS) ssHandler.sendPacket(out.packet);
+            if (out.ports & PORT_MDPS) mdpsHandler.sendPacket(out.packet);
+            flightRecord(FR_SCS_TX, out.ports, &out.packet, sizeof(SCSPacket));
+            if (out.flush) {
+                if (out.ports & PORT_SS) ssHandler.flush();
+                if (out.ports & PORT_MDPS) mdpsHandler.flush();
+            }
+        }
+    }
+}
+
+void controlTask(void* param) {
+    while (true) {
+        runControlCycle();
+    }
+}
+
+// ==================== TASK STATISTICS ====================
+void printTaskStats() {
+    Serial.printf("Tasks: cycle max=%luus | inbox full=%lu outbox drops=%lu\n",
+                  (unsigned long)taskStats.cycle_max_us,
+                  (unsigned long)taskStats.inbox_full, (unsigned long)taskStats.outbox_drops);
+    Serial.printf("SOS: %lu stops, %lu halts confirmed | stop->halt last=%lums max=%lums%s\n",
+                  (unsigned long)sosStats.stops, (unsigned long)sosStats.confirmed,
+                  (unsigned long)(sosStats.last_us / 1000), (unsigned long)(sosStats.max_us / 1000),
+                  sosStats.pending ? " (waiting)" : "");
+    Serial.printf("Tasks: stack free comms=%u control=%u telemetry=%u\n",
+                  uxTaskGetStackHighWaterMark(commsTaskHandle),
+                  uxTaskGetStackHighWaterMark(controlTaskHandle),
+                  uxTaskGetStackHighWaterMark(telemetryTaskHandle));
+}
@@ -0,0 +1,146 @@
+/*
+ * MARV SNC - Buffered Debug Logging
+ * Formats log records into a RAM ring buffer so the control loop never
+ * waits on the 460800 baud console. A low-priority task on core 0 drains
+ * the ring to USB; the SPI sink is drained from the SPI update tick.
+ */
+
+#include "debug_log.h"
+#include "spi_protocol.h"
+#include <stdarg.h>
+
+// ==================== RING BUFFER STATE ====================
+// Each sink has its own read counter; a slot is only reused once every
+// enabled sink has read it. Counters run freely and wrap with the index mask.
+#define LOG_SINK_COUNT 2
+#define LOG_SINK_INDEX_USB 0
+#define LOG_SINK_INDEX_SPI 1
+
+static_assert((LOG_RING_ENTRIES & (LOG_RING_ENTRIES - 1)) == 0, "LOG_RING_ENTRIES must be a power of two");
+
+static LogRecord logRing[LOG_RING_ENTRIES];
+static uint32_t logHead = 0;
+static uint32_t logTail[LOG_SINK_COUNT] = {0, 0};
+static uint8_t logSinks = 0;
+static LogStats logStats = {0, 0, 0};
+static portMUX_TYPE logMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t logTaskHandle = nullptr;
+
+static const char* const LOG_MODULE_NAMES[LOG_MOD_COUNT] = {"NAVCON", "EDGE", "TONE", "SYSTEM"};
+static const char* const LOG_LEVEL_NAMES[] = {"", "E", "W", "I", "D"};
+
+// ==================== RING BUFFER HELPERS ====================
+// Caller holds logMux
+static void catchUpDisabledSinks() {
+    if (!(logSinks & LOG_SINK_USB)) logTail[LOG_SINK_INDEX_USB] = logHead;
+    if (!(logSinks & LOG_SINK_SPI)) logTail[LOG_SINK_INDEX_SPI] = logHead;
+}
+
+// Copy the next unread record for a sink out of the ring
+static bool popRecord(uint8_t sink_index, LogRecord& out) {
+    bool available = false;
+
+    taskENTER_CRITICAL(&logMux);
+    if (logTail[sink_index] != logHead) {
+        out = logRing[logTail[sink_index] & (LOG_RING_ENTRIES - 1)];
+        logTail[sink_index]++;
+        available = true;
+    }
+    taskEXIT_CRITICAL(&logMux);
+
+    return available;
+}
+
+static const char* moduleName(uint8_t module) {
+    return module < LOG_MOD_COUNT ? LOG_MODULE_NAMES[module] : "?";
+}
+
+// ==================== DRAIN TASK ====================
+static void logDrainTask(void* param) {
+    LogRecord record;
+
+    while (true) {
+        while (popRecord(LOG_SINK_INDEX_USB, record)) {
+            Serial.printf("[%lu] %s/%s: %s\n", (unsigned long)record.timestamp,
+                          LOG_LEVEL_NAMES[record.level], moduleName(record.module), record.message);
+        }
+        vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_PERIOD_MS));
+    }
+}
+
+// ==================== LOGGING FUNCTIONS ====================
+void initializeDebugLog(uint8_t sinks) {
+    logSetSinks(sinks);
+
+    if (logTaskHandle == nullptr) {
+        // Priority 1 (just above idle) on the protocol core, away from loop()
+        xTaskCreatePinnedToCore(logDrainTask, "log_drain", 3072, nullptr, 1, &logTaskHandle, 0);
+    }
+
+    Serial.printf("Debug log initialized (%d records x %d chars)\n", LOG_RING_ENTRIES, LOG_MESSAGE_LEN);
+}
+
+void logWrite(uint8_t module, uint8_t level, const char* format, ...) {
+    LogRecord record;
+    record.timestamp = millis();
+    record.module = module;
+    record.level = level;
+
+    // Format outside the critical section
+    va_list args;
+    va_start(args, format);
+    vsnprintf(record.message, sizeof(record.message), format, args);
+    va_end(args);
+
+    taskENTER_CRITICAL(&logMux);
+    catchUpDisabledSinks();
+
+    uint32_t oldest = logHead;
+    for (uint8_t s = 0; s < LOG_SINK_COUNT; s++) {
+        if ((int32_t)(logTail[s] - oldest) < 0) oldest = logTail[s];
+    }
+
+    uint32_t waiting = logHead - oldest;
+    if (waiting >= LOG_RING_ENTRIES) {
+        // Full - drop the newest rather than stall the caller
+        logStats.dropped++;
+    } else {
+        logRing[logHead & (LOG_RING_ENTRIES - 1)] = record;
+        logHead++;
+        logStats.written++;
+        if (waiting + 1 > logStats.high_water) logStats.high_water = waiting + 1;
+    }
+    taskEXIT_CRITICAL(&logMux);
+}
+
+void logSetSinks(uint8_t sinks) {
+    taskENTER_CRITICAL(&logMux);
+    logSinks = sinks;
+    catchUpDisabledSinks();
+    taskEXIT_CRITICAL(&logMux);
+}
+
+void logDrainToSPI(uint8_t max_records) {
+    extern MarvSPIComm spi_comm;  // From Phase3.ino
+    LogRecord record;
+    char message[sizeof(DebugMessagePayload::message)];
+
+    for (uint8_t i = 0; i < max_records && popRecord(LOG_SINK_INDEX_SPI, record); i++) {
+        // WiFi dashboard severity: 0=INFO, 1=WARN, 2=ERROR
+        uint8_t severity = record.level == LOG_LEVEL_ERROR ? 2 : (record.level == LOG_LEVEL_WARN ? 1 : 0);
+        snprintf(message, sizeof(message), "[%s] %s", moduleName(record.module), record.message);
+        spi_comm.sendDebug(severity, message);
+    }
+}
+
+void printLogStats() {
+    taskENTER_CRITICAL(&logMux);
+    LogStats snapshot = logStats;
+    taskEXIT_CRITICAL(&logMux);
+
+    Serial.printf("Debug Log: written=%lu dropped=%lu high_water=%d/%d sinks=%s%s\n",
+                  (unsigned long)snapshot.written, (unsigned long)snapshot.dropped,
+                  snapshot.high_water, LOG_RING_ENTRIES,
+                  (logSinks & LOG_SINK_USB) ? "USB " : "",
+                  (logSinks & LOG_SINK_SPI) ? "SPI" : "");
+}
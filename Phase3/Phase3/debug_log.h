@@ -0,0 +1,102 @@
+#ifndef DEBUG_LOG_H
+#define DEBUG_LOG_H
+
+#include <Arduino.h>
+
+// ==================== LOG LEVELS ====================
+#define LOG_LEVEL_NONE   0
+#define LOG_LEVEL_ERROR  1
+#define LOG_LEVEL_WARN   2
+#define LOG_LEVEL_INFO   3
+#define LOG_LEVEL_DEBUG  4
+
+// ==================== PER-MODULE COMPILE-TIME LEVELS ====================
+// Anything above a module's level compiles to nothing (arguments are still
+// type-checked but never evaluated). Override with -DLOG_LEVEL_NAVCON=... etc.
+#ifndef LOG_LEVEL_NAVCON
+#define LOG_LEVEL_NAVCON LOG_LEVEL_INFO    // NAVCON state machine
+#endif
+#ifndef LOG_LEVEL_EDGE
+#define LOG_LEVEL_EDGE   LOG_LEVEL_WARN    // Edge case matrix
+#endif
+#ifndef LOG_LEVEL_TONE
+#define LOG_LEVEL_TONE   LOG_LEVEL_INFO    // Pure tone detection
+#endif
+#ifndef LOG_LEVEL_SYSTEM
+#define LOG_LEVEL_SYSTEM LOG_LEVEL_INFO    // System state / UART links
+#endif
+
+enum LogModule {
+    LOG_MOD_NAVCON = 0,
+    LOG_MOD_EDGE,
+    LOG_MOD_TONE,
+    LOG_MOD_SYSTEM,
+    LOG_MOD_COUNT
+};
+
+// ==================== RING BUFFER CONFIGURATION ====================
+#define LOG_RING_ENTRIES   32     // Records held until the drain catches up
+#define LOG_MESSAGE_LEN    96     // Formatted text per record (truncated)
+#define LOG_DRAIN_PERIOD_MS 20    // Drain task wake-up interval
+
+// Output sinks (bit mask, selectable at runtime)
+#define LOG_SINK_USB  0x01        // USB serial console
+#define LOG_SINK_SPI  0x02        // sendDebug() to the WiFi ESP32
+
+struct LogRecord {
+    uint32_t timestamp;           // millis() when logged
+    uint8_t module;               // LogModule
+    uint8_t level;                // LOG_LEVEL_*
+    char message[LOG_MESSAGE_LEN];
+};
+
+struct LogStats {
+    uint32_t written;             // Records accepted into the ring
+    uint32_t dropped;             // Records lost because the ring was full
+    uint8_t high_water;           // Most records ever waiting
+};
+
+// ==================== LOGGING MACROS ====================
+// Usage: LOG(NAVCON, DEBUG, "angle=%d", angle);
+#define LOG(module, level, ...) \
+    do { \
+        if (LOG_LEVEL_##module >= LOG_LEVEL_##level) { \
+            logWrite(LOG_MOD_##module, LOG_LEVEL_##level, __VA_ARGS__); \
+        } \
+    } while (0)
+
+// ==================== LOGGING FUNCTIONS ====================
+/**
+ * Start the low-priority drain task (core 0) that empties the ring to USB
+ * @param sinks: LOG_SINK_* mask to enable initially
+ */
+void initializeDebugLog(uint8_t sinks = LOG_SINK_USB);
+
+/**
+ * Format a record into the ring buffer - never blocks on serial output
+ * Use the LOG() macro instead so disabled levels compile out
+ * @param module: LogModule the record belongs to
+ * @param level: LOG_LEVEL_* severity
+ * @param format: printf-style format string
+ */
+void logWrite(uint8_t module, uint8_t level, const char* format, ...) __attribute__((format(printf, 3, 4)));
+
+/**
+ * Select which sinks the ring is drained to
+ * @param sinks: LOG_SINK_* mask
+ */
+void logSetSinks(uint8_t sinks);
+
+/**
+ * Forward pending records as debug messages over SPI
+ * Called from the SPI update tick so only the main loop touches spi_comm
+ * @param max_records: Upper bound on records sent this call
+ */
+void logDrainToSPI(uint8_t max_records);
+
+/**
+ * Print ring buffer counters
+ */
+void printLogStats();
+
+#endif // DEBUG_LOG_H
@@ -8,13 +8,16 @@
  * 3. S1 or S3 alone = distance tracking mode
  * 4. After 50mm without S2 confirmation = infer steep angle (>45°)
  *
- * The EDGE_CASE_MATRIX rules are available but not actively used.
+ * The EDGE_CASE_MATRIX rules are available but not actively used; lookups
+ * go through a compile-time generated table (findEdgeCaseRule).
  * The updateLineDetectionWithEdgeCases() function implements the
  * proven NAVCON algorithm with enhanced debug output.
  */
 
 #include "edge_case_matrix.h"
+#include "debug_log.h"
 #include "navcon_core.h"
+#include "pc_profiler.h"
 
 // External variable declarations (defined in navcon_core.cpp)
 extern uint8_t current_colors[3];
@@ -35,52 +38,119 @@ extern const uint8_t BLACK;
 extern bool isColorNavigable(uint8_t color);
 extern bool isColorWall(uint8_t color);
 
-// ==================== EDGE CASE RULE MATCHING ====================
+// ==================== COMPILE-TIME LOOKUP TABLE ====================
+// Every (S1, S2, S3) colour combination is resolved against EDGE_CASE_MATRIX
+// at compile time; the table holds the index of the first matching rule.
+// Written as single-expression constexpr functions so it builds as C++11.
 
-const EdgeCaseRule* findEdgeCaseRule(uint8_t s1_color, uint8_t s2_color, uint8_t s3_color) {
-    Serial.printf("EDGE_CASE: Searching for rule - S1:%d, S2:%d, S3:%d\n", s1_color, s2_color, s3_color);
+constexpr uint8_t EDGE_CASE_RULE_COUNT = sizeof(EDGE_CASE_MATRIX) / sizeof(EDGE_CASE_MATRIX[0]) - 1;  // END marker excluded
+constexpr uint8_t EDGE_CASE_NO_RULE = 0xFF;
+constexpr uint8_t EDGE_COLOR_COUNT = 5;
+constexpr uint8_t EDGE_COMBINATIONS = EDGE_COLOR_COUNT * EDGE_COLOR_COUNT * EDGE_COLOR_COUNT;
 
-    // Iterate through the edge case matrix
-    for (int i = 0; EDGE_CASE_MATRIX[i].s1_color != 255; i++) {
-        const EdgeCaseRule* rule = &EDGE_CASE_MATRIX[i];
+constexpr bool edgeRuleMatches(const EdgeCaseRule& rule, uint8_t s1, uint8_t s2, uint8_t s3) {
+    return (rule.s1_color == SAME_AS_S2 ? s1 == s2 : (rule.s1_color == ANY_COLOR || rule.s1_color == s1)) &&
+           (rule.s2_color == ANY_COLOR || rule.s2_color == s2) &&
+           (rule.s3_color == SAME_AS_S2 ? s3 == s2 : (rule.s3_color == ANY_COLOR || rule.s3_color == s3));
+}
 
-        // Check if this rule matches current sensor readings
-        bool s1_match = (rule->s1_color == ANY_COLOR) || (rule->s1_color == s1_color);
-        bool s2_match = (rule->s2_color == ANY_COLOR) || (rule->s2_color == s2_color);
-        bool s3_match = (rule->s3_color == ANY_COLOR) || (rule->s3_color == s3_color);
+constexpr uint8_t edgeFirstMatch(uint8_t s1, uint8_t s2, uint8_t s3, uint8_t i = 0) {
+    return i >= EDGE_CASE_RULE_COUNT ? EDGE_CASE_NO_RULE :
+           edgeRuleMatches(EDGE_CASE_MATRIX[i], s1, s2, s3) ? i :
+           edgeFirstMatch(s1, s2, s3, i + 1);
+}
 
-        // Special case: SAME_AS_S2 handling
-        if (rule->s1_color == SAME_AS_S2) {
-            s1_match = (s1_color == s2_color);
-        }
-        if (rule->s3_color == SAME_AS_S2) {
-            s3_match = (s3_color == s2_color);
-        }
+// Combination index layout: S1 * 25 + S2 * 5 + S3
+constexpr uint8_t edgeComboS1(uint8_t combo) { return combo / (EDGE_COLOR_COUNT * EDGE_COLOR_COUNT); }
+constexpr uint8_t edgeComboS2(uint8_t combo) { return (combo / EDGE_COLOR_COUNT) % EDGE_COLOR_COUNT; }
+constexpr uint8_t edgeComboS3(uint8_t combo) { return combo % EDGE_COLOR_COUNT; }
 
-        if (s1_match && s2_match && s3_match) {
-            Serial.printf("EDGE_CASE: Rule found [%d] - %s (Priority: %s, Action: %s)\n",
-                         i, rule->description,
-                         getPriorityName(rule->priority),
-                         getActionName(rule->action));
-            return rule;
-        }
+constexpr uint8_t edgeFirstMatchForCombo(uint8_t combo) {
+    return edgeFirstMatch(edgeComboS1(combo), edgeComboS2(combo), edgeComboS3(combo));
+}
+
+// 0..124 as a template parameter pack
+template <uint8_t... I> struct EdgeComboList {};
+template <uint8_t N, uint8_t... I> struct EdgeComboRange : EdgeComboRange<N - 1, N - 1, I...> {};
+template <uint8_t... I> struct EdgeComboRange<0, I...> { typedef EdgeComboList<I...> type; };
+
+struct EdgeCaseLookup {
+    uint8_t table[EDGE_COMBINATIONS];
+};
+
+template <uint8_t... I> constexpr EdgeCaseLookup edgeBuildLookup(EdgeComboList<I...>) {
+    return EdgeCaseLookup{ { edgeFirstMatchForCombo(I)... } };
+}
+
+// A plain object rather than a template's static member so it can be placed in DRAM
+static SNC_HOT_DATA const EdgeCaseLookup EdgeCaseTable = edgeBuildLookup(EdgeComboRange<EDGE_COMBINATIONS>::type());
+
+// ==================== COMPILE-TIME MATRIX CHECKS ====================
+
+constexpr bool edgeRuleHasWildcard(const EdgeCaseRule& rule) {
+    return rule.s1_color == ANY_COLOR || rule.s1_color == SAME_AS_S2 ||
+           rule.s2_color == ANY_COLOR ||
+           rule.s3_color == ANY_COLOR || rule.s3_color == SAME_AS_S2;
+}
+
+constexpr bool edgeRuleReachable(uint8_t rule, uint8_t combo = 0) {
+    return combo < EDGE_COMBINATIONS &&
+           (edgeFirstMatchForCombo(combo) == rule || edgeRuleReachable(rule, combo + 1));
+}
+
+// True if every combination the rule covers is taken by itself or a wildcard rule
+constexpr bool edgeShadowedOnlyByWildcards(uint8_t rule, uint8_t combo = 0) {
+    return combo >= EDGE_COMBINATIONS ||
+           ((!edgeRuleMatches(EDGE_CASE_MATRIX[rule], edgeComboS1(combo), edgeComboS2(combo), edgeComboS3(combo)) ||
+             edgeFirstMatchForCombo(combo) == rule ||
+             edgeRuleHasWildcard(EDGE_CASE_MATRIX[edgeFirstMatchForCombo(combo)])) &&
+            edgeShadowedOnlyByWildcards(rule, combo + 1));
+}
+
+constexpr bool edgeNoSpecificShadowing(uint8_t rule = 0) {
+    return rule >= EDGE_CASE_RULE_COUNT ||
+           ((edgeRuleReachable(rule) || edgeShadowedOnlyByWildcards(rule)) && edgeNoSpecificShadowing(rule + 1));
+}
+
+constexpr uint8_t edgeUnreachableCount(uint8_t rule = 0) {
+    return rule >= EDGE_CASE_RULE_COUNT ? 0 :
+           (edgeRuleReachable(rule) ? 0 : 1) + edgeUnreachableCount(rule + 1);
+}
+
+static_assert(EDGE_CASE_RULE_COUNT < EDGE_CASE_NO_RULE, "EDGE_CASE_MATRIX too large for 8-bit rule indices");
+static_assert(edgeNoSpecificShadowing(),
+              "EDGE_CASE_MATRIX: a rule can never match because an earlier non-wildcard rule "
+              "covers it (duplicate or mis-ordered entry)");
+static_assert(edgeUnreachableCount() == EDGE_CASE_WILDCARD_SHADOWED,
+              "EDGE_CASE_MATRIX: the set of rules hidden behind an earlier wildcard rule changed - "
+              "reorder the matrix or update EDGE_CASE_WILDCARD_SHADOWED");
+
+// ==================== EDGE CASE RULE MATCHING ====================
+
+const EdgeCaseRule* SNC_HOT findEdgeCaseRule(uint8_t s1_color, uint8_t s2_color, uint8_t s3_color) {
+    uint8_t index;
+
+    if (s1_color < EDGE_COLOR_COUNT && s2_color < EDGE_COLOR_COUNT && s3_color < EDGE_COLOR_COUNT) {
+        index = EdgeCaseTable.table[s1_color * 25 + s2_color * 5 + s3_color];
+    } else {
+        // Out-of-range sensor value - only wildcard rules can match, scan for them
+        index = edgeFirstMatch(s1_color, s2_color, s3_color);
     }
 
-    Serial.println("EDGE_CASE: No specific rule found - using default behavior");
-    return nullptr;
+    return index == EDGE_CASE_NO_RULE ? nullptr : &EDGE_CASE_MATRIX[index];
 }
 
 // ==================== EDGE CASE RULE APPLICATION ====================
 
 bool applyEdgeCaseRule(const EdgeCaseRule* rule, uint8_t current_angle) {
     if (!rule) {
-        Serial.println("EDGE_CASE: No rule to apply");
+        LOG(EDGE, WARN, "No rule to apply");
         return false;
     }
 
     LineDetectionData& detection = navcon_status.line_detection;
 
-    Serial.printf("EDGE_CASE: Applying rule - %s\n", rule->description);
+    LOG(EDGE, INFO, "Applying rule - %s", rule->description);
 
     switch (rule->action) {
         case ACTION_FOLLOW_S1: {
@@ -97,8 +167,8 @@ bool applyEdgeCaseRule(const EdgeCaseRule* rule, uint8_t current_angle) {
                 detection.line_type = LINE_BLACK_BLUE;
             }
 
-            Serial.printf("EDGE_CASE: Following S1 - Color:%d, Angle:%d°\n",
-                         detection.detected_color, current_angle);
+            LOG(EDGE, INFO, "Following S1 - Color:%d, Angle:%d°",
+                detection.detected_color, current_angle);
             return true;
         }
 
@@ -116,8 +186,8 @@ bool applyEdgeCaseRule(const EdgeCaseRule* rule, uint8_t current_angle) {
                 detection.line_type = LINE_BLACK_BLUE;
             }
 
-            Serial.printf("EDGE_CASE: Following S2 - Color:%d, Angle:%d°\n",
-                         detection.detected_color, current_angle);
+            LOG(EDGE, INFO, "Following S2 - Color:%d, Angle:%d°",
+                detection.detected_color, current_angle);
             return true;
         }
 
@@ -135,8 +205,8 @@ bool applyEdgeCaseRule(const EdgeCaseRule* rule, uint8_t current_angle) {
                 detection.line_type = LINE_BLACK_BLUE;
             }
 
-            Serial.printf("EDGE_CASE: Following S3 - Color:%d, Angle:%d°\n",
-                         detection.detected_color, current_angle);
+            LOG(EDGE, INFO, "Following S3 - Color:%d, Angle:%d°",
+                detection.detected_color, current_angle);
             return true;
         }
 
@@ -170,8 +240,8 @@ bool applyEdgeCaseRule(const EdgeCaseRule* rule, uint8_t current_angle) {
                 detection.line_type = LINE_BLACK_BLUE;
             }
 
-            Serial.printf("EDGE_CASE: Following strongest - S%d Color:%d, Angle:%d°\n",
-                         strongest_sensor, strongest_color, current_angle);
+            LOG(EDGE, INFO, "Following strongest - S%d Color:%d, Angle:%d°",
+                strongest_sensor, strongest_color, current_angle);
             return true;
         }
 
@@ -210,13 +280,13 @@ bool applyEdgeCaseRule(const EdgeCaseRule* rule, uint8_t current_angle) {
                 detection.line_type = LINE_BLACK_BLUE;
             }
 
-            Serial.printf("EDGE_CASE: Averaging angle - S%d Color:%d, EffectiveAngle:%d° (sensors:%d)\n",
-                         rule->primary_sensor, detection.detected_color, effective_angle, sensor_count);
+            LOG(EDGE, INFO, "Averaging angle - S%d Color:%d, EffectiveAngle:%d° (sensors:%d)",
+                rule->primary_sensor, detection.detected_color, effective_angle, sensor_count);
             return true;
         }
 
         case ACTION_EMERGENCY_STOP: {
-            Serial.printf("EDGE_CASE: EMERGENCY STOP triggered - %s\n", rule->description);
+            LOG(EDGE, WARN, "EMERGENCY STOP triggered - %s", rule->description);
 
             // Force immediate stop state
             navcon_status.current_state = NAVCON_STOP;
@@ -231,21 +301,21 @@ bool applyEdgeCaseRule(const EdgeCaseRule* rule, uint8_t current_angle) {
             detection.line_type = LINE_RED_GREEN; // Force stop handling
 
             // Log emergency for analysis
-            Serial.println("EDGE_CASE: EMERGENCY - Multiple conflicting lines detected");
-            Serial.printf("EDGE_CASE: EMERGENCY - S1:%d, S2:%d, S3:%d\n",
-                         current_colors[0], current_colors[1], current_colors[2]);
+            LOG(EDGE, WARN, "EMERGENCY - Multiple conflicting lines detected");
+            LOG(EDGE, WARN, "EMERGENCY - S1:%d, S2:%d, S3:%d",
+                current_colors[0], current_colors[1], current_colors[2]);
 
             return true;
         }
 
         case ACTION_IGNORE_ALL: {
-            Serial.printf("EDGE_CASE: Ignoring all sensors - %s\n", rule->description);
+            LOG(EDGE, INFO, "Ignoring all sensors - %s", rule->description);
             // Don't set detection_active, continue normal forward operation
             return false; // Return false to continue normal forward movement
         }
 
         case ACTION_BACKUP_FIRST: {
-            Serial.printf("EDGE_CASE: Backup first required - %s\n", rule->description);
+            LOG(EDGE, INFO, "Backup first required - %s", rule->description);
 
             // Force immediate stop and reverse
             navcon_status.current_state = NAVCON_STOP;
@@ -259,12 +329,12 @@ bool applyEdgeCaseRule(const EdgeCaseRule* rule, uint8_t current_angle) {
             detection.detection_active = true;
             detection.line_type = LINE_BLACK_BLUE; // Force backup behavior
 
-            Serial.println("EDGE_CASE: Backup sequence initiated");
+            LOG(EDGE, INFO, "Backup sequence initiated");
             return true;
         }
 
         default: {
-            Serial.printf("EDGE_CASE: Unknown action type: %d\n", rule->action);
+            LOG(EDGE, WARN, "Unknown action type: %d", rule->action);
             return false;
         }
     }
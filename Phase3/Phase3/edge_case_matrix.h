@@ -54,8 +54,16 @@ struct EdgeCaseRule {
 #define SAME_AS_S2 254
 
 // ==================== COMPREHENSIVE EDGE CASE MATRIX ====================
+// First match wins. findEdgeCaseRule() uses a 5x5x5 lookup table that the
+// compiler builds from this list (see edge_case_matrix.cpp), and static_asserts
+// reject rules that an earlier rule makes unreachable.
 
-const EdgeCaseRule EDGE_CASE_MATRIX[] = {
+// Rules deliberately left behind the "S2 ... priority" wildcards (S2 has
+// absolute priority; they document the intended two-sensor/single-sensor
+// handling). Adding or removing a shadowed rule must update this count.
+#define EDGE_CASE_WILDCARD_SHADOWED 12
+
+constexpr EdgeCaseRule EDGE_CASE_MATRIX[] = {
 
     // ==================== EMERGENCY CASES (Priority 0) ====================
     // Multiple conflicting navigation lines - EMERGENCY STOP
@@ -82,8 +90,7 @@ const EdgeCaseRule EDGE_CASE_MATRIX[] = {
     {EDGE_GREEN, EDGE_WHITE, EDGE_BLACK, PRIORITY_HIGH, ACTION_FOLLOW_S1, 1, "GREEN-WHITE-BLACK: follow S1 GREEN"},
 
     // Wall avoidance with navigation line visible
-    {EDGE_BLACK, EDGE_WHITE, EDGE_GREEN, PRIORITY_HIGH, ACTION_FOLLOW_S3, 3, "Avoid BLACK wall, follow GREEN"},
-    {EDGE_GREEN, EDGE_WHITE, EDGE_BLACK, PRIORITY_HIGH, ACTION_FOLLOW_S1, 1, "Follow GREEN, avoid BLACK wall"},
+    // (BLACK-WHITE-GREEN / GREEN-WHITE-BLACK are covered by the two rules above)
     {EDGE_BLUE,  EDGE_WHITE, EDGE_GREEN, PRIORITY_HIGH, ACTION_FOLLOW_S3, 3, "Avoid BLUE wall, follow GREEN"},
     {EDGE_GREEN, EDGE_WHITE, EDGE_BLUE,  PRIORITY_HIGH, ACTION_FOLLOW_S1, 1, "Follow GREEN, avoid BLUE wall"},
     {EDGE_BLACK, EDGE_WHITE, EDGE_RED,   PRIORITY_HIGH, ACTION_FOLLOW_S3, 3, "Avoid BLACK wall, follow RED"},
@@ -92,13 +99,13 @@ const EdgeCaseRule EDGE_CASE_MATRIX[] = {
     {EDGE_RED,   EDGE_WHITE, EDGE_BLUE,  PRIORITY_HIGH, ACTION_FOLLOW_S1, 1, "Follow RED, avoid BLUE wall"},
 
     // ==================== MEDIUM PRIORITY CASES (Priority 2) ====================
-    // Two adjacent sensors with same navigable color
+    // Two adjacent sensors with same navigable color (shadowed by S2 priority)
     {EDGE_RED,   EDGE_RED,   EDGE_WHITE, PRIORITY_MEDIUM, ACTION_AVERAGE_ANGLE, 1, "S1-S2 RED line"},
     {EDGE_GREEN, EDGE_GREEN, EDGE_WHITE, PRIORITY_MEDIUM, ACTION_AVERAGE_ANGLE, 1, "S1-S2 GREEN line"},
     {EDGE_WHITE, EDGE_RED,   EDGE_RED,   PRIORITY_MEDIUM, ACTION_AVERAGE_ANGLE, 3, "S2-S3 RED line"},
     {EDGE_WHITE, EDGE_GREEN, EDGE_GREEN, PRIORITY_MEDIUM, ACTION_AVERAGE_ANGLE, 3, "S2-S3 GREEN line"},
 
-    // Two adjacent sensors with same wall color
+    // Two adjacent sensors with same wall color (shadowed by S2 priority)
     {EDGE_BLACK, EDGE_BLACK, EDGE_WHITE, PRIORITY_MEDIUM, ACTION_FOLLOW_STRONGEST, 1, "S1-S2 BLACK wall"},
     {EDGE_BLUE,  EDGE_BLUE,  EDGE_WHITE, PRIORITY_MEDIUM, ACTION_FOLLOW_STRONGEST, 1, "S1-S2 BLUE wall"},
     {EDGE_WHITE, EDGE_BLACK, EDGE_BLACK, PRIORITY_MEDIUM, ACTION_FOLLOW_STRONGEST, 3, "S2-S3 BLACK wall"},
@@ -123,7 +130,7 @@ const EdgeCaseRule EDGE_CASE_MATRIX[] = {
     // All white (normal forward operation)
     {EDGE_WHITE, EDGE_WHITE, EDGE_WHITE, PRIORITY_LOW, ACTION_IGNORE_ALL, 2, "All white - normal forward"},
 
-    // Non-critical single sensor noise
+    // Non-critical single sensor noise (shadowed by S2 priority)
     {EDGE_WHITE, EDGE_RED,   EDGE_WHITE, PRIORITY_LOW, ACTION_FOLLOW_S2, 2, "S2 RED single sensor"},
     {EDGE_WHITE, EDGE_GREEN, EDGE_WHITE, PRIORITY_LOW, ACTION_FOLLOW_S2, 2, "S2 GREEN single sensor"},
     {EDGE_WHITE, EDGE_BLACK, EDGE_WHITE, PRIORITY_LOW, ACTION_FOLLOW_S2, 2, "S2 BLACK single sensor"},
@@ -137,6 +144,8 @@ const EdgeCaseRule EDGE_CASE_MATRIX[] = {
 
 /**
  * Find the best matching edge case rule for current sensor readings
+ * O(1) table lookup for colours 0-4; anything else falls back to a scan.
+ * @return: First matching rule, or nullptr if none matches
  */
 const EdgeCaseRule* findEdgeCaseRule(uint8_t s1_color, uint8_t s2_color, uint8_t s3_color);
 
@@ -0,0 +1,469 @@
+/*
+ * MARV SNC - Flight Recorder
+ * Fixed-size binary records (SCS frames, NAVCON transitions, line detection,
+ * correction tracker) go into a RAM ring from any task; a low-priority task
+ * on core 0 programs them into the flash slot one page at a time and erases
+ * the slot ahead of itself while the robot is idle.
+ * After the run the log is streamed to the WiFi ESP32 for download.
+ */
+
+#include "flight_recorder.h"
+#include "navcon_core.h"
+#include "spi_protocol.h"
+#include "debug_log.h"
+#include <esp_partition.h>
+
+static_assert((FR_RING_RECORDS & (FR_RING_RECORDS - 1)) == 0, "FR_RING_RECORDS must be a power of two");
+static_assert(FR_FLUSH_RECORDS <= FR_RING_RECORDS, "Flush block larger than the ring");
+static_assert(FR_WRITE_RECORDS * sizeof(FlightRecord) == 256, "A write is one flash page");
+
+// Slots are rounded down to 64 KB so the erase uses whole blocks
+#define FR_SLOT_ALIGN 0x10000
+
+// ==================== RING BUFFER STATE ====================
+// Producers append under frMux; the flush task owns [tail, head) once it has
+// read head, so records are copied out without holding the lock.
+static FlightRecord frRing[FR_RING_RECORDS];
+static uint32_t frHead = 0;
+static uint32_t frTail = 0;
+static FlightRecord frStaging[FR_WRITE_RECORDS];
+static FlightRecorderStats frStats = {0, 0, 0, 0, 0, 0, 0, 0};
+static portMUX_TYPE frMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t frTaskHandle = nullptr;
+
+// ==================== STORAGE STATE ====================
+static const esp_partition_t* frPartition = nullptr;
+static uint32_t frSlotBytes = 0;
+static uint8_t frSlot = 0;                     // Slot this boot records into
+static uint32_t frRunId = 0;
+static bool frHavePrevious = false;            // Other slot holds an older run
+static uint32_t frWriteOffset = 0;             // Next byte to program in frSlot (flush task)
+static uint32_t frErasedEnd = 0;               // frSlot is erased from frWriteOffset up to here (flush task)
+static volatile bool frIdle = true;            // Robot not on a run - erasing is allowed
+static volatile bool frRecording = false;      // Written under frMux
+static volatile bool frFinishRequested = false;
+static volatile bool frClosed = false;         // Final flush done - safe to upload
+
+// ==================== UPLOAD STATE ====================
+// Requested from the control task, run from the SPI update tick
+static volatile int8_t frUploadRequest = -1;   // -1 none, 0 current run, 1 previous run
+static bool frUploading = false;
+static uint32_t frUploadBase = 0;
+static uint32_t frUploadOffset = 0;
+static uint32_t frUploadTotal = 0;
+static uint32_t frUploadRunId = 0;
+
+// ==================== FLASH HELPERS ====================
+static uint32_t slotBase(uint8_t slot) {
+    return (uint32_t)slot * frSlotBytes;
+}
+
+static bool readHeader(uint8_t slot, FlightLogHeader& header) {
+    if (esp_partition_read(frPartition, slotBase(slot), &header, sizeof(header)) != ESP_OK) {
+        return false;
+    }
+    return header.magic == FR_MAGIC && header.version == FR_VERSION &&
+           header.record_size == sizeof(FlightRecord) && header.slot_bytes == frSlotBytes;
+}
+
+// Bytes in use (header included). The sector after the last one written is
+// always erased before the write, so the first sector that starts erased
+// bounds the log (an older run's records may still lie beyond it); the end
+// inside the sector before is found by binary search.
+static uint32_t findLogEnd(uint8_t slot) {
+    FlightRecord record;
+    uint32_t sector = FR_SECTOR_BYTES;
+    while (sector < frSlotBytes) {
+        esp_partition_read(frPartition, slotBase(slot) + sector, &record, sizeof(record));
+        if (record.type == 0xFF) {
+            break;
+        }
+        sector += FR_SECTOR_BYTES;
+    }
+
+    uint32_t lo = (sector - FR_SECTOR_BYTES) / sizeof(FlightRecord);
+    uint32_t hi = sector / sizeof(FlightRecord);
+    if (lo == 0) lo = 1;                       // Record 0 is the header
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        esp_partition_read(frPartition, slotBase(slot) + mid * sizeof(FlightRecord), &record, sizeof(record));
+        if (record.type == 0xFF) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo * sizeof(FlightRecord);
+}
+
+// Erase the next sector of the slot (flush task only)
+static bool eraseNextSector() {
+    uint32_t start = micros();
+    esp_err_t err = esp_partition_erase_range(frPartition, slotBase(frSlot) + frErasedEnd, FR_SECTOR_BYTES);
+    uint32_t elapsed = micros() - start;
+    if (elapsed > frStats.erase_max_us) frStats.erase_max_us = elapsed;
+
+    if (err != ESP_OK) {
+        LOG(SYSTEM, ERROR, "Flight recorder: flash erase failed (%d) - recording stopped", err);
+        taskENTER_CRITICAL(&frMux);
+        frRecording = false;
+        taskEXIT_CRITICAL(&frMux);
+        return false;
+    }
+    frErasedEnd += FR_SECTOR_BYTES;
+    return true;
+}
+
+// Records that can be programmed now: the sector after the write must stay
+// erased (see findLogEnd), except at the end of the slot
+static uint32_t writableRecords() {
+    uint32_t limit = frErasedEnd == frSlotBytes ? frSlotBytes : frErasedEnd - FR_SECTOR_BYTES;
+    return limit > frWriteOffset ? (limit - frWriteOffset) / sizeof(FlightRecord) : 0;
+}
+
+// Program records at the write pointer (flush task only)
+static void writeRecords(const FlightRecord* records, uint32_t count) {
+    uint32_t room = (frSlotBytes - frWriteOffset) / sizeof(FlightRecord);
+    if (count > room) {
+        frStats.truncated += count - room;
+        count = room;
+    }
+    if (count == 0) {
+        return;
+    }
+
+    uint32_t start = micros();
+    esp_err_t err = esp_partition_write(frPartition, slotBase(frSlot) + frWriteOffset,
+                                        records, count * sizeof(FlightRecord));
+    uint32_t elapsed = micros() - start;
+    if (elapsed > frStats.flush_max_us) frStats.flush_max_us = elapsed;
+
+    if (err != ESP_OK) {
+        LOG(SYSTEM, ERROR, "Flight recorder: flash write failed (%d) - recording stopped", err);
+        taskENTER_CRITICAL(&frMux);
+        frRecording = false;
+        taskEXIT_CRITICAL(&frMux);
+        return;
+    }
+
+    frWriteOffset += count * sizeof(FlightRecord);
+    frStats.flushed_bytes += count * sizeof(FlightRecord);
+
+    if (frWriteOffset + sizeof(FlightRecord) > frSlotBytes) {
+        taskENTER_CRITICAL(&frMux);
+        frRecording = false;
+        taskEXIT_CRITICAL(&frMux);
+        LOG(SYSTEM, WARN, "Flight recorder: slot full after %lu bytes - recording stopped",
+            (unsigned long)frWriteOffset);
+    }
+}
+
+// Move everything waiting in the ring to flash, one page per write. Between
+// pages the task sleeps a tick so the stalls stay ~1 ms apart; records that
+// don't fit the erased space wait in the ring for the next idle erase.
+static void flushRing() {
+    bool first = true;
+    while (true) {
+        taskENTER_CRITICAL(&frMux);
+        uint32_t waiting = frHead - frTail;
+        taskEXIT_CRITICAL(&frMux);
+
+        uint32_t inPage = FR_WRITE_RECORDS - (frWriteOffset / sizeof(FlightRecord)) % FR_WRITE_RECORDS;
+        uint32_t count = waiting < inPage ? waiting : inPage;
+        if (count == 0) {
+            return;
+        }
+        // Out of erased space: erase the next sector if the robot is idle (or the run is over)
+        uint32_t writable = writableRecords();
+        if (writable == 0 && frErasedEnd < frSlotBytes) {
+            if (!frIdle && !frFinishRequested) {
+                frStats.erase_waits++;
+                return;
+            }
+            if (!eraseNextSector()) {
+                return;
+            }
+            continue;
+        }
+        if (writable > 0 && count > writable) {
+            count = writable;
+        }
+
+        if (!first) {
+            vTaskDelay(1);
+        }
+        first = false;
+        for (uint32_t i = 0; i < count; i++) {
+            frStaging[i] = frRing[(frTail + i) & (FR_RING_RECORDS - 1)];
+        }
+
+        taskENTER_CRITICAL(&frMux);
+        frTail += count;
+        taskEXIT_CRITICAL(&frMux);
+
+        writeRecords(frStaging, count);
+    }
+}
+
+// ==================== FLUSH TASK ====================
+static void flightRecorderTask(void* param) {
+    while (true) {
+        // Woken early once a flush block is waiting; while idle with the slot
+        // not yet erased, back every FR_ERASE_GAP_MS to erase the next sector
+        bool eraseAhead = frIdle && frRecording && frErasedEnd < frSlotBytes;
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(eraseAhead ? FR_ERASE_GAP_MS : FR_FLUSH_PERIOD_MS));
+        flushRing();
+        if (frIdle && frRecording && frErasedEnd < frSlotBytes) {
+            eraseNextSector();
+        }
+
+        // Producers stopped under frMux, so this flush saw their last records
+        if (frFinishRequested && !frClosed) {
+            flushRing();
+            frClosed = true;
+            LOG(SYSTEM, INFO, "Flight recorder: run %lu closed (%lu bytes)",
+                (unsigned long)frRunId, (unsigned long)frWriteOffset);
+        }
+    }
+}
+
+// ==================== RECORDER FUNCTIONS ====================
+void initializeFlightRecorder() {
+    frPartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, nullptr);
+    if (frPartition == nullptr) {
+        Serial.println("Flight recorder disabled (no data partition)");
+        return;
+    }
+    frSlotBytes = (frPartition->size / 2) & ~(uint32_t)(FR_SLOT_ALIGN - 1);
+    if (frSlotBytes == 0) {
+        Serial.println("Flight recorder disabled (data partition too small)");
+        frPartition = nullptr;
+        return;
+    }
+
+    // Record into whichever slot doesn't hold the newest run
+    FlightLogHeader header0;
+    FlightLogHeader header1;
+    bool valid0 = readHeader(0, header0);
+    bool valid1 = readHeader(1, header1);
+    frHavePrevious = valid0 || valid1;
+    if (!frHavePrevious) {
+        frSlot = 0;
+        frRunId = 1;
+    } else if (valid0 && (!valid1 || (int32_t)(header0.run_id - header1.run_id) > 0)) {
+        frSlot = 1;
+        frRunId = header0.run_id + 1;
+    } else {
+        frSlot = 0;
+        frRunId = header1.run_id + 1;
+    }
+
+    // Header sector plus the one after it (findLogEnd); the rest is erased in the background
+    uint32_t eraseStart = micros();
+    if (esp_partition_erase_range(frPartition, slotBase(frSlot), 2 * FR_SECTOR_BYTES) != ESP_OK) {
+        Serial.println("Flight recorder disabled (erase failed)");
+        frPartition = nullptr;
+        return;
+    }
+    uint32_t eraseUs = micros() - eraseStart;
+    frErasedEnd = 2 * FR_SECTOR_BYTES;
+
+    FlightLogHeader header = {};
+    header.magic = FR_MAGIC;
+    header.run_id = frRunId;
+    header.version = FR_VERSION;
+    header.record_size = sizeof(FlightRecord);
+    header.slot_bytes = frSlotBytes;
+    esp_partition_write(frPartition, slotBase(frSlot), &header, sizeof(header));
+    frWriteOffset = sizeof(header);
+
+    frRecording = true;
+    if (frTaskHandle == nullptr) {
+        // Priority 1 on the protocol core. Flash I/O still stalls the control core
+        // (the cache is off on both), which is why it comes in pages and idle-time erases.
+        xTaskCreatePinnedToCore(flightRecorderTask, "flight_rec", 3072, nullptr, 1, &frTaskHandle, 0);
+    }
+
+    Serial.printf("Flight recorder initialized (run %lu, slot %d, %lu records, 8 KB erase %lu us)\n",
+                  (unsigned long)frRunId, frSlot,
+                  (unsigned long)(frSlotBytes / sizeof(FlightRecord) - 1), (unsigned long)eraseUs);
+}
+
+void flightRecorderSetIdle(bool idle) {
+    frIdle = idle;
+}
+
+void flightRecord(uint8_t type, uint8_t aux, const void* data, uint8_t length) {
+    if (!frRecording) {
+        return;
+    }
+
+    // Build outside the critical section
+    FlightRecord record;
+    record.time_us = micros();
+    record.type = type;
+    record.aux = aux;
+    if (length > FR_RECORD_DATA) length = FR_RECORD_DATA;
+    memset(record.data, 0, sizeof(record.data));
+    if (length > 0) {
+        memcpy(record.data, data, length);
+    }
+
+    bool wake = false;
+    taskENTER_CRITICAL(&frMux);
+    if (frRecording) {
+        uint32_t waiting = frHead - frTail;
+        if (waiting >= FR_RING_RECORDS) {
+            // Full - drop the newest rather than stall the caller
+            frStats.dropped++;
+        } else {
+            frRing[frHead & (FR_RING_RECORDS - 1)] = record;
+            frHead++;
+            frStats.recorded++;
+            if (waiting + 1 > frStats.high_water) frStats.high_water = waiting + 1;
+            wake = (waiting + 1 == FR_FLUSH_RECORDS);
+        }
+    }
+    taskEXIT_CRITICAL(&frMux);
+
+    if (wake) {
+        xTaskNotifyGive(frTaskHandle);
+    }
+}
+
+void flightRecordNavcon() {
+    static uint8_t lastState = 0xFF;
+    static uint8_t lastLine[9];
+    static uint8_t lastCorrection[8];
+    static bool haveSnapshot = false;
+
+    uint8_t state = (uint8_t)navcon_status.current_state;
+    if (state != lastState) {
+        uint8_t transition[2] = {lastState, state};
+        flightRecord(FR_NAVCON_STATE, 0, transition, sizeof(transition));
+        lastState = state;
+    }
+
+    const LineDetectionData& ld = navcon_status.line_detection;
+    uint8_t line[9] = {
+        ld.detected_color, ld.detecting_sensor,
+        (uint8_t)(ld.detection_start_distance & 0xFF), (uint8_t)(ld.detection_start_distance >> 8),
+        ld.initial_angle, ld.current_target_angle,
+        (uint8_t)ld.angle_valid, (uint8_t)ld.detection_active, (uint8_t)ld.line_type
+    };
+    const CorrectionTracker& ct = navcon_status.correction;
+    uint8_t correction[8] = {
+        ct.correction_direction, ct.attempts_made, (uint8_t)ct.in_correction_sequence,
+        (uint8_t)(ct.last_rotation_commanded & 0xFF), (uint8_t)(ct.last_rotation_commanded >> 8),
+        (uint8_t)(ct.last_rotation_actual & 0xFF), (uint8_t)(ct.last_rotation_actual >> 8),
+        (uint8_t)ct.rotation_feedback_processed
+    };
+
+    if (!haveSnapshot || memcmp(line, lastLine, sizeof(line)) != 0) {
+        flightRecord(FR_LINE_DETECTION, 0, line, sizeof(line));
+        memcpy(lastLine, line, sizeof(line));
+    }
+    if (!haveSnapshot || memcmp(correction, lastCorrection, sizeof(correction)) != 0) {
+        flightRecord(FR_CORRECTION, 0, correction, sizeof(correction));
+        memcpy(lastCorrection, correction, sizeof(correction));
+    }
+    haveSnapshot = true;
+}
+
+void flightRecorderFinish() {
+    if (frPartition == nullptr || frFinishRequested) {
+        return;
+    }
+    flightRecord(FR_RUN_END, 0, nullptr, 0);
+
+    taskENTER_CRITICAL(&frMux);
+    frRecording = false;
+    taskEXIT_CRITICAL(&frMux);
+
+    frFinishRequested = true;
+    xTaskNotifyGive(frTaskHandle);
+}
+
+void flightRecorderRequestUpload(bool previous) {
+    if (frPartition == nullptr) {
+        Serial.println("Flight recorder: not available");
+        return;
+    }
+    if (previous && !frHavePrevious) {
+        Serial.println("Flight recorder: no previous run in flash");
+        return;
+    }
+    if (!previous) {
+        flightRecorderFinish();
+    }
+    frUploadRequest = previous ? 1 : 0;
+}
+
+void flightRecorderPumpSPI() {
+    extern MarvSPIComm spi_comm;  // From Phase3.ino
+
+    if (!frUploading) {
+        int8_t request = frUploadRequest;
+        if (request < 0 || (request == 0 && !frClosed)) {
+            return;  // Nothing asked for, or the current run is still being flushed
+        }
+        frUploadRequest = -1;
+
+        uint8_t slot = request ? (frSlot ^ 1) : frSlot;
+        FlightLogHeader header;
+        if (!readHeader(slot, header)) {
+            LOG(SYSTEM, WARN, "Flight recorder: slot %d holds no run", slot);
+            return;
+        }
+        frUploadBase = slotBase(slot);
+        frUploadOffset = 0;
+        frUploadTotal = findLogEnd(slot);
+        frUploadRunId = header.run_id;
+        frUploading = true;
+        LOG(SYSTEM, INFO, "Flight recorder: uploading run %lu (%lu bytes)",
+            (unsigned long)frUploadRunId, (unsigned long)frUploadTotal);
+    }
+
+    FlightLogChunkPayload chunk;
+    uint32_t remaining = frUploadTotal - frUploadOffset;
+    uint8_t length = remaining < FLIGHT_LOG_CHUNK_BYTES ? remaining : FLIGHT_LOG_CHUNK_BYTES;
+    chunk.offset = frUploadOffset;
+    chunk.total = frUploadTotal;
+    chunk.run_id = frUploadRunId;
+    esp_partition_read(frPartition, frUploadBase + frUploadOffset, chunk.data, length);
+
+    // Both DMA slots busy - same chunk again next tick
+    if (spi_comm.sendFlightLog(chunk, length)) {
+        frUploadOffset += length;
+    }
+
+    if (frUploadOffset >= frUploadTotal) {
+        frUploading = false;
+        LOG(SYSTEM, INFO, "Flight recorder: run %lu uploaded", (unsigned long)frUploadRunId);
+    }
+}
+
+void printFlightRecorderStats() {
+    if (frPartition == nullptr) {
+        Serial.println("Flight Recorder: disabled");
+        return;
+    }
+
+    taskENTER_CRITICAL(&frMux);
+    FlightRecorderStats snapshot = frStats;
+    taskEXIT_CRITICAL(&frMux);
+
+    Serial.printf("Flight Recorder: run=%lu slot=%d %s | recorded=%lu dropped=%lu truncated=%lu\n",
+                  (unsigned long)frRunId, frSlot,
+                  frClosed ? "closed" : (frRecording ? "recording" : "stopped"),
+                  (unsigned long)snapshot.recorded, (unsigned long)snapshot.dropped,
+                  (unsigned long)snapshot.truncated);
+    Serial.printf("Flight Recorder: flash %lu/%lu KB (erased to %lu KB) high_water=%d/%d%s\n",
+                  (unsigned long)(frWriteOffset / 1024), (unsigned long)(frSlotBytes / 1024),
+                  (unsigned long)(frErasedEnd / 1024), snapshot.high_water, FR_RING_RECORDS,
+                  frUploading ? " (uploading)" : "");
+    Serial.printf("Flight Recorder: stalls page_write_max=%luus sector_erase_max=%luus erase_waits=%lu\n",
+                  (unsigned long)snapshot.flush_max_us, (unsigned long)snapshot.erase_max_us,
+                  (unsigned long)snapshot.erase_waits);
+}
@@ -0,0 +1,121 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <Arduino.h>
+
+// ==================== RECORD TYPES ====================
+enum FlightRecordType : uint8_t {
+    FR_SCS_RX = 1,          // Frame taken off a UART ring (aux = PORT_SS / PORT_MDPS, data = 4 frame bytes)
+    FR_SCS_TX,              // Frame handed to the UARTs (aux = PORT_* mask, data = 4 frame bytes)
+    FR_NAVCON_STATE,        // data[0] = old NavconState, data[1] = new NavconState
+    FR_LINE_DETECTION,      // LineDetectionData on change (see flightRecordNavcon)
+    FR_CORRECTION,          // CorrectionTracker on change
+    FR_RUN_END              // End of maze latched - recording stops here
+};
+
+// ==================== STORAGE CONFIGURATION ====================
+// The log lives in the data partition normally given to SPIFFS, split into
+// two slots used alternately per boot, so the run before a reset survives.
+// Every flash write or erase turns the cache off on BOTH cores for its
+// duration, whichever core issues it, so the cost is kept in small pieces:
+// setup() erases only the first two sectors, the rest of the slot is erased
+// one sector at a time while the robot is idle (not on a MAZE run), and
+// records are programmed one 256-byte flash page per write.
+#define FR_RECORD_DATA       10
+#define FR_RING_RECORDS      1024   // RAM ring between the hot path and flash (16 KB)
+#define FR_FLUSH_RECORDS     256    // Records waiting that wake the flush task early
+#define FR_WRITE_RECORDS     16     // Records per flash write (256 B, one flash page)
+#define FR_SECTOR_BYTES      4096   // Flash erase unit
+#define FR_FLUSH_PERIOD_MS   1000   // Partial flush interval - bounds loss on reset
+#define FR_ERASE_GAP_MS      20     // Pause between background sector erases
+#define FR_MAGIC             0x3152464D  // "MFR1"
+#define FR_VERSION           1
+
+// 16 bytes; a run log is a FlightLogHeader followed by records up to the
+// first erased (all 0xFF) record
+struct FlightRecord {
+    uint32_t time_us;             // micros()
+    uint8_t type;                 // FlightRecordType
+    uint8_t aux;
+    uint8_t data[FR_RECORD_DATA];
+} __attribute__((packed));
+
+struct FlightLogHeader {
+    uint32_t magic;               // FR_MAGIC
+    uint32_t run_id;              // Increments per boot; the newer slot is the current run
+    uint8_t version;              // FR_VERSION
+    uint8_t record_size;          // sizeof(FlightRecord)
+    uint16_t reserved;
+    uint32_t slot_bytes;          // Capacity including this header
+} __attribute__((packed));
+
+static_assert(sizeof(FlightRecord) == 16, "FlightRecord must stay 16 bytes");
+static_assert(sizeof(FlightLogHeader) == sizeof(FlightRecord), "Header occupies one record slot");
+
+struct FlightRecorderStats {
+    uint32_t recorded;            // Records accepted into the ring
+    uint32_t dropped;             // Lost to a full ring
+    uint32_t truncated;           // Lost because the slot was full
+    uint32_t flushed_bytes;       // Bytes programmed into flash this run
+    uint32_t flush_max_us;        // Longest single flash write (both cores stall this long)
+    uint32_t erase_max_us;        // Longest single sector erase (likewise)
+    uint32_t erase_waits;         // Flushes held back because the erased space ran out
+    uint16_t high_water;          // Most records ever waiting in the ring
+};
+
+// ==================== RECORDER FUNCTIONS ====================
+/**
+ * Pick the older slot, erase its first two sectors and start the flush task
+ * (core 0), which erases the rest while the robot is idle
+ * Call from setup() before the tasks start.
+ */
+void initializeFlightRecorder();
+
+/**
+ * Tell the flush task whether the robot is idle (control task, every cycle)
+ * Sector erases (tens of ms with the cache off) only run while idle.
+ * @param idle: true while not on a MAZE run
+ */
+void flightRecorderSetIdle(bool idle);
+
+/**
+ * Append one record to the RAM ring - a short critical section, no flash I/O
+ * Safe from any task; records are dropped (and counted) if the ring is full.
+ * @param type: FlightRecordType
+ * @param aux: Type-specific byte
+ * @param data: Up to FR_RECORD_DATA bytes (rest zero-filled)
+ * @param length: Bytes in data
+ */
+void flightRecord(uint8_t type, uint8_t aux, const void* data, uint8_t length);
+
+/**
+ * Record NAVCON's state, line detection and correction tracker if they
+ * changed since the last call (control task, after each NAVCON step)
+ */
+void flightRecordNavcon();
+
+/**
+ * Stop recording: the flush task writes what is left and closes the run
+ * The current run is uploaded over SPI once it is closed.
+ */
+void flightRecorderFinish();
+
+/**
+ * Stream a run to the WiFi ESP32 as PKT_FLIGHT_LOG chunks
+ * @param previous: true for the run before this boot, false for this one
+ *                  (finishes recording first)
+ */
+void flightRecorderRequestUpload(bool previous);
+
+/**
+ * Send the next upload chunk, if any (SPI update tick, outside the batch)
+ * A chunk the DMA queue can't take is retried on the next tick.
+ */
+void flightRecorderPumpSPI();
+
+/**
+ * Print recorder counters and slot usage
+ */
+void printFlightRecorderStats();
+
+#endif // FLIGHT_RECORDER_H
@@ -3,33 +3,33 @@
 
 #include <Arduino.h>
 
-// ==================== GPIO PIN DEFINITIONS ====================
-// GPIO Command pins (inputs from WiFi ESP32)
-#define CMD_TOUCH_PIN     4   // Input from WiFi ESP32 GPIO 4
-#define CMD_TONE_PIN      2   // Input from WiFi ESP32 GPIO 2
-#define CMD_SEND_PIN      15  // Input from WiFi ESP32 GPIO 15
+// ==================== PIN DEFINITIONS ====================
+// Dashboard commands no longer use pins: the WiFi ESP32 sends them as
+// PKT_COMMAND replies on SPI MISO (see spi_protocol.h), so GPIO 4, 2 and 15
+// are free.
 
 // ADC Pin for Pure Tone Detection
 #define PURE_TONE_ADC_PIN 36  // ADC input for pure tone voltage (1.65V-3.3V)
 
 // ==================== GPIO FUNCTIONS ====================
 /**
- * Initialize GPIO pins for command inputs
- * Sets up pins as INPUT_PULLDOWN and prints initialization status
+ * Initialize the command and pure tone inputs
+ * Starts the tone detector (GPIO 36) and prints initialization status
  */
 void setupGPIOCommands();
 
 /**
- * Check for WiFi commands from GPIO pins
- * Monitors all three command pins and updates system status
+ * Act on dashboard commands received over SPI
+ * Drains the commands queued by spi_comm (telemetry task) and updates system status
  * @return: true if any command was received
  */
 bool checkWiFiCommands();
 
 /**
- * Check pure tone ADC input
- * Reads GPIO 36 ADC, ignores voltages below 2.5V
- * Sets pureToneDetected flag if voltage >= 2.5V
+ * Check pure tone input
+ * Polls the threshold detector, then takes a two-tone detection from the
+ * tone detector (GPIO 36, see tone_detector.h)
+ * Sets pureToneDetected flag when one is reported
  * @return: true if pure tone detected
  */
 bool checkPureToneADC();
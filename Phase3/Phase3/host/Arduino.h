@@ -0,0 +1,125 @@
+/*
+ * host/Arduino.h
+ * Thin Arduino/ESP32 shim so the SNC logic (navcon_core, edge_case_matrix,
+ * system_state, scs_protocol) builds as a host library for replay runs.
+ * Time is virtual (hostSetMicros) and Serial output is discarded unless
+ * hostSerialEcho is set - nothing here touches real hardware.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <string>
+
+// ==================== VIRTUAL CLOCK ====================
+extern uint64_t hostMicros;          // Advanced by the replay runner only
+
+inline unsigned long micros() { return (unsigned long)(uint32_t)hostMicros; }
+inline unsigned long millis() { return (unsigned long)(uint32_t)(hostMicros / 1000); }
+inline void hostSetMicros(uint64_t us) { if (us > hostMicros) hostMicros = us; }
+inline void delay(unsigned long ms) { hostMicros += (uint64_t)ms * 1000; }
+inline void delayMicroseconds(unsigned int us) { hostMicros += us; }
+
+// ==================== GPIO (no-ops) ====================
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define INPUT_PULLDOWN 3
+#define SERIAL_8N1 0
+
+// Section placement means nothing on the host
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+inline void pinMode(int, int) {}
+inline void digitalWrite(int, int) {}
+inline int digitalRead(int) { return LOW; }
+inline int analogRead(int) { return 0; }
+
+template <class T, class L, class H>
+inline T constrain(T value, L low, H high) {
+    return value < low ? (T)low : (value > high ? (T)high : value);
+}
+
+// ==================== STRING ====================
+// SystemStatus keeps a few display strings; only assignment and c_str() are used
+class String {
+public:
+    String(const char* text = "") : value(text ? text : "") {}
+    String& operator=(const char* text) { value = text ? text : ""; return *this; }
+    const char* c_str() const { return value.c_str(); }
+    size_t length() const { return value.size(); }
+    bool operator==(const char* text) const { return value == text; }
+
+private:
+    std::string value;
+};
+
+// ==================== SERIAL ====================
+extern bool hostSerialEcho;          // Print sketch output to stdout (replay -v)
+
+class HostSerial {
+public:
+    void begin(unsigned long, int = 0, int = -1, int = -1) {}
+    void updateBaudRate(unsigned long) {}
+    int available() { return 0; }
+    int read() { return -1; }
+    size_t read(uint8_t*, size_t) { return 0; }
+    int availableForWrite() { return 1 << 10; }
+    size_t write(const uint8_t*, size_t length) { return length; }
+    void flush() {}
+    void setTxBufferSize(size_t) {}
+    void setRxFIFOFull(uint8_t) {}
+    void setRxTimeout(uint8_t) {}
+    template <class F> void onReceive(F, bool = false) {}
+
+    int printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        if (!hostSerialEcho) return 0;
+        va_list args;
+        va_start(args, format);
+        int n = vprintf(format, args);
+        va_end(args);
+        return n;
+    }
+    void print(const char* text) { if (hostSerialEcho) fputs(text, stdout); }
+    void print(int value) { if (hostSerialEcho) printf("%d", value); }
+    void println(const char* text = "") { if (hostSerialEcho) puts(text); }
+    void println(const String& text) { println(text.c_str()); }
+    void println(int value) { if (hostSerialEcho) printf("%d\n", value); }
+};
+
+typedef HostSerial HardwareSerial;
+extern HostSerial Serial;
+
+// ==================== ESP ====================
+// Host "cycles" are TSC ticks on x86 and nanoseconds elsewhere - compare
+// host numbers with host numbers only
+class EspClass {
+public:
+    uint32_t getCycleCount();
+    void restart() { exit(0); }
+};
+extern EspClass ESP;
+
+inline uint32_t getCpuFrequencyMhz() { return 0; }   // Unknown on the host
+
+// ==================== FREERTOS (handles only) ====================
+typedef void* TaskHandle_t;
+typedef void* QueueHandle_t;
+inline void xTaskNotifyGive(TaskHandle_t) {}
+
+// Single-threaded on the host: critical sections compile to nothing
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define taskENTER_CRITICAL(mux) ((void)(mux))
+#define taskEXIT_CRITICAL(mux) ((void)(mux))
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,2 @@
+// Host shim - HardwareSerial lives in Arduino.h
+#include <Arduino.h>
@@ -0,0 +1,52 @@
+/*
+ * host/Preferences.h
+ * NVS shim: blobs live in process memory for as long as the host program
+ * runs, so the simulator can save a map on one run and load it on the next.
+ */
+
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include <Arduino.h>
+#include <map>
+#include <vector>
+
+class Preferences {
+public:
+    bool begin(const char* name, bool = false) {
+        space = name;
+        return true;
+    }
+
+    void end() {}
+
+    size_t putBytes(const char* key, const void* value, size_t length) {
+        const uint8_t* bytes = (const uint8_t*)value;
+        store()[space + "/" + key].assign(bytes, bytes + length);
+        return length;
+    }
+
+    size_t getBytesLength(const char* key) {
+        auto it = store().find(space + "/" + key);
+        return (it == store().end()) ? 0 : it->second.size();
+    }
+
+    size_t getBytes(const char* key, void* buffer, size_t length) {
+        auto it = store().find(space + "/" + key);
+        if (it == store().end() || it->second.size() > length) {
+            return 0;
+        }
+        memcpy(buffer, it->second.data(), it->second.size());
+        return it->second.size();
+    }
+
+private:
+    std::string space;
+
+    static std::map<std::string, std::vector<uint8_t>>& store() {
+        static std::map<std::string, std::vector<uint8_t>> blobs;
+        return blobs;
+    }
+};
+
+#endif // HOST_PREFERENCES_H
@@ -0,0 +1,9 @@
+// Host shim - spi_protocol.h only needs the type for MarvSPIComm's members
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include <Arduino.h>
+
+class SPIClass {};
+
+#endif // HOST_SPI_H
@@ -0,0 +1,19 @@
+// Host shim - opaque handles for MarvSPIComm's members (never used on the host)
+#ifndef HOST_SPI_MASTER_H
+#define HOST_SPI_MASTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct spi_device_t* spi_device_handle_t;
+
+typedef struct {
+    uint32_t flags;
+    size_t length;
+    size_t rxlength;
+    void* user;
+    const void* tx_buffer;
+    void* rx_buffer;
+} spi_transaction_t;
+
+#endif // HOST_SPI_MASTER_H
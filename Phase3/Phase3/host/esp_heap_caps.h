@@ -0,0 +1 @@
+// Host shim - nothing from heap_caps is used on the host
@@ -0,0 +1,84 @@
+/*
+ * host/host_stubs.cpp
+ * Host stand-ins for the SNC modules that only make sense on the robot:
+ * the log ring, latency trace, flight recorder, tone detector, PC profiler,
+ * UART handlers and SPI link.
+ * LOG() output goes to stdout with the on-target format when echo is on.
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "scs_protocol.h"
+#include "spi_protocol.h"
+#include "debug_log.h"
+#include "latency_trace.h"
+#include "flight_recorder.h"
+#include "tone_detector.h"
+#include "pc_profiler.h"
+
+// ==================== SHIM STATE ====================
+uint64_t hostMicros = 0;
+bool hostSerialEcho = false;
+HostSerial Serial;
+EspClass ESP;
+
+uint32_t EspClass::getCycleCount() {
+#if defined(__x86_64__) || defined(__i386__)
+    // Fenced on both sides: a bare rdtsc can run ahead of (or behind) the
+    // few dozen instructions being timed, and short calls then measure 0
+    _mm_lfence();
+    uint64_t tsc = __rdtsc();
+    _mm_lfence();
+    return (uint32_t)tsc;
+#else
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// ==================== SKETCH GLOBALS ====================
+// Only reached from printSystemStatus() - never transmit on the host
+SerialPacketHandler ssHandler(&Serial, 0, 0);
+SerialPacketHandler mdpsHandler(&Serial, 0, 0);
+
+MarvSPIComm::MarvSPIComm(SPIClass* spi_instance, uint8_t chip_select)
+    : spi(spi_instance), cs_pin(chip_select) {}
+void MarvSPIComm::printPerformanceStats() {}
+MarvSPIComm spi_comm(nullptr, 0);
+
+void printTaskStats() {}
+
+// ==================== DEBUG LOG ====================
+static const char* const HOST_LOG_MODULES[LOG_MOD_COUNT] = {"NAVCON", "EDGE", "TONE", "SYSTEM"};
+static const char* const HOST_LOG_LEVELS[] = {"", "E", "W", "I", "D"};
+
+// Always formats, so host timings include the cost a record has on target
+void logWrite(uint8_t module, uint8_t level, const char* format, ...) {
+    char message[LOG_MESSAGE_LEN];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    if (!hostSerialEcho) return;
+    printf("[%lu] %s/%s: %s\n", millis(), level <= LOG_LEVEL_DEBUG ? HOST_LOG_LEVELS[level] : "?",
+           module < LOG_MOD_COUNT ? HOST_LOG_MODULES[module] : "?", message);
+}
+
+void printLogStats() {}
+
+// ==================== LATENCY TRACE / FLIGHT RECORDER ====================
+void traceMark(TraceStage) {}
+void printLatencyTrace() {}
+void resetLatencyTrace() {}
+
+void flightRecordNavcon() {}
+void flightRecorderRequestUpload(bool) {}
+void printFlightRecorderStats() {}
+
+void printToneDetectorStats() {}
+
+void printPcProfile() {}
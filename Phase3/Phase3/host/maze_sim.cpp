@@ -0,0 +1,780 @@
+/*
+ * host/maze_sim.cpp
+ * Closed-loop kinematic simulator: the host-built SNC/NAVCON drives a
+ * differential-drive MARV through randomly generated line mazes. SS and MDPS
+ * are replaced by models that answer on the SCS round-robin, so NAVCON sees
+ * the same frames, in the same order, as on the robot.
+ *
+ * World   Grid of square cells. Every cell edge is a line: the edges of a
+ *         random spanning tree (plus --open of the rest) are RED/GREEN, the
+ *         others BLACK/BLUE, the outer boundary BLACK. Start is cell (0,0)
+ *         at a random heading, the goal is the far corner cell.
+ * MDPS    Geometry from MDPS/main.cpp: wheel radius, distancePerSlot,
+ *         systemCircumference. Drives at NAVCON's DAT1/DAT0 speed (a new
+ *         speed in the same direction retargets the ramp) and rotates at
+ *         ROT_SPEED under the accel limit. IST3 is the encoder edge rate, so
+ *         it reads 0 only a few edge periods after the wheels stop; IST4
+ *         flags the report that closes a stop or rotation (--no-motion-event
+ *         leaves it out, as the MDPS did before). Each report starts with
+ *         the IST5/6 odometry record (--no-odometry: IST1-4 only); the NAVCON reply is held until a rotation
+ *         or stop completes. Per-wheel slip (--slip, drawn per manoeuvre)
+ *         moves the robot less than the encoders count.
+ * SS      Three sensors SENSOR_SPACING apart on a row --sensor-offset ahead
+ *         of the axle, seen --latency late. Colours latch between reports
+ *         (a line crossed between rounds is still reported); the incidence
+ *         angle is measured when a line is first seen, with --angle-noise.
+ *
+ * A maze ends COMPLETE when the robot is in the goal cell (SS sends end of
+ * maze), WALL when the robot's centre crosses a BLACK/BLUE line, TIMEOUT
+ * after --timeout simulated seconds. --second-run runs every completed maze
+ * again from the same start with the route the SNC stored (maze_route.h). NAVCON keeps global state, so batches
+ * run in parallel as forked worker processes (--jobs, default one per core).
+ *
+ * Usage: maze_sim [--mazes N] [--seed S] [--size WxH] [--cell MM] [--line MM]
+ *                 [--open P] [--slip S] [--angle-noise DEG] [--latency MS]
+ *                 [--round MS] [--sensor-offset MM] [--timeout S] [--jobs N]
+ *                 [--no-latch] [--no-motion-event] [--no-odometry] [--fixed-speed]
+ *                 [--second-run]
+ *                 [--trace] [-v]
+ */
+
+#include <Arduino.h>
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <random>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "scs_protocol.h"
+#include "system_state.h"
+#include "navcon_core.h"
+#include "maze_map.h"
+#include "maze_route.h"
+#include "snc_harness.h"
+
+// ==================== MDPS GEOMETRY (MDPS/main.cpp) ====================
+#define MDPS_WHEEL_RADIUS_MM   25.0     // radius
+#define MDPS_COUNTS_PER_REV    60.0     // 30 slots x 2 edges
+#define MDPS_BASE_DIAMETER_MM  150.0    // baseDiameter (wheel centre to wheel centre)
+#define MDPS_TAN_SPEED         38.0     // tanSpeedR/L default vop (reported in CAL)
+#define MDPS_NAVCON_SPEED_MIN  10.0     // NAVCON_SPEED_MIN/MAX: DAT1/DAT0 clamp for forward/backward
+#define MDPS_NAVCON_SPEED_MAX  60.0
+#define MDPS_ROT_SPEED         26.0     // ROT_SPEED
+#define MDPS_ACCEL_MAX         150.0    // PROFILE_ACCEL_MAX (mm/s^2)
+#define MDPS_TICK_US           2000     // CONTROL_PERIOD_US
+#define MDPS_SPEED_STOP_FACTOR 1.5      // SPEED_STOP_FACTOR: no edge for this many periods reads 0
+#define MDPS_SPEED_STOP_MIN_US 20000    // SPEED_STOP_MIN_US
+
+static const double kPi = 3.14159265358979323846;
+static const double kDistancePerSlot = 2 * kPi * MDPS_WHEEL_RADIUS_MM / MDPS_COUNTS_PER_REV;
+static const double kDistancePerDegree = kPi * MDPS_BASE_DIAMETER_MM / 360.0;   // systemCircumference / 360
+
+#define SIM_MAX_MDPS_WAIT_US   10000000 // A rotation/stop that never completes ends the wait
+#define SIM_MAX_FAILURES_SHOWN 10
+
+struct SimConfig {
+    int width = 4;
+    int height = 4;
+    double cell_mm = 300;
+    double line_mm = 20;
+    double open_fraction = 0.1;   // Non-tree edges made navigable (loops)
+    double slip = 0.02;           // Std dev of per-wheel slip fraction
+    double angle_noise_deg = 2;
+    double latency_ms = 0;
+    double round_ms = 20;         // SCS frame time per round (on top of SNC rate limits)
+    double sensor_offset_mm = 80;
+    double timeout_s = 600;
+    bool fixed_speed = false;     // navcon_adaptive_speed off (VOP_FORWARD throughout)
+    bool motion_event = true;     // MDPS flags motion complete in IST4
+    bool odometry = true;         // MDPS sends the IST5/6 odometry record
+    bool second_run = false;      // Rerun completed mazes on the stored route
+    bool ss_latch = true;         // Report lines crossed between reports, not just the last sample
+    bool trace = false;
+};
+
+enum SimOutcome : uint8_t { SIM_COMPLETE = 0, SIM_WALL, SIM_TIMEOUT, SIM_OUTCOME_COUNT };
+static const char* const SIM_OUTCOME_NAMES[SIM_OUTCOME_COUNT] = {"complete", "wall", "timeout"};
+
+struct SimResult {
+    uint32_t seed;
+    uint8_t outcome;              // SimOutcome
+    float time_s;                 // MAZE entry to the end
+    uint16_t rotations;           // NAVCON rotate commands executed
+    uint16_t reverses;            // ...reverse commands
+    uint16_t lines_crossed;       // RED/GREEN lines the centre crossed
+    uint16_t navcon_turns;        // NAVCON commands sent
+    float drift_mm;               // SNC dead-reckoned position vs the true one, at the end
+    float heading_error_deg;      // ...and heading
+    float travelled_mm;           // SNC odometer at the end
+    float forward_mm;             // Driven forward ...
+    float cruise_mm;              // ...of that faster than VOP_FORWARD
+    uint8_t rerun_outcome;        // Second run on the stored route (SIM_OUTCOME_COUNT: not run)
+    float rerun_time_s;
+    uint8_t control_outcome;      // ...and with the same noise, reactive only
+    float control_time_s;
+};
+
+// ==================== MAZE ====================
+class Maze {
+public:
+    Maze(const SimConfig& config, std::mt19937& rng)
+        : width(config.width), height(config.height), cell(config.cell_mm), half_line(config.line_mm / 2),
+          vertical((width + 1) * height), horizontal(width * (height + 1)) {
+        std::uniform_int_distribution<int> coin(0, 1);
+        for (uint8_t& edge : vertical) edge = coin(rng) ? BLUE : BLACK;
+        for (uint8_t& edge : horizontal) edge = coin(rng) ? BLUE : BLACK;
+        for (int j = 0; j < height; j++) vertical[j * (width + 1)] = vertical[j * (width + 1) + width] = BLACK;
+        for (int i = 0; i < width; i++) horizontal[i] = horizontal[height * width + i] = BLACK;
+
+        // Random spanning tree (depth first) - every cell reachable over RED/GREEN
+        std::vector<bool> visited(width * height, false);
+        std::vector<int> stack(1, 0);
+        visited[0] = true;
+        while (!stack.empty()) {
+            int current = stack.back();
+            int ci = current % width, cj = current / width;
+            int options[4], count = 0;
+            if (ci > 0 && !visited[current - 1]) options[count++] = 0;
+            if (ci < width - 1 && !visited[current + 1]) options[count++] = 1;
+            if (cj > 0 && !visited[current - width]) options[count++] = 2;
+            if (cj < height - 1 && !visited[current + width]) options[count++] = 3;
+            if (count == 0) {
+                stack.pop_back();
+                continue;
+            }
+            int next = 0;
+            switch (options[std::uniform_int_distribution<int>(0, count - 1)(rng)]) {
+                case 0: vEdge(ci, cj) = navigable(rng); next = current - 1; break;
+                case 1: vEdge(ci + 1, cj) = navigable(rng); next = current + 1; break;
+                case 2: hEdge(ci, cj) = navigable(rng); next = current - width; break;
+                case 3: hEdge(ci, cj + 1) = navigable(rng); next = current + width; break;
+            }
+            visited[next] = true;
+            stack.push_back(next);
+        }
+
+        std::uniform_real_distribution<double> unit(0, 1);
+        for (int j = 0; j < height; j++) {
+            for (int i = 1; i < width; i++) {
+                if (isColorWall(vEdge(i, j)) && unit(rng) < config.open_fraction) vEdge(i, j) = navigable(rng);
+            }
+        }
+        for (int j = 1; j < height; j++) {
+            for (int i = 0; i < width; i++) {
+                if (isColorWall(hEdge(i, j)) && unit(rng) < config.open_fraction) hEdge(i, j) = navigable(rng);
+            }
+        }
+    }
+
+    const int width;
+    const int height;
+    const double cell;
+
+    // Colour under a point; *vertical_line tells which line orientation it is on
+    uint8_t colorAt(double x, double y, bool* vertical_line = nullptr) const {
+        int i = (int)lround(x / cell);
+        int j = (int)floor(y / cell);
+        if (fabs(x - i * cell) <= half_line && i >= 0 && i <= width && j >= 0 && j < height) {
+            if (vertical_line) *vertical_line = true;
+            return vertical[j * (width + 1) + i];
+        }
+        i = (int)floor(x / cell);
+        j = (int)lround(y / cell);
+        if (fabs(y - j * cell) <= half_line && i >= 0 && i < width && j >= 0 && j <= height) {
+            if (vertical_line) *vertical_line = false;
+            return horizontal[j * width + i];
+        }
+        return WHITE;
+    }
+
+    // Line between two horizontally / vertically adjacent cells (or the boundary)
+    uint8_t edgeBetween(int i0, int j0, int i1, int j1) const {
+        if (i0 != i1) {
+            int i = std::max(i0, i1);
+            return (i < 0 || i > width || j0 < 0 || j0 >= height) ? BLACK : vertical[j0 * (width + 1) + i];
+        }
+        int j = std::max(j0, j1);
+        return (j < 0 || j > height || i0 < 0 || i0 >= width) ? BLACK : horizontal[j * width + i0];
+    }
+
+private:
+    const double half_line;
+    std::vector<uint8_t> vertical;      // (width+1) x height: line x = i*cell, row j
+    std::vector<uint8_t> horizontal;    // width x (height+1): line y = j*cell, column i
+
+    uint8_t& vEdge(int i, int j) { return vertical[j * (width + 1) + i]; }
+    uint8_t& hEdge(int i, int j) { return horizontal[j * width + i]; }
+    static uint8_t navigable(std::mt19937& rng) {
+        return std::uniform_int_distribution<int>(0, 1)(rng) ? GREEN : RED;
+    }
+};
+
+// ==================== ROBOT + MDPS MODEL ====================
+enum MdpsMode { MDPS_IDLE, MDPS_FORWARD, MDPS_REVERSE, MDPS_ROTATE, MDPS_STOPPING };
+
+struct Pose {
+    double x, y, theta;           // mm, mm, rad (CCW from +x)
+};
+
+class MazeSim : public SNCHarness {
+public:
+    MazeSim(const SimConfig& config_in, uint32_t seed)
+        : config(config_in), rng(seed), maze(config_in, rng), sim_us(0), mode(MDPS_IDLE), speed(0),
+          speed_target(0), travel(0), rotation_target_mm(0), rotation_angle(0), rotation_dir(0),
+          last_rotation(0), last_rotation_dir(0), slip_right(0), slip_left(0), odometer(0), edges(0),
+          last_edge_us(0), edge_period_us(0), motion_closed(false), command_pending(false),
+          ss_angle(0), ss_seen_line(false) {
+        result = SimResult();
+        result.seed = seed;
+
+        pose.x = maze.cell / 2;
+        pose.y = maze.cell / 2;
+        pose.theta = std::uniform_real_distribution<double>(0, 2 * kPi)(rng);
+        latency_ticks = (size_t)(config.latency_ms * 1000 / MDPS_TICK_US);
+        history.assign(latency_ticks + 1, pose);
+        history_head = 0;
+        clearLatch();
+        for (int s = 0; s < 3; s++) ss_current[s] = WHITE;
+    }
+
+    /**
+     * Draw slip and angle noise from a new sequence (maze and start pose stay)
+     */
+    void reseedNoise(uint32_t seed) {
+        rng.seed(seed);
+    }
+
+    SimResult run() {
+        reset(1000000);
+        navcon_adaptive_speed = !config.fixed_speed;
+        sim_us = hostMicros;
+
+        // IDLE -> CAL -> MAZE, as the HUB QTP sequence does
+        runTurn();
+        receive(SCSPacket(createControlByte(SYS_CAL, SUB_SS, 0), 0, 0, 0));
+        receive(SCSPacket(createControlByte(SYS_CAL, SUB_MDPS, 0), MDPS_TAN_SPEED, MDPS_TAN_SPEED, 0));
+        receive(SCSPacket(createControlByte(SYS_CAL, SUB_MDPS, 1), 90, 0, 0));
+        receive(SCSPacket(createControlByte(SYS_CAL, SUB_SS, 1), 0, 0, 0));
+
+        uint64_t maze_start_us = 0;
+        Pose start = pose;
+        uint64_t timeout_us = (uint64_t)(config.timeout_s * 1e6);
+        bool done = false;
+
+        while (!done) {
+            runTurn();
+            if (systemStatus.currentSystemState == SYS_MAZE && maze_start_us == 0) {
+                maze_start_us = sim_us;
+                start = pose;     // The SNC map origin
+            }
+
+            // The robot keeps executing the last command while the SNC waits out its rate limits
+            if (!advanceTo(hostMicros)) break;
+            if (command_pending) {
+                command_pending = false;
+                applyCommand(command);
+                uint64_t limit = sim_us + SIM_MAX_MDPS_WAIT_US;
+                while ((mode == MDPS_ROTATE || mode == MDPS_STOPPING) && sim_us < limit) {
+                    if (!step()) break;
+                }
+                if (result.outcome == SIM_WALL) break;
+            }
+            hostSetMicros(sim_us);
+
+            sendMDPSReport();
+            if (!advanceTo(sim_us + (uint64_t)(config.round_ms * 1000))) break;
+            hostSetMicros(sim_us);
+            done = sendSSReport();
+
+            if (maze_start_us && sim_us - maze_start_us > timeout_us) {
+                result.outcome = SIM_TIMEOUT;
+                break;
+            }
+        }
+
+        result.time_s = (float)((sim_us - maze_start_us) / 1e6);
+        measureDrift(start);
+        return result;
+    }
+
+private:
+    // True pose in the frame the SNC's map was started in, against its estimate
+    void measureDrift(const Pose& start) {
+        const MazePose& estimate = mazeMapPose();
+        double dx = pose.x - start.x, dy = pose.y - start.y;
+        double c = cos(start.theta), s = sin(start.theta);
+        double ex = dx * c + dy * s - estimate.x_mm;
+        double ey = -dx * s + dy * c - estimate.y_mm;
+        double heading = (pose.theta - start.theta) * 180 / kPi - estimate.heading_deg;
+        heading = fmod(heading + 540.0, 360.0) - 180.0;
+        result.drift_mm = (float)sqrt(ex * ex + ey * ey);
+        result.heading_error_deg = (float)fabs(heading);
+        result.travelled_mm = (float)estimate.travelled_mm;
+    }
+
+    const SimConfig& config;
+    std::mt19937 rng;
+    Maze maze;
+    SimResult result;
+
+    uint64_t sim_us;
+    Pose pose;
+    std::vector<Pose> history;    // Poses over the last --latency (ring)
+    size_t history_head;
+    size_t latency_ticks;
+
+    MdpsMode mode;
+    double speed;                 // Wheel speed magnitude (mm/s)
+    double speed_target;
+    double travel;                // Mean encoder travel since the last clearPCNT (mm)
+    double rotation_target_mm;
+    uint16_t rotation_angle;
+    uint8_t rotation_dir;
+    uint16_t last_rotation;
+    uint8_t last_rotation_dir;
+    double slip_right;
+    double slip_left;
+    double odometer;              // Mean encoder travel, never cleared (mm)
+    long edges;                   // Slot edges counted on it
+    uint64_t last_edge_us;
+    uint64_t edge_period_us;      // Time between the last two edges
+    bool motion_closed;           // A stop/rotation ended since the last report (ResetFlag)
+    SCSPacket command;
+    bool command_pending;
+
+    uint8_t ss_current[3];        // Colours at the last sample
+    uint8_t ss_latch[3];          // First non-white colour per sensor since the last report
+    uint8_t ss_angle;
+    bool ss_seen_line;
+
+    // ---------- SNC side ----------
+    void beforeSNCFrame() override {
+        // The operator touches through IDLE and CAL; there is no pure tone
+        if (systemStatus.currentSystemState == SYS_IDLE || systemStatus.currentSystemState == SYS_CAL) {
+            systemStatus.touchDetected = true;
+        }
+    }
+
+    void onSNCFrame(const SCSPacket& packet) override {
+        if (packet.control == createControlByte(SYS_MAZE, SUB_SNC, 3)) {
+            command = packet;
+            command_pending = true;
+            result.navcon_turns++;
+        }
+    }
+
+    // ---------- MDPS ----------
+    // handleNavcon(): stop ramps down, anything else only starts from rest
+    void applyCommand(const SCSPacket& packet) {
+        if (config.trace) {
+            printf("  t=%8.2f s  pose (%6.1f, %6.1f) %6.1f deg  NAVCON state %d  cmd %3d %3d %d\n",
+                   sim_us / 1e6, pose.x, pose.y, pose.theta * 180 / kPi, navcon_status.current_state,
+                   packet.dat1, packet.dat0, packet.dec);
+        }
+
+        if (packet.dat1 == 0 && packet.dat0 == 0) {
+            if (mode == MDPS_FORWARD || mode == MDPS_REVERSE) {
+                mode = MDPS_STOPPING;
+                speed_target = 0;
+            } else if (mode == MDPS_ROTATE || mode == MDPS_IDLE) {
+                mode = MDPS_IDLE;
+                speed = 0;
+                motion_closed = true;     // Stop() straight away
+            }
+            return;
+        }
+        // Forward/backward at NAVCON's speed; the same direction again only retargets the ramp
+        double commanded = std::min(std::max((packet.dat1 + packet.dat0) / 2.0, MDPS_NAVCON_SPEED_MIN),
+                                    MDPS_NAVCON_SPEED_MAX);
+        if ((mode == MDPS_FORWARD && packet.dec == 0) || (mode == MDPS_REVERSE && packet.dec == 1)) {
+            speed_target = commanded;
+            return;
+        }
+        if (mode != MDPS_IDLE) return;
+
+        travel = 0;
+        std::normal_distribution<double> slip(0, config.slip);
+        slip_right = std::min(fabs(slip(rng)), 0.5);
+        slip_left = std::min(fabs(slip(rng)), 0.5);
+
+        switch (packet.dec) {
+            case 0:
+                mode = MDPS_FORWARD;
+                speed_target = commanded;
+                break;
+            case 1:
+                mode = MDPS_REVERSE;
+                speed_target = commanded;
+                result.reverses++;
+                break;
+            case 2:
+            case 3:
+                mode = MDPS_ROTATE;
+                speed_target = MDPS_ROT_SPEED;
+                rotation_angle = ((uint16_t)packet.dat1 << 8) | packet.dat0;
+                rotation_dir = packet.dec;
+                rotation_target_mm = rotation_angle * kDistancePerDegree;
+                result.rotations++;
+                break;
+        }
+    }
+
+    void sendMDPSReport() {
+        uint16_t distance = (uint16_t)(floor(travel / kDistancePerSlot) * kDistancePerSlot);
+        // speedEstimatorTick(): edge rate, 0 once no edge came for a few edge periods
+        uint64_t quiet_us = std::max((uint64_t)(MDPS_SPEED_STOP_FACTOR * edge_period_us),
+                                     (uint64_t)MDPS_SPEED_STOP_MIN_US);
+        uint8_t measured = 0;
+        if (edge_period_us > 0 && sim_us - last_edge_us < quiet_us) {
+            measured = (uint8_t)std::min(lround(kDistancePerSlot * 1e6 / edge_period_us), 255L);
+        }
+        uint8_t complete = (config.motion_event && motion_closed) ? MDPS_DEC_MOTION_COMPLETE : 0;
+        motion_closed = false;
+        if (config.odometry) {
+            // Both encoders count the same edges here; slip is what they miss
+            uint16_t counts = (uint16_t)edges;
+            uint8_t stamp = (uint8_t)(sim_us / (MDPS_ODOMETRY_TICK_MS * 1000));
+            receive(SCSPacket(createControlByte(SYS_MAZE, SUB_MDPS, MDPS_IST_ODOMETRY_RIGHT), counts >> 8,
+                              counts & 0xFF, stamp));
+            receive(SCSPacket(createControlByte(SYS_MAZE, SUB_MDPS, MDPS_IST_ODOMETRY_LEFT), counts >> 8,
+                              counts & 0xFF, stamp));
+        }
+        receive(SCSPacket(createControlByte(SYS_MAZE, SUB_MDPS, 1), 0, 0, 0));
+        receive(SCSPacket(createControlByte(SYS_MAZE, SUB_MDPS, 2), last_rotation >> 8, last_rotation & 0xFF,
+                          last_rotation_dir));
+        receive(SCSPacket(createControlByte(SYS_MAZE, SUB_MDPS, 3), measured, measured, 0));
+        receive(SCSPacket(createControlByte(SYS_MAZE, SUB_MDPS, 4), distance >> 8, distance & 0xFF, complete));
+    }
+
+    // ---------- SS ----------
+    void clearLatch() {
+        for (int s = 0; s < 3; s++) ss_latch[s] = WHITE;
+    }
+
+    // Sample the (delayed) sensor row into the latch; measure the angle on a new line
+    void sampleSensors() {
+        const Pose& seen = history[(history_head + 1) % history.size()];   // Oldest = --latency ago
+        double cx = seen.x + cos(seen.theta) * config.sensor_offset_mm;
+        double cy = seen.y + sin(seen.theta) * config.sensor_offset_mm;
+        double lx = -sin(seen.theta), ly = cos(seen.theta);
+
+        bool any = false;
+        for (int s = 0; s < 3; s++) {
+            ss_current[s] = WHITE;
+            double lateral = (1 - s) * SENSOR_SPACING;   // S1 left, S2 centre, S3 right
+            bool vertical_line = false;
+            uint8_t color = maze.colorAt(cx + lx * lateral, cy + ly * lateral, &vertical_line);
+            if (color == WHITE) continue;
+            any = true;
+            ss_current[s] = color;
+            if (ss_latch[s] == WHITE) ss_latch[s] = color;
+
+            if (!ss_seen_line) {
+                ss_seen_line = true;
+                double incidence = acos(fabs(vertical_line ? cos(seen.theta) : sin(seen.theta))) * 180 / kPi;
+                incidence += std::normal_distribution<double>(0, config.angle_noise_deg)(rng);
+                ss_angle = (uint8_t)lround(constrain(incidence, 0.0, 90.0));
+            }
+        }
+        if (!any && ss_latch[0] == WHITE && ss_latch[1] == WHITE && ss_latch[2] == WHITE) {
+            ss_seen_line = false;
+        }
+    }
+
+    // Returns true once end of maze has been sent
+    bool sendSSReport() {
+        int ci = (int)floor(pose.x / maze.cell), cj = (int)floor(pose.y / maze.cell);
+        if (ci == maze.width - 1 && cj == maze.height - 1) {
+            receive(SCSPacket(createControlByte(SYS_MAZE, SUB_SS, 3), 0, 0, 0));
+            result.outcome = SIM_COMPLETE;
+            return true;
+        }
+
+        const uint8_t* seen = config.ss_latch ? ss_latch : ss_current;
+        uint16_t colors = (seen[0] << 6) | (seen[1] << 3) | seen[2];
+        clearLatch();
+        receive(SCSPacket(createControlByte(SYS_MAZE, SUB_SS, 1), colors >> 8, colors & 0xFF, 0));
+        receive(SCSPacket(createControlByte(SYS_MAZE, SUB_SS, 2), ss_angle, 0, 0));
+        return false;
+    }
+
+    // ---------- Physics ----------
+    bool advanceTo(uint64_t until_us) {
+        while (sim_us < until_us) {
+            if (!step()) return false;
+        }
+        return true;
+    }
+
+    // One MDPS control tick; false once the robot has crossed a wall
+    bool step() {
+        const double dt = MDPS_TICK_US / 1e6;
+        double dv = MDPS_ACCEL_MAX * dt;
+        speed = speed < speed_target ? std::min(speed + dv, speed_target) : std::max(speed - dv, speed_target);
+
+        double right = speed * (1 - slip_right);
+        double left = speed * (1 - slip_left);
+        double v = 0, w = 0;
+        switch (mode) {
+            case MDPS_FORWARD:
+            case MDPS_STOPPING:
+                v = (right + left) / 2;
+                w = (right - left) / MDPS_BASE_DIAMETER_MM;
+                break;
+            case MDPS_REVERSE:
+                v = -(right + left) / 2;
+                w = -(right - left) / MDPS_BASE_DIAMETER_MM;
+                break;
+            case MDPS_ROTATE:
+                w = (rotation_dir == 2 ? 1 : -1) * (right + left) / MDPS_BASE_DIAMETER_MM;
+                break;
+            case MDPS_IDLE:
+                break;
+        }
+        travel += speed * dt;
+        odometer += speed * dt;
+        long edge = (long)floor(odometer / kDistancePerSlot);
+        if (edge != edges) {
+            edge_period_us = sim_us + MDPS_TICK_US - last_edge_us;
+            last_edge_us = sim_us + MDPS_TICK_US;
+            edges = edge;
+        }
+        if (mode == MDPS_FORWARD) {
+            result.forward_mm += (float)(v * dt);
+            if (speed > VOP_FORWARD + 0.5) result.cruise_mm += (float)(v * dt);
+        }
+
+        int ci = (int)floor(pose.x / maze.cell), cj = (int)floor(pose.y / maze.cell);
+        pose.x += v * cos(pose.theta) * dt;
+        pose.y += v * sin(pose.theta) * dt;
+        pose.theta = fmod(pose.theta + w * dt + 2 * kPi, 2 * kPi);
+        sim_us += MDPS_TICK_US;
+
+        history_head = (history_head + 1) % history.size();
+        history[history_head] = pose;
+        sampleSensors();
+
+        if (mode == MDPS_ROTATE && travel >= rotation_target_mm) {
+            mode = MDPS_IDLE;
+            speed = speed_target = 0;
+            last_rotation = (uint16_t)lround(travel / kDistancePerDegree);   // finishRotation(): from the encoders
+            last_rotation_dir = rotation_dir;
+            motion_closed = true;
+        } else if (mode == MDPS_STOPPING && speed == 0) {
+            mode = MDPS_IDLE;
+            motion_closed = true;
+        }
+
+        int ni = (int)floor(pose.x / maze.cell), nj = (int)floor(pose.y / maze.cell);
+        if (ni != ci || nj != cj) {
+            if (isColorWall(maze.edgeBetween(ci, cj, ni, nj))) {
+                result.outcome = SIM_WALL;
+                return false;
+            }
+            result.lines_crossed++;
+        }
+        return true;
+    }
+};
+
+// ==================== BATCH ====================
+// Results go down the pipe from a worker, or straight into results in-process
+// (a single job writing more than the pipe buffer before anyone reads would block)
+static void runSlice(const SimConfig& config, uint32_t base_seed, int mazes, int job, int jobs, int out_fd,
+                     std::vector<SimResult>* results) {
+    for (int i = job; i < mazes; i += jobs) {
+        MazeSim sim(config, base_seed + i);
+        SimResult result = sim.run();
+        result.rerun_outcome = SIM_OUTCOME_COUNT;
+
+        // Same seed: same maze, start pose and heading. Both reruns get a fresh
+        // noise sequence, or the reactive one would just repeat the first run
+        if (config.second_run && result.outcome == SIM_COMPLETE && mazeRouteLoad()) {
+            maze_route_enabled = false;
+            MazeSim control(config, base_seed + i);
+            control.reseedNoise(~(base_seed + i));
+            SimResult reactive = control.run();
+            result.control_outcome = reactive.outcome;
+            result.control_time_s = reactive.time_s;
+
+            mazeRouteLoad();
+            MazeSim rerun(config, base_seed + i);
+            rerun.reseedNoise(~(base_seed + i));
+            SimResult second = rerun.run();
+            result.rerun_outcome = second.outcome;
+            result.rerun_time_s = second.time_s;
+        }
+        maze_route_enabled = false;
+        if (results) {
+            results->push_back(result);
+        } else if (write(out_fd, &result, sizeof(result)) != (ssize_t)sizeof(result)) {
+            _exit(1);
+        }
+    }
+}
+
+static bool parseSize(const char* text, int& width, int& height) {
+    return sscanf(text, "%dx%d", &width, &height) == 2 && width > 1 && height > 0 && width <= 64 && height <= 64;
+}
+
+static double percentile(std::vector<float> values, double p) {
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, (size_t)(p * values.size()))];
+}
+
+int main(int argc, char** argv) {
+    SimConfig config;
+    int mazes = 100;
+    uint32_t seed = 1;
+    int jobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        bool used = true;
+        if (strcmp(arg, "--trace") == 0) { config.trace = true; used = false; }
+        else if (strcmp(arg, "--no-latch") == 0) { config.ss_latch = false; used = false; }
+        else if (strcmp(arg, "--fixed-speed") == 0) { config.fixed_speed = true; used = false; }
+        else if (strcmp(arg, "--no-motion-event") == 0) { config.motion_event = false; used = false; }
+        else if (strcmp(arg, "--no-odometry") == 0) { config.odometry = false; used = false; }
+        else if (strcmp(arg, "--second-run") == 0) { config.second_run = true; used = false; }
+        else if (strcmp(arg, "-v") == 0) { hostSerialEcho = true; used = false; }
+        else if (!value) { fprintf(stderr, "maze_sim: %s needs a value\n", arg); return 2; }
+        else if (strcmp(arg, "--mazes") == 0) mazes = atoi(value);
+        else if (strcmp(arg, "--seed") == 0) seed = strtoul(value, nullptr, 0);
+        else if (strcmp(arg, "--size") == 0) {
+            if (!parseSize(value, config.width, config.height)) {
+                fprintf(stderr, "maze_sim: --size wants WxH (2..64)\n");
+                return 2;
+            }
+        }
+        else if (strcmp(arg, "--cell") == 0) config.cell_mm = atof(value);
+        else if (strcmp(arg, "--line") == 0) config.line_mm = atof(value);
+        else if (strcmp(arg, "--open") == 0) config.open_fraction = atof(value);
+        else if (strcmp(arg, "--slip") == 0) config.slip = atof(value);
+        else if (strcmp(arg, "--angle-noise") == 0) config.angle_noise_deg = atof(value);
+        else if (strcmp(arg, "--latency") == 0) config.latency_ms = atof(value);
+        else if (strcmp(arg, "--round") == 0) config.round_ms = atof(value);
+        else if (strcmp(arg, "--sensor-offset") == 0) config.sensor_offset_mm = atof(value);
+        else if (strcmp(arg, "--timeout") == 0) config.timeout_s = atof(value);
+        else if (strcmp(arg, "--jobs") == 0) jobs = atoi(value);
+        else { fprintf(stderr, "maze_sim: unknown option %s\n", arg); return 2; }
+        if (used) i++;
+    }
+    if (mazes < 1) mazes = 1;
+    if (jobs < 1 || config.trace || hostSerialEcho) jobs = 1;   // Keep traced output in order
+    if (jobs > mazes) jobs = mazes;
+
+    auto start = std::chrono::steady_clock::now();
+
+    // One forked worker per job, each with its own copy of NAVCON's globals
+    int fds[2];
+    if (pipe(fds) != 0) {
+        perror("maze_sim: pipe");
+        return 2;
+    }
+    std::vector<pid_t> workers;
+    std::vector<SimResult> results;
+    for (int job = 0; job < jobs; job++) {
+        pid_t pid = (jobs == 1) ? 0 : fork();
+        if (pid < 0) {
+            perror("maze_sim: fork");
+            return 2;
+        }
+        if (pid == 0) {
+            if (jobs > 1) close(fds[0]);
+            runSlice(config, seed, mazes, job, jobs, fds[1], (jobs == 1) ? &results : nullptr);
+            if (jobs > 1) _exit(0);
+            break;
+        }
+        workers.push_back(pid);
+    }
+    close(fds[1]);
+
+    SimResult result;
+    while (read(fds[0], &result, sizeof(result)) == (ssize_t)sizeof(result)) results.push_back(result);
+    close(fds[0]);
+    for (pid_t pid : workers) waitpid(pid, nullptr, 0);
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::sort(results.begin(), results.end(),
+              [](const SimResult& a, const SimResult& b) { return a.seed < b.seed; });
+
+    // ---------- Report ----------
+    uint32_t outcomes[SIM_OUTCOME_COUNT] = {0};
+    std::vector<float> times, drifts, heading_errors;
+    double rotations = 0, reverses = 0, turns = 0, drift_sum = 0, heading_sum = 0, travelled = 0;
+    double forward = 0, cruise = 0;
+    for (const SimResult& r : results) {
+        outcomes[r.outcome]++;
+        drifts.push_back(r.drift_mm);
+        heading_errors.push_back(r.heading_error_deg);
+        drift_sum += r.drift_mm;
+        heading_sum += r.heading_error_deg;
+        travelled += r.travelled_mm;
+        forward += r.forward_mm;
+        cruise += r.cruise_mm;
+        rotations += r.rotations;
+        reverses += r.reverses;
+        turns += r.navcon_turns;
+        if (r.outcome == SIM_COMPLETE) times.push_back(r.time_s);
+    }
+    size_t n = results.size();
+
+    printf("maze_sim: %zu mazes %dx%d (cell %.0f mm, line %.0f mm), slip %.3f, angle noise %.1f deg, "
+           "latency %.0f ms, seeds %u..%u, %d jobs\n", n, config.width, config.height, config.cell_mm,
+           config.line_mm, config.slip, config.angle_noise_deg, config.latency_ms, seed, seed + mazes - 1, jobs);
+    printf("  complete %u (%.1f%%), wall %u, timeout %u\n", outcomes[SIM_COMPLETE],
+           n ? 100.0 * outcomes[SIM_COMPLETE] / n : 0.0, outcomes[SIM_WALL], outcomes[SIM_TIMEOUT]);
+    if (!times.empty()) {
+        double sum = 0;
+        for (float t : times) sum += t;
+        printf("  completion time: mean %.1f s, p50 %.1f s, p95 %.1f s, max %.1f s\n",
+               sum / times.size(), percentile(times, 0.5), percentile(times, 0.95), percentile(times, 1.0));
+    }
+    printf("  per maze: %.1f rotations, %.1f reverses, %.1f NAVCON turns (%s speed)\n",
+           n ? rotations / n : 0.0, n ? reverses / n : 0.0, n ? turns / n : 0.0,
+           config.fixed_speed ? "fixed" : "adaptive");
+    printf("  forward: %.0f mm per maze, %.1f%% of it above VOP_FORWARD\n", n ? forward / n : 0.0,
+           forward > 0 ? 100.0 * cruise / forward : 0.0);
+    if (n) {
+        printf("  pose drift at the end: mean %.0f mm, p95 %.0f mm (%.1f%% of %.0f mm travelled), "
+               "heading mean %.1f deg, p95 %.1f deg\n", drift_sum / n, percentile(drifts, 0.95),
+               travelled > 0 ? 100.0 * drift_sum / travelled : 0.0, travelled / n, heading_sum / n,
+               percentile(heading_errors, 0.95));
+    }
+
+    if (config.second_run) {
+        // Each completed maze is run twice more: on the stored route, and reactive only
+        uint32_t reruns = 0, route_complete = 0, control_complete = 0;
+        double route_sum = 0, control_sum = 0;
+        for (const SimResult& r : results) {
+            if (r.rerun_outcome == SIM_OUTCOME_COUNT) continue;
+            reruns++;
+            if (r.rerun_outcome == SIM_COMPLETE) {
+                route_complete++;
+                route_sum += r.rerun_time_s;
+            }
+            if (r.control_outcome == SIM_COMPLETE) {
+                control_complete++;
+                control_sum += r.control_time_s;
+            }
+        }
+        printf("  second run of %u completed mazes: route %u complete (mean %.1f s), reactive %u (mean %.1f s)\n",
+               reruns, route_complete, route_complete ? route_sum / route_complete : 0.0, control_complete,
+               control_complete ? control_sum / control_complete : 0.0);
+    }
+
+    int shown = 0;
+    for (const SimResult& r : results) {
+        if (r.outcome == SIM_COMPLETE) continue;
+        if (shown++ == 0) printf("  failures (rerun one with --seed S --mazes 1 --trace):\n");
+        if (shown > SIM_MAX_FAILURES_SHOWN) break;
+        printf("    seed %u: %s after %.1f s, %u rotations, %u lines crossed\n", r.seed,
+               SIM_OUTCOME_NAMES[r.outcome], r.time_s, r.rotations, r.lines_crossed);
+    }
+    printf("  %.2f s wall clock (%.0f mazes/s)\n", seconds, seconds > 0 ? n / seconds : 0.0);
+    return 0;
+}
@@ -0,0 +1,71 @@
+/*
+ * host/navcon_bench.cpp
+ * Host build of the NAVCON micro-benchmark (navcon_bench.cpp; serial 'B' on
+ * target). Prints cycles per call for each case and can append the numbers
+ * to a CSV keyed by a tag (e.g. the commit hash) to track them over time.
+ *
+ * Usage: navcon_bench [--rounds N] [--csv FILE --tag NAME] [--budget CYCLES]
+ * Exit status: 0, or 1 if any case's worst call exceeds --budget
+ */
+
+#include <Arduino.h>
+#include "navcon_bench.h"
+#include "navcon_core.h"
+
+int main(int argc, char** argv) {
+    int rounds = 20;
+    uint32_t budget = 0;
+    const char* csv_path = nullptr;
+    const char* tag = "local";
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+            rounds = constrain(atoi(argv[++i]), 1, 255);
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv_path = argv[++i];
+        } else if (strcmp(argv[i], "--tag") == 0 && i + 1 < argc) {
+            tag = argv[++i];
+        } else if (strcmp(argv[i], "--budget") == 0 && i + 1 < argc) {
+            budget = strtoul(argv[++i], nullptr, 0);
+        } else {
+            fprintf(stderr, "usage: navcon_bench [--rounds N] [--csv FILE --tag NAME] [--budget CYCLES]\n");
+            return 2;
+        }
+    }
+
+    initializeNavcon();
+
+    NavconBenchResult results[BENCH_CASE_COUNT];
+    uint32_t worst = runNavconBenchmark(results, rounds);
+
+    printf("%-34s %8s %8s %8s  %s\n", "case (host cycles/call)", "min", "mean", "max", "worst input");
+    for (int c = 0; c < BENCH_CASE_COUNT; c++) {
+        char input[16];
+        describeBenchInput(results[c].worst_input, input, sizeof(input));
+        printf("%-34s %8u %8llu %8u  %s\n", results[c].name, results[c].min_cycles,
+               (unsigned long long)(results[c].sum_cycles / NAVCON_BENCH_INPUTS), results[c].max_cycles, input);
+    }
+    printf("%u calls per case, worst %u cycles\n", results[0].calls, worst);
+
+    if (csv_path) {
+        FILE* csv = fopen(csv_path, "a");
+        if (!csv) {
+            fprintf(stderr, "navcon_bench: can't open %s\n", csv_path);
+            return 2;
+        }
+        // A new file gets a header row
+        fseek(csv, 0, SEEK_END);
+        if (ftell(csv) == 0) fprintf(csv, "tag,case,calls,min,mean,max\n");
+        for (int c = 0; c < BENCH_CASE_COUNT; c++) {
+            fprintf(csv, "%s,%s,%u,%u,%llu,%u\n", tag, results[c].name, results[c].calls, results[c].min_cycles,
+                    (unsigned long long)(results[c].sum_cycles / NAVCON_BENCH_INPUTS), results[c].max_cycles);
+        }
+        fclose(csv);
+    }
+
+    if (budget && worst > budget) {
+        printf("OVER BUDGET: %u > %u cycles\n", worst, budget);
+        return 1;
+    }
+    return 0;
+}
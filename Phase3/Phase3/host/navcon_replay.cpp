@@ -0,0 +1,456 @@
+/*
+ * host/navcon_replay.cpp
+ * Replays recorded SCS traffic through the SNC state manager and NAVCON on
+ * the host, as fast as the CPU allows, and checks every SNC frame produced
+ * against the one recorded.
+ *
+ * Inputs:
+ *   HUB logs (HUB/QTP1.txt etc.) "Sent:" lines feed the SNC, "Received:" lines
+ *                               are the SNC frames it must reproduce. Every
+ *                               "Start QTP" line begins a new session (the
+ *                               robot was restarted), so the SNC is reset there.
+ *                               The HUB stops logging when a QTP ends, so SNC
+ *                               frames past the end of a session are not checked.
+ *                               A session stops at the first HUB "Error" line
+ *                               (a rejected frame is dropped too): the recorded
+ *                               firmware failed there, so it is no reference
+ *   Flight logs (marv_run_*.bin) FR_SCS_RX records feed the SNC, FR_SCS_TX
+ *                               records from SUB_SNC are the expected output
+ *
+ * Operator events (touch, pure tone) aren't in either log, so they are taken
+ * from the recorded frame: if the next expected SNC frame reports a touch or
+ * tone in the state the SNC is in, the event is raised before generating it.
+ * Rate-limited turns skip the wait on the virtual clock instead of sleeping.
+ *
+ * Matching (--match, default: control for HUB logs, frame for flight logs):
+ *   frame    all four bytes
+ *   speed    as frame, but a forward/reverse command (MAZE:SNC:IST3, DEC 0/1)
+ *            only has to agree on stopped vs moving, not the speed itself
+ *            (logs recorded at another VOP_FORWARD or without the scheduler)
+ *   control  control byte (SYS-SUB-IST) only. The bundled HUB logs come from
+ *            firmware older than this tree (VOP_FORWARD 10, a longer reverse),
+ *            so only their frame sequence still applies
+ *
+ * Usage: navcon_replay [-v] [--repeat N] [--match frame|speed|control] <log> [log...]
+ * Exit status: 0 all logs reproduced, 1 a log diverged, 2 a log failed to load
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "scs_protocol.h"
+#include "system_state.h"
+#include "navcon_core.h"
+#include "flight_recorder.h"
+#include "snc_harness.h"
+
+struct ReplayFrame {
+    uint64_t time_us;             // Recorded time (HUB logs: 1 s resolution)
+    uint32_t source;              // Log line (HUB) or record index (flight log)
+    bool from_snc;                // Recorded SNC output rather than an input
+    bool restart;                 // First frame of a session (HUB "Start QTP" line before it)
+    SCSPacket packet;
+};
+
+enum MatchMode : uint8_t {
+    MATCH_AUTO,                   // control for HUB logs, frame for flight logs
+    MATCH_FRAME,
+    MATCH_SPEED,
+    MATCH_CONTROL
+};
+
+struct ReplayLog {
+    std::string name;
+    std::vector<ReplayFrame> frames;
+    uint32_t expected_count;
+    uint32_t sessions;            // Power-on runs in the log
+    uint32_t cut;                 // ...ended early where the HUB reported an error
+    bool flight_log;              // Sources are record indices, not line numbers
+};
+
+struct ReplayResult {
+    uint32_t inputs;              // Frames fed to the SNC
+    uint32_t ignored;             // Inputs after end of maze (the SNC ignores them too)
+    uint32_t produced;            // SNC frames generated
+    uint32_t unlogged;            // ...after the HUB stopped logging the session
+    uint32_t matched;             // ...equal to the recorded frame
+    MatchMode mode;               // ...under this comparison
+    bool diverged;
+    const ReplayFrame* want;      // First divergence (nullptr: SNC sent an extra frame)
+    const ReplayFrame* last;      // ...after this, the last frame of its session
+    SCSPacket got;                // ...and what was produced instead
+    bool got_valid;               // false: recorded frame was never produced
+};
+
+// ==================== LOG LOADING ====================
+static bool parseHubLine(const char* line, uint64_t& time_us, bool& from_snc, SCSPacket& packet) {
+    const char* direction = strstr(line, "|| Sent:");
+    from_snc = false;
+    if (!direction) {
+        direction = strstr(line, "|| Received:");
+        from_snc = true;
+    }
+    if (!direction) return false;
+
+    int day, month, year, hours, minutes, seconds;
+    if (sscanf(line, "%d/%d/%d %d:%d:%d", &day, &month, &year, &hours, &minutes, &seconds) != 6) {
+        return false;
+    }
+
+    // "(s-u-i) || NAME | NAME | i ||  dat1 | dat0 | dec || control ||"
+    int sys, sub, ist, dat1, dat0, dec, control;
+    const char* fields = strchr(direction, '(');
+    if (!fields || sscanf(fields, "(%d-%d-%d)", &sys, &sub, &ist) != 3) return false;
+    fields = strstr(fields, "||");
+    if (fields) fields = strstr(fields + 2, "||");
+    if (!fields || sscanf(fields + 2, " %d | %d | %d || %d", &dat1, &dat0, &dec, &control) != 4) {
+        return false;
+    }
+    if (control != createControlByte((SystemState)sys, (SubsystemID)sub, ist)) return false;
+
+    time_us = (((uint64_t)hours * 60 + minutes) * 60 + seconds) * 1000000ULL;
+    packet = SCSPacket(control, dat1, dat0, dec);
+    return true;
+}
+
+static bool loadHubLog(const char* path, ReplayLog& log) {
+    FILE* file = fopen(path, "r");
+    if (!file) return false;
+
+    char line[512];
+    uint32_t number = 0;
+    uint64_t last_us = 0;
+    bool restart = true;
+    bool failed = false;
+    while (fgets(line, sizeof(line), file)) {
+        number++;
+        // The HUB appends every QTP run to the same file
+        if (strstr(line, "Start QTP")) {
+            restart = true;
+            failed = false;
+            continue;
+        }
+
+        // The recorded robot failed the QTP here (rejected frame, time-out,
+        // reset): the rest of the session is no reference for this firmware
+        if (strncmp(line, "Error", 5) == 0) {
+            if (!failed && strstr(line, "TX found")) {
+                while (!log.frames.empty() && !log.frames.back().from_snc) log.frames.pop_back();
+                if (!log.frames.empty()) log.frames.pop_back();
+            }
+            if (!failed) log.cut++;
+            failed = true;
+            continue;
+        }
+        if (failed) continue;
+
+        ReplayFrame frame;
+        if (!parseHubLine(line, frame.time_us, frame.from_snc, frame.packet)) continue;
+        frame.restart = restart;
+        restart = false;
+
+        // Keep order within a logged second (and across midnight): 1 ms per line
+        if (frame.time_us <= last_us) frame.time_us = last_us + 1000;
+        last_us = frame.time_us;
+
+        frame.source = number;
+        log.frames.push_back(frame);
+    }
+    fclose(file);
+    return true;
+}
+
+static bool loadFlightLog(const char* path, ReplayLog& log) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+
+    FlightLogHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != FR_MAGIC ||
+        header.version != FR_VERSION || header.record_size != sizeof(FlightRecord)) {
+        fclose(file);
+        return false;
+    }
+
+    FlightRecord record;
+    uint32_t index = 0;
+    uint32_t last_us = 0;
+    uint64_t time_us = 0;
+    while (fread(&record, sizeof(record), 1, file) == 1 && record.type != 0xFF) {
+        // micros() wraps every ~71 minutes; unwrap to 64 bits
+        time_us += (index == 0) ? record.time_us : (uint32_t)(record.time_us - last_us);
+        last_us = record.time_us;
+        index++;
+
+        ReplayFrame frame;
+        frame.time_us = time_us;
+        frame.source = index;
+        frame.restart = log.frames.empty();
+        frame.packet = SCSPacket(record.data[0], record.data[1], record.data[2], record.data[3]);
+        if (record.type == FR_SCS_RX) {
+            frame.from_snc = false;
+        } else if (record.type == FR_SCS_TX && getSubsystemID(record.data[0]) == SUB_SNC) {
+            frame.from_snc = true;   // Forwarded SS/MDPS frames are not SNC output
+        } else {
+            continue;
+        }
+        log.frames.push_back(frame);
+    }
+    fclose(file);
+    return true;
+}
+
+static bool loadLog(const char* path, ReplayLog& log) {
+    log.name = path;
+    log.frames.clear();
+    log.cut = 0;
+
+    size_t length = strlen(path);
+    log.flight_log = length > 4 && strcmp(path + length - 4, ".bin") == 0;
+    if (!(log.flight_log ? loadFlightLog(path, log) : loadHubLog(path, log))) return false;
+
+    log.expected_count = 0;
+    log.sessions = 0;
+    for (const ReplayFrame& frame : log.frames) {
+        if (frame.from_snc) log.expected_count++;
+        if (frame.restart) log.sessions++;
+    }
+    return !log.frames.empty();
+}
+
+// ==================== REPLAY ====================
+static bool framesMatch(const SCSPacket& want, const SCSPacket& got, MatchMode mode) {
+    if (want.control != got.control) return false;
+    if (mode == MATCH_CONTROL) return true;
+    if (want.dec != got.dec) return false;
+
+    bool drive = mode == MATCH_SPEED && want.control == createControlByte(SYS_MAZE, SUB_SNC, 3) && want.dec <= 1;
+    if (drive) {
+        return (want.dat1 == 0) == (got.dat1 == 0) && (want.dat0 == 0) == (got.dat0 == 0);
+    }
+    return want.dat1 == got.dat1 && want.dat0 == got.dat0;
+}
+
+class Replay : public SNCHarness {
+public:
+    Replay(const ReplayLog& log_in, MatchMode mode_in)
+        : log(log_in), next_expected(0), session_end(0), mode(mode_in) {
+        result = ReplayResult();
+        if (mode == MATCH_AUTO) mode = log.flight_log ? MATCH_FRAME : MATCH_CONTROL;
+        result.mode = mode;
+    }
+
+    ReplayResult run() {
+        for (size_t index = 0; index < log.frames.size(); index++) {
+            const ReplayFrame& frame = log.frames[index];
+            if (frame.restart) {
+                startSession(index);
+            }
+            if (frame.from_snc) continue;
+            catchUp(index);
+            hostSetMicros(frame.time_us);
+            if (receive(frame.packet)) {
+                result.inputs++;
+            } else {
+                result.ignored++;
+            }
+            runTurn();
+        }
+        endSession();
+        return result;
+    }
+
+private:
+    const ReplayLog& log;
+    size_t next_expected;         // Index into log.frames of the next unmatched SNC frame
+    size_t session_end;           // One past the current session's last frame
+    MatchMode mode;
+    ReplayResult result;
+
+    void startSession(size_t first) {
+        endSession();
+        session_end = first + 1;
+        while (session_end < log.frames.size() && !log.frames[session_end].restart) {
+            session_end++;
+        }
+        next_expected = first;
+
+        // Power-on; clock starts at the session's first record so rate limits behave
+        reset(log.frames[first].time_us);
+        runTurn();
+    }
+
+    // The SNC keeps sending on its own between inputs (SOS repeats every
+    // 500 ms); let it produce what was recorded before log.frames[before]
+    void catchUp(size_t before) {
+        const ReplayFrame* want = nextExpectedFrame();
+        while (want && want < log.frames.data() + before && runTurn() > 0) {
+            want = nextExpectedFrame();
+        }
+    }
+
+    // Recorded frames the SNC never produced
+    void endSession() {
+        catchUp(session_end);
+        const ReplayFrame* missing = nextExpectedFrame();
+        if (missing) {
+            diverge(missing, nullptr);
+        }
+    }
+
+    const ReplayFrame* nextExpectedFrame() {
+        while (next_expected < session_end && !log.frames[next_expected].from_snc) {
+            next_expected++;
+        }
+        return next_expected < session_end ? &log.frames[next_expected] : nullptr;
+    }
+
+    void diverge(const ReplayFrame* want, const SCSPacket* got) {
+        if (result.diverged) return;
+        result.diverged = true;
+        result.want = want;
+        result.last = &log.frames[session_end - 1];
+        result.got_valid = (got != nullptr);
+        if (got) result.got = *got;
+    }
+
+    // Raise the touch/tone the recorded frame reports, if it is for the current state
+    void beforeSNCFrame() override {
+        const ReplayFrame* want = nextExpectedFrame();
+        if (!want || want->packet.dat1 != 1) return;
+
+        SystemState state = getSystemState(want->packet.control);
+        uint8_t ist = getInternalState(want->packet.control);
+        if (state != systemStatus.currentSystemState) return;
+
+        if ((state == SYS_IDLE || state == SYS_CAL) && ist == 0) {
+            systemStatus.touchDetected = true;
+        } else if (state == SYS_MAZE && ist == 1) {
+            systemStatus.pureToneDetected = true;
+        } else if (state == SYS_MAZE && ist == 2) {
+            systemStatus.touchDetected = true;
+        } else if (state == SYS_SOS && ist == 0) {
+            systemStatus.pureToneDetected = true;
+        }
+    }
+
+    void onSNCFrame(const SCSPacket& packet) override {
+        result.produced++;
+
+        const ReplayFrame* want = nextExpectedFrame();
+        if (!want) {
+            // The HUB stops logging at "End QTP" / a time-out while the SNC
+            // carries on, so a HUB session may end before the SNC's last frame
+            if (log.flight_log) {
+                diverge(nullptr, &packet);
+            } else {
+                result.unlogged++;
+            }
+            return;
+        }
+        next_expected++;
+
+        if (framesMatch(want->packet, packet, mode)) {
+            result.matched++;
+        } else {
+            diverge(want, &packet);
+        }
+    }
+};
+
+// ==================== REPORTING ====================
+static void formatFrame(char* out, size_t size, const SCSPacket& packet) {
+    snprintf(out, size, "(%d-%d-%d) %3d %3d %3d", getSystemState(packet.control),
+             getSubsystemID(packet.control), getInternalState(packet.control),
+             packet.dat1, packet.dat0, packet.dec);
+}
+
+static void printResult(const ReplayLog& log, const ReplayResult& result) {
+    static const char* const MODE_NAMES[] = { "auto", "frame", "speed", "control" };
+    printf("%s %s: %u inputs, %u/%u SNC frames matched (%s)", result.diverged ? "FAIL" : "PASS",
+           log.name.c_str(), result.inputs, result.matched, log.expected_count, MODE_NAMES[result.mode]);
+    if (result.ignored) printf(", %u after EOM", result.ignored);
+    if (log.sessions > 1) printf(", %u sessions", log.sessions);
+    if (log.cut) printf(" (%u cut at a HUB error)", log.cut);
+    if (result.unlogged) printf(", %u past end of session", result.unlogged);
+    printf("\n");
+
+    if (!result.diverged) return;
+
+    const char* where = log.flight_log ? "record" : "line";
+    char want[40], got[40];
+    if (result.want) formatFrame(want, sizeof(want), result.want->packet);
+    if (result.got_valid) formatFrame(got, sizeof(got), result.got);
+
+    if (!result.want) {
+        printf("     %s %u: extra SNC frame after the %s ended: %s\n", where, result.last->source,
+               log.sessions > 1 ? "session" : "log", got);
+    } else if (!result.got_valid) {
+        printf("     %s %u: recorded %s never produced\n", where, result.want->source, want);
+    } else {
+        printf("     %s %u: recorded %s, replay %s\n", where, result.want->source, want, got);
+    }
+}
+
+// ==================== MAIN ====================
+int main(int argc, char** argv) {
+    std::vector<ReplayLog> logs;
+    int repeat = 1;
+    MatchMode mode = MATCH_AUTO;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            hostSerialEcho = true;
+        } else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = atoi(argv[++i]);
+            if (repeat < 1) repeat = 1;
+        } else if (strcmp(argv[i], "--match") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            if (strcmp(name, "frame") == 0) mode = MATCH_FRAME;
+            else if (strcmp(name, "speed") == 0) mode = MATCH_SPEED;
+            else if (strcmp(name, "control") == 0) mode = MATCH_CONTROL;
+            else {
+                fprintf(stderr, "navcon_replay: --match is frame, speed or control\n");
+                return 2;
+            }
+        } else {
+            ReplayLog log;
+            if (!loadLog(argv[i], log)) {
+                fprintf(stderr, "navcon_replay: can't load %s\n", argv[i]);
+                return 2;
+            }
+            logs.push_back(log);
+        }
+    }
+
+    if (logs.empty()) {
+        fprintf(stderr, "usage: navcon_replay [-v] [--repeat N] [--match frame|speed|control] <HUB log .txt | flight log .bin>...\n");
+        return 2;
+    }
+
+    bool failed = false;
+    uint64_t frames = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int pass = 0; pass < repeat; pass++) {
+        for (const ReplayLog& log : logs) {
+            Replay replay(log, mode);
+            ReplayResult result = replay.run();
+            frames += result.inputs + result.produced;
+
+            // Report once; later passes are for timing only
+            if (pass == 0) {
+                printResult(log, result);
+                failed |= result.diverged;
+            }
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t runs = (uint64_t)repeat * logs.size();
+    printf("\n%llu replays, %llu frames in %.3f s (%.0f frames/s, %.0f replays/s)\n",
+           (unsigned long long)runs, (unsigned long long)frames, seconds,
+           seconds > 0 ? frames / seconds : 0.0, seconds > 0 ? runs / seconds : 0.0);
+
+    return failed ? 1 : 0;
+}
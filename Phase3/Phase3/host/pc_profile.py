@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""
+host/pc_profile.py
+Folds the SNC's PC profile (serial 'C' in a -DPC_PROFILER=1 build) into
+per-function totals using the sketch ELF's symbol table, and lists what is
+already in IRAM with its size so the hot set can be weighed against the
+remaining IRAM budget.
+
+    python3 host/pc_profile.py build/Phase3.ino.elf capture.txt
+    python3 host/pc_profile.py --nm xtensa-esp32-elf-nm Phase3.ino.elf capture.txt
+"""
+
+import argparse
+import bisect
+import re
+import subprocess
+import sys
+
+IRAM_LOW, IRAM_HIGH = 0x40080000, 0x400A0000
+PC_LINE = re.compile(r"^PC 0x([0-9a-fA-F]{8})\s+(\d+)")
+
+
+def load_symbols(nm, elf):
+    out = subprocess.run([nm, "-nSC", "--defined-only", elf], check=True,
+                         capture_output=True, text=True).stdout
+    symbols = []
+    for line in out.splitlines():
+        parts = line.split(None, 3)
+        if len(parts) == 4 and parts[2] in "tTwW":
+            symbols.append((int(parts[0], 16), int(parts[1], 16), parts[3]))
+    symbols.sort()
+    return symbols
+
+
+def function_of(symbols, starts, pc):
+    i = bisect.bisect_right(starts, pc) - 1
+    if i >= 0:
+        start, size, name = symbols[i]
+        if pc < start + max(size, 1) + 16:  # bins are 16 bytes wide
+            return name, start, size
+    return "?0x%08x" % pc, pc, 0
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("elf")
+    parser.add_argument("capture", help="serial log containing a 'C' report")
+    parser.add_argument("--nm", default="xtensa-esp32-elf-nm")
+    parser.add_argument("--top", type=int, default=20)
+    args = parser.parse_args()
+
+    symbols = load_symbols(args.nm, args.elf)
+    starts = [s[0] for s in symbols]
+
+    totals = {}
+    sampled = 0
+    with open(args.capture, errors="replace") as capture:
+        for line in capture:
+            match = PC_LINE.match(line.strip())
+            if not match:
+                continue
+            pc, count = int(match.group(1), 16), int(match.group(2))
+            name, start, size = function_of(symbols, starts, pc)
+            entry = totals.setdefault(name, [0, start, size])
+            entry[0] += count
+            sampled += count
+
+    if not sampled:
+        print("no 'PC 0x...' lines in %s" % args.capture)
+        return 1
+
+    print("%-48s %8s %6s %7s  %s" % ("function", "samples", "%", "bytes", "where"))
+    ranked = sorted(totals.items(), key=lambda kv: -kv[1][0])
+    for name, (count, start, size) in ranked[:args.top]:
+        where = "iram" if IRAM_LOW <= start < IRAM_HIGH else "flash"
+        print("%-48s %8d %5.1f%% %7d  %s" % (name[:48], count, 100.0 * count / sampled, size, where))
+
+    iram = [s for s in symbols if IRAM_LOW <= s[0] < IRAM_HIGH]
+    print("\nIRAM text: %d functions, %d bytes (of %d)" %
+          (len(iram), sum(s[1] for s in iram), IRAM_HIGH - IRAM_LOW))
+    flash_hot = sum(c for n, (c, st, sz) in ranked if not IRAM_LOW <= st < IRAM_HIGH)
+    print("Sampled time in flash-resident functions: %.1f%% of the printed bins" %
+          (100.0 * flash_hot / sampled))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
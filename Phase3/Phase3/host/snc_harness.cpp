@@ -0,0 +1,60 @@
+/*
+ * host/snc_harness.cpp
+ * See snc_harness.h
+ */
+
+#include "snc_harness.h"
+#include "system_state.h"
+#include "navcon_core.h"
+#include "maze_route.h"
+
+void SNCHarness::reset(uint64_t start_us) {
+    hostMicros = start_us;
+    initializeSystemState();
+    initializeNavcon();
+}
+
+bool SNCHarness::receive(const SCSPacket& packet) {
+    if (systemStatus.eomLatched) {
+        return false;
+    }
+
+    // End of maze latches before any processing, as in the sketch
+    if (getSubsystemID(packet.control) == SUB_SS && getSystemState(packet.control) == SYS_MAZE &&
+        getInternalState(packet.control) == 3) {
+        systemStatus.eomLatched = true;
+        systemStatus.currentSystemState = SYS_IDLE;
+        systemStatus.nextExpectedSubsystem = SUB_SNC;
+        systemStatus.nextExpectedIST = 0;
+        mazeRouteSaveRun();
+        return true;
+    }
+
+    processStateTransition(packet);
+    handleNavconIncomingData(packet);
+    return true;
+}
+
+uint8_t SNCHarness::runTurn() {
+    uint64_t waited = 0;
+    uint8_t sent = 0;
+
+    while (sent < SNC_MAX_FRAMES_PER_TURN && shouldSendSNCPacket()) {
+        beforeSNCFrame();
+        if (!shouldSendSNCPacketNow()) {
+            // IDLE waits for a touch that isn't coming; elsewhere skip the wait
+            if (systemStatus.currentSystemState == SYS_IDLE || waited >= SNC_MAX_WAIT_US) break;
+            hostMicros += SNC_WAIT_STEP_US;
+            waited += SNC_WAIT_STEP_US;
+            continue;
+        }
+
+        SCSPacket packet = generateSNCPacket();
+        if (packet.control == 0) break;
+        processStateTransition(packet);
+        updateAutoSendState();
+        sent++;
+        onSNCFrame(packet);
+    }
+    return sent;
+}
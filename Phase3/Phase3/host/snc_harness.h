@@ -0,0 +1,53 @@
+/*
+ * host/snc_harness.h
+ * Drives the host-built SNC the way the control task does, minus the UARTs.
+ * Frames from SS/MDPS go in through receive(); runTurn() lets the SNC send
+ * while it is its turn and hands each frame to onSNCFrame(). Rate-limited
+ * turns skip the wait on the virtual clock instead of sleeping through it.
+ */
+
+#ifndef HOST_SNC_HARNESS_H
+#define HOST_SNC_HARNESS_H
+
+#include <Arduino.h>
+#include "scs_protocol.h"
+
+#define SNC_WAIT_STEP_US        10000    // Virtual clock step while a turn is rate limited
+#define SNC_MAX_WAIT_US         2000000  // Give up on a turn after this long (stuck SNC)
+#define SNC_MAX_FRAMES_PER_TURN 8        // MAZE sends IST1..3 back to back
+
+class SNCHarness {
+public:
+    virtual ~SNCHarness() {}
+
+    /**
+     * Power-on state for the SNC and NAVCON
+     * @param start_us: Virtual clock at power-on
+     */
+    void reset(uint64_t start_us);
+
+    /**
+     * One frame from SS or MDPS (handleSSFrame()/handleMDPSFrame() minus I/O)
+     * @return false if the SNC ignored it (end of maze latched)
+     */
+    bool receive(const SCSPacket& packet);
+
+    /**
+     * Let the SNC send while it is its turn (runControlCycle()'s send block)
+     * @return Frames sent
+     */
+    uint8_t runTurn();
+
+protected:
+    /**
+     * Called before each SNC frame is generated - raise touch/tone here
+     */
+    virtual void beforeSNCFrame() {}
+
+    /**
+     * Called for every frame the SNC sends
+     */
+    virtual void onSNCFrame(const SCSPacket& packet) = 0;
+};
+
+#endif // HOST_SNC_HARNESS_H
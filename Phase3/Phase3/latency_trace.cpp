@@ -0,0 +1,152 @@
+/*
+ * MARV SNC - Turn Latency Tracing
+ * Cycle-counter timestamps along the SCS round-robin path, folded into
+ * fixed-size per-stage histograms (no allocation, no locks on the hot path).
+ */
+
+#include "latency_trace.h"
+#include "spi_protocol.h"
+#include "pc_profiler.h"
+
+static_assert(TRACE_STAGE_COUNT == LATENCY_STAGE_COUNT, "PKT_LATENCY_STATS stage count out of sync");
+
+// ==================== TRACE STATE ====================
+static TraceHistogram traceHist[TRACE_STAGE_COUNT];
+static uint32_t cpuMhz = 240;
+
+// Current turn (control task only)
+static bool turnActive = false;
+static bool turnDecided = false;
+static uint32_t turnStartCycles = 0;
+static uint32_t lastMarkCycles = 0;
+
+static const char* const TRACE_STAGE_NAMES[TRACE_STAGE_COUNT] = {
+    "handoff", "state", "navcon_rx", "decision", "tx", "turn"
+};
+
+// ==================== HISTOGRAM HELPERS ====================
+static uint8_t SNC_HOT bucketIndex(uint32_t cycles) {
+    if (cycles < 4) {
+        return cycles;
+    }
+    uint8_t msb = 31 - __builtin_clz(cycles);
+    uint8_t sub = (cycles >> (msb - 2)) & 0x03;
+    return (msb - 1) * 4 + sub;
+}
+
+// Largest value that falls into a bucket
+static uint32_t bucketUpperBound(uint8_t index) {
+    if (index < 4) {
+        return index;
+    }
+    uint8_t msb = index / 4 + 1;
+    uint8_t sub = index % 4;
+    uint32_t width = 1UL << (msb - 2);
+    return ((4UL + sub) << (msb - 2)) + (width - 1);
+}
+
+static void SNC_HOT recordCycles(TraceStage stage, uint32_t cycles) {
+    TraceHistogram& h = traceHist[stage];
+    if (h.count == 0 || cycles < h.min_cycles) h.min_cycles = cycles;
+    if (cycles > h.max_cycles) h.max_cycles = cycles;
+    h.sum_cycles += cycles;
+    h.count++;
+    h.buckets[bucketIndex(cycles)]++;
+}
+
+static uint32_t percentileCycles(const TraceHistogram& h, uint8_t percent) {
+    if (h.count == 0) {
+        return 0;
+    }
+    uint32_t target = (uint32_t)(((uint64_t)h.count * percent + 99) / 100);
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < TRACE_HIST_BUCKETS; i++) {
+        seen += h.buckets[i];
+        if (seen >= target) {
+            uint32_t bound = bucketUpperBound(i);
+            return bound < h.max_cycles ? bound : h.max_cycles;
+        }
+    }
+    return h.max_cycles;
+}
+
+static uint32_t cyclesToNs(uint32_t cycles) {
+    return (uint32_t)((uint64_t)cycles * 1000 / cpuMhz);
+}
+
+// ==================== TRACE FUNCTIONS ====================
+void initializeLatencyTrace() {
+    cpuMhz = getCpuFrequencyMhz();
+    resetLatencyTrace();
+    Serial.printf("Latency trace initialized (%d stages, %lu MHz cycle counter)\n",
+                  TRACE_STAGE_COUNT, (unsigned long)cpuMhz);
+}
+
+void SNC_HOT traceFrameReceived(uint32_t handoff_us) {
+    uint32_t now = ESP.getCycleCount();
+    uint32_t handoff = handoff_us * cpuMhz;
+
+    // The latest frame before the reply is the one that starts the turn
+    turnActive = true;
+    turnDecided = false;
+    turnStartCycles = now - handoff;
+    lastMarkCycles = now;
+    recordCycles(TRACE_HANDOFF, handoff);
+}
+
+void SNC_HOT traceMark(TraceStage stage) {
+    if (!turnActive) {
+        return;
+    }
+    uint32_t now = ESP.getCycleCount();
+    recordCycles(stage, now - lastMarkCycles);
+    lastMarkCycles = now;
+    if (stage == TRACE_DECISION) {
+        turnDecided = true;
+    }
+}
+
+void SNC_HOT traceReplySent() {
+    if (turnActive && turnDecided) {
+        uint32_t now = ESP.getCycleCount();
+        recordCycles(TRACE_TX, now - lastMarkCycles);
+        recordCycles(TRACE_TURN, now - turnStartCycles);
+    }
+    turnActive = false;
+    turnDecided = false;
+}
+
+void traceSnapshot(LatencyStatsPayload& out) {
+    out.timestamp = millis();
+    out.stage_count = TRACE_STAGE_COUNT;
+    memset(out.reserved, 0, sizeof(out.reserved));
+
+    for (uint8_t i = 0; i < TRACE_STAGE_COUNT; i++) {
+        const TraceHistogram& h = traceHist[i];
+        LatencyStageStats& s = out.stages[i];
+        s.count = h.count;
+        s.min_ns = cyclesToNs(h.min_cycles);
+        s.mean_ns = h.count ? cyclesToNs((uint32_t)(h.sum_cycles / h.count)) : 0;
+        s.p99_ns = cyclesToNs(percentileCycles(h, 99));
+        s.max_ns = cyclesToNs(h.max_cycles);
+    }
+}
+
+void printLatencyTrace() {
+    Serial.println("Latency trace (us):        count      min     mean      p99      max");
+    for (uint8_t i = 0; i < TRACE_STAGE_COUNT; i++) {
+        const TraceHistogram& h = traceHist[i];
+        float mean = h.count ? (float)(h.sum_cycles / h.count) / cpuMhz : 0.0f;
+        Serial.printf("  %-22s %8lu %8.2f %8.2f %8.2f %8.2f\n", TRACE_STAGE_NAMES[i],
+                      (unsigned long)h.count,
+                      (float)h.min_cycles / cpuMhz, mean,
+                      (float)percentileCycles(h, 99) / cpuMhz,
+                      (float)h.max_cycles / cpuMhz);
+    }
+}
+
+void resetLatencyTrace() {
+    memset(traceHist, 0, sizeof(traceHist));
+    turnActive = false;
+    turnDecided = false;
+}
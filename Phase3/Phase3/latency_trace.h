@@ -0,0 +1,78 @@
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include <Arduino.h>
+
+struct LatencyStatsPayload;  // spi_protocol.h
+
+// ==================== TRACE STAGES ====================
+// A turn starts when a frame leaves the UART ring and ends when the NAVCON
+// reply is queued for transmit. Each stage is the time since the previous mark.
+enum TraceStage {
+    TRACE_HANDOFF = 0,      // UART ring -> control task (comms task + inbox)
+    TRACE_STATE,            // Frame dequeued -> processStateTransition done
+    TRACE_NAVCON_RX,        // -> handleNavconIncomingData done
+    TRACE_DECISION,         // -> runEnhancedNavcon returned its packet
+    TRACE_TX,               // -> reply queued for both UARTs
+    TRACE_TURN,             // End to end: UART ring -> reply queued
+    TRACE_STAGE_COUNT
+};
+
+// Log-linear histogram: 4 buckets per power of two (<= 25% bucket width),
+// covering the full 32-bit cycle range in fixed memory
+#define TRACE_HIST_BUCKETS 124
+
+struct TraceHistogram {
+    uint32_t count;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint64_t sum_cycles;
+    uint32_t buckets[TRACE_HIST_BUCKETS];
+};
+
+// ==================== TRACE FUNCTIONS ====================
+// All marks are taken on the control task (core 1) with ESP.getCycleCount(),
+// which is per-core; only the hand-off crosses cores and is taken from micros().
+
+/**
+ * Cache the CPU clock and clear all histograms
+ */
+void initializeLatencyTrace();
+
+/**
+ * Start a turn for a frame the control task just dequeued
+ * @param handoff_us: micros() elapsed since the comms task took it off the ring
+ */
+void traceFrameReceived(uint32_t handoff_us);
+
+/**
+ * Record the time since the previous mark into a stage (no-op outside a turn)
+ * @param stage: TRACE_STATE, TRACE_NAVCON_RX or TRACE_DECISION
+ */
+void traceMark(TraceStage stage);
+
+/**
+ * Close the turn once the SNC reply is queued
+ * TX and TURN are only recorded if NAVCON made a decision during the turn.
+ */
+void traceReplySent();
+
+/**
+ * Summarise every stage (count, min, mean, p99, max in ns) for PKT_LATENCY_STATS
+ * Reads the control task's histograms without locking; a torn read only
+ * skews one report.
+ * @param out: Payload to fill
+ */
+void traceSnapshot(LatencyStatsPayload& out);
+
+/**
+ * Print min/mean/p99/max per stage in microseconds
+ */
+void printLatencyTrace();
+
+/**
+ * Clear all histograms (serial 'L')
+ */
+void resetLatencyTrace();
+
+#endif // LATENCY_TRACE_H
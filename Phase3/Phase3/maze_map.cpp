@@ -0,0 +1,327 @@
+/*
+ * MARV SNC - Dead-Reckoning Pose and Maze Map
+ * Integrates the MDPS reports NAVCON otherwise forgets into a pose in the
+ * frame MAZE was entered in: distance along the heading, signed by the last
+ * forward/reverse command, and the IST2 rotation that answers each rotate
+ * command. Distance comes from the IST5/6 encoder counts when the MDPS sends
+ * them, else from IST4 (reset at every stop/rotation). Every line and wall
+ * detection is marked in a 4-bit grid and queued for the dashboard.
+ *
+ * Written by the control task; the telemetry task takes copies under mapMux.
+ */
+
+#include "maze_map.h"
+#include "debug_log.h"
+#include <math.h>
+#include <string.h>
+
+// ==================== POSE STATE (control task) ====================
+static MazePose mapPose = {0, 0, 0, 0, 0, 0, 0, 0};
+static float mapHeadingRad = 0;
+static int8_t mapLegSign = 0;              // +1 forward, -1 reverse, 0 rotating / at rest
+static uint16_t mapLastDistance = 0;       // Last IST4 value in this leg
+static bool mapRotationPending = false;    // A rotate was sent; the next IST2 is its result
+static bool mapPoseDirty = false;
+static float mapTravelledMm = 0;
+
+// ==================== ODOMETRY STATE (control task) ====================
+static bool mapOdometry = false;           // IST5/6 seen since MAZE entry: IST4 is no longer integrated
+static uint16_t mapOdoRight = 0;           // Last record (low 16 bits of the MDPS counts)
+static uint16_t mapOdoLeft = 0;
+static uint8_t mapOdoStamp = 0;
+static uint32_t mapOdoCountRight = 0;      // Extended since MAZE entry
+static uint32_t mapOdoCountLeft = 0;
+static uint32_t mapOdoTimeMs = 0;          // MDPS clock since the first record
+
+// ==================== MAP STATE ====================
+static uint8_t mapGrid[MAP_GRID_BYTES];
+static MapLineRecord mapLines[MAP_LINE_LOG];
+static uint16_t mapLineHead = 0;           // Next encounter written (control task)
+static uint16_t mapLineTail = 0;           // Next encounter sent (telemetry task)
+static uint16_t mapLinesDropped = 0;
+static portMUX_TYPE mapMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ==================== GRID ====================
+bool mazeMapCellOf(float x_mm, float y_mm, int& gx, int& gy) {
+    gx = (int)floorf(x_mm / MAP_CELL_MM) + MAP_HALF_CELLS;
+    gy = (int)floorf(y_mm / MAP_CELL_MM) + MAP_HALF_CELLS;
+    return gx >= 0 && gy >= 0 && gx < MAP_GRID_CELLS && gy < MAP_GRID_CELLS;
+}
+
+static bool cellIndex(float x_mm, float y_mm, int& index) {
+    int gx, gy;
+    if (!mazeMapCellOf(x_mm, y_mm, gx, gy)) {
+        return false;
+    }
+    index = gy * MAP_GRID_CELLS + gx;
+    return true;
+}
+
+static uint8_t cellGet(int index) {
+    uint8_t pair = mapGrid[index >> 1];
+    return (index & 1) ? (pair >> 4) : (pair & 0x0F);
+}
+
+// Walls beat lines, lines beat the floor
+static void cellMark(float x_mm, float y_mm, uint8_t value) {
+    int index;
+    if (!cellIndex(x_mm, y_mm, index)) {
+        return;
+    }
+    uint8_t current = cellGet(index);
+    bool keep = (value == MAP_TRAVELLED) ? current != MAP_UNKNOWN
+                                         : isColorWall(current) && !isColorWall(value);
+    if (keep) {
+        return;
+    }
+    uint8_t& pair = mapGrid[index >> 1];
+    pair = (index & 1) ? (uint8_t)((pair & 0x0F) | (value << 4)) : (uint8_t)((pair & 0xF0) | value);
+}
+
+// ==================== POSE ====================
+static void headingChanged() {
+    // Keep the heading in (-pi, pi] so a long run does not lose float precision
+    while (mapHeadingRad > (float)M_PI) mapHeadingRad -= 2 * (float)M_PI;
+    while (mapHeadingRad <= -(float)M_PI) mapHeadingRad += 2 * (float)M_PI;
+}
+
+static void publishPose() {
+    taskENTER_CRITICAL(&mapMux);
+    mapPose.heading_deg = mapHeadingRad * 180.0f / (float)M_PI;
+    mapPoseDirty = true;
+    taskEXIT_CRITICAL(&mapMux);
+}
+
+void mazeMapReset() {
+    taskENTER_CRITICAL(&mapMux);
+    memset(&mapPose, 0, sizeof(mapPose));
+    mapPoseDirty = true;
+    mapLineHead = mapLineTail = 0;
+    mapLinesDropped = 0;
+    taskEXIT_CRITICAL(&mapMux);
+
+    memset(mapGrid, 0, sizeof(mapGrid));
+    mapHeadingRad = 0;
+    mapLegSign = 0;
+    mapLastDistance = 0;
+    mapRotationPending = false;
+    mapTravelledMm = 0;
+    mapOdometry = false;
+    mapOdoCountRight = mapOdoCountLeft = 0;
+    mapOdoTimeMs = 0;
+    cellMark(0, 0, MAP_TRAVELLED);
+}
+
+void mazeMapNoteCommand(const SCSPacket& command) {
+    bool stop = command.dat1 == 0 && command.dat0 == 0;
+    int8_t sign = mapLegSign;                   // A stop coasts in the leg it ends
+    if (!stop) {
+        sign = (command.dec == 0) ? 1 : (command.dec == 1) ? -1 : 0;
+        if (command.dec == 2 || command.dec == 3) {
+            mapRotationPending = true;
+        }
+    }
+    // The MDPS clears its counters when it starts a new kind of movement
+    if (sign != mapLegSign) {
+        mapLegSign = sign;
+        mapLastDistance = 0;
+        if (sign != 0) {
+            taskENTER_CRITICAL(&mapMux);
+            mapPose.legs++;
+            taskEXIT_CRITICAL(&mapMux);
+        }
+    }
+}
+
+// Move the pose delta_mm along the heading in the current leg's direction
+static void advancePose(float delta_mm) {
+    if (mapLegSign == 0 || delta_mm <= 0) {
+        return;
+    }
+
+    float step = mapLegSign * delta_mm;
+    float dx = cosf(mapHeadingRad), dy = sinf(mapHeadingRad);
+    float x0 = mapPose.x_mm, y0 = mapPose.y_mm;
+    mapTravelledMm += delta_mm;
+
+    taskENTER_CRITICAL(&mapMux);
+    mapPose.x_mm = x0 + step * dx;
+    mapPose.y_mm = y0 + step * dy;
+    mapPose.travelled_mm = (uint32_t)lroundf(mapTravelledMm);
+    taskEXIT_CRITICAL(&mapMux);
+
+    // Floor under the axle, every half cell along the step
+    for (float s = MAP_CELL_MM / 2; s < delta_mm; s += MAP_CELL_MM / 2) {
+        float along = (float)(mapLegSign * s);
+        cellMark(x0 + along * dx, y0 + along * dy, MAP_TRAVELLED);
+    }
+    cellMark(mapPose.x_mm, mapPose.y_mm, MAP_TRAVELLED);
+    publishPose();
+}
+
+void mazeMapNoteDistance(uint16_t distance_mm) {
+    // A drop means the MDPS reset after a stop; what it reports now is all new
+    uint16_t delta = (distance_mm >= mapLastDistance) ? distance_mm - mapLastDistance : distance_mm;
+    mapLastDistance = distance_mm;
+    if (!mapOdometry) {
+        advancePose(delta);
+    }
+}
+
+void mazeMapNoteOdometry(uint16_t right, uint16_t left, uint8_t stamp) {
+    if (!mapOdometry) {
+        mapOdometry = true;                     // First record is the reference
+    } else {
+        // Counts only rise (PCNT counts both edges either way round); 16 bits is 170 m between records
+        uint16_t dr = (uint16_t)(right - mapOdoRight);
+        uint16_t dl = (uint16_t)(left - mapOdoLeft);
+        mapOdoCountRight += dr;
+        mapOdoCountLeft += dl;
+        mapOdoTimeMs += (uint8_t)(stamp - mapOdoStamp) * MDPS_ODOMETRY_TICK_MS;
+        advancePose((dr + dl) * (MAP_MM_PER_COUNT / 2));
+    }
+    mapOdoRight = right;
+    mapOdoLeft = left;
+    mapOdoStamp = stamp;
+}
+
+void mazeMapNoteRotation(uint16_t angle, uint8_t direction) {
+    if (!mapRotationPending) {
+        return;                                 // The MDPS repeats its last result every round
+    }
+    mapRotationPending = false;
+    if (direction != 2 && direction != 3) {
+        return;
+    }
+    float turn = angle * (float)M_PI / 180.0f;
+    mapHeadingRad += (direction == 2) ? turn : -turn;
+    headingChanged();
+    taskENTER_CRITICAL(&mapMux);
+    mapPose.rotations++;
+    taskEXIT_CRITICAL(&mapMux);
+    publishPose();
+}
+
+// ==================== ENCOUNTERS ====================
+void mazeMapSensorPosition(uint8_t sensor, float& x_mm, float& y_mm) {
+    float c = cosf(mapHeadingRad), s = sinf(mapHeadingRad);
+    float lateral = (sensor == 1) ? SENSOR_SPACING : (sensor == 3) ? -(float)SENSOR_SPACING : 0;   // S1 left, S3 right
+    x_mm = mapPose.x_mm + MAP_SENSOR_AHEAD_MM * c - lateral * s;
+    y_mm = mapPose.y_mm + MAP_SENSOR_AHEAD_MM * s + lateral * c;
+}
+
+void mazeMapRecordLine(const LineDetectionData& detection) {
+    if (detection.detected_color == WHITE) {
+        return;
+    }
+    float x, y;
+    mazeMapSensorPosition(detection.detecting_sensor, x, y);
+    cellMark(x, y, detection.detected_color);
+
+    bool wall = isColorWall(detection.detected_color);
+    taskENTER_CRITICAL(&mapMux);
+    uint16_t sequence = mapPose.lines + mapPose.walls;
+    if (wall) {
+        mapPose.walls++;
+    } else {
+        mapPose.lines++;
+    }
+    mapPoseDirty = true;
+    if ((uint16_t)(mapLineHead - mapLineTail) < MAP_LINE_LOG) {
+        MapLineRecord& record = mapLines[mapLineHead % MAP_LINE_LOG];
+        record.sequence = sequence;
+        record.x_mm = (int16_t)lroundf(x);
+        record.y_mm = (int16_t)lroundf(y);
+        record.heading_deg = (int16_t)lroundf(mapHeadingRad * 180.0f / (float)M_PI);
+        record.color = detection.detected_color;
+        record.sensor = detection.detecting_sensor;
+        record.angle = detection.initial_angle;
+        record.angle_valid = detection.angle_valid;
+        mapLineHead++;
+    } else {
+        mapLinesDropped++;                      // Dashboard sees the gap in sequence
+    }
+    taskEXIT_CRITICAL(&mapMux);
+
+    LOG(NAVCON, DEBUG, "MAP: %s at (%d, %d) mm, heading %d°", wall ? "wall" : "line",
+        (int)x, (int)y, (int)lroundf(mapHeadingRad * 180.0f / (float)M_PI));
+}
+
+// ==================== TELEMETRY ====================
+bool mazeMapTakePose(MazePose& pose, bool force) {
+    taskENTER_CRITICAL(&mapMux);
+    bool take = mapPoseDirty || force;
+    if (take) {
+        pose = mapPose;
+        mapPoseDirty = false;
+    }
+    taskEXIT_CRITICAL(&mapMux);
+    return take;
+}
+
+bool mazeMapTakeLine(MapLineRecord& line) {
+    taskENTER_CRITICAL(&mapMux);
+    bool take = mapLineTail != mapLineHead;
+    if (take) {
+        line = mapLines[mapLineTail % MAP_LINE_LOG];
+        mapLineTail++;
+    }
+    taskEXIT_CRITICAL(&mapMux);
+    return take;
+}
+
+const MazePose& mazeMapPose() {
+    return mapPose;
+}
+
+const uint8_t* mazeMapGrid() {
+    return mapGrid;
+}
+
+uint8_t mazeMapCellAt(float x_mm, float y_mm) {
+    int index;
+    return cellIndex(x_mm, y_mm, index) ? cellGet(index) : (uint8_t)MAP_UNKNOWN;
+}
+
+// ==================== DEBUG ====================
+void printMazeMap() {
+    Serial.printf("Pose: (%.0f, %.0f) mm heading %.1f° | %lu mm travelled, %u legs, %u rotations\n",
+                  mapPose.x_mm, mapPose.y_mm, mapPose.heading_deg, (unsigned long)mapPose.travelled_mm,
+                  mapPose.legs, mapPose.rotations);
+    Serial.printf("Map: %u lines, %u walls (%u not sent, %u dropped)\n", mapPose.lines, mapPose.walls,
+                  (uint16_t)(mapLineHead - mapLineTail), mapLinesDropped);
+    if (mapOdometry) {
+        Serial.printf("Odometry: R %lu, L %lu counts over %lu ms (MDPS clock)\n", (unsigned long)mapOdoCountRight,
+                      (unsigned long)mapOdoCountLeft, (unsigned long)mapOdoTimeMs);
+    } else {
+        Serial.println("Odometry: none from the MDPS - distance from IST4");
+    }
+
+    // Bounding box of everything known, printed north (+y) up
+    int minX = MAP_GRID_CELLS, maxX = -1, minY = MAP_GRID_CELLS, maxY = -1;
+    for (int gy = 0; gy < MAP_GRID_CELLS; gy++) {
+        for (int gx = 0; gx < MAP_GRID_CELLS; gx++) {
+            if (cellGet(gy * MAP_GRID_CELLS + gx) != MAP_UNKNOWN) {
+                if (gx < minX) minX = gx;
+                if (gx > maxX) maxX = gx;
+                if (gy < minY) minY = gy;
+                if (gy > maxY) maxY = gy;
+            }
+        }
+    }
+    int robot = -1;
+    cellIndex(mapPose.x_mm, mapPose.y_mm, robot);
+
+    static const char CELL_CHARS[] = " RGBK.";   // MAP_UNKNOWN, RED..BLACK, MAP_TRAVELLED
+    char row[MAP_GRID_CELLS + 1];
+    for (int gy = maxY; gy >= minY; gy--) {
+        int n = 0;
+        for (int gx = minX; gx <= maxX; gx++) {
+            int index = gy * MAP_GRID_CELLS + gx;
+            uint8_t cell = cellGet(index);
+            row[n++] = (index == robot) ? '@' : (cell <= MAP_TRAVELLED) ? CELL_CHARS[cell] : '?';
+        }
+        row[n] = '\0';
+        Serial.printf("  |%s|\n", row);
+    }
+}
@@ -0,0 +1,137 @@
+#ifndef MAZE_MAP_H
+#define MAZE_MAP_H
+
+#include <Arduino.h>
+#include "scs_protocol.h"
+#include "navcon_core.h"
+
+// ==================== POSE / MAP CONFIGURATION ====================
+// Pose frame: origin where MAZE was entered, +x along the heading at that
+// moment, +y to its left, heading CCW. The grid is centred on the origin.
+#define MAP_CELL_MM           50
+#define MAP_GRID_CELLS        80       // 80 x 80 cells = 4 m square, 4 bits each (3.2 KB)
+#define MAP_LINE_LOG          64       // Encounters waiting for the dashboard (power of two)
+#define MAP_SENSOR_AHEAD_MM   80       // Sensor row ahead of the axle
+#define MAP_POSE_INTERVAL_MS  200      // Pose telemetry at most this often
+#define MAP_MM_PER_COUNT      (2 * (float)M_PI * 25 / 60)   // MDPS encoder count: 25 mm wheel, 30 slots x 2 edges
+
+#define MAP_GRID_BYTES        (MAP_GRID_CELLS * MAP_GRID_CELLS / 2)
+#define MAP_HALF_CELLS        (MAP_GRID_CELLS / 2)
+
+static_assert((MAP_LINE_LOG & (MAP_LINE_LOG - 1)) == 0, "MAP_LINE_LOG must be a power of two");
+static_assert((MAP_GRID_CELLS & 1) == 0, "Grid packs two cells per byte");
+
+// Grid cell contents: unknown, floor the axle crossed, or the line colour seen
+// there (RED..BLACK as the SS reports them). A wall is never overwritten by a
+// line, a line never by the floor.
+enum MapCellValue : uint8_t {
+    MAP_UNKNOWN = 0,
+    MAP_TRAVELLED = 5
+};
+
+struct MazePose {
+    float x_mm;
+    float y_mm;
+    float heading_deg;            // (-180, 180]
+    uint32_t travelled_mm;        // Odometer, both directions
+    uint16_t lines;               // RED/GREEN encounters recorded
+    uint16_t walls;               // BLACK/BLUE encounters recorded
+    uint16_t legs;                // Forward/reverse legs integrated
+    uint16_t rotations;           // Rotations integrated
+};
+
+// One line or wall encounter, where the detecting sensor was
+struct MapLineRecord {
+    uint16_t sequence;            // Increments per encounter since MAZE entry
+    int16_t x_mm;
+    int16_t y_mm;
+    int16_t heading_deg;          // Robot heading at the detection
+    uint8_t color;                // RED/GREEN/BLUE/BLACK
+    uint8_t sensor;               // First sensor (1, 2 or 3)
+    uint8_t angle;                // Incidence angle (46 = inferred steep)
+    uint8_t angle_valid;          // Measured rather than inferred
+};
+
+// ==================== POSE / MAP FUNCTIONS ====================
+/**
+ * Clear the pose, grid and encounter log (on entering MAZE from CAL)
+ */
+void mazeMapReset();
+
+/**
+ * Note the NAVCON command just sent - it says which way the next
+ * MDPS distance counts and that the next rotation report is new
+ * @param command: MAZE:SNC:IST3 frame
+ */
+void mazeMapNoteCommand(const SCSPacket& command);
+
+/**
+ * Integrate an MDPS distance report (IST4, mm since the last stop/rotation)
+ */
+void mazeMapNoteDistance(uint16_t distance_mm);
+
+/**
+ * Integrate an MDPS odometry record (IST5 right + IST6 left). Once one has
+ * arrived the pose follows the count deltas and IST4 is no longer integrated.
+ * @param stamp: MDPS clock in MDPS_ODOMETRY_TICK_MS steps
+ */
+void mazeMapNoteOdometry(uint16_t right, uint16_t left, uint8_t stamp);
+
+/**
+ * Integrate an MDPS rotation report (IST2) if it answers a rotate command
+ * @param direction: 2=LEFT (CCW), 3=RIGHT (CW)
+ */
+void mazeMapNoteRotation(uint16_t angle, uint8_t direction);
+
+/**
+ * Record a new line detection at the detecting sensor's position
+ */
+void mazeMapRecordLine(const LineDetectionData& detection);
+
+/**
+ * Copy the current pose
+ * @param force: copy even if nothing changed since the last take
+ * @return: true if pose was filled
+ */
+bool mazeMapTakePose(MazePose& pose, bool force = false);
+
+/**
+ * Take the oldest encounter the dashboard has not been sent
+ * @return: true if line was filled
+ */
+bool mazeMapTakeLine(MapLineRecord& line);
+
+/**
+ * Current pose (control task, or host tools)
+ */
+const MazePose& mazeMapPose();
+
+/**
+ * Grid cell at a pose-frame position (MAP_UNKNOWN outside the grid)
+ */
+uint8_t mazeMapCellAt(float x_mm, float y_mm);
+
+/**
+ * The packed grid: row-major from the cell at (-MAP_HALF_CELLS, -MAP_HALF_CELLS),
+ * two cells per byte, the even x in the low nibble (for saving it)
+ */
+const uint8_t* mazeMapGrid();
+
+/**
+ * Grid cell that holds a pose-frame position
+ * @return: false outside the grid
+ */
+bool mazeMapCellOf(float x_mm, float y_mm, int& gx, int& gy);
+
+/**
+ * Pose-frame position of a line sensor at the current pose
+ * @param sensor: 1 (left), 2 or 3 (right)
+ */
+void mazeMapSensorPosition(uint8_t sensor, float& x_mm, float& y_mm);
+
+/**
+ * Print the pose, encounter counts and the visited part of the grid
+ */
+void printMazeMap();
+
+#endif // MAZE_MAP_H
@@ -0,0 +1,286 @@
+/*
+ * MARV SNC - Second-Run Route
+ * Turns the maze map of a completed run into a distance-to-goal field over
+ * 100 mm route cells (breadth-first from the end pose through every cell the
+ * first run drove over) and answers NAVCON's one open question at a wall:
+ * LEFT or RIGHT. Dead ends the first run explored are branches of the field
+ * that never lead downhill, so the second run does not enter them.
+ *
+ * Stored in NVS so the route survives the reset between competition runs.
+ * Planned in the control task when the route is loaded or saved, never
+ * during a turn.
+ */
+
+#include "maze_route.h"
+#include "debug_log.h"
+#include <Preferences.h>
+#include <math.h>
+
+#define ROUTE_CELLS          (ROUTE_GRID_CELLS * ROUTE_GRID_CELLS)
+#define ROUTE_CELL_MM        (MAP_CELL_MM * ROUTE_CELL_MAP_CELLS)
+#define ROUTE_FLAG_OPEN      0x01       // Driven over (floor or a RED/GREEN line)
+#define ROUTE_FLAG_WALL      0x02       // A BLACK/BLUE encounter
+#define ROUTE_UNREACHED      0xFFFF
+#define ROUTE_STORE_MAGIC    0x3150414D // "MAP1"
+
+static_assert(MAP_GRID_CELLS % ROUTE_CELL_MAP_CELLS == 0, "Route cells must tile the map");
+
+// NVS blob: the end pose and the packed map grid, as maze_map.cpp keeps it
+struct RouteStore {
+    uint32_t magic;
+    int16_t end_x_mm;
+    int16_t end_y_mm;
+    uint8_t grid[MAP_GRID_BYTES];
+};
+
+bool maze_route_enabled = false;
+
+// ==================== ROUTE STATE (control task) ====================
+static RouteStore routeStore;                       // Last map saved or loaded
+static uint8_t routeFlags[ROUTE_CELLS];
+static uint16_t routeDistance[ROUTE_CELLS];         // Route cells to the goal
+static uint16_t routeQueue[ROUTE_CELLS];            // Breadth-first frontier
+static bool routeReady = false;
+static uint16_t routeStartDistance = ROUTE_UNREACHED;
+static uint16_t routeWallsKnown = 0;
+static uint16_t routeTurnsLeft = 0;
+static uint16_t routeTurnsRight = 0;
+static uint16_t routeTurnsReactive = 0;
+
+// ==================== ROUTE CELLS ====================
+static bool routeCellOf(float x_mm, float y_mm, int& rx, int& ry) {
+    int gx, gy;
+    if (!mazeMapCellOf(x_mm, y_mm, gx, gy)) {
+        return false;
+    }
+    rx = gx / ROUTE_CELL_MAP_CELLS;
+    ry = gy / ROUTE_CELL_MAP_CELLS;
+    return true;
+}
+
+static float routeCellCentre(int r) {
+    return (r - ROUTE_GRID_CELLS / 2 + 0.5f) * ROUTE_CELL_MM;
+}
+
+static bool routeInside(int rx, int ry) {
+    return rx >= 0 && ry >= 0 && rx < ROUTE_GRID_CELLS && ry < ROUTE_GRID_CELLS;
+}
+
+static bool routeFlagNear(int rx, int ry, int radius, uint8_t flag) {
+    for (int dy = -radius; dy <= radius; dy++) {
+        for (int dx = -radius; dx <= radius; dx++) {
+            if (routeInside(rx + dx, ry + dy) && (routeFlags[(ry + dy) * ROUTE_GRID_CELLS + rx + dx] & flag)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// ==================== PLANNING ====================
+static bool routePlan(const RouteStore& store) {
+    routeReady = false;
+    routeWallsKnown = 0;
+    memset(routeFlags, 0, sizeof(routeFlags));
+    for (int gy = 0; gy < MAP_GRID_CELLS; gy++) {
+        for (int gx = 0; gx < MAP_GRID_CELLS; gx++) {
+            int index = gy * MAP_GRID_CELLS + gx;
+            uint8_t cell = (index & 1) ? (store.grid[index >> 1] >> 4) : (store.grid[index >> 1] & 0x0F);
+            uint8_t& flags = routeFlags[(gy / ROUTE_CELL_MAP_CELLS) * ROUTE_GRID_CELLS + gx / ROUTE_CELL_MAP_CELLS];
+            if (cell == MAP_TRAVELLED || isColorNavigable(cell)) {
+                flags |= ROUTE_FLAG_OPEN;
+            } else if (isColorWall(cell)) {
+                flags |= ROUTE_FLAG_WALL;
+            }
+        }
+    }
+    for (int i = 0; i < ROUTE_CELLS; i++) {
+        routeDistance[i] = ROUTE_UNREACHED;
+        if (routeFlags[i] & ROUTE_FLAG_WALL) routeWallsKnown++;
+    }
+
+    int ex = 0, ey = 0;
+    if (!routeCellOf(store.end_x_mm, store.end_y_mm, ex, ey)) {
+        return false;
+    }
+
+    // Goal: every open cell near the end pose (the end of maze region)
+    uint16_t head = 0, tail = 0;
+    for (int dy = -ROUTE_GOAL_RADIUS; dy <= ROUTE_GOAL_RADIUS; dy++) {
+        for (int dx = -ROUTE_GOAL_RADIUS; dx <= ROUTE_GOAL_RADIUS; dx++) {
+            int rx = ex + dx, ry = ey + dy;
+            if (routeInside(rx, ry) && (routeFlags[ry * ROUTE_GRID_CELLS + rx] & ROUTE_FLAG_OPEN)) {
+                routeDistance[ry * ROUTE_GRID_CELLS + rx] = 0;
+                routeQueue[tail++] = ry * ROUTE_GRID_CELLS + rx;
+            }
+        }
+    }
+
+    // Breadth-first over open cells, diagonals included (the trail is one cell wide)
+    while (head != tail) {
+        uint16_t index = routeQueue[head++];
+        int rx = index % ROUTE_GRID_CELLS, ry = index / ROUTE_GRID_CELLS;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                int nx = rx + dx, ny = ry + dy;
+                if (!routeInside(nx, ny)) continue;
+                uint16_t next = ny * ROUTE_GRID_CELLS + nx;
+                if ((routeFlags[next] & ROUTE_FLAG_OPEN) && routeDistance[next] == ROUTE_UNREACHED) {
+                    routeDistance[next] = routeDistance[index] + 1;
+                    routeQueue[tail++] = next;
+                }
+            }
+        }
+    }
+
+    int sx = 0, sy = 0;
+    if (!routeCellOf(0, 0, sx, sy)) {
+        routeReady = false;
+        return false;
+    }
+    routeStartDistance = routeDistance[sy * ROUTE_GRID_CELLS + sx];
+    routeReady = routeStartDistance != ROUTE_UNREACHED;
+    return routeReady;
+}
+
+// ==================== PERSISTENCE ====================
+bool mazeRouteSaveRun() {
+    const MazePose& pose = mazeMapPose();
+    routeStore.magic = ROUTE_STORE_MAGIC;
+    routeStore.end_x_mm = (int16_t)lroundf(pose.x_mm);
+    routeStore.end_y_mm = (int16_t)lroundf(pose.y_mm);
+    memcpy(routeStore.grid, mazeMapGrid(), MAP_GRID_BYTES);
+
+    Preferences prefs;
+    bool saved = prefs.begin(ROUTE_NVS_NAMESPACE, false) &&
+                 prefs.putBytes(ROUTE_NVS_KEY, &routeStore, sizeof(routeStore)) == sizeof(routeStore);
+    prefs.end();
+    LOG(SYSTEM, INFO, "ROUTE: map of this run %s (end at %d, %d mm)", saved ? "stored" : "NOT stored",
+        routeStore.end_x_mm, routeStore.end_y_mm);
+
+    if (maze_route_enabled) {
+        routePlan(routeStore);
+    }
+    return saved;
+}
+
+bool mazeRouteLoad() {
+    Preferences prefs;
+    size_t length = 0;
+    if (prefs.begin(ROUTE_NVS_NAMESPACE, true)) {
+        length = prefs.getBytes(ROUTE_NVS_KEY, &routeStore, sizeof(routeStore));
+        prefs.end();
+    }
+    if (length != sizeof(routeStore) || routeStore.magic != ROUTE_STORE_MAGIC) {
+        Serial.println("ROUTE: no stored map - complete a run first");
+        return false;
+    }
+    if (!routePlan(routeStore)) {
+        Serial.println("ROUTE: stored map does not connect the start to the end of maze");
+        return false;
+    }
+    maze_route_enabled = true;
+    routeTurnsLeft = routeTurnsRight = routeTurnsReactive = 0;
+    return true;
+}
+
+// ==================== WALL DECISION ====================
+uint8_t mazeRouteWallTurn(const LineDetectionData& detection) {
+    if (!maze_route_enabled || !routeReady) {
+        return 0;
+    }
+
+    // Only walls the first run met - a new one means the map does not fit here
+    float wx, wy;
+    int rx, ry;
+    mazeMapSensorPosition(detection.detecting_sensor, wx, wy);
+    if (!routeCellOf(wx, wy, rx, ry) || !routeFlagNear(rx, ry, 1, ROUTE_FLAG_WALL)) {
+        routeTurnsReactive++;
+        return 0;
+    }
+
+    // Nearest reached cell, then ROUTE_LOOKAHEAD cells downhill
+    const MazePose& pose = mazeMapPose();
+    int cx, cy;
+    if (!routeCellOf(pose.x_mm, pose.y_mm, cx, cy)) {
+        routeTurnsReactive++;
+        return 0;
+    }
+    uint16_t at = 0, at_distance = ROUTE_UNREACHED;
+    for (int radius = 0; radius <= ROUTE_SNAP_RADIUS && at_distance == ROUTE_UNREACHED; radius++) {
+        for (int dy = -radius; dy <= radius; dy++) {
+            for (int dx = -radius; dx <= radius; dx++) {
+                int nx = cx + dx, ny = cy + dy;
+                if (!routeInside(nx, ny)) continue;
+                uint16_t index = ny * ROUTE_GRID_CELLS + nx;
+                if (routeDistance[index] < at_distance) {
+                    at = index;
+                    at_distance = routeDistance[index];
+                }
+            }
+        }
+    }
+    if (at_distance == ROUTE_UNREACHED) {
+        routeTurnsReactive++;
+        return 0;
+    }
+    uint16_t target = at;
+    for (int step = 0; step < ROUTE_LOOKAHEAD; step++) {
+        int tx = target % ROUTE_GRID_CELLS, ty = target / ROUTE_GRID_CELLS;
+        uint16_t best = target;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                if (!routeInside(tx + dx, ty + dy)) continue;
+                uint16_t next = (ty + dy) * ROUTE_GRID_CELLS + tx + dx;
+                if (routeDistance[next] < routeDistance[best]) best = next;
+            }
+        }
+        if (best == target) break;      // The goal
+        target = best;
+    }
+    if (target == at) {
+        routeTurnsReactive++;
+        return 0;
+    }
+
+    // Which side of the robot the route continues on
+    float bearing = atan2f(routeCellCentre(target / ROUTE_GRID_CELLS) - pose.y_mm,
+                           routeCellCentre(target % ROUTE_GRID_CELLS) - pose.x_mm) * 180.0f / (float)M_PI;
+    float relative = fmodf(bearing - pose.heading_deg + 540.0f, 360.0f) - 180.0f;
+    if (fabsf(relative) < ROUTE_AMBIGUOUS_DEG || fabsf(relative) > 180 - ROUTE_AMBIGUOUS_DEG) {
+        routeTurnsReactive++;
+        return 0;
+    }
+    uint8_t direction = (relative > 0) ? 2 : 3;
+    if (direction == 2) {
+        routeTurnsLeft++;
+    } else {
+        routeTurnsRight++;
+    }
+    LOG(NAVCON, DEBUG, "ROUTE: wall at (%d, %d) mm, route %d° off the heading - turn %s, %u cells to go",
+        (int)wx, (int)wy, (int)relative, direction == 2 ? "LEFT" : "RIGHT", at_distance);
+    return direction;
+}
+
+uint8_t mazeRouteCellAt(float x_mm, float y_mm) {
+    int gx, gy;
+    if (!maze_route_enabled || !routeReady || !mazeMapCellOf(x_mm, y_mm, gx, gy)) {
+        return MAP_UNKNOWN;
+    }
+    int index = gy * MAP_GRID_CELLS + gx;
+    uint8_t pair = routeStore.grid[index >> 1];
+    return (index & 1) ? (pair >> 4) : (pair & 0x0F);
+}
+
+// ==================== DEBUG ====================
+void printMazeRoute() {
+    Serial.printf("Route: second-run mode %s, %s\n", maze_route_enabled ? "ON" : "OFF",
+                  routeReady ? "route planned" : "no route");
+    if (routeReady) {
+        Serial.printf("  start %u cells (%u mm) from the end at (%d, %d) mm, %u wall cells known\n",
+                      routeStartDistance, routeStartDistance * ROUTE_CELL_MM, routeStore.end_x_mm,
+                      routeStore.end_y_mm, routeWallsKnown);
+        Serial.printf("  wall turns this run: %u left, %u right, %u reactive\n", routeTurnsLeft,
+                      routeTurnsRight, routeTurnsReactive);
+    }
+}
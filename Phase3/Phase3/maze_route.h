@@ -0,0 +1,69 @@
+#ifndef MAZE_ROUTE_H
+#define MAZE_ROUTE_H
+
+#include <Arduino.h>
+#include "navcon_core.h"
+#include "maze_map.h"
+
+// ==================== SECOND-RUN CONFIGURATION ====================
+// A completed run leaves its maze map (maze_map.h) and end pose in NVS. In
+// second-run mode the map is reduced to 100 mm route cells and searched from
+// the end of maze outwards, so every cell the first run drove through knows
+// its distance to the goal. At a known wall NAVCON then turns the way the
+// route continues instead of always RIGHT; anything the map does not explain
+// keeps the reactive handling.
+//
+// Off by default, and not turned on at boot: serial O loads it by hand.
+// maze_sim --second-run (seeds 1..400, default noise) completes 52 route
+// reruns against 39 reactive, but other seed sets come out even, and
+// without noise the route completes 107 of 119 against 119 of 119 reactive.
+// Following the route (faster when it completes: 190 s against 248 s)
+// sends NAVCON down paths the first run never drove, where it meets walls
+// it handles worse. Tuning ROUTE_LOOKAHEAD, ROUTE_AMBIGUOUS_DEG or
+// ROUTE_SNAP_RADIUS moved none of this by more than a few mazes.
+#define ROUTE_CELL_MAP_CELLS   2        // Route cell = 2 x 2 map cells (100 mm)
+#define ROUTE_GRID_CELLS       (MAP_GRID_CELLS / ROUTE_CELL_MAP_CELLS)
+#define ROUTE_GOAL_RADIUS      2        // Route cells around the end pose that count as the goal
+#define ROUTE_SNAP_RADIUS      2        // Furthest the robot may be from the route (cells)
+#define ROUTE_LOOKAHEAD        3        // Route bearing taken this many cells downhill (300 mm)
+#define ROUTE_AMBIGUOUS_DEG    20       // Within this of ahead/behind the route has no opinion
+#define ROUTE_NVS_NAMESPACE    "marv"
+#define ROUTE_NVS_KEY          "map"
+
+// Second-run mode (serial O toggles); off until a stored map was loaded
+extern bool maze_route_enabled;
+
+// ==================== SECOND-RUN FUNCTIONS ====================
+/**
+ * Store the live map and end pose as the route for the next runs
+ * Call once at end of maze (one NVS write, a few ms). Replans in place
+ * when second-run mode is on, so the next run follows the newest map.
+ * @return: false if the NVS write failed
+ */
+bool mazeRouteSaveRun();
+
+/**
+ * Load the stored map from NVS and plan the route; turns second-run mode on
+ * @return: false if there is no stored map or the start cannot reach the goal
+ */
+bool mazeRouteLoad();
+
+/**
+ * Turn the route suggests at a BLACK/BLUE wall (≤45°, first encounter)
+ * @return: 2=LEFT, 3=RIGHT, 0 if the mode is off, the wall is not on the
+ *          stored map or the robot is off the route (use the reactive turn)
+ */
+uint8_t mazeRouteWallTurn(const LineDetectionData& detection);
+
+/**
+ * Cell of the stored map at a pose-frame position
+ * @return: MAP_UNKNOWN if the mode is off or nothing was stored there
+ */
+uint8_t mazeRouteCellAt(float x_mm, float y_mm);
+
+/**
+ * Print the stored route (length, goal, walls known) and turns suggested
+ */
+void printMazeRoute();
+
+#endif // MAZE_ROUTE_H
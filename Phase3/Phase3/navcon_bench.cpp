@@ -0,0 +1,226 @@
+#include "navcon_bench.h"
+#include "navcon_core.h"
+#include "system_state.h"
+
+// ==================== CORPUS ====================
+static const uint8_t BENCH_ANGLES[NAVCON_BENCH_ANGLE_COUNT] = {0, 3, 5, 10, 22, 45, 60, 89};
+static const char BENCH_COLOR_CODES[] = "WRGBK";
+
+static const char* const BENCH_CASE_NAMES[BENCH_CASE_COUNT] = {
+    "state FORWARD_SCAN", "state STOP", "state REVERSE", "state STOP_BEFORE_ROTATE",
+    "state ROTATE", "state EVALUATE_CORRECTION", "state CROSSING_LINE",
+    "updateLineDetectionWithEdgeCases", "planCorrectionForRedGreen", "planCorrectionForBlackBlue"
+};
+
+extern bool stop_confirmation_received;      // navcon_core.cpp
+extern bool waiting_for_stop_confirmation;
+
+// Everything a benchmark call can touch, so a run leaves NAVCON as it found it
+struct NavconSnapshot {
+    NavconStatus status;
+    uint8_t colors[3];
+    uint8_t previous[3];
+    uint8_t angle;
+    uint8_t speed_left;
+    uint8_t speed_right;
+    uint16_t distance;
+    uint16_t rotation;
+    uint8_t rotation_dir;
+    bool motion_complete;
+    bool stop_confirmation;
+    bool waiting_for_stop;
+    float gain[2];
+};
+
+static void saveNavcon(NavconSnapshot& snapshot) {
+    snapshot.status = navcon_status;
+    memcpy(snapshot.colors, current_colors, sizeof(snapshot.colors));
+    memcpy(snapshot.previous, previous_colors, sizeof(snapshot.previous));
+    snapshot.angle = received_incidence_angle;
+    snapshot.speed_left = current_speed_left;
+    snapshot.speed_right = current_speed_right;
+    snapshot.distance = current_distance;
+    snapshot.rotation = current_rotation;
+    snapshot.rotation_dir = current_rotation_dir;
+    snapshot.motion_complete = mdps_motion_complete;
+    snapshot.stop_confirmation = stop_confirmation_received;
+    snapshot.waiting_for_stop = waiting_for_stop_confirmation;
+    memcpy(snapshot.gain, rotation_gain, sizeof(snapshot.gain));
+}
+
+static void restoreNavcon(const NavconSnapshot& snapshot) {
+    navcon_status = snapshot.status;
+    memcpy(current_colors, snapshot.colors, sizeof(snapshot.colors));
+    memcpy(previous_colors, snapshot.previous, sizeof(snapshot.previous));
+    received_incidence_angle = snapshot.angle;
+    current_speed_left = snapshot.speed_left;
+    current_speed_right = snapshot.speed_right;
+    current_distance = snapshot.distance;
+    current_rotation = snapshot.rotation;
+    current_rotation_dir = snapshot.rotation_dir;
+    mdps_motion_complete = snapshot.motion_complete;
+    stop_confirmation_received = snapshot.stop_confirmation;
+    waiting_for_stop_confirmation = snapshot.waiting_for_stop;
+    memcpy(rotation_gain, snapshot.gain, sizeof(snapshot.gain));
+}
+
+// Load corpus input into NAVCON's globals, mid-manoeuvre for the case's state.
+// Odd inputs see the MDPS stopped / confirmed, even ones still moving.
+static void loadBenchInput(uint8_t bench_case, uint16_t input) {
+    uint8_t combo = input / NAVCON_BENCH_ANGLE_COUNT;
+    uint8_t angle = BENCH_ANGLES[input % NAVCON_BENCH_ANGLE_COUNT];
+    bool settled = (input & 1) != 0;
+
+    current_colors[0] = combo / 25;
+    current_colors[1] = (combo / 5) % 5;
+    current_colors[2] = combo % 5;
+    for (int i = 0; i < 3; i++) previous_colors[i] = WHITE;
+    received_incidence_angle = angle;
+    current_speed_left = settled ? 0 : VOP_FORWARD;
+    current_speed_right = settled ? 0 : VOP_FORWARD;
+    current_distance = settled ? REVERSE_DISTANCE : REVERSE_DISTANCE / 2;
+    current_rotation = angle;
+    current_rotation_dir = 2;
+    mdps_motion_complete = settled;
+    stop_confirmation_received = settled;
+    waiting_for_stop_confirmation = !settled;
+
+    navcon_status.reset();
+    if (bench_case == BENCH_LINE_DETECTION || bench_case == BENCH_STATE_FORWARD_SCAN) {
+        return;  // Fresh scan - detection comes from the colours above
+    }
+
+    // A line already being handled: first non-white sensor and its colour
+    uint8_t sensor = 2;
+    uint8_t color = current_colors[1];
+    if (color == WHITE) {
+        sensor = current_colors[0] != WHITE ? 1 : 3;
+        color = current_colors[sensor - 1];
+    }
+    if (bench_case == BENCH_PLAN_RED_GREEN && !isColorNavigable(color)) color = (input & 2) ? GREEN : RED;
+    if (bench_case == BENCH_PLAN_BLACK_BLUE && !isColorWall(color)) color = (input & 2) ? BLUE : BLACK;
+
+    LineDetectionData& detection = navcon_status.line_detection;
+    detection.detected_color = color;
+    detection.detecting_sensor = sensor;
+    detection.initial_angle = angle;
+    detection.current_target_angle = angle;
+    detection.angle_valid = true;
+    detection.detection_active = true;
+    detection.line_type = isColorNavigable(color) ? LINE_RED_GREEN :
+                          (isColorWall(color) ? LINE_BLACK_BLUE : LINE_NONE);
+
+    if (bench_case >= BENCH_PLAN_RED_GREEN) {
+        return;  // Planners run from FORWARD_SCAN before any correction
+    }
+
+    CorrectionTracker& correction = navcon_status.correction;
+    correction.correction_direction = settled ? 3 : 2;
+    correction.in_correction_sequence = true;
+    correction.last_rotation_commanded = angle > 45 ? STEERING_CORRECTION : (angle ? angle : 90);
+    navcon_status.black_blue_nav.expecting_180_turn = (input & 2) != 0;
+    navcon_status.calculated_reverse_distance = REVERSE_DISTANCE;
+    navcon_status.current_state = (NavconState)bench_case;
+}
+
+static void runBenchCase(uint8_t bench_case) {
+    switch (bench_case) {
+        case BENCH_LINE_DETECTION:
+            updateLineDetectionWithEdgeCases();
+            break;
+        case BENCH_PLAN_RED_GREEN:
+            planCorrectionForRedGreen();
+            break;
+        case BENCH_PLAN_BLACK_BLUE:
+            planCorrectionForBlackBlue();
+            break;
+        default:
+            executeNavconStateMachine();
+            break;
+    }
+}
+
+// ==================== BENCHMARK FUNCTIONS ====================
+uint32_t runNavconBenchmark(NavconBenchResult* results, uint8_t rounds) {
+    NavconSnapshot snapshot;
+    saveNavcon(snapshot);
+
+    // Cost of the two timer reads themselves
+    uint32_t overhead = UINT32_MAX;
+    for (int i = 0; i < 16; i++) {
+        uint32_t start = ESP.getCycleCount();
+        uint32_t elapsed = ESP.getCycleCount() - start;
+        if (elapsed < overhead) overhead = elapsed;
+    }
+
+    uint32_t worst = 0;
+    for (uint8_t c = 0; c < BENCH_CASE_COUNT; c++) {
+        NavconBenchResult& result = results[c];
+        result.name = BENCH_CASE_NAMES[c];
+        result.calls = 0;
+        result.min_cycles = UINT32_MAX;
+        result.max_cycles = 0;
+        result.sum_cycles = 0;
+        result.worst_input = 0;
+
+        // An input's cost is its fastest round, so an interrupt landing in
+        // one call can't pose as the worst case
+        for (uint16_t input = 0; input < NAVCON_BENCH_INPUTS; input++) {
+            uint32_t best = UINT32_MAX;
+            for (uint8_t round = 0; round < rounds; round++) {
+                loadBenchInput(c, input);
+
+                uint32_t start = ESP.getCycleCount();
+                runBenchCase(c);
+                uint32_t elapsed = ESP.getCycleCount() - start;
+                elapsed = elapsed > overhead ? elapsed - overhead : 0;
+
+                result.calls++;
+                if (elapsed < best) best = elapsed;
+            }
+
+            result.sum_cycles += best;
+            if (best < result.min_cycles) result.min_cycles = best;
+            if (best > result.max_cycles) {
+                result.max_cycles = best;
+                result.worst_input = input;
+            }
+        }
+        if (result.max_cycles > worst) worst = result.max_cycles;
+    }
+
+    restoreNavcon(snapshot);
+    return worst;
+}
+
+void describeBenchInput(uint16_t input, char* out, size_t size) {
+    uint8_t combo = (input / NAVCON_BENCH_ANGLE_COUNT) % NAVCON_BENCH_COLOR_COMBOS;
+    snprintf(out, size, "%c/%c/%c @%u", BENCH_COLOR_CODES[combo / 25], BENCH_COLOR_CODES[(combo / 5) % 5],
+             BENCH_COLOR_CODES[combo % 5], BENCH_ANGLES[input % NAVCON_BENCH_ANGLE_COUNT]);
+}
+
+void printNavconBenchmark() {
+    if (systemStatus.currentSystemState != SYS_IDLE) {
+        Serial.println("BENCH: Only runs in IDLE (it would stall the NAVCON turn)");
+        return;
+    }
+
+    static NavconBenchResult results[BENCH_CASE_COUNT];
+    uint32_t worst = runNavconBenchmark(results, 4);
+    uint32_t mhz = getCpuFrequencyMhz();
+
+    Serial.println("\n========== NAVCON BENCHMARK (cycles/call) ==========");
+    Serial.printf("%-34s %6s %6s %6s  %s\n", "case", "min", "mean", "max", "worst input");
+    for (uint8_t c = 0; c < BENCH_CASE_COUNT; c++) {
+        const NavconBenchResult& result = results[c];
+        char input[16];
+        describeBenchInput(result.worst_input, input, sizeof(input));
+        Serial.printf("%-34s %6lu %6lu %6lu  %s\n", result.name, (unsigned long)result.min_cycles,
+                      (unsigned long)(result.sum_cycles / NAVCON_BENCH_INPUTS), (unsigned long)result.max_cycles, input);
+    }
+    Serial.printf("Worst %lu cycles (%lu us @ %lu MHz), budget %lu: %s\n",
+                  (unsigned long)worst, (unsigned long)(mhz ? worst / mhz : 0), (unsigned long)mhz,
+                  (unsigned long)NAVCON_TURN_BUDGET_CYCLES,
+                  worst <= NAVCON_TURN_BUDGET_CYCLES ? "OK" : "OVER BUDGET");
+    Serial.println("====================================================");
+}
@@ -0,0 +1,63 @@
+#ifndef NAVCON_BENCH_H
+#define NAVCON_BENCH_H
+
+#include <Arduino.h>
+
+// ==================== BENCHMARK CONFIGURATION ====================
+// Corpus: every S1/S2/S3 colour combination at each incidence angle below
+#define NAVCON_BENCH_COLOR_COMBOS  125
+#define NAVCON_BENCH_ANGLE_COUNT   8
+#define NAVCON_BENCH_INPUTS        (NAVCON_BENCH_COLOR_COMBOS * NAVCON_BENCH_ANGLE_COUNT)
+
+// Worst-case NAVCON decision on target: 100 us at 240 MHz
+#define NAVCON_TURN_BUDGET_CYCLES  24000
+
+enum NavconBenchCase {
+    BENCH_STATE_FORWARD_SCAN = 0,   // executeNavconStateMachine() per NavconState
+    BENCH_STATE_STOP,
+    BENCH_STATE_REVERSE,
+    BENCH_STATE_STOP_BEFORE_ROTATE,
+    BENCH_STATE_ROTATE,
+    BENCH_STATE_EVALUATE_CORRECTION,
+    BENCH_STATE_CROSSING_LINE,
+    BENCH_LINE_DETECTION,           // updateLineDetectionWithEdgeCases()
+    BENCH_PLAN_RED_GREEN,           // planCorrectionForRedGreen()
+    BENCH_PLAN_BLACK_BLUE,          // planCorrectionForBlackBlue()
+    BENCH_CASE_COUNT
+};
+
+struct NavconBenchResult {
+    const char* name;
+    uint32_t calls;
+    uint32_t min_cycles;          // Cheapest input (each input: fastest of its rounds)
+    uint32_t max_cycles;          // Most expensive input - the number the budget holds
+    uint64_t sum_cycles;          // Sum of input costs (mean = sum / NAVCON_BENCH_INPUTS)
+    uint16_t worst_input;         // Corpus index of the max (see describeBenchInput)
+};
+
+// ==================== BENCHMARK FUNCTIONS ====================
+/**
+ * Time every case over the corpus with ESP.getCycleCount()
+ * NAVCON's state and inputs are saved first and restored after, and the
+ * timer overhead is subtracted. Blocks the calling task (~100 ms on target).
+ * @param results: BENCH_CASE_COUNT entries to fill
+ * @param rounds: Calls per input (more rounds filter out more interrupt noise)
+ * @return Largest max_cycles of any case
+ */
+uint32_t runNavconBenchmark(NavconBenchResult* results, uint8_t rounds);
+
+/**
+ * Format a corpus input as "S1/S2/S3 @angle"
+ * @param input: Corpus index (0..NAVCON_BENCH_INPUTS-1)
+ * @param out: Output buffer
+ * @param size: Bytes in out
+ */
+void describeBenchInput(uint16_t input, char* out, size_t size);
+
+/**
+ * Run the benchmark and print cycles per call against the turn budget
+ * (serial 'B'; refused outside IDLE so a live run is never stalled)
+ */
+void printNavconBenchmark();
+
+#endif // NAVCON_BENCH_H
@@ -1,12 +1,19 @@
 #include "navcon_core.h"
 #include "edge_case_matrix.h"
+#include "debug_log.h"
+#include "flight_recorder.h"
+#include "maze_map.h"
+#include "maze_route.h"
+#include "pc_profiler.h"
+#include <math.h>
 
 // ==================== CONSTANT DEFINITIONS ====================
 // Define the constants that were declared as extern in the header
 const uint16_t REVERSE_DISTANCE = 45;      // mm to reverse before rotation
 const uint16_t SENSOR_SPACING = 61;        // mm between S2 and S1/S3 (updated to 6.1cm)
 const uint8_t STEERING_CORRECTION = 5;     // degrees for steering corrections
-const uint8_t VOP_FORWARD = 30;            // forward speed mm/s (adjust as needed)
+const uint8_t VOP_FORWARD = 38;            // forward speed mm/s (the tanSpeed the MDPS drove before it took ours)
+const uint8_t VOP_CRUISE = 50;             // forward speed mm/s between lines (adaptive mode)
 
 // Color constant definitions
 const uint8_t WHITE = 0;
@@ -25,11 +32,18 @@ uint8_t current_speed_right = 0;                           // Right wheel speed
 uint16_t current_distance = 0;                             // Distance since last stop
 uint16_t current_rotation = 0;                             // Last rotation executed
 uint8_t current_rotation_dir = 0;                          // 2=left(CCW), 3=right(CW)
+bool mdps_motion_complete = false;                         // IST4 carried MDPS_DEC_MOTION_COMPLETE
+static uint16_t odometry_right = 0;                        // IST5 count, waiting for its IST6
 bool stop_confirmation_received = false;                    // indiactes if we have infact stopped proerply aftrer reversring
 bool waiting_for_stop_confirmation = false;  
 
 // Main NAVCON status instance
 NavconStatus navcon_status;
+bool navcon_adaptive_speed = true;
+float rotation_gain[2] = {1.0f, 1.0f};
+
+#define ROTATION_GAIN_MIN_ANGLE 10     // Smaller rotations are mostly encoder quantisation
+#define ROTATION_GAIN_LIMIT     0.5f   // Reject feedback more than 50% off (aborted / bad frame)
 
 // ==================== DATA STRUCTURE IMPLEMENTATIONS ====================
 void LineDetectionData::reset() {
@@ -49,6 +63,7 @@ void CorrectionTracker::reset() {
     in_correction_sequence = false;
     last_rotation_commanded = 0;
     last_rotation_actual = 0;
+    rotation_wanted = 0;
     rotation_feedback_processed = false;
 }
 
@@ -70,6 +85,12 @@ void NavconStatus::reset() {
     // Initialize smart reverse distance tracking
     distance_at_block_entry = 0;
     calculated_reverse_distance = 0;
+
+    last_turn_ms = 0;
+    turn_interval_ms = 0;
+
+    speed_block_leg = false;
+    speed_line_spacing_mm = 0;
 }
 
 // ==================== UTILITY FUNCTIONS ====================
@@ -88,15 +109,21 @@ bool sensorsAllWhite() {
 }
 
 bool isMDPSStopped() {
-    return (current_speed_left == 0 && current_speed_right == 0);
+    return mdps_motion_complete || (current_speed_left == 0 && current_speed_right == 0);
+}
+
+uint16_t estimateDistanceNow() {
+    uint32_t speed = (current_speed_left + current_speed_right) / 2;
+    uint32_t predicted = current_distance + speed * navcon_status.turn_interval_ms / 1000;
+    return predicted > UINT16_MAX ? UINT16_MAX : predicted;
 }
 
 void printNavconState(const char* message) {
-    const char* state_names[] = {
+    static const char* const state_names[] = {
     "FORWARD_SCAN", "STOP", "REVERSE", "STOP_BEFORE_ROTATE",
     "ROTATE", "EVALUATE_CORRECTION", "CROSSING_LINE"
     };
-    // Serial.printf("NAVCON [%s]: %s\n", state_names[navcon_status.current_state], message);  // Disabled for performance
+    LOG(NAVCON, DEBUG, "[%s]: %s", state_names[navcon_status.current_state], message);
 }
 
 // ==================== FIXED LINE DETECTION IMPLEMENTATION ====================
@@ -269,6 +296,51 @@ void calculateSmartReverseDistance() {
 }
 
 // ==================== CORRECTION PLANNING IMPLEMENTATION ====================
+uint16_t planRotation(uint16_t wanted, uint8_t direction) {
+    uint16_t rotation = (uint16_t)(wanted / rotation_gain[direction == 3] + 0.5f);
+    // Above STEERING_CORRECTION, or EVALUATE would take it for a steering step
+    return constrain(rotation, (uint16_t)(STEERING_CORRECTION + 1), (uint16_t)180);
+}
+
+void recordRotationFeedback() {
+    CorrectionTracker& correction = navcon_status.correction;
+    if (correction.rotation_feedback_processed) {
+        return;
+    }
+    correction.rotation_feedback_processed = true;
+    correction.last_rotation_actual = current_rotation;
+
+    uint16_t commanded = correction.last_rotation_commanded;
+    if (commanded < ROTATION_GAIN_MIN_ANGLE || current_rotation == 0) {
+        return;
+    }
+    float sample = (float)current_rotation / commanded;
+    if (sample < 1.0f - ROTATION_GAIN_LIMIT || sample > 1.0f + ROTATION_GAIN_LIMIT) {
+        LOG(NAVCON, WARN, "Rotation feedback %d° for %d° ignored", current_rotation, commanded);
+        return;
+    }
+    float& gain = rotation_gain[correction.correction_direction == 3];
+    gain = 0.75f * gain + 0.25f * sample;
+}
+
+bool planRotationFollowUp() {
+    CorrectionTracker& correction = navcon_status.correction;
+    int16_t shortfall = (int16_t)correction.rotation_wanted - (int16_t)correction.last_rotation_actual;
+    if (abs(shortfall) <= 5) {
+        return false;
+    }
+    // Overshot: come back the other way
+    if (shortfall < 0) {
+        correction.correction_direction = 5 - correction.correction_direction;
+    }
+    correction.rotation_wanted = abs(shortfall);
+    correction.last_rotation_commanded = planRotation(correction.rotation_wanted, correction.correction_direction);
+    correction.attempts_made++;
+    LOG(NAVCON, INFO, "RED/GREEN: rotation off by %d° - another %d° %s", shortfall,
+        correction.last_rotation_commanded, correction.correction_direction == 2 ? "LEFT" : "RIGHT");
+    return true;
+}
+
 void planCorrectionForRedGreen() {
     LineDetectionData& detection = navcon_status.line_detection;
     CorrectionTracker& correction = navcon_status.correction;
@@ -281,46 +353,31 @@ void planCorrectionForRedGreen() {
         return;
     }
     
-    // Calculate exact rotation needed to get to ≤5°
-    uint16_t rotation_needed = 0;
-    
-    if (detection.current_target_angle <= 45) {
-        // Need correction TOWARD the line - rotate to bring angle down to ~5°
-        rotation_needed = detection.current_target_angle;
-        
-        // Determine correction direction based on which sensor detected
-        if (detection.detecting_sensor == 1) {
-            correction.correction_direction = 2;  // S1 detected -> turn LEFT toward line
-        } else if (detection.detecting_sensor == 3) {
-            correction.correction_direction = 3;  // S3 detected -> turn RIGHT toward line  
-        } else {
-            // S2 detection - use a default based on angle
-            correction.correction_direction = 2;  // Default LEFT
-        }
-        
-        // Serial.printf("RED/GREEN: ≤45° - correcting %d° %s toward line (angle: %d°)\n",
-        //              rotation_needed,
-        //              correction.correction_direction == 2 ? "LEFT" : "RIGHT",
-        //              detection.current_target_angle);
+    // Turn toward the line: whichever edge sensor saw it first
+    if (detection.detecting_sensor == 1) {
+        correction.correction_direction = 2;  // S1 detected -> turn LEFT toward line
+    } else if (detection.detecting_sensor == 3) {
+        correction.correction_direction = 3;  // S3 detected -> turn RIGHT toward line
+    } else {
+        correction.correction_direction = 2;  // S2 only - default LEFT
     }
-    else {
-        // Angle > 45° - steer AWAY from line edge to reduce angle to ~40°
-        rotation_needed =5;  // Bring it down to manageable angle
-        
-        // Steer AWAY from the line
-        if (detection.detecting_sensor == 1) {
-            correction.correction_direction = 2;  // S1 detected -> turn RIGHT AWAY from line
-        } else if (detection.detecting_sensor == 3) {
-            correction.correction_direction = 3;  // S3 detected -> turn LEFT AWAY from line
-        } else {
-            correction.correction_direction = 3;  // Default RIGHT
-        }
-        
-        // Serial.printf("RED/GREEN: >45° - correcting %d° %s AWAY from line (angle: %d°)\n",
-        //              rotation_needed,
-        //              correction.correction_direction == 2 ? "LEFT" : "RIGHT",
-        //              detection.current_target_angle);
+
+    // A measured angle is taken out in one rotation, scaled by what the MDPS has
+    // really been turning. An inferred steep angle (or a steep one from an unknown
+    // side) could be far off, so that still steps STEERING_CORRECTION at a time
+    uint16_t rotation_needed;
+    if (detection.angle_valid && (detection.current_target_angle <= 45 || detection.detecting_sensor != 2)) {
+        correction.rotation_wanted = detection.current_target_angle;
+        rotation_needed = planRotation(correction.rotation_wanted, correction.correction_direction);
+    } else {
+        correction.rotation_wanted = STEERING_CORRECTION;
+        rotation_needed = STEERING_CORRECTION;
     }
+    correction.attempts_made++;
+
+    LOG(NAVCON, DEBUG, "RED/GREEN: %d° - rotating %d° %s (wanted %d°, gain %d%%)",
+        detection.current_target_angle, rotation_needed, correction.correction_direction == 2 ? "LEFT" : "RIGHT",
+        correction.rotation_wanted, (int)(rotation_gain[correction.correction_direction == 3] * 100));
     
     // Store the planned rotation
     correction.in_correction_sequence = true;
@@ -375,24 +432,26 @@ void planCorrectionForBlackBlue() {
     
     // Handle normal angle cases (≤45°) - includes after steep angle corrections
     if (detection.current_target_angle <= 45) {
+        // RIGHT unless a stored route (second-run mode) knows this wall leads LEFT
+        uint8_t direction = (mazeRouteWallTurn(detection) == 2) ? 2 : 3;
         uint16_t rotation = 90;
         
         if (detection.detecting_sensor == 1) {
-            rotation = 90 - detection.current_target_angle;
+            rotation = (direction == 3) ? 90 - detection.current_target_angle : 90 + detection.current_target_angle;
         } else if (detection.detecting_sensor == 3) {
-            rotation = 90 + detection.current_target_angle;
+            rotation = (direction == 3) ? 90 + detection.current_target_angle : 90 - detection.current_target_angle;
         }
         
         correction.in_correction_sequence = true;
-        correction.correction_direction = 3;  // Always RIGHT turn for BLACK/BLUE
+        correction.correction_direction = direction;
         correction.last_rotation_commanded = rotation;
         correction.rotation_feedback_processed = false;
         
         bb_nav.expecting_180_turn = true;
         bb_nav.first_black_blue_angle = 0;  // Reset for next sequence
         
-        // Serial.printf("BLACK/BLUE: Normal angle - %d° RIGHT turn (sensor %d, angle %d°)\n",
-        //              rotation, detection.detecting_sensor, detection.current_target_angle);
+        // Serial.printf("BLACK/BLUE: Normal angle - %d° %s turn (sensor %d, angle %d°)\n",
+        //              rotation, direction == 3 ? "RIGHT" : "LEFT", detection.detecting_sensor, detection.current_target_angle);
 
         // Calculate smart reverse distance before entering STOP state
         calculateSmartReverseDistance();
@@ -436,8 +495,75 @@ void planCorrectionForBlackBlue() {
 }
 
 
+// ==================== FORWARD SPEED SCHEDULER ====================
+// Distance covered at VOP_CRUISE between a line reaching the sensor row and
+// the wheels being at rest: NAVCON turns to see it and send the stop, then
+// the MDPS profile braking at its acceleration limit
+static uint16_t cruiseStoppingDistance() {
+    uint32_t turn_ms = navcon_status.turn_interval_ms ? navcon_status.turn_interval_ms : 1000;
+    return (uint16_t)(SPEED_REACTION_TURNS * VOP_CRUISE * turn_ms / 1000 +
+                      (uint32_t)VOP_CRUISE * VOP_CRUISE / (2 * SPEED_DECEL_MM_S2));
+}
+
+static bool isMapLine(uint8_t cell) {
+    return cell >= RED && cell <= BLACK;
+}
+
+// A line the live or the stored map knows of ahead of any of the three sensors
+static bool mapPredictsLine(uint16_t lookahead_mm) {
+    const MazePose& pose = mazeMapPose();
+    float heading = pose.heading_deg * (float)M_PI / 180.0f;
+    float dx = cosf(heading), dy = sinf(heading);
+    for (uint8_t sensor = 1; sensor <= 3; sensor++) {
+        float sx, sy;
+        mazeMapSensorPosition(sensor, sx, sy);
+        for (uint16_t along = MAP_CELL_MM / 2; along <= lookahead_mm; along += MAP_CELL_MM / 2) {
+            float x = sx + along * dx, y = sy + along * dy;
+            if (isMapLine(mazeMapCellAt(x, y)) || isMapLine(mazeRouteCellAt(x, y))) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Called for a new detection in a block leg: block entry to here is one line spacing sample
+static void noteLineForSpeed() {
+    if (current_distance < navcon_status.distance_at_block_entry) {
+        return;
+    }
+    uint16_t spacing = current_distance - navcon_status.distance_at_block_entry;
+    navcon_status.speed_line_spacing_mm = navcon_status.speed_line_spacing_mm
+        ? (uint16_t)((3 * navcon_status.speed_line_spacing_mm + spacing) / 4) : spacing;
+}
+
+uint8_t scheduleForwardSpeed() {
+    // Any non-white reading, or a leg that did not start at a line crossing: the safe speed
+    if (!navcon_adaptive_speed || !sensorsAllWhite() || navcon_status.current_state != NAVCON_FORWARD_SCAN ||
+        navcon_status.line_detection.detection_active || !navcon_status.speed_block_leg ||
+        navcon_status.speed_line_spacing_mm == 0) {
+        return VOP_FORWARD;
+    }
+
+    // Lines come at roughly the block pitch: cruise only while the next is further than a stop
+    uint16_t stopping = cruiseStoppingDistance() + SPEED_MARGIN_MM;
+    // The MDPS distance restarts with each movement, so the estimate can sit below the block entry
+    int32_t in_block = (int32_t)estimateDistanceNow() - (int32_t)navcon_status.distance_at_block_entry;
+    if (in_block < 0) {
+        in_block = 0;
+    }
+    if (in_block + stopping > navcon_status.speed_line_spacing_mm) {
+        return VOP_FORWARD;
+    }
+    if (mapPredictsLine(stopping)) {
+        return VOP_FORWARD;
+    }
+    return VOP_CRUISE;
+}
+
 // ==================== PACKET CREATION IMPLEMENTATION ====================
 SCSPacket createStopPacket() {
+    navcon_status.speed_block_leg = false;   // The MDPS restarts its distance at the next movement
     
     SCSPacket packet;
     packet.control = createControlByte((SystemState)2, (SubsystemID)1, 3); // MAZE, SNC, IST=3
@@ -459,10 +585,11 @@ SCSPacket createForwardPacket() {
         return createStopPacket();
     }
 
+    uint8_t speed = scheduleForwardSpeed();
     SCSPacket packet;
     packet.control = createControlByte((SystemState)2, (SubsystemID)1, 3); // MAZE, SNC, IST=3
-    packet.dat1 = VOP_FORWARD;
-    packet.dat0 = VOP_FORWARD;
+    packet.dat1 = speed;
+    packet.dat0 = speed;
     packet.dec = 0;
     return packet;
 }
@@ -486,7 +613,7 @@ SCSPacket createRotatePacket(uint16_t angle, uint8_t direction) {
 }
 
 // ==================== CORRECTED STATE MACHINE - NO STOP AFTER ROTATION ====================
-SCSPacket executeNavconStateMachine() {
+SCSPacket SNC_HOT executeNavconStateMachine() {
     printNavconState("Executing");
     
     switch (navcon_status.current_state) {
@@ -497,10 +624,10 @@ SCSPacket executeNavconStateMachine() {
             // Check if we detected a line that needs processing
             if (navcon_status.line_detection.detection_active) {
 
-                // Serial.printf("DEBUG: Line detected! Color=%d, Sensor=%d, Angle=%d°\n",
-                //              navcon_status.line_detection.detected_color,
-                //              navcon_status.line_detection.detecting_sensor,
-                //              navcon_status.line_detection.current_target_angle);
+                LOG(NAVCON, DEBUG, "Line detected! Color=%d, Sensor=%d, Angle=%d°",
+                    navcon_status.line_detection.detected_color,
+                    navcon_status.line_detection.detecting_sensor,
+                    navcon_status.line_detection.current_target_angle);
                 
                 // Plan correction based on line type
                 switch (navcon_status.line_detection.line_type) {
@@ -525,13 +652,13 @@ SCSPacket executeNavconStateMachine() {
         }
         
         case NAVCON_STOP: {
-            // Wait for MDPS to confirm stop (speeds = 0)
-            if (current_speed_left == 0 && current_speed_right == 0) {
+            // Wait for MDPS to confirm stop (motion complete, or speeds = 0)
+            if (isMDPSStopped()) {
                 navcon_status.stop_confirmed = true;
                 navcon_status.current_state = NAVCON_REVERSE;
                 navcon_status.reverse_start_distance = current_distance;
                 stop_confirmation_received = false;
-                // Serial.println("Stop confirmed - starting reverse");  // Disabled for performance
+                LOG(NAVCON, INFO, "Stop confirmed - starting reverse");
                 return createReversePacket();
             }
             
@@ -549,15 +676,15 @@ SCSPacket executeNavconStateMachine() {
                 stop_confirmation_received = false;
                 waiting_for_stop_confirmation = true;
 
-                Serial.printf("Reverse complete (distance: %d mm, target: %d mm) - stopping before rotate\n",
-                            current_distance, navcon_status.calculated_reverse_distance);
+                LOG(NAVCON, INFO, "Reverse complete (distance: %d mm, target: %d mm) - stopping before rotate",
+                    current_distance, navcon_status.calculated_reverse_distance);
 
                 return createStopPacket();
             }
 
             // Continue reversing
-            // Serial.printf("Reversing... distance: %d mm (target: %d mm)\n",
-            //             current_distance, navcon_status.calculated_reverse_distance);
+            LOG(NAVCON, DEBUG, "Reversing... distance: %d mm (target: %d mm)",
+                current_distance, navcon_status.calculated_reverse_distance);
             return createReversePacket();
         }
 
@@ -570,31 +697,34 @@ SCSPacket executeNavconStateMachine() {
                 
                 uint16_t rotation_amount = navcon_status.correction.last_rotation_commanded;
                 uint8_t rotation_direction = navcon_status.correction.correction_direction;
+                navcon_status.correction.rotation_feedback_processed = false;
                 
-                // Serial.printf("Stop confirmed - rotating %d° %s\n",
-                //             rotation_amount,
-                //             rotation_direction == 2 ? "LEFT" : "RIGHT");
+                LOG(NAVCON, INFO, "Stop confirmed - rotating %d° %s",
+                    rotation_amount,
+                    rotation_direction == 2 ? "LEFT" : "RIGHT");
                 
                 return createRotatePacket(rotation_amount, rotation_direction);
             }
             
             // Keep sending stop until confirmed
-            // Serial.println("Waiting for stop confirmation...");  // Disabled for performance
+            LOG(NAVCON, DEBUG, "Waiting for stop confirmation...");
             return createStopPacket();
         }
 
         case NAVCON_ROTATE: {
+            recordRotationFeedback();
+
             // Safety check: Don't rotate if all sensors are white or if we have invalid rotation data
             if (sensorsAllWhite() || navcon_status.correction.last_rotation_commanded == 0 ||
                 navcon_status.correction.last_rotation_commanded > 360) {
-                Serial.printf("ERROR: Invalid rotation attempt (angle=%d, sensors WWW) - aborting\n",
-                            navcon_status.correction.last_rotation_commanded);
+                LOG(NAVCON, ERROR, "Invalid rotation attempt (angle=%d, sensors WWW) - aborting",
+                    navcon_status.correction.last_rotation_commanded);
                 navcon_status.line_detection.reset();
                 navcon_status.correction.reset();
                 navcon_status.current_state = NAVCON_FORWARD_SCAN;
                 return createForwardPacket();
             }
-            
+
             navcon_status.current_state = NAVCON_EVALUATE_CORRECTION;
             // Fall through
         }
@@ -605,11 +735,12 @@ SCSPacket executeNavconStateMachine() {
         case NAVCON_CROSSING_LINE: {
             // Continue forward while crossing RED/GREEN
             if (sensorsAllWhite()) {
-                // Serial.println("Line crossing complete - resuming forward scan");  // Disabled for performance
+                LOG(NAVCON, INFO, "Line crossing complete - resuming forward scan");
 
                 // Record distance when entering new block (all sensors white = fully crossed)
                 navcon_status.distance_at_block_entry = current_distance;
-                // Serial.printf("  -> Block entry distance recorded: %d mm\n", current_distance);  // Disabled for performance
+                navcon_status.speed_block_leg = true;
+                LOG(NAVCON, DEBUG, "Block entry distance recorded: %d mm", current_distance);
 
                 navcon_status.resetForNewDetection();
 
@@ -620,40 +751,35 @@ SCSPacket executeNavconStateMachine() {
         }
         
         case NAVCON_EVALUATE_CORRECTION: {
-            // Serial.printf("EVALUATE: Processing rotation feedback - commanded=%d°, actual=%d°\n",
-            //             navcon_status.correction.last_rotation_commanded, current_rotation);
+            LOG(NAVCON, DEBUG, "EVALUATE: Processing rotation feedback - commanded=%d°, actual=%d°",
+                navcon_status.correction.last_rotation_commanded, current_rotation);
             
             // Check if this was a steep angle correction (5° incremental)
             if (navcon_status.correction.last_rotation_commanded == STEERING_CORRECTION) {
-                // Serial.printf("EVALUATE: 5° steering correction completed - performing COMPLETE reset\n");
+                LOG(NAVCON, INFO, "EVALUATE: 5° steering correction completed - performing COMPLETE reset");
                 
                 // COMPLETE reset to ensure clean state for next detection
                 navcon_status.resetForNewDetection();
                 
                 // Force return to forward scan
                 navcon_status.current_state = NAVCON_FORWARD_SCAN;
-                // Serial.println("EVALUATE: Clean slate - resuming forward scan");  // Disabled for performance
+                LOG(NAVCON, DEBUG, "EVALUATE: Clean slate - resuming forward scan");
                 return createForwardPacket();
             }
             
             // Regular correction evaluation (RED/GREEN full angle corrections, BLACK/BLUE 90°/180°)
             if (navcon_status.line_detection.line_type == LINE_RED_GREEN) {
-                int16_t rotation_difference = abs(navcon_status.correction.last_rotation_commanded - current_rotation);
-                
-                if (rotation_difference <= 5) {
-                    // Serial.println("RED/GREEN: Rotation sufficient - starting line crossing");  // Disabled for performance
+                // Iterate only when the MDPS feedback says the one-shot rotation missed
+                if (!planRotationFollowUp()) {
+                    LOG(NAVCON, INFO, "RED/GREEN: Rotation sufficient - starting line crossing");
                     navcon_status.current_state = NAVCON_CROSSING_LINE;
                     return createForwardPacket();
-                } else {
-                    int16_t additional_rotation = navcon_status.correction.last_rotation_commanded - current_rotation;
-                    // Serial.printf("RED/GREEN: Rotation insufficient - need %d° more\n", additional_rotation);  // Disabled for performance
-                    navcon_status.correction.last_rotation_commanded = abs(additional_rotation);
-                    navcon_status.current_state = NAVCON_STOP;
-                    return createStopPacket();
                 }
+                navcon_status.current_state = NAVCON_STOP;
+                return createStopPacket();
             }
             else if (navcon_status.line_detection.line_type == LINE_BLACK_BLUE) {
-                // Serial.printf("BLACK/BLUE EVALUATE: %d° turn completed\n", current_rotation);
+                LOG(NAVCON, INFO, "BLACK/BLUE EVALUATE: %d° turn completed", current_rotation);
 
                 // Check if this was the SECOND turn (180° total) or FIRST turn (90°)
                 if (navcon_status.black_blue_nav.first_turn_completed) {
@@ -667,12 +793,12 @@ SCSPacket executeNavconStateMachine() {
                 }
 
                 navcon_status.current_state = NAVCON_FORWARD_SCAN;
-                // Serial.println("BLACK/BLUE: Turn complete - moving forward");  // Disabled for performance
+                LOG(NAVCON, DEBUG, "BLACK/BLUE: Turn complete - moving forward");
                 return createForwardPacket();
             }
             
             // Fallback - complete reset
-            // Serial.println("EVALUATE: Unknown condition - performing complete reset");  // Disabled for performance
+            LOG(NAVCON, WARN, "EVALUATE: Unknown condition - performing complete reset");
             navcon_status.resetForNewDetection();
             navcon_status.current_state = NAVCON_FORWARD_SCAN;
             return createForwardPacket();
@@ -684,15 +810,50 @@ SCSPacket executeNavconStateMachine() {
 // ==================== PUBLIC INTERFACE FUNCTIONS ====================
 void initializeNavcon() {
     navcon_status.reset();
+    // Sensor/MDPS inputs back to power-on values (a host replay re-runs this per scenario)
+    for (int i = 0; i < 3; i++) {
+        current_colors[i] = WHITE;
+        previous_colors[i] = WHITE;
+    }
+    received_incidence_angle = 0;
+    current_speed_left = 0;
+    current_speed_right = 0;
+    current_distance = 0;
+    current_rotation = 0;
+    current_rotation_dir = 0;
+    mdps_motion_complete = false;
+    stop_confirmation_received = false;
+    waiting_for_stop_confirmation = false;
+    rotation_gain[0] = rotation_gain[1] = 1.0f;
     Serial.println("NAVCON System Initialized");
 }
 
-SCSPacket runEnhancedNavcon() {
+SCSPacket SNC_HOT runEnhancedNavcon() {
     // This is called when it's NAVCON's turn (MAZE state, SNC IST=3)
-    return executeNavconStateMachine();
+    unsigned long now = millis();
+    if (navcon_status.last_turn_ms != 0) {
+        unsigned long interval = now - navcon_status.last_turn_ms;
+        if (interval > 5000) interval = 5000;   // A pause (EOM, MAZE re-entry) isn't a turn interval
+        navcon_status.turn_interval_ms = navcon_status.turn_interval_ms
+            ? (3 * navcon_status.turn_interval_ms + interval) / 4 : interval;
+    }
+    navcon_status.last_turn_ms = now;
+
+    bool was_detecting = navcon_status.line_detection.detection_active;
+    bool block_leg = navcon_status.speed_block_leg;     // The stop for this detection clears it
+    SCSPacket packet = executeNavconStateMachine();
+    if (!was_detecting && navcon_status.line_detection.detection_active) {
+        mazeMapRecordLine(navcon_status.line_detection);
+        if (block_leg) {
+            noteLineForSpeed();
+        }
+    }
+    mazeMapNoteCommand(packet);
+    flightRecordNavcon();
+    return packet;
 }
 
-void handleNavconIncomingData(const SCSPacket& packet) {
+void SNC_HOT handleNavconIncomingData(const SCSPacket& packet) {
     // Extract subsystem and internal state from packet
     SystemState packetSysState = getSystemState(packet.control);
     SubsystemID packetSubsystem = getSubsystemID(packet.control);
@@ -741,6 +902,7 @@ void handleNavconIncomingData(const SCSPacket& packet) {
                 // MDPS Rotation feedback
                 current_rotation = (packet.dat1 << 8) | packet.dat0;
                 current_rotation_dir = packet.dec;  // 2=left, 3=right
+                mazeMapNoteRotation(current_rotation, current_rotation_dir);
                 // Serial.printf("NAVCON: Rotation completed - %d° %s\n",
                 //              current_rotation,
                 //              current_rotation_dir == 2 ? "LEFT" : "RIGHT");
@@ -761,9 +923,20 @@ void handleNavconIncomingData(const SCSPacket& packet) {
                     }
                 }
             }
+            else if (packetIST == MDPS_IST_ODOMETRY_RIGHT) {
+                odometry_right = (packet.dat1 << 8) | packet.dat0;   // Integrated with the left count
+            }
+            else if (packetIST == MDPS_IST_ODOMETRY_LEFT) {
+                mazeMapNoteOdometry(odometry_right, (packet.dat1 << 8) | packet.dat0, packet.dec);
+            }
             else if (packetIST == 4) {
-                // MDPS Distance feedback
+                // MDPS Distance feedback - final, and the wheels at rest, when it closes a stop/rotation
                 current_distance = (packet.dat1 << 8) | packet.dat0;
+                mdps_motion_complete = (packet.dec & MDPS_DEC_MOTION_COMPLETE) != 0;
+                if (mdps_motion_complete && navcon_status.current_state == NAVCON_STOP_BEFORE_ROTATE) {
+                    stop_confirmation_received = true;
+                }
+                mazeMapNoteDistance(current_distance);
                 // Serial.printf("NAVCON: Distance = %d mm\n", current_distance);
             }
             break;
@@ -791,6 +964,9 @@ void printNavconDebugInfo() {
                  navcon_status.correction.last_rotation_actual);
     Serial.printf("Speeds: L=%d R=%d | Distance: %d | Angle: %d°\n",
                  current_speed_left, current_speed_right, current_distance, received_incidence_angle);
+    Serial.printf("Turn interval: %d ms | Rotation gain: L=%.3f R=%.3f\n",
+                 navcon_status.turn_interval_ms,
+                 rotation_gain[0], rotation_gain[1]);
     Serial.println("============================\n");
 }
 
@@ -811,6 +987,7 @@ void NavconStatus::resetForNewDetection() {
     correction.in_correction_sequence = false;
     correction.last_rotation_commanded = 0;
     correction.last_rotation_actual = 0;
+    correction.rotation_wanted = 0;
     correction.rotation_feedback_processed = false;
     
     // Reset black/blue navigation state
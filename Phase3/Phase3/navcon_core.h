@@ -8,7 +8,14 @@
 extern const uint16_t REVERSE_DISTANCE;      // mm to reverse
 extern const uint16_t SENSOR_SPACING;        // mm between S2 and S1/S3  
 extern const uint8_t STEERING_CORRECTION;    // degrees for corrections
-extern const uint8_t VOP_FORWARD;            // forward speed mm/s
+extern const uint8_t VOP_FORWARD;            // forward speed mm/s (near lines, and the safe default)
+extern const uint8_t VOP_CRUISE;             // forward speed mm/s on a clear white stretch
+
+// Forward speed scheduler: cruise only with no line predicted inside the
+// distance it takes to see one and stop from VOP_CRUISE
+#define SPEED_REACTION_TURNS    1       // Turns from a line reaching the sensors to the stop frame
+#define SPEED_DECEL_MM_S2       150     // MDPS PROFILE_ACCEL_MAX
+#define SPEED_MARGIN_MM         40      // Kept between the stopping point and a predicted line
 
 // Color Constants
 extern const uint8_t WHITE;
@@ -54,6 +61,7 @@ struct CorrectionTracker {
     bool in_correction_sequence;       // Are we in the middle of corrections?
     uint16_t last_rotation_commanded;   // What we asked MDPS to rotate
     uint16_t last_rotation_actual;      // What MDPS actually rotated
+    uint16_t rotation_wanted;           // Heading change the command is meant to achieve
     bool rotation_feedback_processed;
     void reset();
 };
@@ -81,6 +89,14 @@ struct NavconStatus {
     uint16_t distance_at_block_entry;      // Distance when crossing into new block completes
     uint16_t calculated_reverse_distance;   // Dynamic reverse distance based on position
 
+    // Time between NAVCON turns, to see where the MDPS will be next turn (speed scheduler)
+    unsigned long last_turn_ms;
+    uint16_t turn_interval_ms;              // Smoothed; 0 until two turns have been seen
+
+    // Forward speed scheduler
+    bool speed_block_leg;                   // This forward leg entered its block by crossing a line
+    uint16_t speed_line_spacing_mm;         // Smoothed block entry to next line distance; 0 until seen
+
     void reset();
     void resetForNewDetection();
 };
@@ -95,10 +111,18 @@ extern uint8_t current_speed_right;        // Right wheel speed
 extern uint16_t current_distance;          // Distance since last stop
 extern uint16_t current_rotation;          // Last rotation executed
 extern uint8_t current_rotation_dir;       // 2=left(CCW), 3=right(CW)
+extern bool mdps_motion_complete;          // Last MDPS report closed a stop/rotation (IST4 DEC)
 
 // Main NAVCON status
 extern NavconStatus navcon_status;
 
+// MDPS reported / commanded rotation, learned per direction ([0] LEFT, [1] RIGHT)
+extern float rotation_gain[2];
+
+// Adaptive forward speed (serial V toggles): VOP_CRUISE on white stretches
+// the map and the line spacing say are clear, VOP_FORWARD everywhere else
+extern bool navcon_adaptive_speed;
+
 // ==================== MAIN NAVCON FUNCTIONS ====================
 /**
  * Initialize the NAVCON system
@@ -111,6 +135,12 @@ void initializeNavcon();
  */
 SCSPacket runEnhancedNavcon();
 
+/**
+ * One step of the NAVCON state machine for the current state
+ * runEnhancedNavcon() wraps this with the flight recorder; also timed by navcon_bench
+ */
+SCSPacket executeNavconStateMachine();
+
 /**
  * Process incoming packets from SS and MDPS to update NAVCON variables
  * Called for every received packet in MAZE state
@@ -139,10 +169,18 @@ bool isColorWall(uint8_t color);
 bool sensorsAllWhite();
 
 /**
- * Check if MDPS has stopped (both wheels at 0 speed)
+ * Check if MDPS has stopped: its last report closed the stop, or (an MDPS
+ * without the motion-complete flag) both wheels read 0 speed
  */
 bool isMDPSStopped();
 
+/**
+ * Distance the MDPS has covered by this NAVCON turn. Its report came early in
+ * the round, so this is current_distance plus one turn interval at the
+ * reported wheel speed
+ */
+uint16_t estimateDistanceNow();
+
 /**
  * Print current NAVCON state with message
  */
@@ -164,10 +202,30 @@ void updateLineDetectionWithEdgeCases();
 // ==================== CORRECTION PLANNING FUNCTIONS ====================
 /**
  * Plan correction strategy for RED/GREEN lines
- * Handles ≤5° (cross), ≤45° (toward), >45° (away) cases
+ * ≤5° crosses; a measured angle is corrected in one rotation of the whole
+ * angle toward the line; an inferred steep angle steps 5° at a time
  */
 void planCorrectionForRedGreen();
 
+/**
+ * Rotation to command for a wanted heading change in a direction (2=LEFT, 3=RIGHT),
+ * using the learned rotation_gain
+ */
+uint16_t planRotation(uint16_t wanted, uint8_t direction);
+
+/**
+ * Take the MDPS feedback for the rotation just completed: stores it as
+ * last_rotation_actual and updates rotation_gain. Once per rotation
+ */
+void recordRotationFeedback();
+
+/**
+ * Heading still to turn after a RED/GREEN rotation (wanted - actual); negative
+ * means it overshot. Re-plans the correction if it is more than 5°
+ * @return true if another rotation is needed
+ */
+bool planRotationFollowUp();
+
 /**
  * Plan correction strategy for BLACK/BLUE lines  
  * Handles 90° turns and 180° turn scenarios
@@ -181,10 +239,19 @@ void planCorrectionForBlackBlue();
 SCSPacket createStopPacket();
 
 /**
- * Create FORWARD packet (normal forward speed)
+ * Create FORWARD packet at the scheduled speed
  */
 SCSPacket createForwardPacket();
 
+/**
+ * Forward speed for this turn: VOP_CRUISE only while scanning all white in a
+ * block entered by crossing a line, with the next line (from the usual line
+ * spacing and the map) further than the stopping distance; VOP_FORWARD on any
+ * other reading or state. The MDPS motion profile ramps between them
+ * @return: speed in mm/s for both wheels
+ */
+uint8_t scheduleForwardSpeed();
+
 /**
  * Create REVERSE packet (reverse direction)
  */
@@ -0,0 +1,151 @@
+/*
+ * MARV SNC - PC Sampling Profiler
+ * A timer interrupt records which address core 1 was executing, binned by
+ * 16-byte block in a fixed open-addressed table, so the hot set that should
+ * live in IRAM is measured instead of guessed. Also reports the IRAM budget.
+ */
+
+#include "pc_profiler.h"
+#include <soc/soc.h>
+#if PC_PROFILER
+#include <driver/timer.h>
+#endif
+
+// Linker symbols: start of IRAM and end of everything placed in it
+extern int _iram_start;
+extern int _iram_end;
+
+// ==================== PROFILER STATE ====================
+// Written by the sampling interrupt only; read with the timer paused
+static uint32_t pcBinKey[PC_PROFILE_SLOTS];     // (PC >> 4) + 1, 0 = free
+static uint32_t pcBinCount[PC_PROFILE_SLOTS];
+static PcProfileStats pcStats;
+static uint32_t pcWindowStartMs = 0;
+
+static const char* const PC_REGION_NAMES[PC_REGION_COUNT] = {
+    "iram", "flash", "rom", "other"
+};
+
+#define PC_PROBE_LIMIT 8    // Linear probes before a sample counts as untracked
+
+static inline uint8_t IRAM_ATTR regionOf(uint32_t pc) {
+    if (pc >= SOC_IRAM_LOW && pc < SOC_IRAM_HIGH) return PC_REGION_IRAM;
+    if (pc >= SOC_IROM_LOW && pc < SOC_IROM_HIGH) return PC_REGION_FLASH;
+    if (pc >= SOC_IROM_MASK_LOW && pc < SOC_IROM_MASK_HIGH) return PC_REGION_ROM;
+    return PC_REGION_OTHER;
+}
+
+// ==================== SAMPLING INTERRUPT ====================
+#if PC_PROFILER
+static bool IRAM_ATTR pcSampleIsr(void*) {
+    // Level-1 interrupts do not nest, so this always interrupted a task; the
+    // interrupt entry stored that task's SP in its TCB (first field) and the
+    // exception frame there starts exit, pc, ps, ...
+    const uint32_t* frame = *(const uint32_t* const*)xTaskGetCurrentTaskHandle();
+    uint32_t pc = frame[1];
+
+    pcStats.samples++;
+    pcStats.region[regionOf(pc)]++;
+
+    uint32_t key = (pc >> 4) + 1;
+    uint32_t slot = key & (PC_PROFILE_SLOTS - 1);
+    for (uint8_t probe = 0; probe < PC_PROBE_LIMIT; probe++) {
+        if (pcBinKey[slot] == key) {
+            pcBinCount[slot]++;
+            return false;
+        }
+        if (pcBinKey[slot] == 0) {
+            pcBinKey[slot] = key;
+            pcBinCount[slot] = 1;
+            return false;
+        }
+        slot = (slot + 1) & (PC_PROFILE_SLOTS - 1);
+    }
+    pcStats.untracked++;
+    return false;
+}
+#endif
+
+// ==================== PROFILER FUNCTIONS ====================
+static void clearPcProfile() {
+    memset(pcBinKey, 0, sizeof(pcBinKey));
+    memset(pcBinCount, 0, sizeof(pcBinCount));
+    memset(&pcStats, 0, sizeof(pcStats));
+    pcWindowStartMs = millis();
+}
+
+static void printIramBudget() {
+    uint32_t used = (uint32_t)((uintptr_t)&_iram_end - (uintptr_t)&_iram_start);
+    uint32_t total = SOC_IRAM_HIGH - (uint32_t)(uintptr_t)&_iram_start;
+    Serial.printf("IRAM: %lu of %lu bytes used (%lu free, %.1f%%), hot paths %s\n",
+                  (unsigned long)used, (unsigned long)total, (unsigned long)(total - used),
+                  100.0f * used / total, HOT_PATHS_IN_IRAM ? "pinned" : "in flash");
+}
+
+void initializePcProfiler() {
+    clearPcProfile();
+    printIramBudget();
+
+#if PC_PROFILER
+    // 1 MHz tick from the 80 MHz APB clock, alarm every sample period
+    timer_config_t config = {};
+    config.alarm_en = TIMER_ALARM_EN;
+    config.counter_en = TIMER_PAUSE;
+    config.intr_type = TIMER_INTR_LEVEL;
+    config.counter_dir = TIMER_COUNT_UP;
+    config.auto_reload = TIMER_AUTORELOAD_EN;
+    config.divider = 80;
+    timer_init(TIMER_GROUP_1, TIMER_0, &config);
+    timer_set_counter_value(TIMER_GROUP_1, TIMER_0, 0);
+    timer_set_alarm_value(TIMER_GROUP_1, TIMER_0, 1000000 / PC_PROFILE_HZ);
+    timer_enable_intr(TIMER_GROUP_1, TIMER_0);
+    timer_isr_callback_add(TIMER_GROUP_1, TIMER_0, pcSampleIsr, nullptr, ESP_INTR_FLAG_IRAM);
+    timer_start(TIMER_GROUP_1, TIMER_0);
+    Serial.printf("PC profiler initialized (%d Hz on core %d, %d bins)\n",
+                  PC_PROFILE_HZ, xPortGetCoreID(), PC_PROFILE_SLOTS);
+#endif
+}
+
+PcProfileStats pcProfileStats() {
+    return pcStats;
+}
+
+void printPcProfile() {
+    printIramBudget();
+
+#if PC_PROFILER
+    timer_pause(TIMER_GROUP_1, TIMER_0);
+
+    uint32_t window = millis() - pcWindowStartMs;
+    uint32_t samples = pcStats.samples ? pcStats.samples : 1;
+    Serial.printf("PC profile: %lu samples over %lu ms, %lu untracked\n",
+                  (unsigned long)pcStats.samples, (unsigned long)window, (unsigned long)pcStats.untracked);
+    for (uint8_t r = 0; r < PC_REGION_COUNT; r++) {
+        Serial.printf("  %-6s %8lu %5.1f%%\n", PC_REGION_NAMES[r],
+                      (unsigned long)pcStats.region[r], 100.0f * pcStats.region[r] / samples);
+    }
+
+    // Busiest bins first; each printed bin is zeroed so the next pass finds the runner-up
+    for (uint8_t n = 0; n < PC_PROFILE_TOP; n++) {
+        uint32_t best = PC_PROFILE_SLOTS;
+        for (uint32_t i = 0; i < PC_PROFILE_SLOTS; i++) {
+            if (pcBinKey[i] != 0 && pcBinCount[i] > 0 &&
+                (best == PC_PROFILE_SLOTS || pcBinCount[i] > pcBinCount[best])) {
+                best = i;
+            }
+        }
+        if (best == PC_PROFILE_SLOTS) {
+            break;
+        }
+        uint32_t pc = (pcBinKey[best] - 1) << 4;
+        Serial.printf("PC 0x%08lx %8lu %5.1f%% %s\n", (unsigned long)pc, (unsigned long)pcBinCount[best],
+                      100.0f * pcBinCount[best] / samples, PC_REGION_NAMES[regionOf(pc)]);
+        pcBinCount[best] = 0;
+    }
+
+    clearPcProfile();
+    timer_start(TIMER_GROUP_1, TIMER_0);
+#else
+    Serial.println("PC profile: not a profiling build (-DPC_PROFILER=1)");
+#endif
+}
@@ -0,0 +1,76 @@
+#ifndef PC_PROFILER_H
+#define PC_PROFILER_H
+
+#include <Arduino.h>
+
+// ==================== HOT PATH PLACEMENT ====================
+// The SCS receive/transmit path, the NAVCON step and the edge case lookup are
+// pinned in IRAM (and their lookup tables in DRAM) so another core or task
+// evicting cache lines cannot add a flash fetch to the turn. They run in task
+// context and call flash-resident code, so a flash write or erase (NVS, the
+// flight recorder) still stalls them: the cache is off on both cores then.
+// Build with -DHOT_PATHS_IN_IRAM=0 to leave them in flash and profile the
+// difference. Only instruction fetch moves: string literals and float
+// constants these functions use still come through the cache.
+#ifndef HOT_PATHS_IN_IRAM
+#define HOT_PATHS_IN_IRAM 1
+#endif
+
+#if HOT_PATHS_IN_IRAM
+#define SNC_HOT       IRAM_ATTR
+#define SNC_HOT_DATA  DRAM_ATTR
+#else
+#define SNC_HOT
+#define SNC_HOT_DATA
+#endif
+
+// ==================== PROFILER CONFIGURATION ====================
+// Profiling build (-DPC_PROFILER=1): a hardware timer interrupts core 1
+// (NAVCON/state) and records the PC it interrupted. Serial 'C' prints where
+// the samples landed - IRAM, flash or ROM - and the busiest addresses, which
+// host/pc_profile.py folds into per-function totals against the sketch ELF.
+// Off, the module only reports the IRAM budget.
+#ifndef PC_PROFILER
+#define PC_PROFILER 0
+#endif
+
+#define PC_PROFILE_HZ        2000    // Samples per second (timer group 1, timer 0)
+#define PC_PROFILE_SLOTS     512     // Distinct 16-byte PC bins tracked (power of two)
+#define PC_PROFILE_TOP       24      // Bins printed by printPcProfile()
+
+static_assert((PC_PROFILE_SLOTS & (PC_PROFILE_SLOTS - 1)) == 0, "PC_PROFILE_SLOTS must be a power of two");
+
+// Where the interrupted PC was
+enum PcRegion {
+    PC_REGION_IRAM = 0,     // Internal instruction RAM (IRAM_ATTR, FreeRTOS, ISRs)
+    PC_REGION_FLASH,        // Cached flash (everything else)
+    PC_REGION_ROM,          // Mask ROM (libc, boot helpers)
+    PC_REGION_OTHER,
+    PC_REGION_COUNT
+};
+
+struct PcProfileStats {
+    uint32_t samples;                       // Timer interrupts that took a sample
+    uint32_t region[PC_REGION_COUNT];
+    uint32_t untracked;                     // Samples whose bin found no free slot
+};
+
+// ==================== PROFILER FUNCTIONS ====================
+/**
+ * Start the sampling timer (profiling build) and print the IRAM budget
+ * Call from setup() - the interrupt is allocated on the calling core.
+ */
+void initializePcProfiler();
+
+/**
+ * Copy the sample counters (zero outside a profiling build)
+ */
+PcProfileStats pcProfileStats();
+
+/**
+ * Print the IRAM budget, the region split and the busiest PC bins
+ * (serial 'C'); the bins are cleared for the next window
+ */
+void printPcProfile();
+
+#endif // PC_PROFILER_H
@@ -1,4 +1,5 @@
 #include "scs_protocol.h"
+#include "pc_profiler.h"
 
 // ==================== SCS PACKET IMPLEMENTATION ====================
 SCSPacket::SCSPacket() : control(0), dat1(0), dat0(0), dec(0) {}
@@ -62,72 +63,319 @@ void printPacket(const SCSPacket& packet, const char* direction) {
 
 // ==================== SERIAL PACKET HANDLER IMPLEMENTATION ====================
 SerialPacketHandler::SerialPacketHandler(HardwareSerial* ser, int rx, int tx) 
-    : serial(ser), bufferIndex(0), lastByteTime(0), synced(false), rxPin(rx), txPin(tx) {}
+    : serial(ser), rxPin(rx), txPin(tx), partialCount(0), lastByteTime(0),
+      ringHead(0), ringTail(0), synced(false), stats{0, 0, 0, 0, 0, 0},
+      rateIndex(0), monitorMs(0), monitorErrors(0), probeMs(0), linkHeardMs(0),
+      retrainMs(0), retrainWaitMs(SCS_LINK_RETRAIN_MS), retrainFrames(0), heldHead(0), heldTail(0),
+      rxNotifyTask(nullptr) {}
 
 void SerialPacketHandler::begin(unsigned long baud) {
+    // TX ring must be sized before the driver is installed
+    serial->setTxBufferSize(SCS_TX_QUEUE_FRAMES * PACKET_SIZE);
     serial->begin(baud, SERIAL_8N1, rxPin, txPin);
-    bufferIndex = 0;
+    partialCount = 0;
     synced = false;
+    rateIndex = 0;
+    for (uint8_t i = 0; i < SCS_LINK_RATE_COUNT; i++) {
+        if (SCS_LINK_RATES[i] == baud) rateIndex = i;
+    }
+
+    // Wake the UART event task once a full frame is in the FIFO, or after
+    // 2 idle symbols (~43us at 460800) so a burst is delivered without polling
+    serial->setRxFIFOFull(PACKET_SIZE);
+    serial->setRxTimeout(2);
+    serial->onReceive([this]() { onUartReceive(); }, false);
 }
 
-bool SerialPacketHandler::readPacket(SCSPacket& packet) {
-    while (serial->available()) {
-        uint8_t incomingByte = serial->read();
-        unsigned long currentTime = millis();
-        
-        // Reset buffer if timeout occurred (3ms for optimal recovery)
-        if (currentTime - lastByteTime > 3 && bufferIndex > 0) {
-            bufferIndex = 0;
-            synced = false;
+void SNC_HOT SerialPacketHandler::onUartReceive() {
+    unsigned long now = micros();
+
+    // A half frame followed by a gap means we lost a byte - drop it and realign
+    if (partialCount > 0 && now - lastByteTime > SCS_FRAME_GAP_US) {
+        partialCount = 0;
+        synced = false;
+        stats.resyncs++;
+    }
+
+    uint32_t framesBefore = stats.frames;
+    uint8_t chunk[32];
+    size_t n;
+    while ((n = serial->read(chunk, sizeof(chunk))) > 0) {
+        stats.bytes += n;
+        for (size_t i = 0; i < n; i++) {
+            partial[partialCount++] = chunk[i];
+            if (partialCount == PACKET_SIZE) {
+                pushFrame(partial);
+                partialCount = 0;
+            }
         }
-        
-        lastByteTime = currentTime;
-        buffer[bufferIndex] = incomingByte;
-        bufferIndex++;
-        
-        // Try to find valid packet when we have enough bytes
-        if (bufferIndex >= PACKET_SIZE) {
-            for (int start = 0; start <= bufferIndex - PACKET_SIZE; start++) {
-                SCSPacket testPacket;
-                testPacket.control = buffer[start];
-                testPacket.dat1 = buffer[start + 1];
-                testPacket.dat0 = buffer[start + 2];
-                testPacket.dec = buffer[start + 3];
-                
-                // Basic validation
-                SystemState sys = getSystemState(testPacket.control);
-                SubsystemID sub = getSubsystemID(testPacket.control);
-                uint8_t ist = getInternalState(testPacket.control);
-                
-                if (sys <= SYS_SOS && sub <= SUB_SS && ist <= 15) {
-                    packet = testPacket;
-                    int remainingBytes = bufferIndex - (start + PACKET_SIZE);
-                    if (remainingBytes > 0) {
-                        memmove(buffer, buffer + start + PACKET_SIZE, remainingBytes);
-                    }
-                    bufferIndex = remainingBytes;
-                    synced = true;
-                    return true;
+    }
+
+    lastByteTime = now;
+
+    TaskHandle_t task = rxNotifyTask;
+    if (task != nullptr && stats.frames != framesBefore) {
+        xTaskNotifyGive(task);
+    }
+}
+
+void SNC_HOT SerialPacketHandler::pushFrame(const uint8_t* bytes) {
+    uint8_t head = ringHead.load(std::memory_order_relaxed);
+    uint8_t next = (head + 1) & (SCS_RX_RING_FRAMES - 1);
+
+    if (next == ringTail.load(std::memory_order_acquire)) {
+        stats.drops++;  // loop() fell behind - keep the older frames
+        return;
+    }
+
+    SCSPacket& slot = ring[head];
+    slot.control = bytes[0];
+    slot.dat1 = bytes[1];
+    slot.dat0 = bytes[2];
+    slot.dec = bytes[3];
+
+    ringHead.store(next, std::memory_order_release);
+    stats.frames++;
+    synced = true;
+}
+
+const SCSPacket* SNC_HOT SerialPacketHandler::peekPacket() const {
+    if (heldTail != heldHead) {
+        return &held[heldTail];
+    }
+    uint8_t tail = ringTail.load(std::memory_order_relaxed);
+    if (tail == ringHead.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    return &ring[tail];
+}
+
+void SNC_HOT SerialPacketHandler::consumePacket() {
+    if (heldTail != heldHead) {
+        if (++heldTail == heldHead) {
+            heldHead = heldTail = 0;
+        }
+        return;
+    }
+    uint8_t tail = ringTail.load(std::memory_order_relaxed);
+    if (tail == ringHead.load(std::memory_order_acquire)) {
+        return;
+    }
+    ringTail.store((tail + 1) & (SCS_RX_RING_FRAMES - 1), std::memory_order_release);
+}
+
+bool SNC_HOT SerialPacketHandler::readPacket(SCSPacket& packet) {
+    const SCSPacket* frame = peekPacket();
+    if (frame == nullptr) {
+        return false;
+    }
+
+    packet = *frame;
+    consumePacket();
+    return true;
+}
+
+void SNC_HOT SerialPacketHandler::sendPacket(const SCSPacket& packet) {
+    const uint8_t frame[PACKET_SIZE] = { packet.control, packet.dat1, packet.dat0, packet.dec };
+
+    // Queue full means the far end stopped draining - wait rather than drop,
+    // a lost SCS frame would desync the round-robin
+    if (serial->availableForWrite() < PACKET_SIZE) {
+        stats.txStalls++;
+    }
+
+    serial->write(frame, PACKET_SIZE);
+    stats.txFrames++;
+}
+
+void SerialPacketHandler::flush() {
+    serial->flush();
+}
+
+// ==================== LINK TRAINING ====================
+// Bit patterns that trip a marginal link: alternating, all-ones/zeros, runs
+static const uint8_t LINK_PATTERN[] = { 0x55, 0xAA, 0x00, 0xFF, 0x0F, 0xF0, 0x33, 0xCC };
+
+void SerialPacketHandler::setRate(uint8_t index) {
+    serial->flush();
+    serial->updateBaudRate(SCS_LINK_RATES[index]);
+    partialCount = 0;
+    synced = false;
+    rateIndex = index;
+}
+
+unsigned long SerialPacketHandler::getBaud() const {
+    return SCS_LINK_RATES[rateIndex];
+}
+
+bool SerialPacketHandler::popRing(SCSPacket& packet) {
+    uint8_t tail = ringTail.load(std::memory_order_relaxed);
+    if (tail == ringHead.load(std::memory_order_acquire)) {
+        return false;
+    }
+    packet = ring[tail];
+    ringTail.store((tail + 1) & (SCS_RX_RING_FRAMES - 1), std::memory_order_release);
+    return true;
+}
+
+bool SerialPacketHandler::awaitLinkFrame(uint8_t control, uint8_t op, uint8_t dat0, uint8_t dec) {
+    unsigned long start = millis();
+    SCSPacket reply;
+    while (millis() - start < SCS_LINK_REPLY_MS) {
+        if (popRing(reply)) {
+            // A retrain runs between normal traffic - keep it for the inbox
+            if (!scsIsLinkFrame(reply.control)) {
+                if (heldHead < SCS_LINK_HELD_FRAMES) {
+                    held[heldHead++] = reply;
+                } else {
+                    stats.drops++;
                 }
+                continue;
             }
-            
-            // Prevent buffer overflow
-            if (bufferIndex >= BUFFER_SIZE) {
-                memmove(buffer, buffer + 1, BUFFER_SIZE - 1);
-                bufferIndex = BUFFER_SIZE - 1;
-            }
+            return reply.control == control && reply.dat1 == op && reply.dat0 == dat0 && reply.dec == dec;
         }
+        delay(1);
     }
-    
     return false;
 }
 
-void SerialPacketHandler::sendPacket(const SCSPacket& packet) {
-    serial->write(packet.control);
-    serial->write(packet.dat1);
-    serial->write(packet.dat0);
-    serial->write(packet.dec);
-    serial->flush();
+bool SerialPacketHandler::trialRate(SubsystemID peer, uint8_t index) {
+    const uint8_t mine = scsControlByte(SYS_IDLE, SUB_SNC, SCS_LINK_IST);
+    const uint8_t theirs = scsControlByte(SYS_IDLE, peer, SCS_LINK_IST);
+    uint8_t previous = rateIndex;
+
+    sendPacket(SCSPacket(mine, SCS_LINK_OP_PROPOSE, index, 0));
+    bool ok = awaitLinkFrame(theirs, SCS_LINK_OP_ACK, index, 0);
+    if (ok) {
+        setRate(index);
+        delay(SCS_LINK_SETTLE_MS);
+        SCSLinkStats before = stats;
+        for (uint8_t seq = 0; ok && seq < SCS_LINK_PATTERN_FRAMES; seq++) {
+            uint8_t pattern = LINK_PATTERN[seq % sizeof(LINK_PATTERN)];
+            sendPacket(SCSPacket(mine, SCS_LINK_OP_PATTERN, pattern, seq));
+            ok = awaitLinkFrame(theirs, SCS_LINK_OP_PATTERN, pattern, seq);
+        }
+        ok = ok && stats.resyncs == before.resyncs && stats.drops == before.drops;
+
+        // Repeated so a lost echo does not leave the peer committed and us not
+        bool committed = false;
+        for (int attempt = 0; ok && !committed && attempt < 3; attempt++) {
+            sendPacket(SCSPacket(mine, SCS_LINK_OP_COMMIT, index, 0));
+            committed = awaitLinkFrame(theirs, SCS_LINK_OP_COMMIT, index, 0);
+        }
+        ok = committed;
+    }
+
+    if (!ok) {
+        // Peer may have switched on an ACK we missed - it reverts after its trial
+        setRate(previous);
+        delay(SCS_LINK_TRIAL_MS + SCS_LINK_SETTLE_MS);
+        SCSPacket stale;
+        while (popRing(stale)) {}
+    }
+    return ok;
+}
+
+void SerialPacketHandler::fallBack(uint8_t index) {
+    // Peer switches on the first FALLBACK it understands
+    SCSPacket fallback(scsControlByte(SYS_IDLE, SUB_SNC, SCS_LINK_IST), SCS_LINK_OP_FALLBACK, index, 0);
+    for (int i = 0; i < 3; i++) {
+        sendPacket(fallback);
+    }
+    setRate(index);
+}
+
+unsigned long SerialPacketHandler::trainLink(SubsystemID peer) {
+    // After an SNC-only reset the peer may still sit at a rate it committed
+    // before: tell it to drop to the base rate at every rate it could be on
+    for (uint8_t index = SCS_LINK_RATE_COUNT - 1; index > 0; index--) {
+        setRate(index);
+        fallBack(0);
+    }
+    delay(SCS_LINK_SETTLE_MS);
+    SCSPacket stale;
+    while (popRing(stale)) {}
+
+    raiseRate(peer);
+    return getBaud();
+}
+
+void SerialPacketHandler::raiseRate(SubsystemID peer) {
+    for (uint8_t index = rateIndex + 1; index < SCS_LINK_RATE_COUNT; index++) {
+        if (!trialRate(peer, index)) {
+            break;
+        }
+    }
+    monitorMs = probeMs = linkHeardMs = retrainMs = millis();
+    monitorErrors = stats.resyncs;
+    retrainFrames = stats.frames;
+}
+
+bool SerialPacketHandler::retrainLink(SubsystemID peer) {
+    unsigned long now = millis();
+    if (rateIndex > 0 || now - retrainMs < retrainWaitMs) {
+        return false;
+    }
+
+    // Nothing received since the last attempt -> peer still down, keep waiting
+    uint32_t frames = stats.frames;
+    if (frames == retrainFrames) {
+        retrainMs = now;
+        return false;
+    }
+
+    raiseRate(peer);
+    if (rateIndex == 0) {
+        // Wiring that cannot go faster should not stall the comms task every few seconds
+        retrainWaitMs = retrainWaitMs * 2 < SCS_LINK_RETRAIN_MAX_MS ? retrainWaitMs * 2 : SCS_LINK_RETRAIN_MAX_MS;
+        return false;
+    }
+    retrainWaitMs = SCS_LINK_RETRAIN_MS;
+    return true;
+}
+
+void SerialPacketHandler::noteLinkFrame() {
+    linkHeardMs = millis();
+}
+
+bool SerialPacketHandler::monitorLink() {
+    unsigned long now = millis();
+
+    // Above the base rate the peer must keep answering the keepalive; if it
+    // does not, one end has lost the rate (peer reset, lost FALLBACK)
+    if (rateIndex > 0) {
+        if (now - linkHeardMs >= SCS_LINK_SILENCE_MS) {
+            fallBack(0);
+            // Retrain only once the peer is heard from again
+            retrainMs = now;
+            retrainFrames = stats.frames;
+            return true;
+        }
+        if (now - probeMs >= SCS_LINK_PROBE_MS) {
+            probeMs = now;
+            sendPacket(SCSPacket(scsControlByte(SYS_IDLE, SUB_SNC, SCS_LINK_IST), SCS_LINK_OP_PATTERN, LINK_PATTERN[0], 0));
+        }
+    }
+
+    if (now - monitorMs < SCS_LINK_MONITOR_MS) {
+        return false;
+    }
+    monitorMs = now;
+
+    // Wire errors only - ring drops mean the consumer was slow, not the link
+    uint32_t errors = stats.resyncs;
+    uint32_t burst = errors - monitorErrors;
+    monitorErrors = errors;
+    if (burst < SCS_LINK_ERROR_BURST || rateIndex == 0) {
+        return false;
+    }
+
+    fallBack(rateIndex - 1);
+    return true;
+}
+
+void SerialPacketHandler::setRxNotify(TaskHandle_t task) {
+    rxNotifyTask = task;
 }
 
 bool SerialPacketHandler::isSynced() const {
@@ -135,5 +383,24 @@ bool SerialPacketHandler::isSynced() const {
 }
 
 int SerialPacketHandler::getBufferLevel() const {
-    return bufferIndex;
-}
\ No newline at end of file
+    uint8_t head = ringHead.load(std::memory_order_acquire);
+    uint8_t tail = ringTail.load(std::memory_order_acquire);
+    return (head - tail) & (SCS_RX_RING_FRAMES - 1);
+}
+
+SCSLinkStats SerialPacketHandler::getStats() const {
+    return stats;
+}
+
+void SerialPacketHandler::printStats(const char* name) const {
+    Serial.printf("%s link: %lu baud | frames=%lu resyncs=%lu drops=%lu bytes=%lu queued=%d | tx=%lu stalls=%lu\n",
+                  name,
+                  getBaud(),
+                  (unsigned long)stats.frames,
+                  (unsigned long)stats.resyncs,
+                  (unsigned long)stats.drops,
+                  (unsigned long)stats.bytes,
+                  getBufferLevel(),
+                  (unsigned long)stats.txFrames,
+                  (unsigned long)stats.txStalls);
+}
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include <HardwareSerial.h>
+#include <atomic>
 
 // ==================== SCS SYSTEM DEFINITIONS ====================
 enum SystemState {
@@ -30,6 +31,19 @@ struct SCSPacket {
     SCSPacket(uint8_t ctrl, uint8_t d1, uint8_t d0, uint8_t d);
 };
 
+// MAZE:MDPS:IST4 DEC flag: this report closes a stop or rotation - the wheels
+// are at rest and DAT1:DAT0 is the final distance. Sent once, before the MDPS
+// clears its counters; IST2 ahead of it already holds the final angle
+#define MDPS_DEC_MOTION_COMPLETE  0x01
+
+// MAZE:MDPS:IST5/IST6 odometry record, ahead of IST1 in every MDPS report:
+// DAT1:DAT0 = low 16 bits of the right (IST5) / left (IST6) wheel's encoder
+// count since boot, never cleared by a stop; DEC = MDPS time the counts were
+// read, in 10 ms steps. Both wrap - receivers extend them by differencing
+#define MDPS_IST_ODOMETRY_RIGHT   5
+#define MDPS_IST_ODOMETRY_LEFT    6
+#define MDPS_ODOMETRY_TICK_MS     10
+
 // ==================== PACKET PARSING FUNCTIONS ====================
 /**
  * Extract system state from control byte
@@ -51,6 +65,13 @@ uint8_t getInternalState(uint8_t control);
  */
 uint8_t createControlByte(SystemState sys, SubsystemID sub, uint8_t ist);
 
+/**
+ * Create control byte as a constant expression (compile-time tables)
+ */
+constexpr uint8_t scsControlByte(SystemState sys, SubsystemID sub, uint8_t ist) {
+    return ((sys & 0x03) << 6) | ((sub & 0x03) << 4) | (ist & 0x0F);
+}
+
 // ==================== DEBUG FUNCTIONS ====================
 /**
  * Convert system state to string for debugging
@@ -69,16 +90,149 @@ void printPacket(const SCSPacket& packet, const char* direction = "");
 
 // ==================== SERIAL PACKET HANDLER ====================
 #define PACKET_SIZE 4
-#define BUFFER_SIZE 16
+
+// RX frame ring depth (whole SCS frames, must be a power of two)
+#define SCS_RX_RING_FRAMES 16
+
+// Gap between UART bursts that abandons a half-received frame (resync)
+#define SCS_FRAME_GAP_US 3000
+
+// TX queue depth in frames - backs the UART driver's TX ring buffer, which is
+// drained by the TX-empty interrupt (must exceed the 128-byte hardware FIFO)
+#define SCS_TX_QUEUE_FRAMES 64
+
+// ==================== LINK TRAINING ====================
+// Every SCS link comes up at SCS_LINK_RATES[0]. At startup the SNC proposes
+// each faster rate in turn: both ends switch, SCS_LINK_PATTERN_FRAMES test
+// frames are echoed back, and the rate is committed only if every echo came
+// back intact with no framing error. An error burst later drops the link one
+// rate. Above the base rate the SNC sends a keepalive every SCS_LINK_PROBE_MS
+// that the peer echoes; an end that hears no link frame for
+// SCS_LINK_SILENCE_MS (SNC reset, FALLBACK lost) goes back to the base rate.
+// A link sitting at the base rate whose peer is talking again (late boot,
+// silence fallback) is retrained from the comms task every
+// SCS_LINK_RETRAIN_MS, backing off to SCS_LINK_RETRAIN_MAX_MS while the
+// trial keeps failing; frames the peer sends meanwhile are held back and
+// delivered afterwards.
+// Link frames are IDLE:<sender>:IST15 and never reach the state machine;
+// the SS and MDPS sketches carry the same constants.
+#define SCS_LINK_IST             15
+#define SCS_LINK_OP_PROPOSE      1       // SNC: try rate DAT0 (index)
+#define SCS_LINK_OP_ACK          2       // Peer: switching to DAT0
+#define SCS_LINK_OP_PATTERN      3       // SNC: DAT0 = test byte, DEC = sequence (peer echoes)
+#define SCS_LINK_OP_COMMIT       4       // SNC: keep rate DAT0 (peer echoes)
+#define SCS_LINK_OP_FALLBACK     5       // SNC: drop to rate DAT0 now (sent 3x, no reply)
+#define SCS_LINK_PATTERN_FRAMES  32
+#define SCS_LINK_REPLY_MS        20      // Wait for each ACK / echo
+#define SCS_LINK_SETTLE_MS       5       // Both ends switching baud
+#define SCS_LINK_TRIAL_MS        200     // Peer returns to its last rate without a COMMIT by then
+#define SCS_LINK_MONITOR_MS      1000    // Error-burst window
+#define SCS_LINK_ERROR_BURST     4       // Resyncs in one window that drop the rate
+#define SCS_LINK_PROBE_MS        250     // Keepalive (echoed PATTERN) above the base rate
+#define SCS_LINK_SILENCE_MS      1000    // No link frame by then -> back to SCS_LINK_RATES[0]
+#define SCS_LINK_RETRAIN_MS      5000    // Base-rate link with a live peer -> train again
+#define SCS_LINK_RETRAIN_MAX_MS  80000   // Retrain back-off cap (doubles per failed attempt)
+#define SCS_LINK_HELD_FRAMES     16      // Non-link frames kept aside during a retrain
+
+static const uint32_t SCS_LINK_RATES[] = { 115200, 230400, 460800, 921600, 1500000, 2000000 };
+#define SCS_LINK_RATE_COUNT (sizeof(SCS_LINK_RATES) / sizeof(SCS_LINK_RATES[0]))
+
+/**
+ * Link training / fallback frame (IDLE:any:IST15)
+ */
+constexpr bool scsIsLinkFrame(uint8_t control) {
+    return (control >> 6) == SYS_IDLE && (control & 0x0F) == SCS_LINK_IST;
+}
+
+// Per-port link counters, updated from the UART event task
+struct SCSLinkStats {
+    uint32_t frames;    // Complete frames pushed into the RX ring
+    uint32_t resyncs;   // Partial frames discarded after an inter-frame gap
+    uint32_t drops;     // Frames lost because the RX ring was full
+    uint32_t bytes;     // Raw bytes taken from the UART
+    uint32_t txFrames;  // Frames queued for transmit
+    uint32_t txStalls;  // Sends that found the TX queue full and had to wait
+};
 
 class SerialPacketHandler {
 private:
     HardwareSerial* serial;
-    uint8_t buffer[BUFFER_SIZE];
-    int bufferIndex;
-    unsigned long lastByteTime;
-    bool synced;
     int rxPin, txPin;
+
+    // Frame assembly (owned by the UART event task)
+    uint8_t partial[PACKET_SIZE];
+    uint8_t partialCount;
+    unsigned long lastByteTime;
+
+    // Single-producer / single-consumer frame ring
+    SCSPacket ring[SCS_RX_RING_FRAMES];
+    std::atomic<uint8_t> ringHead;  // Written by UART event task
+    std::atomic<uint8_t> ringTail;  // Written by the consumer (comms task)
+
+    volatile bool synced;
+    SCSLinkStats stats;
+
+    // Link rate (index into SCS_LINK_RATES) and error-burst window
+    uint8_t rateIndex;
+    unsigned long monitorMs;
+    uint32_t monitorErrors;
+    unsigned long probeMs;          // Last keepalive sent
+    volatile unsigned long linkHeardMs;  // Last link frame from the peer
+    unsigned long retrainMs;        // Last training attempt
+    unsigned long retrainWaitMs;    // Current retrain interval (backs off on failure)
+    uint32_t retrainFrames;         // stats.frames at that attempt
+
+    // Non-link frames that arrived during training (comms task only),
+    // handed out by peekPacket() ahead of the ring
+    SCSPacket held[SCS_LINK_HELD_FRAMES];
+    uint8_t heldHead, heldTail;
+
+    // Task woken (xTaskNotifyGive) whenever frames land in the ring
+    volatile TaskHandle_t rxNotifyTask;
+
+    /**
+     * UART receive event callback - drains the UART FIFO and frames bytes
+     */
+    void onUartReceive();
+
+    /**
+     * Push one assembled frame into the RX ring (producer side)
+     */
+    void pushFrame(const uint8_t* bytes);
+
+    /**
+     * Take the oldest frame straight from the RX ring, skipping held frames
+     */
+    bool popRing(SCSPacket& packet);
+
+    /**
+     * Switch this end of the link to SCS_LINK_RATES[index]
+     */
+    void setRate(uint8_t index);
+
+    /**
+     * Wait for one link frame from the peer (training only)
+     * Other frames on the way are held for peekPacket().
+     * @return: true if the next link frame matched within SCS_LINK_REPLY_MS
+     */
+    bool awaitLinkFrame(uint8_t control, uint8_t op, uint8_t dat0, uint8_t dec);
+
+    /**
+     * Tell the peer to drop to SCS_LINK_RATES[index] (3x FALLBACK), then follow
+     */
+    void fallBack(uint8_t index);
+
+    /**
+     * Propose one rate, run the echo test at it and commit it
+     * @return: false if the peer did not follow (link is back at the old rate)
+     */
+    bool trialRate(SubsystemID peer, uint8_t index);
+
+    /**
+     * Trial each rate above the current one until one fails, then restart
+     * the keepalive / error-burst / retrain timers
+     */
+    void raiseRate(SubsystemID peer);
     
 public:
     /**
@@ -90,23 +244,80 @@ public:
     SerialPacketHandler(HardwareSerial* ser, int rx, int tx);
     
     /**
-     * Initialize serial communication
-     * @param baud: Baud rate (typically 19200)
+     * Initialize serial communication and attach the UART receive event
+     * @param baud: Baud rate (SCS_LINK_RATES[0] until trainLink())
      */
     void begin(unsigned long baud);
     
     /**
-     * Read incoming packet from serial buffer
+     * Copy the oldest received frame out of the RX ring
      * @param packet: Reference to packet structure to fill
      * @return: true if valid packet received
      */
     bool readPacket(SCSPacket& packet);
+
+    /**
+     * Borrow the oldest received frame without copying it
+     * The frame stays valid until consumePacket() is called.
+     * @return: Pointer to frame in the RX ring, or nullptr if empty
+     */
+    const SCSPacket* peekPacket() const;
+
+    /**
+     * Release the frame returned by peekPacket()
+     */
+    void consumePacket();
     
     /**
-     * Send packet over serial
+     * Train the link up from SCS_LINK_RATES[0] (setup only, before the tasks
+     * start; ~100 ms per rate, SCS_LINK_TRIAL_MS more when a rate fails)
+     * @param peer: Subsystem on the far end (replies as IDLE:peer:IST15)
+     * @return: Baud rate locked in
+     */
+    unsigned long trainLink(SubsystemID peer);
+
+    /**
+     * Train again if the link is at SCS_LINK_RATES[0] and the peer has sent
+     * frames since the last attempt - call from the comms task while the
+     * system is idle (blocks it as long as trainLink())
+     * @param peer: Subsystem on the far end
+     * @return: true if the rate was raised
+     */
+    bool retrainLink(SubsystemID peer);
+
+    /**
+     * Keepalive, silence and error-burst checks - call from the comms task
+     * @return: true if the rate was lowered
+     */
+    bool monitorLink();
+
+    /**
+     * A link frame from the peer was consumed (keepalive echo)
+     */
+    void noteLinkFrame();
+
+    /**
+     * Current baud rate
+     */
+    unsigned long getBaud() const;
+
+    /**
+     * Queue packet for transmit (returns without waiting for the wire)
      * @param packet: Packet to send
      */
     void sendPacket(const SCSPacket& packet);
+
+    /**
+     * Block until every queued frame has left the UART
+     * Only for the few places that need ordering on the wire (e.g. EOM forward).
+     */
+    void flush();
+
+    /**
+     * Wake a task whenever new frames arrive, instead of polling the ring
+     * @param task: Task to notify (nullptr to disable)
+     */
+    void setRxNotify(TaskHandle_t task);
     
     /**
      * Check if handler is synchronized
@@ -115,10 +326,22 @@ public:
     bool isSynced() const;
     
     /**
-     * Get current buffer level for debugging
-     * @return: Number of bytes in buffer
+     * Get current RX ring level for debugging
+     * @return: Number of whole frames waiting to be read
      */
     int getBufferLevel() const;
+
+    /**
+     * Get link counters (frames, resyncs, drops, bytes, TX frames/stalls)
+     * @return: Snapshot of the per-port counters
+     */
+    SCSLinkStats getStats() const;
+
+    /**
+     * Print link counters for debugging
+     * @param name: Port label (e.g. "SS", "MDPS")
+     */
+    void printStats(const char* name) const;
 };
 
 #endif // SCS_PROTOCOL_H
\ No newline at end of file
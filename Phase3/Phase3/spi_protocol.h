@@ -9,6 +9,8 @@
 
 #include <Arduino.h>
 #include <SPI.h>
+#include <driver/spi_master.h>
+#include <esp_heap_caps.h>
 
 // Include existing protocol definitions instead of redefining
 #include "scs_protocol.h"
@@ -54,8 +56,15 @@ enum PacketType : uint8_t {
     PKT_ROTATION_COMMAND = 0x32,
     PKT_ROTATION_FEEDBACK = 0x33,
     PKT_ANGLE_EVALUATION = 0x34,
+    PKT_POSE = 0x35,            // Dead-reckoned pose in the MAZE entry frame
+    PKT_MAP_LINE = 0x36,        // One line/wall encounter on the map
     PKT_DEBUG_MESSAGE = 0x40,
-    PKT_HEARTBEAT = 0x42
+    PKT_HEARTBEAT = 0x42,
+    PKT_LATENCY_STATS = 0x43,   // Per-stage turn latency summary (SNC trace)
+    PKT_FLIGHT_LOG = 0x44,      // Flight recorder upload chunk (after the run)
+    PKT_BATCH = 0x50,           // Payload is a run of BatchRecordHeader + record
+    PKT_COMMAND = 0x60,         // Dashboard command, WiFi ESP32 -> SNC on MISO
+    PKT_COMMAND_ACK = 0x61      // SNC -> WiFi ESP32: command received
 };
 
 // ============================================================================
@@ -80,6 +89,19 @@ struct SPIPacket {
     uint8_t checksum_payload;
 } __attribute__((packed));
 
+// Header flags (SPIPacketHeader.flags)
+// SPI_FLAG_VARLEN: length-prefixed framing (protocol v2). Only the header,
+// data_length payload bytes and the payload checksum (at payload[data_length])
+// are clocked. The WiFi ESP32 advertises support by setting this flag in the
+// header it returns on MISO; the SNC switches over once it sees it.
+#define SPI_FLAG_VARLEN 0x01
+
+// Legacy fixed frame (flags == 0) - always clocks the full payload area
+#define SPI_FIXED_FRAME_SIZE (sizeof(SPIPacketHeader) + MAX_PAYLOAD_SIZE + 1)
+
+// Length-prefixed frame, padded to a 4-byte multiple for the slave DMA
+#define SPI_VARLEN_FRAME_SIZE(len) ((sizeof(SPIPacketHeader) + (len) + 1 + 3) & ~(size_t)3)
+
 // Payload Structures
 struct SystemStatePayload {
     uint32_t timestamp;
@@ -190,25 +212,184 @@ struct DebugMessagePayload {
     char message[115];
 } __attribute__((packed));
 
+// Pose frame: origin where MAZE was entered, +x along the heading at that
+// moment, +y to its left, heading CCW in tenths of a degree
+struct PosePayload {
+    uint32_t timestamp;
+    int16_t x_mm;
+    int16_t y_mm;
+    int16_t heading_ddeg;       // (-1800, 1800]
+    uint16_t lines;             // RED/GREEN encounters since MAZE entry
+    uint32_t travelled_mm;
+    uint16_t walls;             // BLACK/BLUE encounters since MAZE entry
+    uint16_t legs;              // Forward/reverse legs integrated
+    uint16_t rotations;
+    uint8_t reserved[2];
+} __attribute__((packed));
+
+// Encounters are numbered from 0 per run; a gap in 'sequence' is a record
+// the SNC had to drop
+struct MapLinePayload {
+    uint32_t timestamp;
+    uint16_t sequence;
+    int16_t x_mm;               // Detecting sensor's position, pose frame
+    int16_t y_mm;
+    int16_t heading_deg;        // Robot heading at the detection
+    uint8_t color;
+    uint8_t sensor;             // First sensor (1, 2 or 3)
+    uint8_t angle;              // Incidence angle (46 = inferred steep)
+    uint8_t angle_valid;
+} __attribute__((packed));
+
+// Turn latency stages: handoff, state, navcon_rx, decision, tx, turn
+#define LATENCY_STAGE_COUNT 6
+
+struct LatencyStageStats {
+    uint32_t count;
+    uint32_t min_ns;
+    uint32_t mean_ns;
+    uint32_t p99_ns;
+    uint32_t max_ns;
+} __attribute__((packed));
+
+struct LatencyStatsPayload {
+    uint32_t timestamp;
+    uint8_t stage_count;
+    uint8_t reserved[3];
+    LatencyStageStats stages[LATENCY_STAGE_COUNT];
+} __attribute__((packed));
+
+// Flight recorder upload: the run log is streamed in offset order; the
+// receiver writes each chunk at 'offset' (offset 0 starts a new upload).
+// data_length = offsetof(data) + bytes of data actually carried.
+#define FLIGHT_LOG_CHUNK_BYTES 224
+
+struct FlightLogChunkPayload {
+    uint32_t offset;            // Byte offset of data[] in the run log
+    uint32_t total;             // Run log size in bytes
+    uint32_t run_id;            // Recorder run the log belongs to
+    uint8_t data[FLIGHT_LOG_CHUNK_BYTES];
+} __attribute__((packed));
+
+// Dashboard commands ride back on MISO in every transaction the SNC clocks:
+// the slave repeats its oldest unacknowledged command (header.sequence =
+// command sequence) until a PKT_COMMAND_ACK echoing it arrives. The SNC acts
+// on each sequence once, so a repeat is only acknowledged again.
+enum WiFiCommand : uint8_t {
+    WIFI_CMD_TOUCH = 1,
+    WIFI_CMD_PURE_TONE = 2,
+    WIFI_CMD_SEND = 3,
+    WIFI_CMD_RESET_MAIN = 4
+};
+
+struct CommandPayload {
+    uint16_t sequence;          // Command sequence (PKT_COMMAND_ACK echoes it)
+    uint8_t command;            // WiFiCommand
+    uint8_t reserved;
+} __attribute__((packed));
+
+// MISO bytes the SNC reads per transaction: header + CommandPayload + checksum
+#define SPI_MISO_REPLY_SIZE SPI_VARLEN_FRAME_SIZE(sizeof(CommandPayload))
+
+// TLV record inside a PKT_BATCH payload; 'length' bytes of the record's
+// normal payload structure follow immediately
+struct BatchRecordHeader {
+    uint8_t type;               // PacketType of the record
+    uint8_t length;
+} __attribute__((packed));
+
 // ============================================================================
 // MAIN SPI COMMUNICATION CLASS
 // ============================================================================
 
+// DMA transmit slots: one in flight while the next is being filled
+#define SPI_TX_SLOTS 2
+
+// Dashboard commands taken off MISO, waiting for the control task
+#define SPI_COMMAND_QUEUE 8
+
 class MarvSPIComm {
 private:
-    SPIClass* spi;
+    SPIClass* spi;              // Blocking fallback if the DMA driver can't start
     uint8_t cs_pin;
     uint16_t sequence_counter;
-    SPIPacket tx_packet;
     uint32_t packets_sent;
+    uint32_t bytes_sent;
+
+    // Where send* helpers build the next frame: the free DMA slot, or
+    // scratch_packet while batching / when both slots are still in flight
+    SPIPacket* tx_packet;
+    SPIPacket scratch_packet;
+
+    // DMA double buffer (spi_device_queue_trans)
+    bool dma_enabled;
+    spi_device_handle_t dma_device;
+    SPIPacket* dma_tx[SPI_TX_SLOTS];
+    uint8_t* dma_rx[SPI_TX_SLOTS];      // Slave's MISO reply per slot (SPI_MISO_REPLY_SIZE)
+    spi_transaction_t dma_trans[SPI_TX_SLOTS];
+    bool slot_busy[SPI_TX_SLOTS];
+    uint8_t back_slot;
+    uint32_t packets_completed;
+    uint32_t packets_dropped;
+    uint8_t max_in_flight;
+
+    // Batch under construction (PKT_BATCH); send* calls append to it while open
+    bool batching;
+    uint8_t batch_buf[MAX_PAYLOAD_SIZE];
+    uint8_t batch_len;
+    uint8_t batch_records;
+
+    // Framing negotiated from the slave's MISO header (see SPI_FLAG_VARLEN)
+    bool varlen_mode;
+    uint8_t varlen_miss_count;
+
+    // Dashboard commands (PKT_COMMAND on MISO); the ack rides in the next frame
+    QueueHandle_t command_queue;
+    uint16_t last_command_seq;
+    bool have_command_seq;
+    bool ack_pending;
+    CommandPayload ack;
+    uint32_t commands_received;
+    uint32_t command_repeats;       // Copies of a command already taken (ack still on its way)
     
     uint8_t calculateChecksum(const uint8_t* data, size_t length);
+    void selectBackBuffer();
     void buildHeader(PacketType type, uint8_t payload_length);
     bool sendPacket();
+    void updateNegotiation(const uint8_t* miso_header);
+    void handleSlaveReply(const uint8_t* miso, size_t length);
 
 public:
     MarvSPIComm(SPIClass* spi_instance, uint8_t chip_select);
     void begin();
+
+    /**
+     * Reap completed DMA transfers (non-blocking)
+     * Also called implicitly before each frame is built.
+     */
+    void poll();
+
+    /**
+     * Start collecting send* calls into one PKT_BATCH frame
+     * Nothing goes on the bus until commitBatch().
+     */
+    void beginBatch();
+
+    /**
+     * Append one TLV record to the open batch
+     * Commits and reopens the batch automatically if the record doesn't fit.
+     * @param type: Record packet type
+     * @param payload: Record payload (normal payload structure for that type)
+     * @param length: Payload length in bytes
+     * @return: false if no batch is open or the record can never fit
+     */
+    bool append(PacketType type, const void* payload, uint8_t length);
+
+    /**
+     * Send the open batch as a single frame (one CS assertion)
+     * @return: true if a frame was sent
+     */
+    bool commitBatch();
     
     // System State
     bool sendSystemState(SystemState state, Subsystem sub, uint8_t ist);
@@ -236,13 +417,33 @@ public:
     bool sendRotationFeedback(uint16_t actual, uint16_t target);
     bool sendAngleEvaluation(uint16_t original, uint16_t remaining, 
                             bool will_cross, uint8_t corrections, uint16_t threshold);
+    bool sendPose(const PosePayload& pose);
+    bool sendMapLine(const MapLinePayload& line);
     
     // Debug
     bool sendDebug(uint8_t severity, const char* message);
     bool sendHeartbeat();
+    bool sendLatencyStats(const LatencyStatsPayload& stats);
+    bool sendFlightLog(const FlightLogChunkPayload& chunk, uint8_t data_bytes);
+
+    // Dashboard commands
+    /**
+     * Acknowledge the last command taken off MISO (appends to an open batch)
+     * @return: false if there is nothing to acknowledge
+     */
+    bool sendCommandAck();
+
+    /**
+     * Take the next dashboard command (safe from any task)
+     * @param command: Filled with the command and its sequence
+     * @return: false if none is waiting
+     */
+    bool receiveCommand(CommandPayload& command);
 
     // Performance monitoring
     void printPerformanceStats();
+    uint32_t getDroppedCount() const { return packets_dropped; }
+    bool isVarlenMode() const { return varlen_mode; }
 };
 
 #endif // SPI_PROTOCOL_H
\ No newline at end of file
@@ -5,30 +5,92 @@
  */
 
 #include "spi_protocol.h"
+#include "pc_profiler.h"
 #include <Arduino.h>
 
+// Consecutive frames without the slave's VARLEN advert before falling back
+// to fixed-size frames (tolerates the slave briefly re-arming its DMA)
+#define SPI_NEGOTIATION_MISS_LIMIT 32
+
 // ============================================================================
 // MARV SPI COMMUNICATION CLASS IMPLEMENTATION
 // ============================================================================
 
 MarvSPIComm::MarvSPIComm(SPIClass* spi_instance, uint8_t chip_select)
-    : spi(spi_instance), cs_pin(chip_select), sequence_counter(0), packets_sent(0) {
-    memset(&tx_packet, 0, sizeof(SPIPacket));
+    : spi(spi_instance), cs_pin(chip_select), sequence_counter(0), packets_sent(0),
+      bytes_sent(0), tx_packet(&scratch_packet),
+      dma_enabled(false), dma_device(nullptr), back_slot(0),
+      packets_completed(0), packets_dropped(0), max_in_flight(0),
+      batching(false), batch_len(0), batch_records(0),
+      varlen_mode(false), varlen_miss_count(0),
+      command_queue(nullptr), last_command_seq(0), have_command_seq(false), ack_pending(false),
+      commands_received(0), command_repeats(0) {
+    memset(&scratch_packet, 0, sizeof(SPIPacket));
+    memset(&ack, 0, sizeof(ack));
+    for (int i = 0; i < SPI_TX_SLOTS; i++) {
+        dma_tx[i] = nullptr;
+        dma_rx[i] = nullptr;
+        slot_busy[i] = false;
+    }
 }
 
 void MarvSPIComm::begin() {
-    pinMode(cs_pin, OUTPUT);
-    digitalWrite(cs_pin, HIGH);
+    command_queue = xQueueCreate(SPI_COMMAND_QUEUE, sizeof(CommandPayload));
 
     // Use VSPI (GPIO 5=CS, 18=SCK, 23=MOSI, 19=MISO)
-    spi->begin();
+    spi_bus_config_t buscfg = {};
+    buscfg.mosi_io_num = 23;
+    buscfg.miso_io_num = 19;
+    buscfg.sclk_io_num = 18;
+    buscfg.quadwp_io_num = -1;
+    buscfg.quadhd_io_num = -1;
+    buscfg.max_transfer_sz = sizeof(SPIPacket);
+
+    // Hardware CS; hold it a few bit-times after the last byte so the slave
+    // latches the final word (pre-transfer hold isn't available full-duplex)
+    spi_device_interface_config_t devcfg = {};
+    devcfg.clock_speed_hz = 2000000;
+    devcfg.mode = 0;
+    devcfg.spics_io_num = cs_pin;
+    devcfg.cs_ena_posttrans = 4;
+    devcfg.queue_size = SPI_TX_SLOTS;
+
+    bool buffers_ok = true;
+    for (int i = 0; i < SPI_TX_SLOTS; i++) {
+        dma_tx[i] = (SPIPacket*)heap_caps_malloc(sizeof(SPIPacket), MALLOC_CAP_DMA);
+        dma_rx[i] = (uint8_t*)heap_caps_malloc(SPI_MISO_REPLY_SIZE, MALLOC_CAP_DMA);
+        buffers_ok = buffers_ok && dma_tx[i] && dma_rx[i];
+    }
 
-    Serial.println("SPI Master initialized for WiFi communication");
-    Serial.println("  CS: GPIO 15, SCK: GPIO 18, MOSI: GPIO 23");
+    if (buffers_ok &&
+        spi_bus_initialize(VSPI_HOST, &buscfg, SPI_DMA_CH_AUTO) == ESP_OK &&
+        spi_bus_add_device(VSPI_HOST, &devcfg, &dma_device) == ESP_OK) {
+        dma_enabled = true;
+        back_slot = 0;
+        tx_packet = dma_tx[back_slot];
+        memset(tx_packet, 0, sizeof(SPIPacket));
+
+        Serial.println("SPI Master initialized for WiFi communication (DMA, double-buffered)");
+    } else {
+        // Fall back to blocking Arduino SPI - telemetry still works, just not async
+        for (int i = 0; i < SPI_TX_SLOTS; i++) {
+            heap_caps_free(dma_tx[i]);
+            heap_caps_free(dma_rx[i]);
+            dma_tx[i] = nullptr;
+            dma_rx[i] = nullptr;
+        }
+        pinMode(cs_pin, OUTPUT);
+        digitalWrite(cs_pin, HIGH);
+        spi->begin();
+
+        Serial.println("SPI Master initialized for WiFi communication (blocking - DMA init failed)");
+    }
+
+    Serial.printf("  CS: GPIO %d, SCK: GPIO 18, MOSI: GPIO 23\n", cs_pin);
     Serial.println("  Speed: 2MHz, Mode: 0");
 }
 
-uint8_t MarvSPIComm::calculateChecksum(const uint8_t* data, size_t length) {
+uint8_t SNC_HOT MarvSPIComm::calculateChecksum(const uint8_t* data, size_t length) {
     uint8_t checksum = 0;
     for (size_t i = 0; i < length; i++) {
         checksum ^= data[i];
@@ -36,52 +98,270 @@ uint8_t MarvSPIComm::calculateChecksum(const uint8_t* data, size_t length) {
     return checksum;
 }
 
+void MarvSPIComm::poll() {
+    if (!dma_enabled) {
+        return;
+    }
+
+    // Drain finished transactions without waiting; slot index rides in 'user'
+    spi_transaction_t* done;
+    while (spi_device_get_trans_result(dma_device, &done, 0) == ESP_OK) {
+        int slot = (int)(intptr_t)done->user;
+        slot_busy[slot] = false;
+        packets_completed++;
+        handleSlaveReply(dma_rx[slot], done->rxlength / 8);
+    }
+}
+
+void MarvSPIComm::selectBackBuffer() {
+    if (batching) {
+        // Records are staged in scratch and copied into batch_buf
+        tx_packet = &scratch_packet;
+        return;
+    }
+    if (!dma_enabled) {
+        return;
+    }
+
+    poll();
+
+    // Build into whichever slot isn't on the wire; if both are, build into
+    // scratch and let sendPacket() count the drop
+    if (slot_busy[back_slot]) {
+        back_slot ^= 1;
+    }
+    tx_packet = slot_busy[back_slot] ? &scratch_packet : dma_tx[back_slot];
+}
+
 void MarvSPIComm::buildHeader(PacketType type, uint8_t payload_length) {
-    tx_packet.header.sync1 = 0xAA;
-    tx_packet.header.sync2 = 0x55;
-    tx_packet.header.packet_type = (uint8_t)type;
-    tx_packet.header.data_length = payload_length;
-    tx_packet.header.sequence = sequence_counter++;
-    tx_packet.header.flags = 0;
+    selectBackBuffer();
+
+    // Batched records only need type/length - the batch frame gets the real header
+    if (batching) {
+        tx_packet->header.packet_type = (uint8_t)type;
+        tx_packet->header.data_length = payload_length;
+        return;
+    }
+
+    tx_packet->header.sync1 = 0xAA;
+    tx_packet->header.sync2 = 0x55;
+    tx_packet->header.packet_type = (uint8_t)type;
+    tx_packet->header.data_length = payload_length;
+    tx_packet->header.flags = varlen_mode ? SPI_FLAG_VARLEN : 0;
+    // sequence and checksum_header are stamped by sendPacket()
+}
+
+bool SNC_HOT MarvSPIComm::sendPacket() {
+    if (batching) {
+        return append((PacketType)tx_packet->header.packet_type,
+                      tx_packet->payload, tx_packet->header.data_length);
+    }
+
+    if (dma_enabled && tx_packet == &scratch_packet) {
+        packets_dropped++;  // Both DMA slots still in flight
+        return false;
+    }
+
+    // The sequence only advances for frames that reach the wire, so a gap the
+    // dashboard sees is link loss - local drops are in packets_dropped
+    tx_packet->header.sequence = sequence_counter;
 
     // Calculate header checksum (excluding checksum field itself)
-    tx_packet.header.checksum_header = calculateChecksum(
-        (uint8_t*)&tx_packet.header,
+    tx_packet->header.checksum_header = calculateChecksum(
+        (uint8_t*)&tx_packet->header,
         sizeof(SPIPacketHeader) - 1
     );
-}
 
-bool MarvSPIComm::sendPacket() {
     // Calculate payload checksum
-    tx_packet.checksum_payload = calculateChecksum(
-        tx_packet.payload,
-        tx_packet.header.data_length
+    uint8_t checksum = calculateChecksum(
+        tx_packet->payload,
+        tx_packet->header.data_length
     );
 
-    size_t packet_size = sizeof(SPIPacketHeader) + MAX_PAYLOAD_SIZE + 1;
+    size_t packet_size;
+    if (tx_packet->header.flags & SPI_FLAG_VARLEN) {
+        // Checksum follows the payload directly; only clock what is used
+        ((uint8_t*)tx_packet)[sizeof(SPIPacketHeader) + tx_packet->header.data_length] = checksum;
+        packet_size = SPI_VARLEN_FRAME_SIZE(tx_packet->header.data_length);
+    } else {
+        tx_packet->checksum_payload = checksum;
+        packet_size = SPI_FIXED_FRAME_SIZE;
+    }
 
-    // Efficient SPI transmission with minimal delays
-    digitalWrite(cs_pin, LOW);
-    delayMicroseconds(5);  // Reduced from 10 to 5 microseconds
+    if (dma_enabled) {
+        // Queue and return - the DMA clocks it out while the caller carries on
+        spi_transaction_t& t = dma_trans[back_slot];
+        memset(&t, 0, sizeof(t));
+        t.length = packet_size * 8;
+        // The slave's header plus a command, if the frame is long enough to carry one
+        t.rxlength = (packet_size < SPI_MISO_REPLY_SIZE ? packet_size : SPI_MISO_REPLY_SIZE) * 8;
+        t.tx_buffer = tx_packet;
+        t.rx_buffer = dma_rx[back_slot];
+        t.user = (void*)(intptr_t)back_slot;
+
+        if (spi_device_queue_trans(dma_device, &t, 0) != ESP_OK) {
+            packets_dropped++;
+            return false;
+        }
+
+        slot_busy[back_slot] = true;
+        uint8_t in_flight = slot_busy[0] + slot_busy[1];
+        if (in_flight > max_in_flight) {
+            max_in_flight = in_flight;
+        }
+        back_slot ^= 1;
+        tx_packet = slot_busy[back_slot] ? &scratch_packet : dma_tx[back_slot];
+    } else {
+        // Efficient SPI transmission with minimal delays
+        digitalWrite(cs_pin, LOW);
+        delayMicroseconds(5);  // Reduced from 10 to 5 microseconds
+
+        spi->beginTransaction(SPISettings(2000000, MSBFIRST, SPI_MODE0));
+        spi->transfer((uint8_t*)tx_packet, packet_size);
+        spi->endTransaction();
+
+        delayMicroseconds(5);  // Reduced from 10 to 5 microseconds
+        digitalWrite(cs_pin, HIGH);
+
+        // transfer() is in-place, so tx_packet now holds what the slave clocked back
+        handleSlaveReply((const uint8_t*)tx_packet, packet_size);
+    }
 
-    spi->beginTransaction(SPISettings(2000000, MSBFIRST, SPI_MODE0));
-    spi->transfer((uint8_t*)&tx_packet, packet_size);
-    spi->endTransaction();
+    sequence_counter++;
+    packets_sent++;
+    bytes_sent += packet_size;
+    return true;
+}
 
-    delayMicroseconds(5);  // Reduced from 10 to 5 microseconds
-    digitalWrite(cs_pin, HIGH);
+void MarvSPIComm::updateNegotiation(const uint8_t* miso_header) {
+    const SPIPacketHeader& reply = *(const SPIPacketHeader*)miso_header;
+    bool advertised = reply.sync1 == 0xAA && reply.sync2 == 0x55 &&
+                      reply.checksum_header == calculateChecksum(miso_header, sizeof(SPIPacketHeader) - 1) &&
+                      (reply.flags & SPI_FLAG_VARLEN);
+
+    if (advertised) {
+        varlen_miss_count = 0;
+        if (!varlen_mode) {
+            varlen_mode = true;
+            Serial.println("SPI: slave supports length-prefixed frames - switching to VARLEN");
+        }
+    } else if (varlen_mode && ++varlen_miss_count >= SPI_NEGOTIATION_MISS_LIMIT) {
+        varlen_mode = false;
+        varlen_miss_count = 0;
+        Serial.println("SPI: slave stopped advertising VARLEN - back to fixed frames");
+    }
+}
 
-    packets_sent++;
+// A PKT_COMMAND reply is taken once per sequence and acknowledged (again) in
+// the next frame; the slave keeps repeating it until that ack arrives
+void MarvSPIComm::handleSlaveReply(const uint8_t* miso, size_t length) {
+    updateNegotiation(miso);
+
+    const SPIPacketHeader& reply = *(const SPIPacketHeader*)miso;
+    if (length < SPI_MISO_REPLY_SIZE || reply.packet_type != PKT_COMMAND ||
+        reply.data_length != sizeof(CommandPayload) || reply.sync1 != 0xAA || reply.sync2 != 0x55 ||
+        reply.checksum_header != calculateChecksum(miso, sizeof(SPIPacketHeader) - 1)) {
+        return;
+    }
+    const uint8_t* payload = miso + sizeof(SPIPacketHeader);
+    if (payload[sizeof(CommandPayload)] != calculateChecksum(payload, sizeof(CommandPayload))) {
+        return;     // Torn read (slave rewrote its reply mid-transfer) - the next frame retries
+    }
+
+    CommandPayload command;
+    memcpy(&command, payload, sizeof(command));
+    if (command.sequence != reply.sequence) {
+        return;
+    }
+
+    if (have_command_seq && command.sequence == last_command_seq) {
+        command_repeats++;
+    } else if (xQueueSend(command_queue, &command, 0) == pdPASS) {
+        last_command_seq = command.sequence;
+        have_command_seq = true;
+        commands_received++;
+    } else {
+        return;     // Control task behind - leave it unacknowledged so it comes back
+    }
+    ack = command;
+    ack_pending = true;
+}
+
+bool MarvSPIComm::sendCommandAck() {
+    if (!ack_pending) {
+        return false;
+    }
+    buildHeader(PKT_COMMAND_ACK, sizeof(CommandPayload));
+    memcpy(tx_packet->payload, &ack, sizeof(CommandPayload));
+
+    bool sent = sendPacket();
+    if (sent) {
+        ack_pending = false;
+    }
+    return sent;
+}
+
+bool MarvSPIComm::receiveCommand(CommandPayload& command) {
+    return command_queue != nullptr && xQueueReceive(command_queue, &command, 0) == pdPASS;
+}
+
+// ============================================================================
+// BATCHED TELEMETRY
+// ============================================================================
+
+void MarvSPIComm::beginBatch() {
+    batching = true;
+    batch_len = 0;
+    batch_records = 0;
+}
+
+bool MarvSPIComm::append(PacketType type, const void* payload, uint8_t length) {
+    if (!batching || length > MAX_PAYLOAD_SIZE - sizeof(BatchRecordHeader)) {
+        return false;
+    }
+
+    // Full - ship what we have and keep going in a fresh batch. The record is
+    // usually staged in scratch_packet, which commitBatch() overwrites (and a
+    // blocking transfer fills with MISO bytes), so take a copy first.
+    if (batch_len + sizeof(BatchRecordHeader) + length > MAX_PAYLOAD_SIZE) {
+        uint8_t pending[MAX_PAYLOAD_SIZE];
+        memcpy(pending, payload, length);
+        commitBatch();
+        beginBatch();
+        return append(type, pending, length);
+    }
+
+    BatchRecordHeader* rec = (BatchRecordHeader*)&batch_buf[batch_len];
+    rec->type = (uint8_t)type;
+    rec->length = length;
+    memcpy(&batch_buf[batch_len + sizeof(BatchRecordHeader)], payload, length);
+
+    batch_len += sizeof(BatchRecordHeader) + length;
+    batch_records++;
     return true;
 }
 
+bool MarvSPIComm::commitBatch() {
+    batching = false;
+    if (batch_records == 0) {
+        return false;
+    }
+
+    buildHeader(PKT_BATCH, batch_len);
+    memcpy(tx_packet->payload, batch_buf, batch_len);
+    batch_len = 0;
+    batch_records = 0;
+
+    return sendPacket();
+}
+
 // ============================================================================
 // SYSTEM STATE FUNCTIONS
 // ============================================================================
 
 bool MarvSPIComm::sendSystemState(SystemState state, Subsystem sub, uint8_t ist) {
-    SystemStatePayload* payload = (SystemStatePayload*)tx_packet.payload;
     buildHeader(PKT_SYSTEM_STATE, sizeof(SystemStatePayload));
+    SystemStatePayload* payload = (SystemStatePayload*)tx_packet->payload;
 
     payload->timestamp = millis();
     payload->system_state = (uint8_t)state;
@@ -93,8 +373,8 @@ bool MarvSPIComm::sendSystemState(SystemState state, Subsystem sub, uint8_t ist)
 }
 
 bool MarvSPIComm::sendTouchDetected(bool detected, SystemState state, uint16_t vop) {
-    TouchPayload* payload = (TouchPayload*)tx_packet.payload;
     buildHeader(PKT_TOUCH_DETECTED, sizeof(TouchPayload));
+    TouchPayload* payload = (TouchPayload*)tx_packet->payload;
 
     payload->timestamp = millis();
     payload->touch_detected = detected ? 1 : 0;
@@ -105,8 +385,8 @@ bool MarvSPIComm::sendTouchDetected(bool detected, SystemState state, uint16_t v
 }
 
 bool MarvSPIComm::sendPureTone(bool detected, uint16_t freq, uint8_t dB) {
-    PureTonePayload* payload = (PureTonePayload*)tx_packet.payload;
     buildHeader(PKT_PURE_TONE, sizeof(PureTonePayload));
+    PureTonePayload* payload = (PureTonePayload*)tx_packet->payload;
 
     payload->timestamp = millis();
     payload->tone_detected = detected ? 1 : 0;
@@ -123,8 +403,8 @@ bool MarvSPIComm::sendPureTone(bool detected, uint16_t freq, uint8_t dB) {
 bool MarvSPIComm::sendSensorColors(Color s1, Color s2, Color s3) {
     // Debug removed to reduce serial spam
 
-    SensorColorsPayload* payload = (SensorColorsPayload*)tx_packet.payload;
     buildHeader(PKT_SENSOR_COLORS, sizeof(SensorColorsPayload));
+    SensorColorsPayload* payload = (SensorColorsPayload*)tx_packet->payload;
 
     payload->timestamp = millis();
     payload->sensor1_color = (uint8_t)s1;
@@ -137,8 +417,8 @@ bool MarvSPIComm::sendSensorColors(Color s1, Color s2, Color s3) {
 
 bool MarvSPIComm::sendIncidenceAngle(uint16_t angle, uint8_t first_sensor,
                                    uint8_t second_sensor, uint8_t sensors_mask) {
-    IncidenceAnglePayload* payload = (IncidenceAnglePayload*)tx_packet.payload;
     buildHeader(PKT_INCIDENCE_ANGLE, sizeof(IncidenceAnglePayload));
+    IncidenceAnglePayload* payload = (IncidenceAnglePayload*)tx_packet->payload;
 
     payload->timestamp = millis();
     payload->angle = angle;
@@ -152,7 +432,7 @@ bool MarvSPIComm::sendIncidenceAngle(uint16_t angle, uint8_t first_sensor,
 
 bool MarvSPIComm::sendEndOfMaze() {
     buildHeader(PKT_END_OF_MAZE, 4);
-    uint32_t* timestamp = (uint32_t*)tx_packet.payload;
+    uint32_t* timestamp = (uint32_t*)tx_packet->payload;
     *timestamp = millis();
 
     return sendPacket();
@@ -163,8 +443,8 @@ bool MarvSPIComm::sendEndOfMaze() {
 // ============================================================================
 
 bool MarvSPIComm::sendWheelSpeeds(uint8_t vR, uint8_t vL, uint8_t setpoint) {
-    WheelSpeedsPayload* payload = (WheelSpeedsPayload*)tx_packet.payload;
     buildHeader(PKT_WHEEL_SPEEDS, sizeof(WheelSpeedsPayload));
+    WheelSpeedsPayload* payload = (WheelSpeedsPayload*)tx_packet->payload;
 
     payload->timestamp = millis();
     payload->vR = vR;
@@ -176,8 +456,8 @@ bool MarvSPIComm::sendWheelSpeeds(uint8_t vR, uint8_t vL, uint8_t setpoint) {
 }
 
 bool MarvSPIComm::sendDistance(uint16_t distance_mm) {
-    DistancePayload* payload = (DistancePayload*)tx_packet.payload;
     buildHeader(PKT_DISTANCE, sizeof(DistancePayload));
+    DistancePayload* payload = (DistancePayload*)tx_packet->payload;
 
     payload->timestamp = millis();
     payload->distance_mm = distance_mm;
@@ -187,8 +467,8 @@ bool MarvSPIComm::sendDistance(uint16_t distance_mm) {
 }
 
 bool MarvSPIComm::sendRotationAngle(uint16_t angle, uint8_t direction) {
-    RotationAnglePayload* payload = (RotationAnglePayload*)tx_packet.payload;
     buildHeader(PKT_ROTATION_ANGLE, sizeof(RotationAnglePayload));
+    RotationAnglePayload* payload = (RotationAnglePayload*)tx_packet->payload;
 
     payload->timestamp = millis();
     payload->angle = angle;
@@ -204,8 +484,8 @@ bool MarvSPIComm::sendRotationAngle(uint16_t angle, uint8_t direction) {
 
 bool MarvSPIComm::sendLineDetection(Color color, uint8_t sensor, uint16_t angle,
                                    LineType line_type) {
-    LineDetectionPayload* payload = (LineDetectionPayload*)tx_packet.payload;
     buildHeader(PKT_LINE_DETECTION, sizeof(LineDetectionPayload));
+    LineDetectionPayload* payload = (LineDetectionPayload*)tx_packet->payload;
 
     payload->timestamp = millis();
     payload->color = (uint8_t)color;
@@ -219,8 +499,8 @@ bool MarvSPIComm::sendLineDetection(Color color, uint8_t sensor, uint16_t angle,
 
 bool MarvSPIComm::sendNavconState(NavconState old_state, NavconState new_state,
                                  const char* reason) {
-    NavconStatePayload* payload = (NavconStatePayload*)tx_packet.payload;
     buildHeader(PKT_NAVCON_STATE, sizeof(NavconStatePayload));
+    NavconStatePayload* payload = (NavconStatePayload*)tx_packet->payload;
 
     payload->timestamp = millis();
     payload->old_state = (uint8_t)old_state;
@@ -235,8 +515,8 @@ bool MarvSPIComm::sendNavconState(NavconState old_state, NavconState new_state,
 
 bool MarvSPIComm::sendRotationCommand(uint16_t target_angle, uint8_t direction,
                                     uint16_t original_angle, uint16_t corrections) {
-    RotationCommandPayload* payload = (RotationCommandPayload*)tx_packet.payload;
     buildHeader(PKT_ROTATION_COMMAND, sizeof(RotationCommandPayload));
+    RotationCommandPayload* payload = (RotationCommandPayload*)tx_packet->payload;
 
     payload->timestamp = millis();
     payload->target_angle = target_angle;
@@ -249,8 +529,8 @@ bool MarvSPIComm::sendRotationCommand(uint16_t target_angle, uint8_t direction,
 }
 
 bool MarvSPIComm::sendRotationFeedback(uint16_t actual, uint16_t target) {
-    RotationFeedbackPayload* payload = (RotationFeedbackPayload*)tx_packet.payload;
     buildHeader(PKT_ROTATION_FEEDBACK, sizeof(RotationFeedbackPayload));
+    RotationFeedbackPayload* payload = (RotationFeedbackPayload*)tx_packet->payload;
 
     payload->timestamp = millis();
     payload->actual_angle = actual;
@@ -263,8 +543,8 @@ bool MarvSPIComm::sendRotationFeedback(uint16_t actual, uint16_t target) {
 
 bool MarvSPIComm::sendAngleEvaluation(uint16_t original, uint16_t remaining,
                                      bool will_cross, uint8_t corrections, uint16_t threshold) {
-    AngleEvaluationPayload* payload = (AngleEvaluationPayload*)tx_packet.payload;
     buildHeader(PKT_ANGLE_EVALUATION, sizeof(AngleEvaluationPayload));
+    AngleEvaluationPayload* payload = (AngleEvaluationPayload*)tx_packet->payload;
 
     payload->timestamp = millis();
     payload->original_angle = original;
@@ -276,13 +556,27 @@ bool MarvSPIComm::sendAngleEvaluation(uint16_t original, uint16_t remaining,
     return sendPacket();
 }
 
+bool MarvSPIComm::sendPose(const PosePayload& pose) {
+    buildHeader(PKT_POSE, sizeof(PosePayload));
+    memcpy(tx_packet->payload, &pose, sizeof(PosePayload));
+
+    return sendPacket();
+}
+
+bool MarvSPIComm::sendMapLine(const MapLinePayload& line) {
+    buildHeader(PKT_MAP_LINE, sizeof(MapLinePayload));
+    memcpy(tx_packet->payload, &line, sizeof(MapLinePayload));
+
+    return sendPacket();
+}
+
 // ============================================================================
 // DEBUG FUNCTIONS
 // ============================================================================
 
 bool MarvSPIComm::sendDebug(uint8_t severity, const char* message) {
-    DebugMessagePayload* payload = (DebugMessagePayload*)tx_packet.payload;
     buildHeader(PKT_DEBUG_MESSAGE, sizeof(DebugMessagePayload));
+    DebugMessagePayload* payload = (DebugMessagePayload*)tx_packet->payload;
 
     payload->timestamp = millis();
     payload->severity = severity;
@@ -295,12 +589,27 @@ bool MarvSPIComm::sendDebug(uint8_t severity, const char* message) {
 
 bool MarvSPIComm::sendHeartbeat() {
     buildHeader(PKT_HEARTBEAT, 4);
-    uint32_t* uptime = (uint32_t*)tx_packet.payload;
+    uint32_t* uptime = (uint32_t*)tx_packet->payload;
     *uptime = millis();
 
     return sendPacket();
 }
 
+bool MarvSPIComm::sendLatencyStats(const LatencyStatsPayload& stats) {
+    buildHeader(PKT_LATENCY_STATS, sizeof(LatencyStatsPayload));
+    memcpy(tx_packet->payload, &stats, sizeof(LatencyStatsPayload));
+
+    return sendPacket();
+}
+
+bool MarvSPIComm::sendFlightLog(const FlightLogChunkPayload& chunk, uint8_t data_bytes) {
+    uint8_t length = offsetof(FlightLogChunkPayload, data) + data_bytes;
+    buildHeader(PKT_FLIGHT_LOG, length);
+    memcpy(tx_packet->payload, &chunk, length);
+
+    return sendPacket();
+}
+
 // ============================================================================
 // PERFORMANCE MONITORING
 // ============================================================================
@@ -308,7 +617,14 @@ bool MarvSPIComm::sendHeartbeat() {
 void MarvSPIComm::printPerformanceStats() {
     Serial.println("\n--- SPI Communication Performance ---");
     Serial.printf("Total packets sent: %lu\n", packets_sent);
+    Serial.printf("Total bytes clocked: %lu\n", bytes_sent);
+    Serial.printf("Transfer mode: %s\n", dma_enabled ? "DMA double-buffered" : "blocking");
+    Serial.printf("Completed: %lu, Dropped (queue full): %lu, Max in flight: %d\n",
+                  packets_completed, packets_dropped, max_in_flight);
+    Serial.printf("Framing: %s\n", varlen_mode ? "VARLEN (length-prefixed)" : "FIXED (257 bytes)");
     Serial.printf("Current sequence: %d\n", sequence_counter);
+    Serial.printf("Dashboard commands: %lu received, %lu repeats (last seq %u)\n",
+                  commands_received, command_repeats, last_command_seq);
     Serial.printf("SPI Speed: 2MHz\n");
     Serial.println("--------------------------------------\n");
 }
\ No newline at end of file
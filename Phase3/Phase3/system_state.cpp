@@ -1,5 +1,14 @@
 #include "system_state.h"
 #include "navcon_core.h"
+#include "spi_protocol.h"
+#include "debug_log.h"
+#include "latency_trace.h"
+#include "flight_recorder.h"
+#include "navcon_bench.h"
+#include "tone_detector.h"
+#include "maze_map.h"
+#include "maze_route.h"
+#include "pc_profiler.h"
 
 // ==================== GLOBAL SYSTEM STATUS ====================
 SystemStatus systemStatus = {
@@ -16,7 +25,7 @@ SystemStatus systemStatus = {
     false,           // justSentPureToneDetection
     false,           // needsIdlePacket
     0,               // unexpectedPacketCount
-    0,               // gpioCommandCount
+    0,               // wifiCommandCount
     "",              // lastSSPacket
     "",              // lastMDPSPacket
     "",              // lastSNCPacket
@@ -32,8 +41,16 @@ void initializeSystemState() {
     systemStatus.currentSystemState = SYS_IDLE;
     systemStatus.lastTransitionTime = 0;
     updateNextExpectedState();
+    systemStatus.touchDetected = false;
+    systemStatus.pureToneDetected = false;
+    systemStatus.manualSendTrigger = false;
+    systemStatus.waitingForSecondTouch = false;
+    systemStatus.justSentPureToneDetection = false;
     systemStatus.eomLatched = false;
     systemStatus.needsIdlePacket = false;
+    systemStatus.unexpectedPacketCount = 0;
+    lastAutoSend = 0;
+    idleSentOnce = false;
     Serial.println("System State Manager Initialized");
 }
 
@@ -77,276 +94,325 @@ void updateNextExpectedState() {
     }
 }
 
-void updateNextExpectedBasedOnLastPacket(const SCSPacket& lastPacket) {
-    SystemState packetSysState = getSystemState(lastPacket.control);
-    SubsystemID packetSubsystem = getSubsystemID(lastPacket.control);
-    uint8_t packetIST = getInternalState(lastPacket.control);
-    
-    Serial.printf("Updating next expected based on: [%s:%s:IST%d]\n",
-                  systemStateToString(packetSysState),
-                  subsystemToString(packetSubsystem),
-                  packetIST);
-    
-    // IDLE State Logic
-    if (packetSysState == SYS_IDLE && packetSubsystem == SUB_SNC && packetIST == 0) {
-        if (lastPacket.dat1 == 1) {
-            systemStatus.nextExpectedSystemState = SYS_CAL;
-            systemStatus.nextExpectedSubsystem = SUB_SS;
-            systemStatus.nextExpectedIST = 0;
-            systemStatus.nextExpectedDescription = "SS End of Calibration";
-        } else {
-            systemStatus.nextExpectedSystemState = SYS_IDLE;
-            systemStatus.nextExpectedSubsystem = SUB_SNC;
-            systemStatus.nextExpectedIST = 0;
-            systemStatus.nextExpectedDescription = "Touch Detection (to start calibration)";
-        }
-    }
-    // CAL State Logic
-    else if (packetSysState == SYS_CAL) {
-        if (packetSubsystem == SUB_SS && packetIST == 0) {
-            systemStatus.nextExpectedSystemState = SYS_CAL;
-            systemStatus.nextExpectedSubsystem = SUB_MDPS;
-            systemStatus.nextExpectedIST = 0;
-            systemStatus.nextExpectedDescription = "MDPS vop Calibration";
-            systemStatus.waitingForSecondTouch = false;
-        }
-        else if (packetSubsystem == SUB_MDPS && packetIST == 0) {
-            systemStatus.nextExpectedSystemState = SYS_CAL;
-            systemStatus.nextExpectedSubsystem = SUB_MDPS;
-            systemStatus.nextExpectedIST = 1;
-            systemStatus.nextExpectedDescription = "MDPS Battery Level";
-        }
-        else if (packetSubsystem == SUB_MDPS && packetIST == 1) {
-            systemStatus.nextExpectedSystemState = SYS_CAL;
-            systemStatus.nextExpectedSubsystem = SUB_SS;
-            systemStatus.nextExpectedIST = 1;
-            systemStatus.nextExpectedDescription = "SS Colors (CAL)";
-            systemStatus.waitingForSecondTouch = true;
-        }
-        else if (packetSubsystem == SUB_SS && packetIST == 1) {
-            systemStatus.nextExpectedSystemState = SYS_CAL;
-            systemStatus.nextExpectedSubsystem = SUB_SNC;
-            systemStatus.nextExpectedIST = 0;
-            systemStatus.nextExpectedDescription = "Touch Detection (2nd touch to enter MAZE)";
-        }
-        else if (packetSubsystem == SUB_SNC && packetIST == 0) {
-            if (lastPacket.dat1 == 1) {
-                systemStatus.nextExpectedSystemState = SYS_MAZE;
-                systemStatus.nextExpectedSubsystem = SUB_SNC;
-                systemStatus.nextExpectedIST = 1;
-                systemStatus.nextExpectedDescription = "Pure Tone Detection (MAZE)";
-            } else {
-                systemStatus.nextExpectedSystemState = SYS_CAL;
-                systemStatus.nextExpectedSubsystem = SUB_MDPS;
-                systemStatus.nextExpectedIST = 1;
-                systemStatus.nextExpectedDescription = "MDPS Battery Level (loop)";
-            }
-        }
-    }
-    // MAZE State Logic  
-    else if (packetSysState == SYS_MAZE) {
-        if (packetSubsystem == SUB_SNC && packetIST == 1) {
-            if (lastPacket.dat1 == 1) {
-                systemStatus.justSentPureToneDetection = true;
-                systemStatus.nextExpectedSystemState = SYS_SOS;
-                systemStatus.nextExpectedSubsystem = SUB_MDPS;
-                systemStatus.nextExpectedIST = 4;
-                systemStatus.nextExpectedDescription = "MDPS Pure Tone Response (stop motors)";
-            } else {
-                systemStatus.justSentPureToneDetection = false;
-                systemStatus.nextExpectedSystemState = SYS_MAZE;
-                systemStatus.nextExpectedSubsystem = SUB_SNC;
-                systemStatus.nextExpectedIST = 2;
-                systemStatus.nextExpectedDescription = "Touch Detection (MAZE)";
-            }
-        }
-        else if (packetSubsystem == SUB_SNC && packetIST == 2) {
-            systemStatus.justSentPureToneDetection = false;
-            if (lastPacket.dat1 == 1) {
-                systemStatus.nextExpectedSystemState = SYS_IDLE;
-                systemStatus.nextExpectedSubsystem = SUB_SNC;
-                systemStatus.nextExpectedIST = 0;
-                systemStatus.nextExpectedDescription = "Touch Detection (IDLE after manual exit)";
-            } else {
-                systemStatus.nextExpectedSystemState = SYS_MAZE;
-                systemStatus.nextExpectedSubsystem = SUB_SNC;
-                systemStatus.nextExpectedIST = 3;
-                systemStatus.nextExpectedDescription = "Navigation Control (NAVCON)";
-            }
-        }
-        else if (packetSubsystem == SUB_SNC && packetIST == 3) {
-            systemStatus.justSentPureToneDetection = false;
-            systemStatus.nextExpectedSystemState = SYS_MAZE;
-            systemStatus.nextExpectedSubsystem = SUB_MDPS;
-            systemStatus.nextExpectedIST = 1;
-            systemStatus.nextExpectedDescription = "MDPS Battery/Level (MAZE)";
-        }
-        else if (packetSubsystem == SUB_MDPS && packetIST == 1) {
-            systemStatus.justSentPureToneDetection = false;
-            systemStatus.nextExpectedSystemState = SYS_MAZE;
-            systemStatus.nextExpectedSubsystem = SUB_MDPS;
-            systemStatus.nextExpectedIST = 2;
-            systemStatus.nextExpectedDescription = "MDPS Rotation (MAZE)";
-        }
-        else if (packetSubsystem == SUB_MDPS && packetIST == 2) {
-            systemStatus.justSentPureToneDetection = false;
-            systemStatus.nextExpectedSystemState = SYS_MAZE;
-            systemStatus.nextExpectedSubsystem = SUB_MDPS;
-            systemStatus.nextExpectedIST = 3;
-            systemStatus.nextExpectedDescription = "MDPS Speed (MAZE)";
-        }
-        else if (packetSubsystem == SUB_MDPS && packetIST == 3) {
-            systemStatus.justSentPureToneDetection = false;
-            systemStatus.nextExpectedSystemState = SYS_MAZE;
-            systemStatus.nextExpectedSubsystem = SUB_MDPS;
-            systemStatus.nextExpectedIST = 4;
-            systemStatus.nextExpectedDescription = "MDPS Distance (MAZE)";
-        }
-        else if (packetSubsystem == SUB_MDPS && packetIST == 4) {
-            if (systemStatus.justSentPureToneDetection) {
-                systemStatus.justSentPureToneDetection = false;
-                systemStatus.nextExpectedSystemState = SYS_SOS;
-                systemStatus.nextExpectedSubsystem = SUB_SNC;
-                systemStatus.nextExpectedIST = 0;
-                systemStatus.nextExpectedDescription = "Pure Tone Detection (to exit SOS)";
-            } else {
-                systemStatus.nextExpectedSystemState = SYS_MAZE;
-                systemStatus.nextExpectedSubsystem = SUB_SS;
-                systemStatus.nextExpectedIST = 1;
-                systemStatus.nextExpectedDescription = "SS Colors (MAZE) or SS End-of-Maze";
-            }
-        }
-        else if (packetSubsystem == SUB_SS && packetIST == 1) {
-            systemStatus.justSentPureToneDetection = false;
-            systemStatus.nextExpectedSystemState = SYS_MAZE;
-            systemStatus.nextExpectedSubsystem = SUB_SS;
-            systemStatus.nextExpectedIST = 2;
-            systemStatus.nextExpectedDescription = "SS Incidence Angle";
-        }
-        else if (packetSubsystem == SUB_SS && packetIST == 2) {
-            systemStatus.justSentPureToneDetection = false;
-            systemStatus.nextExpectedSystemState = SYS_MAZE;
-            systemStatus.nextExpectedSubsystem = SUB_SNC;
-            systemStatus.nextExpectedIST = 1;
-            systemStatus.nextExpectedDescription = "Pure Tone Detection (loop)";
-        }
-        else if (packetSubsystem == SUB_SS && packetIST == 3) {
-            systemStatus.justSentPureToneDetection = false;
-            systemStatus.nextExpectedSystemState = SYS_IDLE;
-            systemStatus.nextExpectedSubsystem = SUB_SNC;
-            systemStatus.nextExpectedIST = 0;
-            systemStatus.nextExpectedDescription = "Touch Detection (IDLE after maze completion)";
-        }
+// ==================== SNC FRAME GENERATORS ====================
+// One per SNC frame the SNC sends; the rule table below picks the generator
+// for the expected control byte, so generateSNCPacket() is a single lookup.
+static SCSPacket generateIdleTouch() {
+    SCSPacket packet(createControlByte(SYS_IDLE, SUB_SNC, 0), systemStatus.touchDetected ? 1 : 0, 50, 0);
+    systemStatus.touchDetected = false;
+    // Clear needsIdlePacket flag after sending
+    if (systemStatus.needsIdlePacket) {
+        systemStatus.needsIdlePacket = false;
+        Serial.println("  -> Sent IDLE:SNC:IST0 packet after MAZE→IDLE transition");
     }
-    // SOS State Logic
-    else if (packetSysState == SYS_SOS) {
-        if (packetSubsystem == SUB_MDPS && packetIST == 4) {
-            systemStatus.nextExpectedSystemState = SYS_SOS;
-            systemStatus.nextExpectedSubsystem = SUB_SNC;
-            systemStatus.nextExpectedIST = 0;
-            systemStatus.nextExpectedDescription = "Pure Tone Detection (to exit SOS)";
-        }
-        else if (packetSubsystem == SUB_SNC && packetIST == 0) {
-            if (lastPacket.dat1 == 1) {
-                systemStatus.nextExpectedSystemState = SYS_MAZE;
-                systemStatus.nextExpectedSubsystem = SUB_SNC;
-                systemStatus.nextExpectedIST = 1;
-                systemStatus.nextExpectedDescription = "Pure Tone Detection (MAZE after SOS exit)";
-            } else {
-                systemStatus.nextExpectedSystemState = SYS_SOS;
-                systemStatus.nextExpectedSubsystem = SUB_SNC;
-                systemStatus.nextExpectedIST = 0;
-                systemStatus.nextExpectedDescription = "Pure Tone Detection (continue waiting in SOS)";
-            }
-        }
+    return packet;
+}
+
+static SCSPacket generateCalTouch() {
+    SCSPacket packet(createControlByte(SYS_CAL, SUB_SNC, 0), systemStatus.touchDetected ? 1 : 0, 0, 0);
+    systemStatus.touchDetected = false;
+    return packet;
+}
+
+static SCSPacket generateMazeTone() {
+    SCSPacket packet(createControlByte(SYS_MAZE, SUB_SNC, 1), systemStatus.pureToneDetected ? 1 : 0, 0, 0);
+    if (systemStatus.pureToneDetected) {
+        systemStatus.justSentPureToneDetection = true;
+        systemStatus.pureToneDetected = false;
+        Serial.println("SNC: Setting pure tone flag - next MDPS IST4 will be SOS response");
     }
-    
-    Serial.printf("Next expected: [%s:%s:IST%d] - %s\n",
-                  systemStateToString(systemStatus.nextExpectedSystemState),
-                  subsystemToString(systemStatus.nextExpectedSubsystem),
-                  systemStatus.nextExpectedIST,
-                  systemStatus.nextExpectedDescription.c_str());
+    return packet;
+}
+
+static SCSPacket generateMazeTouch() {
+    SCSPacket packet(createControlByte(SYS_MAZE, SUB_SNC, 2), systemStatus.touchDetected ? 1 : 0, 0, 0);
+    systemStatus.touchDetected = false;
+    return packet;
+}
+
+static SCSPacket generateNavcon() {
+    // THIS IS WHERE NAVCON IS CALLED
+    LOG(NAVCON, DEBUG, "NAVCON CALLED: Running enhanced navigation logic");
+    SCSPacket navconPacket = runEnhancedNavcon();
+    traceMark(TRACE_DECISION);
+    return navconPacket;
+}
+
+static SCSPacket generateSOSTone() {
+    SCSPacket packet(createControlByte(SYS_SOS, SUB_SNC, 0), systemStatus.pureToneDetected ? 1 : 0, 0, 0);
+    systemStatus.pureToneDetected = false;
+    return packet;
+}
+
+// ==================== SCS RULE TABLE ====================
+// One rule per control byte (SYS<1:0> | SUB<1:0> | IST<3:0>), built at compile
+// time like the MDPS dispatch table. A rule picks one of two branches on DAT1
+// or on the pure-tone flag; the branch names the next expected frame and, for
+// the frames that change state, the state entered. Control bytes without a
+// rule change nothing.
+typedef SCSPacket (*SNCGenerator)();
+
+#define SCS_NONE   0xFF    // No next frame / no alternative
+#define SCS_STAY   0xFF    // No state transition
+
+enum SCSCondition : uint8_t {
+    SCS_WHEN_ALWAYS = 0,   // branch[0]
+    SCS_WHEN_DAT1,         // branch[DAT1 == 1]
+    SCS_WHEN_TONE_SENT     // branch[justSentPureToneDetection]
+};
+
+// Expectation effects (skipped for stale MAZE frames after SOS)
+#define SCS_FX_TONE_SET      0x01
+#define SCS_FX_TONE_CLEAR    0x02
+#define SCS_FX_SECOND_TOUCH  0x04    // waitingForSecondTouch = true
+#define SCS_FX_FIRST_TOUCH   0x08    // waitingForSecondTouch = false
+// Transition effects
+#define SCS_FX_NAVCON_RESET  0x10
+#define SCS_FX_EOM_CLEAR     0x20
+#define SCS_FX_EOM_LATCH     0x40
+#define SCS_FX_NEEDS_IDLE    0x80
+#define SCS_FX_MAP_RESET     0x100   // New run: pose origin and empty map
+
+struct SCSBranch {
+    uint8_t next;              // Next expected control byte (SCS_NONE: unchanged)
+    uint8_t also;              // Frame accepted in its place (SS end of maze for SS colours)
+    uint8_t enter;             // State entered (SCS_STAY: none)
+    uint16_t effects;          // SCS_FX_*
+    const char* expect;        // nextExpectedDescription
+    const char* transition;    // Logged on entering the state
+};
+
+struct SCSRule {
+    uint8_t when;              // SCSCondition
+    SCSBranch branch[2];
+    SNCGenerator generate;     // Builds this frame (SNC frames only)
+};
+
+#define SCS_GO(next, fx, expect)  { next, SCS_NONE, SCS_STAY, fx, expect, nullptr }
+#define SCS_NO_BRANCH             { SCS_NONE, SCS_NONE, SCS_STAY, 0, nullptr, nullptr }
+
+constexpr uint8_t SCS_IDLE_SNC0 = scsControlByte(SYS_IDLE, SUB_SNC, 0);
+constexpr uint8_t SCS_CAL_SS0   = scsControlByte(SYS_CAL,  SUB_SS,   0);
+constexpr uint8_t SCS_CAL_SS1   = scsControlByte(SYS_CAL,  SUB_SS,   1);
+constexpr uint8_t SCS_CAL_MDPS0 = scsControlByte(SYS_CAL,  SUB_MDPS, 0);
+constexpr uint8_t SCS_CAL_MDPS1 = scsControlByte(SYS_CAL,  SUB_MDPS, 1);
+constexpr uint8_t SCS_CAL_SNC0  = scsControlByte(SYS_CAL,  SUB_SNC,  0);
+constexpr uint8_t SCS_MAZE_SNC1 = scsControlByte(SYS_MAZE, SUB_SNC,  1);
+constexpr uint8_t SCS_MAZE_SNC2 = scsControlByte(SYS_MAZE, SUB_SNC,  2);
+constexpr uint8_t SCS_MAZE_SNC3 = scsControlByte(SYS_MAZE, SUB_SNC,  3);
+constexpr uint8_t SCS_MAZE_MDPS1 = scsControlByte(SYS_MAZE, SUB_MDPS, 1);
+constexpr uint8_t SCS_MAZE_MDPS2 = scsControlByte(SYS_MAZE, SUB_MDPS, 2);
+constexpr uint8_t SCS_MAZE_MDPS3 = scsControlByte(SYS_MAZE, SUB_MDPS, 3);
+constexpr uint8_t SCS_MAZE_MDPS4 = scsControlByte(SYS_MAZE, SUB_MDPS, 4);
+constexpr uint8_t SCS_MAZE_SS1  = scsControlByte(SYS_MAZE, SUB_SS,   1);
+constexpr uint8_t SCS_MAZE_SS2  = scsControlByte(SYS_MAZE, SUB_SS,   2);
+constexpr uint8_t SCS_MAZE_SS3  = scsControlByte(SYS_MAZE, SUB_SS,   3);
+constexpr uint8_t SCS_SOS_MDPS4 = scsControlByte(SYS_SOS,  SUB_MDPS, 4);
+constexpr uint8_t SCS_SOS_SNC0  = scsControlByte(SYS_SOS,  SUB_SNC,  0);
+
+constexpr SCSRule scsRuleFor(uint8_t control) {
+    return
+    // IDLE: first touch starts calibration
+    (control == SCS_IDLE_SNC0) ? SCSRule{ SCS_WHEN_DAT1, {
+        SCS_GO(SCS_IDLE_SNC0, 0, "Touch Detection (to start calibration)"),
+        { SCS_CAL_SS0, SCS_NONE, SYS_CAL, SCS_FX_FIRST_TOUCH | SCS_FX_EOM_CLEAR | SCS_FX_NAVCON_RESET,
+          "SS End of Calibration", "STATE TRANSITION: IDLE → CAL (First touch detected)" } }, generateIdleTouch } :
+    // CAL
+    (control == SCS_CAL_SS0) ? SCSRule{ SCS_WHEN_ALWAYS, {
+        SCS_GO(SCS_CAL_MDPS0, SCS_FX_FIRST_TOUCH, "MDPS vop Calibration"), SCS_NO_BRANCH }, nullptr } :
+    (control == SCS_CAL_MDPS0) ? SCSRule{ SCS_WHEN_ALWAYS, {
+        SCS_GO(SCS_CAL_MDPS1, 0, "MDPS Battery Level"), SCS_NO_BRANCH }, nullptr } :
+    (control == SCS_CAL_MDPS1) ? SCSRule{ SCS_WHEN_ALWAYS, {
+        SCS_GO(SCS_CAL_SS1, SCS_FX_SECOND_TOUCH, "SS Colors (CAL)"), SCS_NO_BRANCH }, nullptr } :
+    (control == SCS_CAL_SS1) ? SCSRule{ SCS_WHEN_ALWAYS, {
+        SCS_GO(SCS_CAL_SNC0, 0, "Touch Detection (2nd touch to enter MAZE)"), SCS_NO_BRANCH }, nullptr } :
+    (control == SCS_CAL_SNC0) ? SCSRule{ SCS_WHEN_DAT1, {
+        SCS_GO(SCS_CAL_MDPS1, 0, "MDPS Battery Level (loop)"),
+        { SCS_MAZE_SNC1, SCS_NONE, SYS_MAZE, SCS_FX_NAVCON_RESET | SCS_FX_MAP_RESET,
+          "Pure Tone Detection (MAZE)", "STATE TRANSITION: CAL → MAZE (Second touch detected)" } }, generateCalTouch } :
+    // MAZE: SNC turn
+    (control == SCS_MAZE_SNC1) ? SCSRule{ SCS_WHEN_DAT1, {
+        SCS_GO(SCS_MAZE_SNC2, SCS_FX_TONE_CLEAR, "Touch Detection (MAZE)"),
+        { SCS_SOS_MDPS4, SCS_NONE, SYS_SOS, SCS_FX_TONE_SET,
+          "MDPS Pure Tone Response (stop motors)", "STATE TRANSITION: MAZE → SOS (Pure tone detected)" } }, generateMazeTone } :
+    (control == SCS_MAZE_SNC2) ? SCSRule{ SCS_WHEN_DAT1, {
+        SCS_GO(SCS_MAZE_SNC3, SCS_FX_TONE_CLEAR, "Navigation Control (NAVCON)"),
+        { SCS_IDLE_SNC0, SCS_NONE, SYS_IDLE, SCS_FX_TONE_CLEAR | SCS_FX_NEEDS_IDLE,
+          "Touch Detection (IDLE after manual exit)", "STATE TRANSITION: MAZE → IDLE (Touch detected in MAZE)" } }, generateMazeTouch } :
+    (control == SCS_MAZE_SNC3) ? SCSRule{ SCS_WHEN_ALWAYS, {
+        SCS_GO(SCS_MAZE_MDPS1, SCS_FX_TONE_CLEAR, "MDPS Battery/Level (MAZE)"), SCS_NO_BRANCH }, generateNavcon } :
+    // MAZE: MDPS turn, which answers the pure tone instead when one was sent
+    (control == SCS_MAZE_MDPS1) ? SCSRule{ SCS_WHEN_ALWAYS, {
+        SCS_GO(SCS_MAZE_MDPS2, SCS_FX_TONE_CLEAR, "MDPS Rotation (MAZE)"), SCS_NO_BRANCH }, nullptr } :
+    (control == SCS_MAZE_MDPS2) ? SCSRule{ SCS_WHEN_ALWAYS, {
+        SCS_GO(SCS_MAZE_MDPS3, SCS_FX_TONE_CLEAR, "MDPS Speed (MAZE)"), SCS_NO_BRANCH }, nullptr } :
+    (control == SCS_MAZE_MDPS3) ? SCSRule{ SCS_WHEN_ALWAYS, {
+        SCS_GO(SCS_MAZE_MDPS4, SCS_FX_TONE_CLEAR, "MDPS Distance (MAZE)"), SCS_NO_BRANCH }, nullptr } :
+    (control == SCS_MAZE_MDPS4) ? SCSRule{ SCS_WHEN_TONE_SENT, {
+        { SCS_MAZE_SS1, SCS_MAZE_SS3, SCS_STAY, 0, "SS Colors (MAZE) or SS End-of-Maze", nullptr },
+        SCS_GO(SCS_SOS_SNC0, SCS_FX_TONE_CLEAR, "Pure Tone Detection (to exit SOS)") }, nullptr } :
+    // MAZE: SS turn, or end of maze
+    (control == SCS_MAZE_SS1) ? SCSRule{ SCS_WHEN_ALWAYS, {
+        SCS_GO(SCS_MAZE_SS2, SCS_FX_TONE_CLEAR, "SS Incidence Angle"), SCS_NO_BRANCH }, nullptr } :
+    (control == SCS_MAZE_SS2) ? SCSRule{ SCS_WHEN_ALWAYS, {
+        SCS_GO(SCS_MAZE_SNC1, SCS_FX_TONE_CLEAR, "Pure Tone Detection (loop)"), SCS_NO_BRANCH }, nullptr } :
+    (control == SCS_MAZE_SS3) ? SCSRule{ SCS_WHEN_ALWAYS, {
+        { SCS_IDLE_SNC0, SCS_NONE, SYS_IDLE, SCS_FX_TONE_CLEAR | SCS_FX_EOM_LATCH | SCS_FX_NAVCON_RESET,
+          "Touch Detection (IDLE after maze completion)", "STATE TRANSITION: MAZE → IDLE (End of maze detected)" },
+        SCS_NO_BRANCH }, nullptr } :
+    // SOS: a second pure tone returns to MAZE
+    (control == SCS_SOS_MDPS4) ? SCSRule{ SCS_WHEN_ALWAYS, {
+        SCS_GO(SCS_SOS_SNC0, 0, "Pure Tone Detection (to exit SOS)"), SCS_NO_BRANCH }, nullptr } :
+    (control == SCS_SOS_SNC0) ? SCSRule{ SCS_WHEN_DAT1, {
+        SCS_GO(SCS_SOS_SNC0, 0, "Pure Tone Detection (continue waiting in SOS)"),
+        { SCS_MAZE_SNC1, SCS_NONE, SYS_MAZE, 0,
+          "Pure Tone Detection (MAZE after SOS exit)", "STATE TRANSITION: SOS → MAZE (Pure tone detected)" } }, generateSOSTone } :
+    // Everything else
+    SCSRule{ SCS_WHEN_ALWAYS, { SCS_NO_BRANCH, SCS_NO_BRANCH }, nullptr };
 }
 
+#define SCS_RULES_4(n)   scsRuleFor(n), scsRuleFor(n + 1), scsRuleFor(n + 2), scsRuleFor(n + 3)
+#define SCS_RULES_16(n)  SCS_RULES_4(n), SCS_RULES_4(n + 4), SCS_RULES_4(n + 8), SCS_RULES_4(n + 12)
+#define SCS_RULES_64(n)  SCS_RULES_16(n), SCS_RULES_16(n + 16), SCS_RULES_16(n + 32), SCS_RULES_16(n + 48)
+
+static constexpr SCSRule scsRules[256] = {
+    SCS_RULES_64(0), SCS_RULES_64(64), SCS_RULES_64(128), SCS_RULES_64(192)
+};
+
+constexpr const SCSBranch& scsBranchTaken(const SCSRule& rule, uint8_t dat1, bool toneSent) {
+    return rule.branch[rule.when == SCS_WHEN_DAT1      ? (dat1 == 1 ? 1 : 0) :
+                       rule.when == SCS_WHEN_TONE_SENT ? (toneSent ? 1 : 0) : 0];
+}
+
+// ==================== QTP SEQUENCE CHECKS ====================
+// The QTP frame sequences, walked through the same table at compile time: each
+// frame must be the one the previous frame left expected, and every SNC frame
+// must have a generator. A table edit that breaks a QTP fails the build.
+struct QTPStep {
+    uint8_t control;
+    uint8_t dat1;
+};
+
+constexpr bool scsToneAfter(const SCSBranch& b, bool tone) {
+    return (b.effects & SCS_FX_TONE_SET) ? true : (b.effects & SCS_FX_TONE_CLEAR) ? false : tone;
+}
+
+constexpr bool scsStepValid(const QTPStep& s, uint8_t expected, uint8_t also, bool tone) {
+    return (s.control == expected || (also != SCS_NONE && s.control == also)) &&
+           scsBranchTaken(scsRules[s.control], s.dat1, tone).next != SCS_NONE &&
+           (((s.control >> 4) & 0x03) != SUB_SNC || scsRules[s.control].generate != nullptr);
+}
+
+constexpr bool scsSequenceValid(const QTPStep* s, int n, uint8_t expected, uint8_t also, bool tone) {
+    return n == 0 ||
+           (scsStepValid(s[0], expected, also, tone) &&
+            scsSequenceValid(s + 1, n - 1,
+                             scsBranchTaken(scsRules[s[0].control], s[0].dat1, tone).next,
+                             scsBranchTaken(scsRules[s[0].control], s[0].dat1, tone).also,
+                             scsToneAfter(scsBranchTaken(scsRules[s[0].control], s[0].dat1, tone), tone)));
+}
+
+#define QTP_SEQUENCE_VALID(steps, first) \
+    scsSequenceValid(steps, sizeof(steps) / sizeof(steps[0]), first, SCS_NONE, false)
+
+// QTP1: IDLE touch → CAL, one battery loop, second touch → MAZE
+static constexpr QTPStep qtpCalibration[] = {
+    { SCS_IDLE_SNC0, 0 }, { SCS_IDLE_SNC0, 1 }, { SCS_CAL_SS0, 0 }, { SCS_CAL_MDPS0, 0 },
+    { SCS_CAL_MDPS1, 0 }, { SCS_CAL_SS1, 0 }, { SCS_CAL_SNC0, 0 }, { SCS_CAL_MDPS1, 0 },
+    { SCS_CAL_SS1, 0 }, { SCS_CAL_SNC0, 1 }, { SCS_MAZE_SNC1, 0 }
+};
+// QTP2: two MAZE rounds
+static constexpr QTPStep qtpMazeRound[] = {
+    { SCS_MAZE_SNC1, 0 }, { SCS_MAZE_SNC2, 0 }, { SCS_MAZE_SNC3, 0 }, { SCS_MAZE_MDPS1, 0 },
+    { SCS_MAZE_MDPS2, 0 }, { SCS_MAZE_MDPS3, 0 }, { SCS_MAZE_MDPS4, 0 }, { SCS_MAZE_SS1, 0 },
+    { SCS_MAZE_SS2, 0 }, { SCS_MAZE_SNC1, 0 }, { SCS_MAZE_SNC2, 0 }, { SCS_MAZE_SNC3, 0 }
+};
+// QTP3: pure tone → SOS, wait, pure tone → MAZE
+static constexpr QTPStep qtpSOS[] = {
+    { SCS_MAZE_SNC1, 1 }, { SCS_SOS_MDPS4, 0 }, { SCS_SOS_SNC0, 0 }, { SCS_SOS_SNC0, 0 },
+    { SCS_SOS_SNC0, 1 }, { SCS_MAZE_SNC1, 0 }
+};
+// Touch in MAZE → IDLE
+static constexpr QTPStep qtpTouchExit[] = {
+    { SCS_MAZE_SNC1, 0 }, { SCS_MAZE_SNC2, 1 }, { SCS_IDLE_SNC0, 0 }
+};
+// End of maze in place of the SS colours → IDLE
+static constexpr QTPStep qtpEndOfMaze[] = {
+    { SCS_MAZE_MDPS4, 0 }, { SCS_MAZE_SS3, 0 }, { SCS_IDLE_SNC0, 0 }
+};
+
+static_assert(QTP_SEQUENCE_VALID(qtpCalibration, SCS_IDLE_SNC0), "SCS rule table breaks the calibration QTP");
+static_assert(QTP_SEQUENCE_VALID(qtpMazeRound, SCS_MAZE_SNC1), "SCS rule table breaks the MAZE round");
+static_assert(QTP_SEQUENCE_VALID(qtpSOS, SCS_MAZE_SNC1), "SCS rule table breaks the SOS QTP");
+static_assert(QTP_SEQUENCE_VALID(qtpTouchExit, SCS_MAZE_SNC1), "SCS rule table breaks the MAZE touch exit");
+static_assert(QTP_SEQUENCE_VALID(qtpEndOfMaze, SCS_MAZE_MDPS4), "SCS rule table breaks the end of maze");
+static_assert(!QTP_SEQUENCE_VALID(qtpEndOfMaze, SCS_MAZE_SS1), "QTP check accepts an unexpected frame");
+
 // ==================== STATE TRANSITION LOGIC ====================
-void processStateTransition(const SCSPacket& packet) {
-    SystemState packetSysState = getSystemState(packet.control);
-    SubsystemID packetSubsystem = getSubsystemID(packet.control);
-    uint8_t packetIST = getInternalState(packet.control);
-    
-    Serial.printf("Processing packet for state transition: [%s:%s:IST%d]\n",
-                  systemStateToString(packetSysState),
-                  subsystemToString(packetSubsystem),
-                  packetIST);
-    
-    // Update expectations first
-    updateNextExpectedBasedOnLastPacket(packet);
-    
-    // Check for actual state transitions
-    if (packetSubsystem == SUB_SNC && packetSysState == SYS_IDLE && packetIST == 0) {
-        if (packet.dat1 == 1) {
-            systemStatus.currentSystemState = SYS_CAL;
-            systemStatus.waitingForSecondTouch = false;
-            systemStatus.lastTransitionTime = millis();
-            systemStatus.eomLatched = false;  // Clear end-of-maze flag for new run
-            Serial.println("STATE TRANSITION: IDLE → CAL (First touch detected)");
-
-            // Reset NAVCON when entering CAL state
-            extern NavconStatus navcon_status;
-            navcon_status.reset();
-            Serial.println("NAVCON: Reset for CAL state");
-        }
+static void applyExpectation(const SCSBranch& branch) {
+    if (branch.next != SCS_NONE) {
+        systemStatus.nextExpectedSystemState = getSystemState(branch.next);
+        systemStatus.nextExpectedSubsystem = getSubsystemID(branch.next);
+        systemStatus.nextExpectedIST = getInternalState(branch.next);
+        systemStatus.nextExpectedDescription = branch.expect;
     }
-    else if (packetSubsystem == SUB_SNC && packetSysState == SYS_CAL && packetIST == 0) {
-        if (packet.dat1 == 1) {
-            systemStatus.currentSystemState = SYS_MAZE;
-            systemStatus.lastTransitionTime = millis();
-            Serial.println("STATE TRANSITION: CAL → MAZE (Second touch detected)");
-
-            // Reset NAVCON when entering MAZE state
-            extern NavconStatus navcon_status;
-            navcon_status.reset();
-            Serial.println("NAVCON: Reset for MAZE state");
-        }
+    if (branch.effects & SCS_FX_TONE_SET) systemStatus.justSentPureToneDetection = true;
+    if (branch.effects & SCS_FX_TONE_CLEAR) systemStatus.justSentPureToneDetection = false;
+    if (branch.effects & SCS_FX_SECOND_TOUCH) systemStatus.waitingForSecondTouch = true;
+    if (branch.effects & SCS_FX_FIRST_TOUCH) systemStatus.waitingForSecondTouch = false;
+}
+
+static void applyTransition(const SCSBranch& branch) {
+    if (branch.enter == SCS_STAY) {
+        return;
     }
-    else if (packetSubsystem == SUB_SNC && packetSysState == SYS_MAZE && packetIST == 1) {
-        if (packet.dat1 == 1) {
-            systemStatus.currentSystemState = SYS_SOS;
-            systemStatus.lastTransitionTime = millis();
-            Serial.println("STATE TRANSITION: MAZE → SOS (Pure tone detected)");
-        }
+    systemStatus.currentSystemState = (SystemState)branch.enter;
+    systemStatus.lastTransitionTime = millis();
+    Serial.println(branch.transition);
+
+    if (branch.effects & SCS_FX_EOM_CLEAR) {
+        systemStatus.eomLatched = false;  // Clear end-of-maze flag for new run
     }
-    else if (packetSubsystem == SUB_SNC && packetSysState == SYS_MAZE && packetIST == 2) {
-        if (packet.dat1 == 1) {
-            systemStatus.currentSystemState = SYS_IDLE;
-            systemStatus.lastTransitionTime = millis();
-            systemStatus.needsIdlePacket = true;  // Flag to send IDLE:SNC:IST0 with dat1=0
-            Serial.println("STATE TRANSITION: MAZE → IDLE (Touch detected in MAZE)");
-            Serial.println("  -> Will send IDLE:SNC:IST0 packet next");
-        }
+    if (branch.effects & SCS_FX_EOM_LATCH) {
+        systemStatus.eomLatched = true;   // end of maze reached, this is to ensure nothing else gets sent again
+        Serial.println("[EOM] systemStatus.eomLatched = TRUE");
     }
-    else if (packetSubsystem == SUB_SNC && packetSysState == SYS_SOS && packetIST == 0) {
-        if (packet.dat1 == 1) {
-            systemStatus.currentSystemState = SYS_MAZE;
-            systemStatus.lastTransitionTime = millis();
-            Serial.println("STATE TRANSITION: SOS → MAZE (Pure tone detected)");
-        }
+    if (branch.effects & SCS_FX_NEEDS_IDLE) {
+        systemStatus.needsIdlePacket = true;  // Flag to send IDLE:SNC:IST0 with dat1=0
+        Serial.println("  -> Will send IDLE:SNC:IST0 packet next");
     }
-    else if (packetSubsystem == SUB_SS && packetSysState == SYS_MAZE && packetIST == 3) {
-        systemStatus.currentSystemState = SYS_IDLE;
-        systemStatus.lastTransitionTime = millis();
-        systemStatus.eomLatched = true;             // end of maze reached, this is to ensure nothing else gets sent again
-
-        Serial.println("STATE TRANSITION: MAZE → IDLE (End of maze detected)");
-        Serial.println("[EOM] systemStatus.eomLatched = TRUE");
-
-        // Reset NAVCON when returning to IDLE state
+    if (branch.effects & SCS_FX_NAVCON_RESET) {
         extern NavconStatus navcon_status;
         navcon_status.reset();
-        Serial.println("NAVCON: Reset for IDLE state");
+        Serial.printf("NAVCON: Reset for %s state\n", systemStateToString(systemStatus.currentSystemState));
     }
-    
-    Serial.printf("Current system state: %s\n", systemStateToString(systemStatus.currentSystemState));
+    if (branch.effects & SCS_FX_MAP_RESET) {
+        mazeMapReset();
+    }
+}
+
+void processStateTransition(const SCSPacket& packet) {
+    const SCSRule& rule = scsRules[packet.control];
+    const SCSBranch& branch = scsBranchTaken(rule, packet.dat1, systemStatus.justSentPureToneDetection);
+
+    // A MAZE frame from SS/MDPS after MAZE → SOS is the rest of the round the
+    // SOS fast path cut short; only the MDPS SOS reply moves the expectations on.
+    bool stale = systemStatus.currentSystemState == SYS_SOS &&
+                 getSystemState(packet.control) == SYS_MAZE &&
+                 getSubsystemID(packet.control) != SUB_SNC;
+    if (stale) {
+        Serial.println("Stale MAZE frame after SOS - expectations unchanged");
+    } else {
+        applyExpectation(branch);
+    }
+    applyTransition(branch);
+
+    LOG(SYSTEM, DEBUG, "SCS 0x%02X dat1=%u -> expect [%s:%s:IST%d] %s, state %s",
+        packet.control, packet.dat1,
+        systemStateToString(systemStatus.nextExpectedSystemState),
+        subsystemToString(systemStatus.nextExpectedSubsystem),
+        systemStatus.nextExpectedIST, systemStatus.nextExpectedDescription,
+        systemStateToString(systemStatus.currentSystemState));
 }
 
 // ==================== SNC PACKET GENERATION ====================
@@ -359,84 +425,14 @@ bool shouldSendSNCPacket() {
 }
 
 SCSPacket generateSNCPacket() {
-    SCSPacket packet;
-    
-    switch (systemStatus.currentSystemState) {
-        case SYS_IDLE:
-            packet.control = createControlByte(SYS_IDLE, SUB_SNC, 0);
-            packet.dat1 = systemStatus.touchDetected ? 1 : 0;
-            packet.dat0 = 50;
-            packet.dec = 0;
-            if (systemStatus.touchDetected) {
-                systemStatus.touchDetected = false;
-            }
-            // Clear needsIdlePacket flag after sending
-            if (systemStatus.needsIdlePacket) {
-                systemStatus.needsIdlePacket = false;
-                Serial.println("  -> Sent IDLE:SNC:IST0 packet after MAZE→IDLE transition");
-            }
-            break;
-            
-        case SYS_CAL:
-            packet.control = createControlByte(SYS_CAL, SUB_SNC, 0);
-            packet.dat1 = systemStatus.touchDetected ? 1 : 0;
-            packet.dat0 = 0;
-            packet.dec = 0;
-            if (systemStatus.touchDetected) {
-                systemStatus.touchDetected = false;
-            }
-            break;
-            
-        case SYS_MAZE:
-            if (systemStatus.nextExpectedSubsystem == SUB_SNC && systemStatus.nextExpectedIST == 1) {
-                packet.control = createControlByte(SYS_MAZE, SUB_SNC, 1);
-                packet.dat1 = systemStatus.pureToneDetected ? 1 : 0;
-                packet.dat0 = 0;
-                packet.dec = 0;
-                if (systemStatus.pureToneDetected) {
-                    systemStatus.justSentPureToneDetection = true;
-                    systemStatus.pureToneDetected = false;
-                    Serial.println("SNC: Setting pure tone flag - next MDPS IST4 will be SOS response");
-                }
-            }
-            else if (systemStatus.nextExpectedSubsystem == SUB_SNC && systemStatus.nextExpectedIST == 2) {
-                packet.control = createControlByte(SYS_MAZE, SUB_SNC, 2);
-                packet.dat1 = systemStatus.touchDetected ? 1 : 0;
-                packet.dat0 = 0;
-                packet.dec = 0;
-                if (systemStatus.touchDetected) {
-                    systemStatus.touchDetected = false;
-                }
-            }
-            else if (systemStatus.nextExpectedSubsystem == SUB_SNC && systemStatus.nextExpectedIST == 3) {
-                // THIS IS WHERE NAVCON IS CALLED
-                Serial.println("NAVCON CALLED: Running enhanced navigation logic");
-                return runEnhancedNavcon();  // Return NAVCON packet directly
-            }
-            else {
-                packet.control = createControlByte(SYS_MAZE, SUB_SNC, 1);
-                packet.dat1 = systemStatus.pureToneDetected ? 1 : 0;
-                packet.dat0 = 0;
-                packet.dec = 0;
-                if (systemStatus.pureToneDetected) {
-                    systemStatus.justSentPureToneDetection = true;
-                    systemStatus.pureToneDetected = false;
-                }
-            }
-            break;
-            
-        case SYS_SOS:
-            packet.control = createControlByte(SYS_SOS, SUB_SNC, 0);
-            packet.dat1 = systemStatus.pureToneDetected ? 1 : 0;
-            packet.dat0 = 0;
-            packet.dec = 0;
-            if (systemStatus.pureToneDetected) {
-                systemStatus.pureToneDetected = false;
-            }
-            break;
+    // The SNC frame for the current state and expected IST; MAZE falls back to
+    // the pure tone turn (IST1), the other states only have IST0
+    SystemState state = systemStatus.currentSystemState;
+    SNCGenerator generate = scsRules[createControlByte(state, SUB_SNC, systemStatus.nextExpectedIST)].generate;
+    if (generate == nullptr) {
+        generate = scsRules[createControlByte(state, SUB_SNC, state == SYS_MAZE ? 1 : 0)].generate;
     }
-    
-    return packet;
+    return generate();
 }
 
 // ==================== AUTO-SEND TIMING FUNCTIONS ====================
@@ -499,7 +495,7 @@ void printSystemStatus() {
     Serial.printf("║ CURRENT SYSTEM STATE: %s\n", systemStateToString(systemStatus.currentSystemState));
     Serial.printf("║ NEXT EXPECTED SUBSYSTEM: %s\n", subsystemToString(systemStatus.nextExpectedSubsystem));
     Serial.printf("║ NEXT EXPECTED IST: %d\n", systemStatus.nextExpectedIST);
-    Serial.printf("║ EXPECTING: %s\n", systemStatus.nextExpectedDescription.c_str());
+    Serial.printf("║ EXPECTING: %s\n", systemStatus.nextExpectedDescription);
     Serial.println("******************************************");
     
     Serial.println("");
@@ -507,11 +503,29 @@ void printSystemStatus() {
     Serial.printf("🎉 END OF MAZE: %s\n", systemStatus.eomLatched ? "✅ YES - MAZE COMPLETE!" : "NO");
     Serial.printf("Waiting for 2nd Touch: %s\n", systemStatus.waitingForSecondTouch ? "YES" : "NO");
     Serial.printf("Unexpected Packets: %d\n", systemStatus.unexpectedPacketCount);
-    Serial.printf("GPIO Commands Received: %d\n", systemStatus.gpioCommandCount);
+    Serial.printf("WiFi Commands Received: %d\n", systemStatus.wifiCommandCount);
     Serial.printf("Touch Ready: %s, Pure Tone Ready: %s, Send Ready: %s\n",
                  systemStatus.touchDetected ? "YES" : "NO",
                  systemStatus.pureToneDetected ? "YES" : "NO",
                  systemStatus.manualSendTrigger ? "YES" : "NO");
+
+    // UART link counters (frames / resyncs / drops per port)
+    extern SerialPacketHandler ssHandler;    // From Phase3.ino
+    extern SerialPacketHandler mdpsHandler;  // From Phase3.ino
+    ssHandler.printStats("SS");
+    mdpsHandler.printStats("MDPS");
+
+    // SPI telemetry (DMA queue drops etc.)
+    extern MarvSPIComm spi_comm;             // From Phase3.ino
+    spi_comm.printPerformanceStats();
+    printLogStats();
+    printFlightRecorderStats();
+    printToneDetectorStats();
+
+    // Task split: control cycle, queue pressure, stack headroom
+    extern void printTaskStats();            // From Phase3.ino
+    printTaskStats();
+    printLatencyTrace();
     
     unsigned long uptime = millis();
     Serial.printf("System Uptime: %lu seconds\n", uptime / 1000);
@@ -533,7 +547,7 @@ void printCompactStatus() {
                   systemStateToString(systemStatus.currentSystemState),
                   subsystemToString(systemStatus.nextExpectedSubsystem),
                   systemStatus.nextExpectedIST,
-                  systemStatus.nextExpectedDescription.c_str());
+                  systemStatus.nextExpectedDescription);
     Serial.println("*******************\n");
 }
 
@@ -587,6 +601,40 @@ void handleSerialCommands() {
             case 'n': case 'N':
                 printNavconDebugInfo();
                 break;
+            case 'l': case 'L':
+                resetLatencyTrace();
+                Serial.println("MANUAL: Latency trace reset");
+                break;
+            case 'f': case 'F':
+                Serial.println("MANUAL: Flight log upload (current run)");
+                flightRecorderRequestUpload(false);
+                break;
+            case 'r': case 'R':
+                Serial.println("MANUAL: Flight log upload (previous run)");
+                flightRecorderRequestUpload(true);
+                break;
+            case 'b': case 'B':
+                printNavconBenchmark();
+                break;
+            case 'g': case 'G':
+                printMazeMap();
+                printMazeRoute();
+                break;
+            case 'o': case 'O':
+                if (maze_route_enabled) {
+                    maze_route_enabled = false;
+                } else {
+                    mazeRouteLoad();
+                }
+                Serial.printf("MANUAL: Second-run route %s\n", maze_route_enabled ? "ON" : "OFF");
+                break;
+            case 'c': case 'C':
+                printPcProfile();
+                break;
+            case 'v': case 'V':
+                navcon_adaptive_speed = !navcon_adaptive_speed;
+                Serial.printf("MANUAL: Adaptive forward speed %s\n", navcon_adaptive_speed ? "ON" : "OFF");
+                break;
         }
     }
 }
\ No newline at end of file
@@ -12,7 +12,7 @@ struct SystemStatus {
     SystemState nextExpectedSystemState;
     SubsystemID nextExpectedSubsystem;
     uint8_t nextExpectedIST;
-    String nextExpectedDescription;
+    const char* nextExpectedDescription;
     
     // Manual control flags (from WiFi interface)
     bool touchDetected;
@@ -26,12 +26,12 @@ struct SystemStatus {
 
     // Error tracking
     int unexpectedPacketCount;
-    int gpioCommandCount;
+    int wifiCommandCount;
     
     // Last packets for display
-    String lastSSPacket;
-    String lastMDPSPacket;
-    String lastSNCPacket;
+    const char* lastSSPacket;
+    const char* lastMDPSPacket;
+    const char* lastSNCPacket;
 
     //End of maze flag
     bool eomLatched;
@@ -51,14 +51,10 @@ void initializeSystemState();
  */
 void updateNextExpectedState();
 
-/**
- * Update next expected state based on last received packet
- * @param lastPacket: The packet that was just processed
- */
-void updateNextExpectedBasedOnLastPacket(const SCSPacket& lastPacket);
-
 /**
  * Process state transitions based on received packet
+ * One lookup in the compile-time SCS rule table: updates the expected frame
+ * and applies the state transition the control byte and DAT1 select.
  * @param packet: Incoming packet to process
  */
 void processStateTransition(const SCSPacket& packet);
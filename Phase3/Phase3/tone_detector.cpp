@@ -0,0 +1,268 @@
+/*
+ * MARV SNC - Pure Tone Detector
+ * With PURE_TONE_GOERTZEL, the I2S peripheral samples GPIO 36 at a fixed rate
+ * into DMA buffers. A low-priority task on core 0 runs a fixed-point Goertzel
+ * filter at the tone frequency over each 10 ms block, turns its power into a
+ * tone on/off envelope, and runs the two-tone sequence check on that
+ * envelope. Time is counted in blocks, so durations do not depend on the
+ * control loop.
+ * Otherwise the control task polls the original 2.5 V threshold on an
+ * analogRead and runs the same two-tone sequence check on millis().
+ */
+
+#include "tone_detector.h"
+#include "debug_log.h"
+#include <driver/i2s.h>
+#include <driver/adc.h>
+#include <math.h>
+
+#define TONE_ADC_PIN      36
+#define TONE_I2S_PORT     I2S_NUM_0
+#define TONE_ADC_CHANNEL  ADC1_CHANNEL_0    // GPIO 36
+#define TONE_COEFF_SHIFT  14                // Goertzel coefficient is Q14
+
+static_assert(TONE_BLOCK_MS > 0, "Block shorter than 1 ms");
+static_assert((TONE_BLOCK_SAMPLES & 1) == 0, "I2S ADC samples arrive in pairs");
+
+// ==================== DSP STATE (tone task) ====================
+#if PURE_TONE_GOERTZEL
+static int32_t toneCoeff = 0;               // 2*cos(2*pi*k/N) in Q14
+static int64_t toneOnPower = 0;             // Goertzel power of a TONE_ON_AMPLITUDE sine
+static int64_t toneOffPower = 0;
+static uint16_t toneSamples[TONE_BLOCK_SAMPLES];
+static TaskHandle_t toneTaskHandle = nullptr;
+static uint8_t toneQuietBlocks = 0;
+#endif
+static bool toneThresholdMode = true;       // Cleared once the Goertzel task is running
+static ToneDetectorStats toneStats = {0, 0, 0, 0, 0, 0, 0, 0};
+
+// Envelope and two-tone sequence, in block-clock (threshold: millis()) milliseconds
+static bool toneActive = false;
+static uint32_t toneStartMs = 0;
+static bool firstToneDetected = false;
+static uint32_t firstToneEndMs = 0;
+static uint32_t firstToneDuration = 0;
+
+// Written by the detector only (tone task, or the control task's poll); the control task remembers what it has taken
+static volatile uint32_t toneDetectionCount = 0;
+static uint32_t toneDetectionsTaken = 0;
+
+#if PURE_TONE_GOERTZEL
+// ==================== GOERTZEL ====================
+// One block -> is the tone present? DC is removed with the block mean; the
+// bin power is compared with an absolute level and with the block's total
+// AC energy (a pure sine puts all of it in the bin, noise spreads it out).
+static bool goertzelBlock(const uint16_t* raw, bool active) {
+    int32_t sum = 0;
+    for (int n = 0; n < TONE_BLOCK_SAMPLES; n++) {
+        sum += raw[n] & 0x0FFF;             // Top 4 bits carry the ADC channel
+    }
+    int32_t mean = sum / TONE_BLOCK_SAMPLES;
+
+    int32_t s1 = 0, s2 = 0;
+    int64_t energy = 0;
+    for (int n = 0; n < TONE_BLOCK_SAMPLES; n++) {
+        // The I2S ADC hands samples over in swapped pairs
+        int32_t x = (int32_t)(raw[n ^ 1] & 0x0FFF) - mean;
+        int32_t s = x + (int32_t)(((int64_t)toneCoeff * s1) >> TONE_COEFF_SHIFT) - s2;
+        s2 = s1;
+        s1 = s;
+        energy += x * x;
+    }
+    int64_t power = (int64_t)s1 * s1 + (int64_t)s2 * s2 -
+                    ((((int64_t)toneCoeff * s1) >> TONE_COEFF_SHIFT) * s2);
+
+    // power = (A*N/2)^2 for a sine of amplitude A; energy = N*A^2/2
+    toneStats.last_amplitude = (uint16_t)(2 * sqrtf((float)power) / TONE_BLOCK_SAMPLES);
+    int64_t purity = energy ? 200 * power / (energy * TONE_BLOCK_SAMPLES) : 0;
+    toneStats.last_purity_pct = (uint8_t)(purity > 100 ? 100 : purity);
+
+    bool loud = power >= (active ? toneOffPower : toneOnPower);
+    bool pure = 100 * 2 * power >= (int64_t)TONE_MIN_PURITY_PCT * energy * TONE_BLOCK_SAMPLES;
+    return loud && pure;
+}
+#endif
+
+// ==================== TWO-TONE SEQUENCE ====================
+static void toneEnded(uint32_t now, uint32_t duration) {
+    toneStats.tones++;
+    LOG(TONE, DEBUG, "Tone ended. Duration=%lums", (unsigned long)duration);
+
+    if (duration < TONE_MIN_MS || duration > TONE_MAX_MS) {
+        LOG(TONE, INFO, "Invalid duration (%lums). Must be 500-1000ms. Resetting.", (unsigned long)duration);
+        firstToneDetected = false;
+        return;
+    }
+    toneStats.valid_tones++;
+
+    if (!firstToneDetected) {
+        firstToneDetected = true;
+        firstToneEndMs = now;
+        firstToneDuration = duration;
+        LOG(TONE, INFO, "FIRST TONE VALID (duration=%lums). Waiting for second tone...", (unsigned long)duration);
+        return;
+    }
+
+    uint32_t gap = now - firstToneEndMs;
+    if (gap <= TONE_MAX_GAP_MS) {
+        LOG(TONE, INFO, "TWO TONES DETECTED! First=%lums Second=%lums Gap=%lums",
+            (unsigned long)firstToneDuration, (unsigned long)duration, (unsigned long)gap);
+        firstToneDetected = false;
+        toneStats.detections++;
+        toneDetectionCount = toneDetectionCount + 1;
+    } else {
+        // Too long between tones - this tone is now the first
+        LOG(TONE, INFO, "Gap too long (%lums). Resetting. This tone is now first.", (unsigned long)gap);
+        firstToneEndMs = now;
+        firstToneDuration = duration;
+    }
+}
+
+static void toneSequenceTimeout(uint32_t now) {
+    if (firstToneDetected && now - firstToneEndMs > TONE_MAX_GAP_MS) {
+        LOG(TONE, INFO, "Timeout waiting for second tone. Resetting.");
+        firstToneDetected = false;
+    }
+}
+
+#if PURE_TONE_GOERTZEL
+// Envelope: on at the first tone block, off after TONE_RELEASE_BLOCKS quiet ones
+static void toneEnvelope(bool present, uint32_t now) {
+    if (present) {
+        toneQuietBlocks = 0;
+        if (!toneActive) {
+            toneActive = true;
+            toneStartMs = now;
+            LOG(TONE, DEBUG, "Tone started - amplitude=%u", toneStats.last_amplitude);
+        }
+    } else if (toneActive && ++toneQuietBlocks >= TONE_RELEASE_BLOCKS) {
+        toneActive = false;
+        uint32_t end = now - (TONE_RELEASE_BLOCKS - 1) * TONE_BLOCK_MS;
+        toneEnded(end, end - toneStartMs);
+    }
+    toneSequenceTimeout(now);
+}
+
+// ==================== TONE TASK ====================
+static void toneTask(void* param) {
+    while (true) {
+        size_t bytes = 0;
+        i2s_read(TONE_I2S_PORT, toneSamples, sizeof(toneSamples), &bytes, portMAX_DELAY);
+        if (bytes != sizeof(toneSamples)) {
+            toneStats.short_reads++;
+            continue;
+        }
+
+        uint32_t start = ESP.getCycleCount();
+        bool present = goertzelBlock(toneSamples, toneActive);
+        uint32_t cycles = ESP.getCycleCount() - start;
+        if (cycles > toneStats.block_max_cycles) {
+            toneStats.block_max_cycles = cycles;
+        }
+
+        toneStats.blocks++;
+        toneEnvelope(present, toneStats.blocks * TONE_BLOCK_MS);
+    }
+}
+#endif
+
+// ==================== THRESHOLD FALLBACK ====================
+static void initializeThresholdDetector() {
+    pinMode(TONE_ADC_PIN, INPUT);
+    analogSetAttenuation(ADC_11db);  // Full range 0-3.3V
+    toneThresholdMode = true;
+    Serial.printf("Tone detector: GPIO 36 threshold %d (2.5 V), polled\n", TONE_THRESHOLD_ADC);
+}
+
+// ==================== PUBLIC FUNCTIONS ====================
+bool initializeToneDetector() {
+#if !PURE_TONE_GOERTZEL
+    initializeThresholdDetector();
+    return true;
+#else
+    const int k = (int)lroundf((float)TONE_BLOCK_SAMPLES * PURE_TONE_FREQ_HZ / TONE_SAMPLE_RATE_HZ);
+    toneCoeff = (int32_t)lroundf(2.0f * cosf(2.0f * (float)M_PI * k / TONE_BLOCK_SAMPLES) * (1 << TONE_COEFF_SHIFT));
+    int64_t on = (int64_t)TONE_ON_AMPLITUDE * TONE_BLOCK_SAMPLES / 2;
+    int64_t off = (int64_t)TONE_OFF_AMPLITUDE * TONE_BLOCK_SAMPLES / 2;
+    toneOnPower = on * on;
+    toneOffPower = off * off;
+
+    i2s_config_t config = {};
+    config.mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN);
+    config.sample_rate = TONE_SAMPLE_RATE_HZ;
+    config.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+    config.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT;
+    config.communication_format = I2S_COMM_FORMAT_STAND_I2S;
+    config.intr_alloc_flags = ESP_INTR_FLAG_LEVEL1;
+    config.dma_buf_count = TONE_DMA_BUFFERS;
+    config.dma_buf_len = TONE_BLOCK_SAMPLES;
+    config.use_apll = false;
+
+    if (i2s_driver_install(TONE_I2S_PORT, &config, 0, nullptr) != ESP_OK ||
+        i2s_set_adc_mode(ADC_UNIT_1, TONE_ADC_CHANNEL) != ESP_OK) {
+        LOG(TONE, ERROR, "I2S ADC setup failed - falling back to the threshold detector");
+        initializeThresholdDetector();
+        return false;
+    }
+    adc1_config_channel_atten(TONE_ADC_CHANNEL, ADC_ATTEN_DB_11);   // Full range 0-3.3V
+    i2s_adc_enable(TONE_I2S_PORT);
+
+    if (toneTaskHandle == nullptr) {
+        // Above the log drain and flight recorder, below the SCS comms task
+        xTaskCreatePinnedToCore(toneTask, "tone_dsp", 3072, nullptr, 2, &toneTaskHandle, 0);
+    }
+
+    Serial.printf("Tone detector: GPIO 36 @ %d Hz, %d ms blocks, Goertzel bin %d (%d Hz)\n",
+                  TONE_SAMPLE_RATE_HZ, TONE_BLOCK_MS, k, k * TONE_SAMPLE_RATE_HZ / TONE_BLOCK_SAMPLES);
+    toneThresholdMode = false;
+    return true;
+#endif
+}
+
+void toneDetectorPoll() {
+    if (!toneThresholdMode) {
+        return;
+    }
+
+    int adcValue = analogRead(TONE_ADC_PIN);
+    uint32_t now = millis();
+    bool present = adcValue >= TONE_THRESHOLD_ADC;
+    toneStats.blocks++;
+    toneStats.last_amplitude = (uint16_t)adcValue;
+
+    if (present && !toneActive) {
+        toneActive = true;
+        toneStartMs = now;
+        LOG(TONE, DEBUG, "Tone started - ADC=%d", adcValue);
+    } else if (!present && toneActive) {
+        toneActive = false;
+        toneEnded(now, now - toneStartMs);
+    }
+    toneSequenceTimeout(now);
+}
+
+bool toneDetectorTakeDetection() {
+    uint32_t count = toneDetectionCount;
+    if (count == toneDetectionsTaken) {
+        return false;
+    }
+    toneDetectionsTaken = count;
+    return true;
+}
+
+void printToneDetectorStats() {
+    if (toneThresholdMode) {
+        Serial.printf("Tone (threshold): %lu polls | tones %lu valid %lu | detections %lu | last ADC %u\n",
+                      (unsigned long)toneStats.blocks, (unsigned long)toneStats.tones,
+                      (unsigned long)toneStats.valid_tones, (unsigned long)toneStats.detections,
+                      toneStats.last_amplitude);
+        return;
+    }
+    Serial.printf("Tone: %lu blocks (%lu short) | tones %lu valid %lu | detections %lu\n",
+                  (unsigned long)toneStats.blocks, (unsigned long)toneStats.short_reads,
+                  (unsigned long)toneStats.tones, (unsigned long)toneStats.valid_tones,
+                  (unsigned long)toneStats.detections);
+    Serial.printf("Tone: last block amplitude %u purity %u%% | worst block %lu cycles\n",
+                  toneStats.last_amplitude, toneStats.last_purity_pct,
+                  (unsigned long)toneStats.block_max_cycles);
+}
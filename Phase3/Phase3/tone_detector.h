@@ -0,0 +1,78 @@
+#ifndef TONE_DETECTOR_H
+#define TONE_DETECTOR_H
+
+#include <Arduino.h>
+
+// ==================== DETECTOR SELECTION ====================
+// PURE_TONE_GOERTZEL=1: I2S DMA sampling and a Goertzel filter at
+// PURE_TONE_FREQ_HZ. 0 (default): the original 2.5 V threshold on an
+// analogRead, polled from the control task. The threshold detector stays the
+// default until PURE_TONE_FREQ_HZ is confirmed against the QTP tone on the
+// robot (printToneDetectorStats() shows the bin amplitude and purity). A
+// Goertzel build whose I2S setup fails also falls back to the threshold.
+#ifndef PURE_TONE_GOERTZEL
+#define PURE_TONE_GOERTZEL 0
+#endif
+
+// ==================== SAMPLING CONFIGURATION ====================
+// GPIO 36 (ADC1 channel 0) is sampled by the I2S peripheral into DMA buffers,
+// so the sample rate no longer depends on how busy the control loop is.
+#define TONE_SAMPLE_RATE_HZ   20000
+#define TONE_BLOCK_SAMPLES    200      // One Goertzel block = 10 ms
+#define TONE_BLOCK_MS         (TONE_BLOCK_SAMPLES * 1000 / TONE_SAMPLE_RATE_HZ)
+#define TONE_DMA_BUFFERS      4
+
+// ==================== DETECTION CONFIGURATION ====================
+#define PURE_TONE_FREQ_HZ     2800     // UNCONFIRMED guess at the QTP tone (bin width = 100 Hz)
+#define TONE_ON_AMPLITUDE     400      // ADC counts peak (~0.32 V) to call a block "tone"
+#define TONE_OFF_AMPLITUDE    250      // ...and to keep calling it tone (hysteresis)
+#define TONE_MIN_PURITY_PCT   30       // Share of the block AC energy in the bin (a tone half a bin off gives ~40%)
+#define TONE_RELEASE_BLOCKS   2        // Quiet blocks before a tone counts as ended
+
+// Threshold fallback (0-3.3 V at 11 dB)
+#define TONE_THRESHOLD_ADC    3102     // 2.5 V
+
+// Two-tone sequence (unchanged from the threshold detector)
+#define TONE_MIN_MS           500
+#define TONE_MAX_MS           1000
+#define TONE_MAX_GAP_MS       2000     // First tone's end to the second tone's end
+
+struct ToneDetectorStats {
+    uint32_t blocks;              // Goertzel blocks processed (the detector's clock), or threshold polls
+    uint32_t short_reads;         // DMA reads that returned less than a block
+    uint32_t tones;               // Tones that ended (any duration)
+    uint32_t valid_tones;         // ...of which 500-1000 ms
+    uint32_t detections;          // Two-tone sequences
+    uint32_t block_max_cycles;    // Worst Goertzel block
+    uint16_t last_amplitude;      // Tone amplitude in the last block (ADC counts), or the last raw read
+    uint8_t last_purity_pct;
+};
+
+// ==================== TONE DETECTOR FUNCTIONS ====================
+/**
+ * Put GPIO 36 on the I2S ADC DMA path and start the DSP task (core 0), or set
+ * it up for the threshold detector
+ * Call from setup() before the tasks start.
+ * @return: false if the Goertzel detector was asked for but the I2S driver
+ *          could not be installed (the threshold detector runs instead)
+ */
+bool initializeToneDetector();
+
+/**
+ * Threshold detector: read GPIO 36 once and advance the two-tone sequence
+ * Call every control cycle; does nothing while the Goertzel task is running.
+ */
+void toneDetectorPoll();
+
+/**
+ * Take a two-tone detection reported by the DSP task, if there is a new one
+ * @return: true once per detected sequence
+ */
+bool toneDetectorTakeDetection();
+
+/**
+ * Print detector counters and the last block's amplitude / purity
+ */
+void printToneDetectorStats();
+
+#endif // TONE_DETECTOR_H
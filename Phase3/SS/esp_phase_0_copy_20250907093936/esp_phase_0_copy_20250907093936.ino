@@ -5,6 +5,8 @@
 
 #include <HardwareSerial.h>
 #include <math.h>
+#include <esp_timer.h>
+#include <Preferences.h>
 
 // ==================== PIN DEFINITIONS ====================
 // UART pins for subsystem communication
@@ -12,7 +14,7 @@
 #define TX_PIN 17            // UART2 TX to SNC
 #define BUTTON_PIN 0       // GPIO 15 for triggering SEND
 //#define END_OF_MAZE_PIN 2    // GPIO 2 for end-of-maze detection
-#define SERIAL_BAUD 460800
+#define SERIAL_BAUD 115200   // SCS link base rate - the SNC trains it up after reset
 #define PI 3.14159265358979323846
 
 // ==================== PACKET STRUCTURE ====================
@@ -42,8 +44,6 @@ enum SubsystemID {
     SUB_SS = 3      // 11
 };
 
-int sample_time = 2;
-
 int red_led = 14;
 int green_led = 12;
 int blue_led = 13;
@@ -56,6 +56,9 @@ int red = 0;
 int green = 1;
 int blue = 2;
 
+// Photodiode ADC pins, indexed by sensor (S1, S2, S3)
+int sensor_pins[] = {36, 39, 34};
+
 int red_threshold[] = {0, 0, 0};
 
 int green_threshold[] = {0, 0, 0};
@@ -72,11 +75,11 @@ uint8_t save_dat_1 = 0;
 
 uint8_t save_dat_0 = 0;
 
-uint16_t first_distance = 0;
+float first_distance = 0;                  // mm travelled when the edge sensor hit the line
 
-uint16_t second_distance =0;
+float second_distance =0;                  // mm travelled when the middle sensor hit the line
 
-uint16_t distance_for_angle_calc = 0;
+float distance_for_angle_calc = 0;
 
 float distance_between_sensors = 61;
 
@@ -90,9 +93,96 @@ bool has_cached_edge = false;              // Flag indicating edge sensor (s1 or
 bool has_cached_middle = false;            // Flag indicating middle sensor (s2) has cached data
 uint16_t cached_edge_distance = 0;         // Distance when edge sensor FIRST detected color
 uint16_t cached_middle_distance = 0;       // Distance when middle sensor FIRST detected color
+int64_t cached_edge_time_us = 0;           // Frame timestamp of the first edge hit
+int64_t cached_middle_time_us = 0;         // Frame timestamp of the first middle hit
 unsigned long last_sample_time = 0;        // For sample rate limiting (milliseconds)
 uint16_t currentDistance = 0;              // Current distance from MDPS packets
 
+// ==================== MOTION SAMPLE HISTORY ====================
+// MDPS distance (IST4) and speed (IST3) packets, stamped on arrival with
+// esp_timer_get_time(). Colour frames carry the same clock, so the distance
+// at the instant a sensor hit a line is interpolated between packets instead
+// of being quantised to whichever packet came last.
+#define MOTION_HISTORY 8                   // Distance samples kept (one segment)
+#define MOTION_EXTRAPOLATE_MAX_US 250000   // Beyond this past the newest sample, don't project
+
+struct MotionSample {
+    int64_t time_us;
+    uint16_t distance_mm;
+};
+
+MotionSample motion_history[MOTION_HISTORY];
+int motion_count = 0;                      // Valid samples (oldest first, ring from motion_oldest)
+int motion_oldest = 0;
+float motion_speed_mm_s = 0;               // Latest IST3 average of both wheels
+int64_t motion_speed_time_us = 0;
+
+// ==================== SCAN ENGINE STATE ====================
+// Timer-driven LED strobe: each tick reads the colour that has been lit for
+// one settle period, then lights the next one. Completed frames are published
+// to a double buffer so loop() never waits on the photodiodes.
+#define SCAN_SETTLE_US 2000                // Photodiode settle time per colour (was a blocking 2 ms delay per colour)
+
+esp_timer_handle_t scan_timer = nullptr;
+volatile bool scan_running = false;       // Cleared under scan_mux by scan_engine_stop()
+volatile bool scan_busy = false;          // A callback is mid-tick (set/cleared under scan_mux)
+int scan_colour = 0;                       // Colour currently lit (red/green/blue)
+int scan_work[3][3];                       // Frame being captured [colour][sensor]
+int scan_frames[2][3][3];                  // Published frames [buffer][colour][sensor]
+int64_t scan_work_time_us = 0;             // Green (mid-frame) capture time of the frame in progress
+int64_t scan_frame_time_us[2];             // Mid-frame timestamp of each published frame
+volatile int scan_front = 0;               // Buffer holding the latest complete frame
+volatile uint32_t scan_frame_count = 0;    // Frames published since boot
+uint32_t scan_last_consumed = 0;           // Last frame handed to color_detection_all()
+portMUX_TYPE scan_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// ==================== COLOUR FILTER STATE ====================
+// Per sensor, per channel: oversampled reads -> median over recent frames ->
+// Schmitt trigger around the calibrated threshold. Cost per frame is 12 ADC
+// reads per tick (~120 us of the 2 ms settle) plus 9 three-tap medians.
+#define SCAN_OVERSAMPLE 4                  // ADC reads averaged per colour per tick
+#define FILTER_MEDIAN_TAPS 3               // Frames in the median window (adds ~1 frame of lag)
+#define HYSTERESIS_DEFAULT 40              // ADC counts either side of a threshold
+static_assert(FILTER_MEDIAN_TAPS == 3, "filter_channel() is a three-tap median");
+
+int filter_history[3][3][FILTER_MEDIAN_TAPS]; // [sensor][colour][tap]
+int filter_next_tap = 0;
+int filter_taps_filled = 0;
+int channel_on[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};  // Hysteresis latch [sensor][colour]
+int hysteresis_band[3][3] = {
+    {HYSTERESIS_DEFAULT, HYSTERESIS_DEFAULT, HYSTERESIS_DEFAULT},
+    {HYSTERESIS_DEFAULT, HYSTERESIS_DEFAULT, HYSTERESIS_DEFAULT},
+    {HYSTERESIS_DEFAULT, HYSTERESIS_DEFAULT, HYSTERESIS_DEFAULT}
+};
+uint8_t filtered_colors[3] = {0, 0, 0};    // Last classification of a new frame
+uint8_t color_confidence[3] = {0, 0, 0};   // 0-100 %, weakest channel margin per sensor
+int64_t filtered_frame_time_us = 0;        // Timestamp of the frame behind filtered_colors
+
+// ==================== CALIBRATION STORAGE ====================
+// Thresholds survive reboots in NVS, one record per surface profile
+// (e.g. bench mat vs maze floor). A valid record skips the first CAL after boot.
+#define CAL_NVS_NAMESPACE "ss_cal"
+#define CAL_RECORD_VERSION 1
+#define CAL_PROFILE_COUNT 4
+#define CAL_FRAMES_PER_SURFACE 32          // ~200 ms of scan engine frames per surface
+#define CAL_CAPTURE_TIMEOUT_MS 1000
+#define CAL_CUE_BLINKS 5                   // Surface cue blinks (200 ms each) before capture
+#define HYSTERESIS_MIN 8                   // Floor for the sigma-derived band
+
+struct CalibrationRecord {
+    uint8_t version;
+    uint8_t profile;
+    int16_t red_threshold[3];
+    int16_t green_threshold[3];
+    int16_t blue_threshold[3];
+    int16_t band[3][3];                    // hysteresis_band [sensor][colour]
+    uint8_t checksum;                      // XOR of all preceding bytes
+};
+
+Preferences cal_prefs;
+uint8_t cal_profile = 0;                   // Active surface profile
+bool cal_skip_next = false;                // Loaded from NVS - skip the first CAL
+
 // ==================== PACKET PARSING FUNCTIONS ====================
 SystemState getSystemState(uint8_t control) {
     return (SystemState)((control >> 6) & 0x03);
@@ -219,6 +309,14 @@ public:
         return false;
     }
     
+    // Change rate in place (link training) - a half frame at the old rate is dropped
+    void setRate(unsigned long baud) {
+        serial->flush();
+        serial->updateBaudRate(baud);
+        bufferIndex = 0;
+        synced = false;
+    }
+    
     void sendPacket(const SCSPacket& packet) {
         serial->write(packet.control);
         serial->write(packet.dat1);
@@ -234,6 +332,98 @@ public:
 // ==================== GLOBAL INSTANCES ====================
 SerialPacketHandler sncHandler(&Serial2, RX_PIN, TX_PIN);
 
+// ==================== LINK TRAINING ====================
+// Same frames and rate table as the SNC's scs_protocol.h: the SNC sends
+// IDLE:SNC:IST15, the SS answers IDLE:SS:IST15. DAT1 = op, DAT0 = rate index
+// (or test byte), DEC = sequence. A trial rate the SNC never commits is
+// dropped again after SCS_LINK_TRIAL_MS. Above the base rate the SNC sends a
+// keepalive every 250 ms; without one for SCS_LINK_SILENCE_MS (SNC reset,
+// lost FALLBACK) the SS goes back to the base rate, and the SNC retrains once it
+// hears from the SS again while idle.
+#define SCS_LINK_IST          15
+#define SCS_LINK_OP_PROPOSE   1    // Try rate DAT0 -> ACK, then switch
+#define SCS_LINK_OP_ACK       2
+#define SCS_LINK_OP_PATTERN   3    // Test frame -> echoed unchanged
+#define SCS_LINK_OP_COMMIT    4    // Keep rate DAT0 -> echoed
+#define SCS_LINK_OP_FALLBACK  5    // Drop to rate DAT0 now, no reply
+#define SCS_LINK_TRIAL_MS     200
+#define SCS_LINK_SILENCE_MS   1000
+
+static const uint32_t SCS_LINK_RATES[] = { SERIAL_BAUD, 230400, 460800, 921600, 1500000, 2000000 };
+#define SCS_LINK_RATE_COUNT (sizeof(SCS_LINK_RATES) / sizeof(SCS_LINK_RATES[0]))
+
+uint8_t linkRate = 0;               // Committed rate (index)
+uint8_t linkTrial = 0;
+bool linkTrialActive = false;
+unsigned long linkTrialMs = 0;
+unsigned long linkHeardMs = 0;      // Last link frame from the SNC
+
+void linkReply(uint8_t op, uint8_t dat0, uint8_t dec) {
+    SCSPacket reply;
+    reply.control = createControlByte(SYS_IDLE, SUB_SS, SCS_LINK_IST);
+    reply.dat1 = op;
+    reply.dat0 = dat0;
+    reply.dec = dec;
+    sncHandler.sendPacket(reply);
+}
+
+// Answer one link frame; false if the packet is not one (state machine gets it)
+bool handleLinkFrame(const SCSPacket& packet) {
+    if (packet.control != createControlByte(SYS_IDLE, SUB_SNC, SCS_LINK_IST)) {
+        return false;
+    }
+    linkHeardMs = millis();
+
+    switch (packet.dat1) {
+        case SCS_LINK_OP_PROPOSE:
+            if (packet.dat0 < SCS_LINK_RATE_COUNT) {
+                linkReply(SCS_LINK_OP_ACK, packet.dat0, 0);
+                sncHandler.setRate(SCS_LINK_RATES[packet.dat0]);
+                linkTrial = packet.dat0;
+                linkTrialActive = true;
+                linkTrialMs = millis();
+            }
+            break;
+        case SCS_LINK_OP_PATTERN:
+            linkReply(SCS_LINK_OP_PATTERN, packet.dat0, packet.dec);
+            break;
+        case SCS_LINK_OP_COMMIT:
+            // Repeated COMMITs (a lost echo) are echoed again
+            if (linkTrialActive && packet.dat0 == linkTrial) {
+                linkRate = linkTrial;
+                linkTrialActive = false;
+            }
+            if (packet.dat0 == linkRate) {
+                linkReply(SCS_LINK_OP_COMMIT, packet.dat0, 0);
+            }
+            break;
+        case SCS_LINK_OP_FALLBACK:
+            // Sent three times - only the first one switches
+            if (packet.dat0 < linkRate) {
+                linkRate = packet.dat0;
+                linkTrialActive = false;
+                sncHandler.setRate(SCS_LINK_RATES[linkRate]);
+            }
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+// Trial rate the SNC never committed (its echo test failed) -> back to the last good rate
+void linkTrialTimeout() {
+    if (linkTrialActive && millis() - linkTrialMs > SCS_LINK_TRIAL_MS) {
+        linkTrialActive = false;
+        sncHandler.setRate(SCS_LINK_RATES[linkRate]);
+    }
+    // Committed rate but the SNC's keepalive stopped -> base rate
+    if (linkRate != 0 && !linkTrialActive && millis() - linkHeardMs > SCS_LINK_SILENCE_MS) {
+        linkRate = 0;
+        sncHandler.setRate(SCS_LINK_RATES[0]);
+    }
+}
+
 // ==================== SYSTEM STATUS TRACKING ====================
 struct SSStatus {
     SystemState currentSystemState;
@@ -328,6 +518,8 @@ void initializeCache() {
     has_cached_middle = false;
     cached_edge_distance = 0;
     cached_middle_distance = 0;
+    cached_edge_time_us = 0;
+    cached_middle_time_us = 0;
     // Also reset distance tracking variables for next detection
     first_distance = 0;
     second_distance = 0;
@@ -336,7 +528,8 @@ void initializeCache() {
 }
 
 // Update cache with first non-white color detection - NEVER OVERWRITE!
-void updateCache(uint8_t s1, uint8_t s2, uint8_t s3, uint16_t distance) {
+// frame_time_us is the scan frame's timestamp, used to interpolate the hit distance
+void updateCache(uint8_t s1, uint8_t s2, uint8_t s3, uint16_t distance, int64_t frame_time_us) {
     bool updated = false;
 
     // Cache sensor 1 (edge) if not already cached and detecting non-white
@@ -345,6 +538,7 @@ void updateCache(uint8_t s1, uint8_t s2, uint8_t s3, uint16_t distance) {
         cached_sensor_set[0] = true;
         if (!has_cached_edge) {
             cached_edge_distance = distance;
+            cached_edge_time_us = frame_time_us;
             has_cached_edge = true;
         }
         updated = true;
@@ -356,6 +550,7 @@ void updateCache(uint8_t s1, uint8_t s2, uint8_t s3, uint16_t distance) {
         cached_sensor_set[1] = true;
         if (!has_cached_middle) {
             cached_middle_distance = distance;
+            cached_middle_time_us = frame_time_us;
             has_cached_middle = true;
         }
         updated = true;
@@ -367,6 +562,7 @@ void updateCache(uint8_t s1, uint8_t s2, uint8_t s3, uint16_t distance) {
         cached_sensor_set[2] = true;
         if (!has_cached_edge) {
             cached_edge_distance = distance;
+            cached_edge_time_us = frame_time_us;
             has_cached_edge = true;
         }
         updated = true;
@@ -374,6 +570,179 @@ void updateCache(uint8_t s1, uint8_t s2, uint8_t s3, uint16_t distance) {
     // NO DEBUG OUTPUT - too spammy
 }
 
+// ==================== MOTION INTERPOLATION ====================
+// Record an IST4 distance; a smaller value means the MDPS reset it
+// (stop/rotate), so the previous segment's samples no longer apply
+void motion_record_distance(uint16_t distance_mm, int64_t time_us) {
+    if (motion_count > 0) {
+        int newest = (motion_oldest + motion_count - 1) % MOTION_HISTORY;
+        if (distance_mm < motion_history[newest].distance_mm) {
+            motion_count = 0;
+            motion_oldest = 0;
+        }
+    }
+
+    int slot = (motion_oldest + motion_count) % MOTION_HISTORY;
+    if (motion_count == MOTION_HISTORY) {
+        motion_oldest = (motion_oldest + 1) % MOTION_HISTORY;
+    } else {
+        motion_count++;
+    }
+    motion_history[slot].time_us = time_us;
+    motion_history[slot].distance_mm = distance_mm;
+}
+
+// Record an IST3 speed report (DAT1 = right, DAT0 = left, mm/s)
+void motion_record_speed(uint8_t right_mm_s, uint8_t left_mm_s, int64_t time_us) {
+    motion_speed_mm_s = (right_mm_s + left_mm_s) / 2.0f;
+    motion_speed_time_us = time_us;
+}
+
+// Distance travelled at time_us: linear between the bracketing IST4 samples,
+// projected past the newest one with the IST3 speed (or the last two samples'
+// slope). Returns -1 with no samples in this segment.
+float motion_distance_at(int64_t time_us) {
+    if (motion_count == 0) {
+        return -1;
+    }
+
+    const MotionSample& oldest = motion_history[motion_oldest];
+    if (time_us <= oldest.time_us) {
+        return oldest.distance_mm;
+    }
+
+    for (int i = 1; i < motion_count; i++) {
+        const MotionSample& a = motion_history[(motion_oldest + i - 1) % MOTION_HISTORY];
+        const MotionSample& b = motion_history[(motion_oldest + i) % MOTION_HISTORY];
+        if (time_us <= b.time_us) {
+            float span = (float)(b.time_us - a.time_us);
+            float frac = span > 0 ? (float)(time_us - a.time_us) / span : 1.0f;
+            return a.distance_mm + frac * (b.distance_mm - a.distance_mm);
+        }
+    }
+
+    // After the newest sample - project forward, but not indefinitely
+    const MotionSample& newest = motion_history[(motion_oldest + motion_count - 1) % MOTION_HISTORY];
+    int64_t ahead_us = time_us - newest.time_us;
+    if (ahead_us > MOTION_EXTRAPOLATE_MAX_US) {
+        ahead_us = MOTION_EXTRAPOLATE_MAX_US;
+    }
+
+    float speed = 0;
+    if (motion_speed_time_us > 0 && motion_speed_time_us >= oldest.time_us) {
+        speed = motion_speed_mm_s;
+    } else if (motion_count >= 2) {
+        const MotionSample& prev = motion_history[(motion_oldest + motion_count - 2) % MOTION_HISTORY];
+        if (newest.time_us > prev.time_us) {
+            speed = (newest.distance_mm - prev.distance_mm) * 1e6f / (float)(newest.time_us - prev.time_us);
+        }
+    }
+    return newest.distance_mm + speed * (ahead_us / 1e6f);
+}
+
+// ==================== TIMER-DRIVEN SCAN ENGINE ====================
+// Light one LED (index matches red/green/blue), all others off
+void scan_set_led(int colour) {
+    digitalWrite(red_led, colour == red ? HIGH : LOW);
+    digitalWrite(green_led, colour == green ? HIGH : LOW);
+    digitalWrite(blue_led, colour == blue ? HIGH : LOW);
+}
+
+// Runs every SCAN_SETTLE_US in the esp_timer task: capture, then advance the strobe
+void scan_timer_callback(void* arg) {
+    // Claim the tick under the lock so scan_engine_stop() either sees it busy or stops it from starting
+    taskENTER_CRITICAL(&scan_mux);
+    bool run = scan_running;
+    scan_busy = run;
+    taskEXIT_CRITICAL(&scan_mux);
+    if (!run) {
+        return;
+    }
+
+    // The lit colour has settled - read it on all three photodiodes
+    for (int sensor = sensor_1; sensor <= sensor_3; sensor++) {
+        int sum = 0;
+        for (int i = 0; i < SCAN_OVERSAMPLE; i++) {
+            sum += analogRead(sensor_pins[sensor]);
+        }
+        scan_work[scan_colour][sensor] = sum / SCAN_OVERSAMPLE;
+    }
+    if (scan_colour == green) {
+        scan_work_time_us = esp_timer_get_time();
+    }
+
+    if (scan_colour == blue) {
+        // Frame complete - fill the back buffer, then flip
+        int back = 1 - scan_front;
+        memcpy(scan_frames[back], scan_work, sizeof(scan_work));
+        scan_frame_time_us[back] = scan_work_time_us;
+        taskENTER_CRITICAL(&scan_mux);
+        scan_front = back;
+        scan_frame_count++;
+        taskEXIT_CRITICAL(&scan_mux);
+        scan_colour = red;
+    } else {
+        scan_colour++;
+    }
+
+    scan_set_led(scan_colour);
+
+    taskENTER_CRITICAL(&scan_mux);
+    scan_busy = false;
+    taskEXIT_CRITICAL(&scan_mux);
+}
+
+void scan_engine_start() {
+    if (scan_timer == nullptr) {
+        esp_timer_create_args_t args = {};
+        args.callback = scan_timer_callback;
+        args.name = "ss_scan";
+        if (esp_timer_create(&args, &scan_timer) != ESP_OK) {
+            Serial.println("🟠 ❌ Scan timer create failed");
+            return;
+        }
+    }
+    if (scan_running) {
+        return;
+    }
+
+    scan_colour = red;
+    scan_set_led(scan_colour);
+    scan_running = true;
+    esp_timer_start_periodic(scan_timer, SCAN_SETTLE_US);
+}
+
+// Hand the LEDs back to blocking code (calibration)
+void scan_engine_stop() {
+    if (!scan_running) {
+        return;
+    }
+    taskENTER_CRITICAL(&scan_mux);
+    scan_running = false;
+    taskEXIT_CRITICAL(&scan_mux);
+    esp_timer_stop(scan_timer);
+
+    // A tick that started before the flag dropped still owns the LEDs and ADC - wait for it
+    while (scan_busy) {
+        taskYIELD();
+    }
+    scan_set_led(-1);
+}
+
+// Copy the latest complete frame out of the double buffer
+// Returns false until the first frame has been published
+bool scan_latest_frame(int readings[3][3], uint32_t* frame_number, int64_t* frame_time_us) {
+    taskENTER_CRITICAL(&scan_mux);
+    uint32_t count = scan_frame_count;
+    memcpy(readings, scan_frames[scan_front], sizeof(scan_frames[0]));
+    int64_t stamp = scan_frame_time_us[scan_front];
+    taskEXIT_CRITICAL(&scan_mux);
+
+    *frame_number = count;
+    *frame_time_us = stamp;
+    return count > 0;
+}
+
 // ==================== SS EXPECTED TO RESPOND LOGIC ====================
 bool isSSExpectedToRespond(uint8_t controlByte) {
     SystemState sys = getSystemState(controlByte);
@@ -471,9 +840,9 @@ SCSPacket generateSSPacket() {
             Serial.printf("   └─ DEC:          0x%02X\n", packet.dec);
             Serial.printf("🔢 STORED LATCH VALUES:\n");
             Serial.printf("   ├─ ssStatus.lastIncidenceAngle: %d degrees\n", ssStatus.lastIncidenceAngle);
-            Serial.printf("   ├─ first_distance:              %d mm\n", first_distance);
-            Serial.printf("   ├─ second_distance:             %d mm\n", second_distance);
-            Serial.printf("   └─ distance_for_angle_calc:     %d mm\n", distance_for_angle_calc);
+            Serial.printf("   ├─ first_distance:              %.2f mm\n", first_distance);
+            Serial.printf("   ├─ second_distance:             %.2f mm\n", second_distance);
+            Serial.printf("   └─ distance_for_angle_calc:     %.2f mm\n", distance_for_angle_calc);
             Serial.println("════════════════════════════════════════════════════════════");
         }
 
@@ -696,6 +1065,16 @@ void setup() {
     //pinMode(END_OF_MAZE_PIN, INPUT_PULLUP);
     sncHandler.begin(SERIAL_BAUD);
 
+    cal_prefs.begin(CAL_NVS_NAMESPACE, true);
+    cal_profile = cal_prefs.getUChar("active", 0);
+    cal_prefs.end();
+    if (cal_profile >= CAL_PROFILE_COUNT) {
+        cal_profile = 0;
+    }
+    cal_skip_next = cal_load(cal_profile);
+
+    scan_engine_start();
+
     // Serial.println("🟠 UART handler initialized (19200 baud)");  // Disabled for performance
     // Serial.println("🟠 Button initialized on GPIO 15");
     // Serial.println("🟠 End-of-Maze pin initialized on GPIO 2");
@@ -719,21 +1098,20 @@ void loop() {
     //checkButton();
 
     // ==================== CONTINUOUS BACKGROUND COLOR SAMPLING ====================
-    // Sample colors EVERY LOOP ITERATION in MAZE state for maximum responsiveness (no artificial delay)
-    // This achieves 1000+ Hz sampling rate - instant line detection with zero missed detections!
+    // The scan engine strobes the LEDs in the background (3 x SCAN_SETTLE_US, ~160 Hz);
+    // each loop only classifies a frame when a new one has been published
     if (ssStatus.currentSystemState == SYS_MAZE) {
-        // Perform color detection on all 3 sensors - NO DELAY, NO THROTTLING
-        uint8_t s1 = color_detection(sensor_1);
-        uint8_t s2 = color_detection(sensor_2);
-        uint8_t s3 = color_detection(sensor_3);
-
-        // Update cache with first non-white color detected (preserves first detection, never overwrites)
-        updateCache(s1, s2, s3, currentDistance);
+        uint8_t frame[3];
+        if (color_detection_all(frame)) {
+            // Update cache with first non-white color detected (preserves first detection, never overwrites)
+            updateCache(frame[sensor_1], frame[sensor_2], frame[sensor_3], currentDistance, filtered_frame_time_us);
+        }
     }
 
-    // Check for incoming packets
+    // Check for incoming packets (link training frames are answered here and go no further)
+    linkTrialTimeout();
     SCSPacket packet;
-    if (sncHandler.readPacket(packet)) {
+    if (sncHandler.readPacket(packet) && !handleLinkFrame(packet)) {
         // printPacket(packet, "📥 RX from SNC:");  // Disabled for performance
 
         ssStatus.lastControlByte = packet.control;
@@ -748,6 +1126,11 @@ void loop() {
         // Update current distance if this is an MDPS distance packet (IST4)
         if (packetSubsystem == SUB_MDPS && packetIST == 4) {
             currentDistance = ((uint16_t)packet.dat1 << 8) | packet.dat0;
+            motion_record_distance(currentDistance, esp_timer_get_time());
+        }
+        // MDPS speed (IST3) drives extrapolation past the newest distance sample
+        else if (packetSystemState == SYS_MAZE && packetSubsystem == SUB_MDPS && packetIST == 3) {
+            motion_record_speed(packet.dat1, packet.dat0, esp_timer_get_time());
         }
 
         // Handle state transitions based on SNC packets
@@ -802,14 +1185,18 @@ void loop() {
     if(ssStatus.lastControlByte == 16 && ssStatus.currentSystemState == SYS_CAL && has_calibrated == 0){
         // when prev controll byte is 16 and current sys state is cal it will calibrate 
         digitalWrite(2, HIGH);
-        calibration();
+        if (cal_skip_next) {
+            // Warm restart with stored thresholds - nothing to measure
+            cal_skip_next = false;
+        } else if (calibration()) {
+            cal_save(cal_profile);
+        }
+        filter_reset();
         has_calibrated = 1;
     } else if(ssStatus.lastControlByte == 97 && ssStatus.currentSystemState == SYS_CAL){
         // when prev control byte is 97 from mdps and current state is calli system will color detect and send color 
         digitalWrite(2, HIGH);
-        ssStatus.sensorColors[0] = color_detection(sensor_1); 
-        ssStatus.sensorColors[1] = color_detection(sensor_2);  
-        ssStatus.sensorColors[2] = color_detection(sensor_3);
+        color_detection_all(ssStatus.sensorColors);
 
     } else if(ssStatus.lastControlByte == 164 && ssStatus.currentSystemState == SYS_MAZE){
         // when last control byte recieved is 164 it will use cached colors or detect if cache empty
@@ -827,9 +1214,13 @@ void loop() {
 
             has_new_detection = true; // We have cached non-white colors
 
-            // Use cached distances for angle calculation
-            first_distance = cached_edge_distance;
-            second_distance = cached_middle_distance;
+            // Distances at the hit timestamps, interpolated between MDPS samples
+            // (both hits share the median filter's lag, so it cancels in the delta);
+            // fall back to the packet-quantised distances without a sample history
+            float edge_at = motion_distance_at(cached_edge_time_us);
+            float middle_at = motion_distance_at(cached_middle_time_us);
+            first_distance = (has_cached_edge && edge_at >= 0) ? edge_at : cached_edge_distance;
+            second_distance = (has_cached_middle && middle_at >= 0) ? middle_at : cached_middle_distance;
 
             // Set toggle if BOTH edge and middle sensors detected WITH VALID distances (needed for angle calc)
             if (has_cached_edge && has_cached_middle &&
@@ -840,9 +1231,7 @@ void loop() {
             }
         } else {
             // No cached non-white - perform direct detection (likely all white)
-            ssStatus.sensorColors[0] = color_detection(sensor_1);
-            ssStatus.sensorColors[1] = color_detection(sensor_2);
-            ssStatus.sensorColors[2] = color_detection(sensor_3);
+            color_detection_all(ssStatus.sensorColors);
 
             // Check if we detected any non-white colors
             if (shouldUpdateCache(ssStatus.sensorColors[sensor_1]) ||
@@ -892,7 +1281,7 @@ void loop() {
                     distance_for_angle_calc = second_distance - first_distance;
                     float b_extra_distance_due_to_angle = sqrtf(distance_for_angle_calc*distance_for_angle_calc + distance_between_sensors*distance_between_sensors) - distance_between_sensors;
                     float angle = asinf(distance_for_angle_calc/(b_extra_distance_due_to_angle + distance_between_sensors))*180/PI;
-                    uint8_t angle_8 = (uint8_t)angle;
+                    uint8_t angle_8 = (uint8_t)(angle + 0.5f);
                     ssStatus.lastIncidenceAngle = angle_8;
 
                     // ====== DEBUG OUTPUT FOR NON-ZERO ANGLE ======
@@ -901,9 +1290,9 @@ void loop() {
                         Serial.println("║           🔺 NON-ZERO ANGLE DETECTED! 🔺                  ║");
                         Serial.println("╚════════════════════════════════════════════════════════════╝");
                         Serial.printf("📊 CALCULATION VARIABLES (LATCH VALUES):\n");
-                        Serial.printf("   ├─ first_distance (edge):    %d mm\n", first_distance);
-                        Serial.printf("   ├─ second_distance (middle): %d mm\n", second_distance);
-                        Serial.printf("   ├─ distance_for_angle_calc:  %d mm (delta)\n", distance_for_angle_calc);
+                        Serial.printf("   ├─ first_distance (edge):    %.2f mm\n", first_distance);
+                        Serial.printf("   ├─ second_distance (middle): %.2f mm\n", second_distance);
+                        Serial.printf("   ├─ distance_for_angle_calc:  %.2f mm (delta)\n", distance_for_angle_calc);
                         Serial.printf("   ├─ distance_between_sensors: %.2f mm\n", distance_between_sensors);
                         Serial.printf("   ├─ b_extra (calc):           %.2f mm\n", b_extra_distance_due_to_angle);
                         Serial.printf("   ├─ Raw angle (float):        %.2f degrees\n", angle);
@@ -1034,6 +1423,35 @@ void loop() {
                 ssStatus.buttonProcessed = false;
                 Serial.println("🟠 SS subsystem reset");
                 break;
+            case 'c': case 'C':
+                // Latest filtered colours with confidence
+                Serial.printf("🟠 Colours: S1=%s (%d%%) S2=%s (%d%%) S3=%s (%d%%) | frames=%lu\n",
+                              colorToString(filtered_colors[sensor_1]), color_confidence[sensor_1],
+                              colorToString(filtered_colors[sensor_2]), color_confidence[sensor_2],
+                              colorToString(filtered_colors[sensor_3]), color_confidence[sensor_3],
+                              (unsigned long)scan_frame_count);
+                break;
+            case '0': case '1': case '2': case '3':
+                // Select surface profile - stored thresholds apply immediately
+                cal_profile = cmd - '0';
+                cal_prefs.begin(CAL_NVS_NAMESPACE, false);
+                cal_prefs.putUChar("active", cal_profile);
+                cal_prefs.end();
+                if (cal_load(cal_profile)) {
+                    filter_reset();
+                    Serial.printf("🟠 Profile %d loaded from NVS\n", cal_profile);
+                } else {
+                    Serial.printf("🟠 Profile %d has no stored calibration - next CAL will measure it\n", cal_profile);
+                }
+                break;
+            case 'k': case 'K':
+                // Forget the active profile so the next CAL recalibrates
+                cal_prefs.begin(CAL_NVS_NAMESPACE, false);
+                cal_prefs.remove(cal_key(cal_profile));
+                cal_prefs.end();
+                cal_skip_next = false;
+                Serial.printf("🟠 Profile %d calibration erased\n", cal_profile);
+                break;
             case 'm': case 'M':
                 // Toggle end-of-maze detection (for testing without GPIO)
                 ssStatus.endOfMazePinActive = !ssStatus.endOfMazePinActive;
@@ -1066,159 +1484,298 @@ void loop() {
 }
 
 
-void calibration()//CCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCC
+// Fast calibration: for each surface (red, green, blue in turn) a short LED
+// cue tells the operator where to place MARV, then the scan engine captures
+// CAL_FRAMES_PER_SURFACE frames. Thresholds sit where the on-surface and
+// nearest off-surface distributions are equally many sigma away.
+// Returns false (thresholds untouched) if a capture timed out.
+bool calibration()//CCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCC
 {
-    int red_on_red[] = {0, 0, 0};
-    int red_on_green[] = {0, 0, 0};
-    int red_on_blue[] = {0, 0, 0};
+    // [surface][led colour][sensor], e.g. mean[green][red][s] = red LED on green surface
+    float mean[3][3][3];
+    float sigma[3][3][3];
+    unsigned long start = millis();
+
+    for (int surface = red; surface <= blue; surface++) {
+      cal_cue_surface(surface);
+      if (!cal_capture_surface(mean[surface], sigma[surface])) {
+        Serial.printf("🟠 ❌ CAL capture timed out on surface %s\n", colorToString(surface + 1));
+        return false;
+      }
+    }
 
+    for (int sensor = sensor_1; sensor <= sensor_3; sensor++) {
+      for (int color = red; color <= blue; color++) {
+        // Closest competing surface is the brighter of the other two
+        int other_a = (color + 1) % 3;
+        int other_b = (color + 2) % 3;
+        int off = mean[other_a][color][sensor] > mean[other_b][color][sensor] ? other_a : other_b;
+
+        float mu_on = mean[color][color][sensor];
+        float mu_off = mean[off][color][sensor];
+        float sd_on = sigma[color][color][sensor];
+        float sd_off = sigma[off][color][sensor];
+
+        float threshold = (mu_on + mu_off) / 2;
+        if (sd_on + sd_off > 0.5f) {
+          threshold = (mu_on * sd_off + mu_off * sd_on) / (sd_on + sd_off);
+        }
 
-    int green_on_red[] = {0, 0, 0};
-    int green_on_green[] = {0, 0, 0};
-    int green_on_blue[] = {0, 0, 0};
+        // Band covers the noise but never more than a quarter of the gap
+        float band = 2 * (sd_on > sd_off ? sd_on : sd_off);
+        if (band < HYSTERESIS_MIN) band = HYSTERESIS_MIN;
+        float gap_limit = fabsf(mu_on - mu_off) / 4;
+        if (band > gap_limit) band = gap_limit;
 
+        cal_threshold(color)[sensor] = (int)(threshold + 0.5f);
+        hysteresis_band[sensor][color] = (int)band;
+      }
+    }
 
-    int blue_on_red[] = {0, 0, 0};
-    int blue_on_green[] = {0, 0, 0};
-    int blue_on_blue[] = {0, 0, 0};
-    digitalWrite(red_led, LOW);
-    digitalWrite(green_led, LOW);
-    digitalWrite(blue_led, LOW);
+    Serial.printf("🟠 CAL done in %lu ms (profile %d)\n", millis() - start, cal_profile);
+    for (int sensor = sensor_1; sensor <= sensor_3; sensor++) {
+      Serial.printf("🟠   S%d thresholds R=%d G=%d B=%d bands R=%d G=%d B=%d\n", sensor + 1,
+                    red_threshold[sensor], green_threshold[sensor], blue_threshold[sensor],
+                    hysteresis_band[sensor][red], hysteresis_band[sensor][green], hysteresis_band[sensor][blue]);
+    }
+    return true;
+}//CCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCc
 
-    for (int i = 0; i <= 20; i++)
-    {
-      digitalWrite(red_led, HIGH);
+int* cal_threshold(int color)
+{
+    if (color == red) return red_threshold;
+    if (color == green) return green_threshold;
+    return blue_threshold;
+}
+
+// Blink the surface colour so the operator knows which patch to place MARV on
+void cal_cue_surface(int surface)
+{
+    scan_engine_stop();
+    for (int i = 0; i < CAL_CUE_BLINKS; i++) {
+      scan_set_led(surface);
       delay(100);
-      digitalWrite(red_led, LOW);
+      scan_set_led(-1);
       delay(100);
     }
-    red_on_red[sensor_1] = flash_n_scan(red, sensor_1);
-    red_on_red[sensor_2] = flash_n_scan(red, sensor_2);
-    red_on_red[sensor_3] = flash_n_scan(red, sensor_3);
-    green_on_red[sensor_1] = flash_n_scan(green, sensor_1);
-    green_on_red[sensor_2] = flash_n_scan(green, sensor_2);
-    green_on_red[sensor_3] = flash_n_scan(green, sensor_3);
-    blue_on_red[sensor_1] = flash_n_scan(blue, sensor_1);
-    blue_on_red[sensor_2] = flash_n_scan(blue, sensor_2);
-    blue_on_red[sensor_3] = flash_n_scan(blue, sensor_3);
-    digitalWrite(red_led, LOW);
-    digitalWrite(green_led, LOW);
-    digitalWrite(blue_led, LOW);
-
-
-    for (int i = 0; i <= 20; i++)
-    {
-      digitalWrite(green_led, HIGH);
-      delay(100);
-      digitalWrite(green_led, LOW);
-      delay(100);
+}
+
+// Per-channel mean and standard deviation over fresh scan engine frames
+// mean/sigma are [led colour][sensor]
+bool cal_capture_surface(float mean[3][3], float sigma[3][3])
+{
+    int readings[3][3];
+    int64_t sum[3][3] = {{0}};
+    int64_t sum_sq[3][3] = {{0}};
+    uint32_t last_frame = 0;
+    uint32_t frame_number = 0;
+    int64_t frame_time_us = 0;
+    int frames = 0;
+
+    scan_engine_start();
+    scan_latest_frame(readings, &last_frame, &frame_time_us);   // Anything up to now predates the cue
+
+    unsigned long start = millis();
+    while (frames < CAL_FRAMES_PER_SURFACE) {
+      if (millis() - start > CAL_CAPTURE_TIMEOUT_MS) {
+        return false;
+      }
+      scan_latest_frame(readings, &frame_number, &frame_time_us);
+      if (frame_number == last_frame) {
+        delay(1);
+        continue;
+      }
+      last_frame = frame_number;
+
+      for (int color = red; color <= blue; color++) {
+        for (int sensor = sensor_1; sensor <= sensor_3; sensor++) {
+          int v = readings[color][sensor];
+          sum[color][sensor] += v;
+          sum_sq[color][sensor] += (int64_t)v * v;
+        }
+      }
+      frames++;
     }
-    red_on_green[sensor_1] = flash_n_scan(red, sensor_1);
-    red_on_green[sensor_2] = flash_n_scan(red, sensor_2);
-    red_on_green[sensor_3] = flash_n_scan(red, sensor_3);
-    green_on_green[sensor_1] = flash_n_scan(green, sensor_1);
-    green_on_green[sensor_2] = flash_n_scan(green, sensor_2);
-    green_on_green[sensor_3] = flash_n_scan(green, sensor_3);
-    blue_on_green[sensor_1] = flash_n_scan(blue, sensor_1);
-    blue_on_green[sensor_2] = flash_n_scan(blue, sensor_2);
-    blue_on_green[sensor_3] = flash_n_scan(blue, sensor_3);
-    digitalWrite(red_led, LOW);
-    digitalWrite(green_led, LOW);
-    digitalWrite(blue_led, LOW);
-
-
-    for (int i = 0; i <= 20; i++)
-    {
-      digitalWrite(blue_led, HIGH);
-      delay(100);
-      digitalWrite(blue_led, LOW);
-      delay(100);
+
+    for (int color = red; color <= blue; color++) {
+      for (int sensor = sensor_1; sensor <= sensor_3; sensor++) {
+        float m = (float)sum[color][sensor] / frames;
+        float var = (float)sum_sq[color][sensor] / frames - m * m;
+        mean[color][sensor] = m;
+        sigma[color][sensor] = var > 0 ? sqrtf(var) : 0;
+      }
     }
-    red_on_blue[sensor_1] = flash_n_scan(red, sensor_1);
-    red_on_blue[sensor_2] = flash_n_scan(red, sensor_2);
-    red_on_blue[sensor_3] = flash_n_scan(red, sensor_3);
-    green_on_blue[sensor_1] = flash_n_scan(green, sensor_1);
-    green_on_blue[sensor_2] = flash_n_scan(green, sensor_2);
-    green_on_blue[sensor_3] = flash_n_scan(green, sensor_3);
-    blue_on_blue[sensor_1] = flash_n_scan(blue, sensor_1);
-    blue_on_blue[sensor_2] = flash_n_scan(blue, sensor_2);
-    blue_on_blue[sensor_3] = flash_n_scan(blue, sensor_3);
-    digitalWrite(red_led, LOW);
-    digitalWrite(green_led, LOW);
-    digitalWrite(blue_led, LOW);
+    return true;
+}
 
+const char* cal_key(uint8_t profile)
+{
+    static char key[8];
+    snprintf(key, sizeof(key), "prof%d", profile);
+    return key;
+}
 
-    if (red_on_green[sensor_1]> red_on_blue[sensor_1]) { 
-      red_threshold[sensor_1] = (red_on_red[sensor_1] + red_on_green[sensor_1])/2;
-    } else{ 
-      red_threshold[sensor_1] = (red_on_red[sensor_1] + red_on_blue[sensor_1])/2;
+uint8_t cal_checksum(const CalibrationRecord& record)
+{
+    const uint8_t* bytes = (const uint8_t*)&record;
+    uint8_t checksum = 0;
+    for (size_t i = 0; i < offsetof(CalibrationRecord, checksum); i++) {
+      checksum ^= bytes[i];
     }
+    return checksum;
+}
 
-    if (red_on_green[sensor_2]> red_on_blue[sensor_2]) { 
-      red_threshold[sensor_2] = (red_on_red[sensor_2] + red_on_green[sensor_2])/2;
-    } else{ 
-      red_threshold[sensor_2] = (red_on_red[sensor_2] + red_on_blue[sensor_2])/2;
+void cal_save(uint8_t profile)
+{
+    CalibrationRecord record;
+    memset(&record, 0, sizeof(record));
+    record.version = CAL_RECORD_VERSION;
+    record.profile = profile;
+    for (int sensor = sensor_1; sensor <= sensor_3; sensor++) {
+      record.red_threshold[sensor] = red_threshold[sensor];
+      record.green_threshold[sensor] = green_threshold[sensor];
+      record.blue_threshold[sensor] = blue_threshold[sensor];
+      for (int color = red; color <= blue; color++) {
+        record.band[sensor][color] = hysteresis_band[sensor][color];
+      }
     }
+    record.checksum = cal_checksum(record);
 
-    if (red_on_green[sensor_3]> red_on_blue[sensor_3]) { 
-      red_threshold[sensor_3] = (red_on_red[sensor_3] + red_on_green[sensor_3])/2;
-    } else{ 
-      red_threshold[sensor_3] = (red_on_red[sensor_3] + red_on_blue[sensor_3])/2;
-    }
+    cal_prefs.begin(CAL_NVS_NAMESPACE, false);
+    size_t written = cal_prefs.putBytes(cal_key(profile), &record, sizeof(record));
+    cal_prefs.end();
 
-    if (green_on_red[sensor_1] > green_on_blue[sensor_1]) {
-      green_threshold[sensor_1] = (green_on_green[sensor_1] +green_on_red[sensor_1])/2;
-    } else {
-      green_threshold[sensor_1] = (green_on_green[sensor_1] + green_on_blue[sensor_1])/2;
+    if (written != sizeof(record)) {
+      Serial.println("🟠 ❌ CAL save to NVS failed");
     }
+}
 
-    if (green_on_red[sensor_2] > green_on_blue[sensor_2]) {
-      green_threshold[sensor_2] = (green_on_green[sensor_2] +green_on_red[sensor_2])/2;
-    } else {
-      green_threshold[sensor_2] = (green_on_green[sensor_2] + green_on_blue[sensor_2])/2;
+// Restore a profile's thresholds; false (nothing changed) if missing or corrupt
+bool cal_load(uint8_t profile)
+{
+    CalibrationRecord record;
+    cal_prefs.begin(CAL_NVS_NAMESPACE, true);
+    size_t length = cal_prefs.getBytes(cal_key(profile), &record, sizeof(record));
+    cal_prefs.end();
+
+    if (length != sizeof(record) || record.version != CAL_RECORD_VERSION ||
+        record.profile != profile || record.checksum != cal_checksum(record)) {
+      return false;
     }
 
-    if (green_on_red[sensor_3] > green_on_blue[sensor_3]) {
-      green_threshold[sensor_3] = (green_on_green[sensor_3] +green_on_red[sensor_3])/2;
-    } else {
-      green_threshold[sensor_3] = (green_on_green[sensor_3] + green_on_blue[sensor_3])/2;
+    for (int sensor = sensor_1; sensor <= sensor_3; sensor++) {
+      red_threshold[sensor] = record.red_threshold[sensor];
+      green_threshold[sensor] = record.green_threshold[sensor];
+      blue_threshold[sensor] = record.blue_threshold[sensor];
+      for (int color = red; color <= blue; color++) {
+        hysteresis_band[sensor][color] = record.band[sensor][color];
+      }
     }
+    return true;
+}
 
-    if (blue_on_green[sensor_1] > blue_on_red[sensor_1]) {
-      blue_threshold[sensor_1] = (blue_on_blue[sensor_1] + blue_on_green[sensor_1])/2;
-    } else {
-      blue_threshold[sensor_1] = (blue_on_blue[sensor_1] + blue_on_red[sensor_1])/2;
+// Shared-illumination scan: the LED array lights all three photodiodes, so
+// each flash is read on every sensor - 3 flashes per frame instead of 9.
+// Never blocks: each new scan engine frame is filtered and classified once;
+// repeat calls return that result (all WHITE before the first frame).
+// Returns true only if the frame had not been seen yet.
+bool color_detection_all(uint8_t colors[3])
+{
+  int readings[3][3];
+  uint32_t frame_number = 0;
+  int64_t frame_time_us = 0;
+
+  bool have_frame = scan_latest_frame(readings, &frame_number, &frame_time_us);
+  bool is_new = have_frame && frame_number != scan_last_consumed;
+
+  if (is_new) {
+    scan_last_consumed = frame_number;
+    filtered_frame_time_us = frame_time_us;
+    filter_push_frame(readings);
+    for (int sensor = sensor_1; sensor <= sensor_3; sensor++) {
+      filtered_colors[sensor] = classify_color(sensor,
+                                               filter_channel(sensor, red),
+                                               filter_channel(sensor, green),
+                                               filter_channel(sensor, blue),
+                                               &color_confidence[sensor]);
     }
+  }
 
-    if (blue_on_green[sensor_2] > blue_on_red[sensor_2]) {
-      blue_threshold[sensor_2] = (blue_on_blue[sensor_2] + blue_on_green[sensor_2])/2;
-    } else {
-      blue_threshold[sensor_2] = (blue_on_blue[sensor_2] + blue_on_red[sensor_2])/2;
+  colors[sensor_1] = filtered_colors[sensor_1];
+  colors[sensor_2] = filtered_colors[sensor_2];
+  colors[sensor_3] = filtered_colors[sensor_3];
+  return is_new;
+}
+
+// Add a frame [colour][sensor] to the per-channel median window
+void filter_push_frame(int readings[3][3])
+{
+  for (int sensor = sensor_1; sensor <= sensor_3; sensor++) {
+    for (int color = red; color <= blue; color++) {
+      filter_history[sensor][color][filter_next_tap] = readings[color][sensor];
     }
+  }
+  filter_next_tap = (filter_next_tap + 1) % FILTER_MEDIAN_TAPS;
+  if (filter_taps_filled < FILTER_MEDIAN_TAPS) {
+    filter_taps_filled++;
+  }
+}
 
-    if (blue_on_green[sensor_3] > blue_on_red[sensor_3]) {
-      blue_threshold[sensor_3] = (blue_on_blue[sensor_3] + blue_on_green[sensor_3])/2;
-    } else {
-      blue_threshold[sensor_3] = (blue_on_blue[sensor_3] + blue_on_red[sensor_3])/2;
+// Median of the window - a single-frame spike at a line edge never reaches the threshold
+int filter_channel(int sensor, int color)
+{
+  int* taps = filter_history[sensor][color];
+  if (filter_taps_filled < FILTER_MEDIAN_TAPS) {
+    // Window still filling - use the newest reading
+    return taps[(filter_next_tap + FILTER_MEDIAN_TAPS - 1) % FILTER_MEDIAN_TAPS];
+  }
+  int a = taps[0], b = taps[1], c = taps[2];
+  if (a > b) { int t = a; a = b; b = t; }
+  if (b > c) { b = c; }
+  return a > b ? a : b;
+}
+
+// Clear the median window and latches (stale frames from before CAL)
+void filter_reset()
+{
+  filter_next_tap = 0;
+  filter_taps_filled = 0;
+  for (int sensor = sensor_1; sensor <= sensor_3; sensor++) {
+    for (int color = red; color <= blue; color++) {
+      channel_on[sensor][color] = 0;
     }
-}//CCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCc
+  }
+}
 
-uint8_t color_detection(int sensor)
+// Schmitt trigger: turn on above threshold + band, off below threshold - band.
+// Confidence is how far the reading sits from the threshold (100 % at 2 bands).
+int channel_test(int sensor, int color, int reading, int threshold, uint8_t* confidence)
 {
-  int red_test = 0;
-  int green_test = 0;
-  int blue_test = 0;
+  int band = hysteresis_band[sensor][color];
+  if (channel_on[sensor][color]) {
+    if (reading < threshold - band) { channel_on[sensor][color] = 0; }
+  } else {
+    if (reading >= threshold + band) { channel_on[sensor][color] = 1; }
+  }
 
-  red_test = flash_n_scan(red, sensor);
-  green_test = flash_n_scan(green, sensor);
-  blue_test = flash_n_scan(blue, sensor);
+  int margin = abs(reading - threshold) * 100 / (2 * (band > 0 ? band : 1));
+  *confidence = margin > 100 ? 100 : margin;
 
+  display_array(sensor, color, channel_on[sensor][color]);
+  return channel_on[sensor][color];
+}
 
-  if (red_test >= red_threshold[sensor]){red_test = 1;display_array(sensor, red, 1);} else { red_test = 0;display_array(sensor, red, 0); }
-  if (green_test >= green_threshold[sensor]){green_test = 1;display_array(sensor, green, 1);} else { green_test = 0;display_array(sensor, green, 0); }
-  if (blue_test >= blue_threshold[sensor]){blue_test = 1;display_array(sensor, blue, 1);} else { blue_test = 0;display_array(sensor, blue, 0); }
+uint8_t classify_color(int sensor, int red_test, int green_test, int blue_test, uint8_t* confidence)
+{
+  uint8_t red_conf, green_conf, blue_conf;
+  red_test = channel_test(sensor, red, red_test, red_threshold[sensor], &red_conf);
+  green_test = channel_test(sensor, green, green_test, green_threshold[sensor], &green_conf);
+  blue_test = channel_test(sensor, blue, blue_test, blue_threshold[sensor], &blue_conf);
+
+  // The colour is only as certain as its weakest channel decision
+  uint8_t weakest = red_conf < green_conf ? red_conf : green_conf;
+  *confidence = weakest < blue_conf ? weakest : blue_conf;
 
-  
   if ( red_test == 1 && green_test == 0 && blue_test ==0){return 1;}
   else if ( red_test == 0 && green_test == 1 && blue_test ==0){return 2;}
   else if ( red_test == 0 && green_test == 0 && blue_test ==1){return 3;}
@@ -1226,8 +1783,17 @@ uint8_t color_detection(int sensor)
   else {return 0;}
 }
 
+// Last state written to each display LED [sensor][color] (-1 = unknown)
+int display_state[3][3] = {{-1, -1, -1}, {-1, -1, -1}, {-1, -1, -1}};
+
 void display_array(int sensor, int color, int status)
 {
+    // Most frames repeat the previous pattern - skip redundant pin writes
+    if (display_state[sensor][color] == status) {
+      return;
+    }
+    display_state[sensor][color] = status;
+
     if (sensor == sensor_1){
       if (color == red){
         digitalWrite(19, status);
@@ -1255,24 +1821,3 @@ void display_array(int sensor, int color, int status)
     }
 
 }
-
-int flash_n_scan(int color, int sensor)//ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff
-{
-  digitalWrite(red_led, LOW);
-  digitalWrite(green_led, LOW);
-  digitalWrite(blue_led, LOW);
-  if ( color == 0)
-  {
-    digitalWrite(red_led, HIGH);
-  } else if(color == 1)
-  {
-    digitalWrite(green_led, HIGH);
-  } else if(color == 2)
-  {
-    digitalWrite(blue_led, HIGH);
-  }
-  delay(sample_time);
-  if (sensor == 0){return analogRead(36);}
-  else if(sensor == 1){return analogRead(39);}
-  else if(sensor == 2){return analogRead(34);} 
-}//fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff